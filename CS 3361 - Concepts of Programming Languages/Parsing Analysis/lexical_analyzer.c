@@ -10,6 +10,7 @@ Due Date:           11/06/2024
 
 Requirement Checks:
     - Reads input file specified as command line argument
+    - Streams gzip/zstd compressed input and stdin ("-") in fixed-size blocks
     - Identifies all lexemes defined in the Cooke language specification
     - Maps lexemes to appropriate tokens
     - Handles whitespace and delimiters correctly
@@ -23,9 +24,16 @@ Requirement Checks:
 #include <string.h>
 #include <ctype.h>
 
+// Declaring compression libraries (zstd is optional, build with ZSTD=1)
+#include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
 // Declaring definitions
 #define MAX_LEXEME_LEN 100
 #define MAX_TOKENS 1000
+#define INPUT_BLOCK_SIZE 65536
 
 // Deckaring token types
 typedef enum {
@@ -43,6 +51,165 @@ typedef struct {
     TokenType token;
 } Token;
 
+// Declaring input encodings detected by magic bytes
+typedef enum {
+    SOURCE_PLAIN, SOURCE_GZIP, SOURCE_ZSTD
+} SourceKind;
+
+// Declaring structure for block-buffered input (memory stays at two blocks)
+typedef struct {
+    FILE* file;
+    SourceKind kind;
+    unsigned char block[INPUT_BLOCK_SIZE];  // Decoded bytes read by the lexer
+    size_t pos;
+    size_t len;
+    unsigned char raw[INPUT_BLOCK_SIZE];    // Compressed bytes read from the file
+    z_stream gz;
+#ifdef HAVE_ZSTD
+    ZSTD_DCtx* zstd;
+    ZSTD_inBuffer zin;
+#endif
+    int frameOpen;                          // Compressed frame started but not finished
+    int eof;
+    const char* error;
+} InputStream;
+
+// Inflating the next gzip block (concatenated members are allowed)
+void fillGzipBlock(InputStream* in) {
+    in->gz.next_out = in->block;
+    in->gz.avail_out = INPUT_BLOCK_SIZE;
+    while (in->gz.avail_out == INPUT_BLOCK_SIZE) {
+        if (in->gz.avail_in == 0) {
+            size_t n = fread(in->raw, 1, INPUT_BLOCK_SIZE, in->file);
+            if (n == 0) {
+                if (in->frameOpen) in->error = "truncated gzip stream";
+                in->eof = 1;
+                break;
+            }
+            in->gz.next_in = in->raw;
+            in->gz.avail_in = (uInt)n;
+        }
+        int ret = inflate(&in->gz, Z_NO_FLUSH);
+        if (ret == Z_STREAM_END) {
+            in->frameOpen = 0;
+            inflateReset(&in->gz);
+        } else if (ret == Z_OK || ret == Z_BUF_ERROR) {
+            in->frameOpen = 1;
+        } else {
+            in->error = "corrupt gzip stream";
+            break;
+        }
+    }
+    in->len = INPUT_BLOCK_SIZE - in->gz.avail_out;
+}
+
+#ifdef HAVE_ZSTD
+// Decompressing the next zstd block (concatenated frames are allowed)
+void fillZstdBlock(InputStream* in) {
+    ZSTD_outBuffer out = { in->block, INPUT_BLOCK_SIZE, 0 };
+    while (out.pos == 0) {
+        if (in->zin.pos == in->zin.size) {
+            size_t n = fread(in->raw, 1, INPUT_BLOCK_SIZE, in->file);
+            if (n == 0) {
+                if (in->frameOpen) in->error = "truncated zstd stream";
+                in->eof = 1;
+                break;
+            }
+            in->zin.src = in->raw;
+            in->zin.size = n;
+            in->zin.pos = 0;
+        }
+        size_t ret = ZSTD_decompressStream(in->zstd, &out, &in->zin);
+        if (ZSTD_isError(ret)) {
+            in->error = "corrupt zstd stream";
+            break;
+        }
+        in->frameOpen = (ret != 0);
+    }
+    in->len = out.pos;
+}
+#endif
+
+// Refilling the lexer block from the underlying source
+void fillBlock(InputStream* in) {
+    in->pos = 0;
+    in->len = 0;
+    switch (in->kind) {
+        case SOURCE_GZIP: fillGzipBlock(in); break;
+#ifdef HAVE_ZSTD
+        case SOURCE_ZSTD: fillZstdBlock(in); break;
+#endif
+        default:
+            in->len = fread(in->block, 1, INPUT_BLOCK_SIZE, in->file);
+            if (in->len == 0) in->eof = 1;
+            break;
+    }
+}
+
+// Opening a path ("-" for stdin) and sniffing its encoding from the first block
+InputStream* openInput(const char* path) {
+    InputStream* in = calloc(1, sizeof(InputStream));
+    if (!in) return NULL;
+    in->file = (strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+    if (!in->file) {
+        free(in);
+        return NULL;
+    }
+    size_t n = fread(in->raw, 1, INPUT_BLOCK_SIZE, in->file);
+    if (n >= 2 && in->raw[0] == 0x1F && in->raw[1] == 0x8B) {
+        in->kind = SOURCE_GZIP;
+        if (inflateInit2(&in->gz, 15 + 32) != Z_OK) {
+            in->error = "could not initialize gzip decoder";
+        }
+        in->gz.next_in = in->raw;
+        in->gz.avail_in = (uInt)n;
+    } else if (n >= 4 && in->raw[0] == 0x28 && in->raw[1] == 0xB5 &&
+               in->raw[2] == 0x2F && in->raw[3] == 0xFD) {
+        in->kind = SOURCE_ZSTD;
+#ifdef HAVE_ZSTD
+        in->zstd = ZSTD_createDCtx();
+        if (!in->zstd) in->error = "could not initialize zstd decoder";
+        in->zin.src = in->raw;
+        in->zin.size = n;
+        in->zin.pos = 0;
+#else
+        in->error = "zstd input is not supported by this build (rebuild with ZSTD=1)";
+#endif
+    } else {
+        // Handing the sniffed bytes straight to the lexer
+        in->kind = SOURCE_PLAIN;
+        memcpy(in->block, in->raw, n);
+        in->len = n;
+        if (n == 0) in->eof = 1;
+    }
+    return in;
+}
+
+// Closing the source and releasing decoder state
+void closeInput(InputStream* in) {
+    if (in->kind == SOURCE_GZIP) inflateEnd(&in->gz);
+#ifdef HAVE_ZSTD
+    if (in->kind == SOURCE_ZSTD) ZSTD_freeDCtx(in->zstd);
+#endif
+    if (in->file != stdin) fclose(in->file);
+    free(in);
+}
+
+// Reading the next decoded byte (EOF at end of input or on error)
+int readChar(InputStream* in) {
+    if (in->pos == in->len) {
+        if (in->eof || in->error) return EOF;
+        fillBlock(in);
+        if (in->len == 0) return EOF;
+    }
+    return in->block[in->pos++];
+}
+
+// Pushing back the byte returned by the last readChar
+void unreadChar(InputStream* in, int c) {
+    if (c != EOF && in->pos > 0) in->pos--;
+}
+
 // Converting TokenType to string representation
 const char* getTokenName(TokenType token) {
     switch(token) {
@@ -92,13 +259,13 @@ TokenType getKeywordToken(const char* lexeme) {
 }
 
 // Declaring next token from input file
-Token getNextToken(FILE* file) {
+Token getNextToken(InputStream* in) {
     Token token = {.lexeme = "", .token = UNKNOWN};
-    char c;
+    int c;
     int i = 0;
     
     // Skipping whitespace and newlines
-    while ((c = fgetc(file)) != EOF && (isspace(c) || c == '\n' || c == '\r'));
+    while ((c = readChar(in)) != EOF && (isspace(c) || c == '\n' || c == '\r'));
     if (c == EOF) {
         return token;
     }
@@ -115,26 +282,26 @@ Token getNextToken(FILE* file) {
     
     // Handling identifiers/keywords
     if (isValidIdentChar(c)) {
-        while ((c = fgetc(file)) != EOF && (isValidIdentChar(c) || isdigit(c))) {
+        while ((c = readChar(in)) != EOF && (isValidIdentChar(c) || isdigit(c))) {
             if (i < MAX_LEXEME_LEN - 1) {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
             }
         }
-        ungetc(c, file);
+        unreadChar(in, c);
         token.token = getKeywordToken(token.lexeme);
         return token;
     }
     
     // Handling numbers
     if (isdigit(c)) {
-        while ((c = fgetc(file)) != EOF && isdigit(c)) {
+        while ((c = readChar(in)) != EOF && isdigit(c)) {
             if (i < MAX_LEXEME_LEN - 1) {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
             }
         }
-        ungetc(c, file);
+        unreadChar(in, c);
         token.token = INT_LIT;
         return token;
     }
@@ -142,73 +309,73 @@ Token getNextToken(FILE* file) {
     // Handling operators and other symbols
     switch (c) {
         case '=':
-            c = fgetc(file);
+            c = readChar(in);
             if (c == '=') {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
                 token.token = EQUAL_OP;
             } else {
-                ungetc(c, file);
+                unreadChar(in, c);
                 token.token = ASSIGN_OP;
             }
             return token;
             
         case '<':
-            c = fgetc(file);
+            c = readChar(in);
             if (c == '=') {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
                 token.token = LEQUAL_OP;
             } else {
-                ungetc(c, file);
+                unreadChar(in, c);
                 token.token = LESSER_OP;
             }
             return token;
             
         case '>':
-            c = fgetc(file);
+            c = readChar(in);
             if (c == '=') {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
                 token.token = GEQUAL_OP;
             } else {
-                ungetc(c, file);
+                unreadChar(in, c);
                 token.token = GREATER_OP;
             }
             return token;
             
         case '!':
-            c = fgetc(file);
+            c = readChar(in);
             if (c == '=') {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
                 token.token = NEQUAL_OP;
             } else {
-                ungetc(c, file);
+                unreadChar(in, c);
                 token.token = BOOL_NOT;
             }
             return token;
             
         case '&':
-            c = fgetc(file);
+            c = readChar(in);
             if (c == '&') {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
                 token.token = BOOL_AND;
             } else {
-                ungetc(c, file);
+                unreadChar(in, c);
                 token.token = UNKNOWN;
             }
             return token;
 
         case '|':
-            c = fgetc(file);
+            c = readChar(in);
             if (c == '|') {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
                 token.token = BOOL_OR;
             } else {
-                ungetc(c, file);
+                unreadChar(in, c);
                 token.token = UNKNOWN;
             }
             return token;
@@ -231,16 +398,21 @@ Token getNextToken(FILE* file) {
 int main(int argc, char *argv[]) {
     // Checking arguments
     if (argc != 2) {
-        printf("Usage: %s <source_file>\n", argv[0]);
+        printf("Usage: %s <source_file | ->\n", argv[0]);
         return 1;
     }
     
-    // Opening input file
-    FILE *file = fopen(argv[1], "r");
-    if (!file) {
+    // Opening input file (plain, gzip or zstd; "-" reads stdin)
+    InputStream *in = openInput(argv[1]);
+    if (!in) {
         printf("Error: Could not open file %s\n", argv[1]);
         return 1;
     }
+    if (in->error) {
+        printf("Error: Could not read file %s: %s\n", argv[1], in->error);
+        closeInput(in);
+        return 1;
+    }
     
     // Printing R# header
     printf("Cooke Analyzer :: RX\n");
@@ -248,11 +420,17 @@ int main(int argc, char *argv[]) {
     // Process tokens directly
     Token token;
     while (1) {
-        token = getNextToken(file);
+        token = getNextToken(in);
         if (token.lexeme[0] == '\0') break;  // EOF reached
         printf("%s\t%s\n", token.lexeme, getTokenName(token.token));
     }
     
-    fclose(file);
-    return 0;
+    // Reporting decompression failures found mid-stream
+    int status = 0;
+    if (in->error) {
+        printf("Error: Could not read file %s: %s\n", argv[1], in->error);
+        status = 1;
+    }
+    closeInput(in);
+    return status;
 }
\ No newline at end of file
@@ -13,9 +13,40 @@ Due Date:           11/20/2024
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+
+// AVX2 newline scanning is picked at run time on x86-64
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define HAVE_AVX2_SCAN 1
+#endif
+
+// Compression libraries (zstd is optional, build with ZSTD=1)
+#include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
 
 #define MAX_LEXEME_LEN 100
 #define MAX_TOKENS 1000
+#define INPUT_BLOCK_SIZE 65536
+#define MAX_REGION_WIDENING 8
+#define PROFILE_SAMPLE_PERIOD 16
+#define IO_BLOCK_SIZE (1 << 18)
+
+// Interpreter profiling is compiled in unless built with PROFILE=0
+#ifndef COOKE_PROFILE
+#define COOKE_PROFILE 1
+#endif
+#if COOKE_PROFILE && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
 
 // Token types
 typedef enum {
@@ -31,29 +62,473 @@ typedef enum {
 typedef struct {
     char lexeme[MAX_LEXEME_LEN];
     TokenType token;
+    uint64_t start;                         // Source offset of the first character
+    uint64_t end;                           // Source offset just past the last character
 } Token;
 
+// Declaring one indexed block of source (newline positions are stored relative to it)
+typedef struct {
+    uint64_t base;                          // Source offset of the block
+    uint64_t line;                          // Newlines before the block
+    uint64_t lineStart;                     // Start of the line the block begins in
+    size_t first;                           // First entry of the block in newlines[]
+} LineBlock;
+
+// Declaring the line-start index (two bytes per line plus one entry per block)
+typedef struct {
+    LineBlock* blocks;
+    size_t blockCount;
+    size_t blockCapacity;
+    uint16_t* newlines;                     // Newline positions within their block
+    size_t count;
+    size_t capacity;
+    uint64_t lines;                         // Newlines indexed so far
+    uint64_t lineStart;                     // Start of the last indexed line
+    size_t window;                          // Blocks kept (0 keeps all; streams keep the last two)
+} LineIndex;
+
+// Declaring input encodings detected by magic bytes
+typedef enum {
+    SOURCE_PLAIN, SOURCE_GZIP, SOURCE_ZSTD, SOURCE_MEMORY
+} SourceKind;
+
+// Declaring structure for block-buffered input (memory stays at two blocks)
+typedef struct {
+    FILE* file;
+    SourceKind kind;
+    const unsigned char* buf;               // Bytes read by the lexer (block or caller memory)
+    uint64_t base;                          // Source offset of buf[0]
+    size_t pos;
+    size_t len;
+    unsigned char block[INPUT_BLOCK_SIZE];  // Decoded bytes of the current block
+    unsigned char raw[INPUT_BLOCK_SIZE];    // Compressed bytes read from the file
+    z_stream gz;
+#ifdef HAVE_ZSTD
+    ZSTD_DCtx* zstd;
+    ZSTD_inBuffer zin;
+#endif
+    int frameOpen;                          // Compressed frame started but not finished
+    int eof;
+    const char* error;
+    LineIndex lines;                        // Filled as blocks are decoded
+} InputStream;
+
+// Line index
+// Growing an index array to hold at least need entries
+void* growArray(void* array, size_t* capacity, size_t need, size_t size) {
+    if (need <= *capacity) return array;
+    size_t grown = *capacity ? *capacity : 1024;
+    while (grown < need) grown *= 2;
+    array = realloc(array, grown * size);
+    if (!array) {
+        printf("Error: Out of memory\n");
+        exit(4);
+    }
+    *capacity = grown;
+    return array;
+}
+
+// Recording newline positions of data[0, len) with memchr
+size_t scanNewlines(uint16_t* out, const unsigned char* data, size_t len) {
+    const unsigned char* p = data;
+    const unsigned char* end = data + len;
+    size_t n = 0;
+    while ((p = memchr(p, '\n', end - p)) != NULL) {
+        out[n++] = (uint16_t)(p - data);
+        p++;
+    }
+    return n;
+}
+
+#ifdef HAVE_AVX2_SCAN
+// Recording newline positions 32 bytes at a time (bit tricks walk each mask)
+__attribute__((target("avx2,popcnt,bmi")))
+size_t scanNewlinesAvx2(uint16_t* out, const unsigned char* data, size_t len) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t n = 0;
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(data + i));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline));
+        while (mask) {
+            out[n++] = (uint16_t)(i + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+    size_t tail = scanNewlines(out + n, data + i, len - i);
+    while (tail--) out[n++] += (uint16_t)i;
+    return n;
+}
+#endif
+
+// Indexing one decoded block at source offset base (blocks arrive in order)
+void indexLines(LineIndex* index, const unsigned char* data, size_t len, uint64_t base) {
+    static size_t (*scan)(uint16_t*, const unsigned char*, size_t) = NULL;
+    if (!scan) {
+        scan = scanNewlines;
+#ifdef HAVE_AVX2_SCAN
+        if (__builtin_cpu_supports("avx2")) scan = scanNewlinesAvx2;
+#endif
+    }
+    if (len == 0) return;
+    
+    // Dropping the oldest block once the window is full (only the running counts outlive it)
+    if (index->window && index->blockCount == index->window) {
+        size_t dropped = (index->blockCount > 1) ? index->blocks[1].first : index->count;
+        size_t i;
+        memmove(index->newlines, index->newlines + dropped, (index->count - dropped) * sizeof(uint16_t));
+        memmove(index->blocks, index->blocks + 1, (index->blockCount - 1) * sizeof(LineBlock));
+        index->count -= dropped;
+        index->blockCount--;
+        for (i = 0; i < index->blockCount; i++) index->blocks[i].first -= dropped;
+    }
+    
+    // Block record first, so lookups can find the line a block starts in
+    index->blocks = growArray(index->blocks, &index->blockCapacity, index->blockCount + 1, sizeof(LineBlock));
+    LineBlock* block = &index->blocks[index->blockCount++];
+    block->base = base;
+    block->line = index->lines;
+    block->lineStart = index->lineStart;
+    block->first = index->count;
+    
+    // Worst case every byte is a newline
+    index->newlines = growArray(index->newlines, &index->capacity, index->count + len, sizeof(uint16_t));
+    size_t n = scan(index->newlines + index->count, data, len);
+    if (n) index->lineStart = base + index->newlines[index->count + n - 1] + 1;
+    index->count += n;
+    index->lines += n;
+}
+
+// Indexing a whole in-memory text
+void indexText(LineIndex* index, const char* text, size_t length) {
+    size_t done;
+    for (done = 0; done < length; done += INPUT_BLOCK_SIZE) {
+        size_t n = length - done < INPUT_BLOCK_SIZE ? length - done : INPUT_BLOCK_SIZE;
+        indexLines(index, (const unsigned char*)text + done, n, done);
+    }
+}
+
+// Releasing index memory
+void freeLineIndex(LineIndex* index) {
+    free(index->blocks);
+    free(index->newlines);
+    memset(index, 0, sizeof(LineIndex));
+}
+
+// Mapping a source offset to its 1-based line and column (two binary searches)
+void lineColumn(const LineIndex* index, uint64_t offset, uint64_t* line, uint64_t* column) {
+    size_t lo = 0;
+    size_t hi = index->blockCount;
+    
+    // Last block starting at or before offset
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (index->blocks[mid].base <= offset) lo = mid;
+        else hi = mid;
+    }
+    if (index->blockCount == 0 || index->blocks[lo].base > offset) {
+        *line = 1;
+        *column = offset + 1;
+        return;
+    }
+    const LineBlock* block = &index->blocks[lo];
+    size_t first = block->first;
+    size_t last = (lo + 1 < index->blockCount) ? index->blocks[lo + 1].first : index->count;
+    
+    // Newlines of the block that lie before offset
+    size_t a = first;
+    size_t b = last;
+    while (a < b) {
+        size_t mid = a + (b - a) / 2;
+        if (block->base + index->newlines[mid] < offset) a = mid + 1;
+        else b = mid;
+    }
+    uint64_t lineStart = (a > first) ? block->base + index->newlines[a - 1] + 1 : block->lineStart;
+    *line = block->line + (a - first) + 1;
+    *column = offset - lineStart + 1;
+}
+
+// Inflating the next gzip block (concatenated members are allowed)
+void fillGzipBlock(InputStream* in) {
+    in->gz.next_out = in->block;
+    in->gz.avail_out = INPUT_BLOCK_SIZE;
+    while (in->gz.avail_out == INPUT_BLOCK_SIZE) {
+        if (in->gz.avail_in == 0) {
+            size_t n = fread(in->raw, 1, INPUT_BLOCK_SIZE, in->file);
+            if (n == 0) {
+                if (in->frameOpen) in->error = "truncated gzip stream";
+                in->eof = 1;
+                break;
+            }
+            in->gz.next_in = in->raw;
+            in->gz.avail_in = (uInt)n;
+        }
+        int ret = inflate(&in->gz, Z_NO_FLUSH);
+        if (ret == Z_STREAM_END) {
+            in->frameOpen = 0;
+            inflateReset(&in->gz);
+        } else if (ret == Z_OK || ret == Z_BUF_ERROR) {
+            in->frameOpen = 1;
+        } else {
+            in->error = "corrupt gzip stream";
+            break;
+        }
+    }
+    in->len = INPUT_BLOCK_SIZE - in->gz.avail_out;
+}
+
+#ifdef HAVE_ZSTD
+// Decompressing the next zstd block (concatenated frames are allowed)
+void fillZstdBlock(InputStream* in) {
+    ZSTD_outBuffer out = { in->block, INPUT_BLOCK_SIZE, 0 };
+    while (out.pos == 0) {
+        if (in->zin.pos == in->zin.size) {
+            size_t n = fread(in->raw, 1, INPUT_BLOCK_SIZE, in->file);
+            if (n == 0) {
+                if (in->frameOpen) in->error = "truncated zstd stream";
+                in->eof = 1;
+                break;
+            }
+            in->zin.src = in->raw;
+            in->zin.size = n;
+            in->zin.pos = 0;
+        }
+        size_t ret = ZSTD_decompressStream(in->zstd, &out, &in->zin);
+        if (ZSTD_isError(ret)) {
+            in->error = "corrupt zstd stream";
+            break;
+        }
+        in->frameOpen = (ret != 0);
+    }
+    in->len = out.pos;
+}
+#endif
+
+// Refilling the lexer block from the underlying source
+void fillBlock(InputStream* in) {
+    in->base += in->len;
+    in->pos = 0;
+    in->len = 0;
+    switch (in->kind) {
+        case SOURCE_GZIP: fillGzipBlock(in); break;
+#ifdef HAVE_ZSTD
+        case SOURCE_ZSTD: fillZstdBlock(in); break;
+#endif
+        default:
+            in->len = fread(in->block, 1, INPUT_BLOCK_SIZE, in->file);
+            if (in->len == 0) in->eof = 1;
+            break;
+    }
+    indexLines(&in->lines, in->block, in->len, in->base);
+}
+
+// Opening a path ("-" for stdin) and sniffing its encoding from the first block
+InputStream* openInput(const char* path) {
+    InputStream* in = calloc(1, sizeof(InputStream));
+    if (!in) return NULL;
+    in->buf = in->block;
+    in->lines.window = 2;                   // Previous block too, for a token that straddles the boundary
+    in->file = (strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+    if (!in->file) {
+        free(in);
+        return NULL;
+    }
+    size_t n = fread(in->raw, 1, INPUT_BLOCK_SIZE, in->file);
+    if (n >= 2 && in->raw[0] == 0x1F && in->raw[1] == 0x8B) {
+        in->kind = SOURCE_GZIP;
+        if (inflateInit2(&in->gz, 15 + 32) != Z_OK) {
+            in->error = "could not initialize gzip decoder";
+        }
+        in->gz.next_in = in->raw;
+        in->gz.avail_in = (uInt)n;
+    } else if (n >= 4 && in->raw[0] == 0x28 && in->raw[1] == 0xB5 &&
+               in->raw[2] == 0x2F && in->raw[3] == 0xFD) {
+        in->kind = SOURCE_ZSTD;
+#ifdef HAVE_ZSTD
+        in->zstd = ZSTD_createDCtx();
+        if (!in->zstd) in->error = "could not initialize zstd decoder";
+        in->zin.src = in->raw;
+        in->zin.size = n;
+        in->zin.pos = 0;
+#else
+        in->error = "zstd input is not supported by this build (rebuild with ZSTD=1)";
+#endif
+    } else {
+        // Handing the sniffed bytes straight to the lexer
+        in->kind = SOURCE_PLAIN;
+        memcpy(in->block, in->raw, n);
+        in->len = n;
+        if (n == 0) in->eof = 1;
+        indexLines(&in->lines, in->block, n, 0);
+    }
+    return in;
+}
+
+// Pointing a stream at text[start, end) already in memory (no copy, no allocation)
+void openMemoryInput(InputStream* in, const char* text, size_t start, size_t end) {
+    in->file = NULL;
+    in->kind = SOURCE_MEMORY;
+    in->buf = (const unsigned char*)text + start;
+    in->base = start;
+    in->pos = 0;
+    in->len = end - start;
+    in->eof = 1;
+    in->error = NULL;
+}
+
+// Closing the source and releasing decoder state
+void closeInput(InputStream* in) {
+    if (in->kind == SOURCE_GZIP) inflateEnd(&in->gz);
+#ifdef HAVE_ZSTD
+    if (in->kind == SOURCE_ZSTD) ZSTD_freeDCtx(in->zstd);
+#endif
+    if (in->file && in->file != stdin) fclose(in->file);
+    freeLineIndex(&in->lines);
+    free(in);
+}
+
+// Reading the next decoded byte (EOF at end of input or on error)
+int readChar(InputStream* in) {
+    if (in->pos == in->len) {
+        if (in->eof || in->error) return EOF;
+        fillBlock(in);
+        if (in->len == 0) return EOF;
+    }
+    return in->buf[in->pos++];
+}
+
+// Pushing back the byte returned by the last readChar
+void unreadChar(InputStream* in, int c) {
+    if (c != EOF && in->pos > 0) in->pos--;
+}
+
+// Statement kinds kept in the syntax tree
+typedef enum {
+    STMT_ASSIGN, STMT_INPUT, STMT_OUTPUT, STMT_IF, STMT_ERROR
+} StmtKind;
+
+struct Seq;
+
+// Statement node (lengths are relative, so later statements never store offsets)
+typedef struct Stmt {
+    StmtKind kind;
+    size_t length;                          // From the previous statement's end through this one's ; or }
+    size_t total;                           // Sum of lengths in this treap subtree
+    size_t errors;                          // STMT_ERROR nodes in this treap subtree
+    unsigned priority;
+    struct Stmt* left;
+    struct Stmt* right;
+    struct Stmt* up;
+    struct Seq* then;                       // if ( C ) { then } else { otherwise }
+    struct Seq* otherwise;
+    size_t thenStart;                       // Block interiors relative to the statement start
+    size_t elseStart;
+    Token* error;                           // STMT_ERROR: first bad token, relative to the statement
+} Stmt;
+
+// Statement sequence: the whole program or the inside of one { } block
+typedef struct Seq {
+    Stmt* root;
+    size_t trailing;                        // Whitespace after the last statement
+    size_t cursor;                          // Absolute end of the last statement while building
+    Stmt* owner;                            // Enclosing if-statement (NULL for the program)
+    struct Seq* parent;                     // Sequence holding the owner
+} Seq;
+
+// Incremental parse state for one source text
+typedef struct {
+    const char* text;
+    size_t length;
+    Seq* program;                           // NULL while the text fails a full parse
+    Token errorToken;                       // Error from the last failed full parse
+    long fullParses;
+    long regionParses;
+} ParseTree;
+
+// Expression kinds of a compiled program
+typedef enum {
+    EXPR_NUM, EXPR_VAR, EXPR_ADD, EXPR_SUB, EXPR_MUL, EXPR_DIV, EXPR_MOD,
+    EXPR_LT, EXPR_GT, EXPR_EQ, EXPR_NE, EXPR_LE, EXPR_GE,
+    EXPR_NOT, EXPR_AND, EXPR_OR
+} ExprKind;
+
+// Expression node of a compiled program
+typedef struct Expr {
+    ExprKind kind;
+    long long value;                        // EXPR_NUM literal
+    int slot;                               // EXPR_VAR variable
+    struct Expr* left;
+    struct Expr* right;
+} Expr;
+
+// Statement of a compiled program (next links a block, then/otherwise hold if bodies)
+typedef struct ExecStmt {
+    StmtKind kind;
+    int slot;                               // Assigned or input variable
+    Expr* expr;                             // Value, output expression or if condition
+    struct ExecStmt* then;
+    struct ExecStmt* otherwise;
+    struct ExecStmt* next;
+    uint64_t offset;                        // Source offset of the first token
+#if COOKE_PROFILE
+    uint64_t count;                         // Executions
+    uint64_t taken;                         // if: times the condition held
+    uint64_t cycles;                        // Sampled cost scaled by the sample period
+#endif
+} ExecStmt;
+
+// Runtime I/O state for input() and output() (one syscall per block, not per record)
+typedef struct {
+    unsigned char in[IO_BLOCK_SIZE];
+    size_t inPos;
+    size_t inLen;
+    int inEof;
+    char out[IO_BLOCK_SIZE];
+    size_t outLen;
+    int binary;                             // Little-endian int32 records instead of text lines
+    int pipe;                               // Output waits for a full block even when input blocks
+} RuntimeIO;
+
+// Compiled program with its variables
+typedef struct {
+    ExecStmt* body;
+    char (*names)[MAX_LEXEME_LEN];
+    long long* values;
+    int variables;
+    int capacity;
+    int* table;                             // Open-addressed name hash (slot + 1, 0 = empty)
+    int tableSize;
+} Program;
+
 // Global variables
-FILE* sourceFile;
+InputStream* sourceFile;
 Token currentToken;
-int lineNumber = 1;
 int hasError = 0;
+uint64_t lastTokenEnd = 0;
+Token errorToken;
 
 // Declaring usage functions
-Token getNextToken(FILE* file);
+Token getNextToken(InputStream* in);
 const char* getTokenName(TokenType token);
 int isValidIdentChar(char c);
 TokenType getKeywordToken(const char* lexeme);
 void reportError();
+void printError(const Token* token, uint64_t line, uint64_t column);
 void match(TokenType expectedToken);
-void P();
-void S();
+void parseProgram(Seq* program);
+void P(Seq* program);
+void S(Seq* seq);
 void C();
 void E();
 void T();
 void F();
 void V();
 void N();
+Stmt* newStmt(StmtKind kind);
+Seq* newSeq(size_t cursor, Stmt* owner, Seq* parent);
+void freeStmts(Stmt* t);
+void freeSeq(Seq* seq);
+void appendStmt(Seq* seq, Stmt* node);
 
 // Converting TokenType to string representation
 const char* getTokenName(TokenType token) {
@@ -103,23 +578,19 @@ TokenType getKeywordToken(const char* lexeme) {
     return IDENT;
 }
 
-// Get next token (lexical analyzer)
-Token getNextToken(FILE* file) {
+// Scan one token (lexical analyzer)
+Token scanToken(InputStream* in) {
     Token token = {.lexeme = "", .token = UNKNOWN};
-    char c;
+    int c;
     int i = 0;
-    int foundNewline = 0;
     
-    // Count lines and skip whitespace
-    while ((c = fgetc(file)) != EOF) {
-        if (c == '\n') {
-            lineNumber++;
-            foundNewline = 1;
-        }
+    // Skip whitespace (lines come from the stream's line index)
+    while ((c = readChar(in)) != EOF) {
         if (!isspace(c)) {
             break;
         }
     }
+    token.start = in->base + in->pos - (c != EOF);
     
     if (c == EOF) {
         return token;
@@ -138,26 +609,26 @@ Token getNextToken(FILE* file) {
     
     // Handle identifiers and keywords
     if (isValidIdentChar(c)) {
-        while ((c = fgetc(file)) != EOF && (isValidIdentChar(c) || isdigit(c))) {
+        while ((c = readChar(in)) != EOF && (isValidIdentChar(c) || isdigit(c))) {
             if (i < MAX_LEXEME_LEN - 1) {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
             }
         }
-        ungetc(c, file);
+        unreadChar(in, c);
         token.token = getKeywordToken(token.lexeme);
         return token;
     }
     
     // Handle numbers
     if (isdigit(c)) {
-        while ((c = fgetc(file)) != EOF && isdigit(c)) {
+        while ((c = readChar(in)) != EOF && isdigit(c)) {
             if (i < MAX_LEXEME_LEN - 1) {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
             }
         }
-        ungetc(c, file);
+        unreadChar(in, c);
         token.token = INT_LIT;
         return token;
     }
@@ -165,73 +636,73 @@ Token getNextToken(FILE* file) {
     // Handle operators and other symbols
     switch (c) {
         case '=':
-            c = fgetc(file);
+            c = readChar(in);
             if (c == '=') {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
                 token.token = EQUAL_OP;
             } else {
-                ungetc(c, file);
+                unreadChar(in, c);
                 token.token = ASSIGN_OP;
             }
             return token;
             
         case '<':
-            c = fgetc(file);
+            c = readChar(in);
             if (c == '=') {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
                 token.token = LEQUAL_OP;
             } else {
-                ungetc(c, file);
+                unreadChar(in, c);
                 token.token = LESSER_OP;
             }
             return token;
             
         case '>':
-            c = fgetc(file);
+            c = readChar(in);
             if (c == '=') {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
                 token.token = GEQUAL_OP;
             } else {
-                ungetc(c, file);
+                unreadChar(in, c);
                 token.token = GREATER_OP;
             }
             return token;
             
         case '!':
-            c = fgetc(file);
+            c = readChar(in);
             if (c == '=') {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
                 token.token = NEQUAL_OP;
             } else {
-                ungetc(c, file);
+                unreadChar(in, c);
                 token.token = BOOL_NOT;
             }
             return token;
             
         case '&':
-            c = fgetc(file);
+            c = readChar(in);
             if (c == '&') {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
                 token.token = BOOL_AND;
             } else {
-                ungetc(c, file);
+                unreadChar(in, c);
                 token.token = UNKNOWN;
             }
             return token;
 
         case '|':
-            c = fgetc(file);
+            c = readChar(in);
             if (c == '|') {
                 token.lexeme[i++] = c;
                 token.lexeme[i] = '\0';
                 token.token = BOOL_OR;
             } else {
-                ungetc(c, file);
+                unreadChar(in, c);
                 token.token = UNKNOWN;
             }
             return token;
@@ -250,18 +721,31 @@ Token getNextToken(FILE* file) {
     }
 }
 
-// Error reporting function
+// Get next token with its source offsets
+Token getNextToken(InputStream* in) {
+    Token token = scanToken(in);
+    token.end = in->base + in->pos;
+    return token;
+}
+
+// Error reporting function (records the first error; printError shows it)
 void reportError() {
     if (!hasError) {
-        printf("Error encounter on line %d: The next lexeme was %s and the next token is %s\n",
-               lineNumber, currentToken.lexeme, getTokenName(currentToken.token));
+        errorToken = currentToken;
         hasError = 1;
     }
 }
 
+// Printing an error in the validator's message format
+void printError(const Token* token, uint64_t line, uint64_t column) {
+    printf("Error encounter on line %" PRIu64 ", column %" PRIu64 ": The next lexeme was %s and the next token is %s\n",
+           line, column, token->lexeme, getTokenName(token->token));
+}
+
 // Match and consume expected token
 void match(TokenType expectedToken) {
     if (currentToken.token == expectedToken) {
+        lastTokenEnd = currentToken.end;
         currentToken = getNextToken(sourceFile);
     } else {
         reportError();
@@ -270,95 +754,101 @@ void match(TokenType expectedToken) {
 
 // Recursive descent parsing functions
 // P() function
-void P() { // P ::= S
-    S();
+void P(Seq* program) { // P ::= S
+    S(program);
 }
 
-// S() function
-void S() {
-    if (hasError) return;
-    
-    // Handle empty input or end of file
-    if (currentToken.lexeme[0] == '\0') {
-        return;
-    }
-    
-    switch(currentToken.token) {
-        case IDENT: // V = E;
-            V();
-            if (hasError) return;
-            match(ASSIGN_OP);
-            if (hasError) return;
-            E();
-            if (hasError) return;
-            match(SEMICOLON);
-            if (currentToken.lexeme[0] != '\0' && !hasError) {
-                S();
-            }
-            break;
-            
-        case KEY_IN: // input(V);
-            match(KEY_IN);
-            if (hasError) return;
-            match(OPEN_PAREN);
-            if (hasError) return;
-            V();
-            if (hasError) return;
-            match(CLOSE_PAREN);
-            if (hasError) return;
-            match(SEMICOLON);
-            if (currentToken.lexeme[0] != '\0' && !hasError) {
-                S();
-            }
-            break;
-            
-        case KEY_OUT: // output(E);
-            match(KEY_OUT);
-            if (hasError) return;
-            match(OPEN_PAREN);
-            if (hasError) return;
-            E();
-            if (hasError) return;
-            match(CLOSE_PAREN);
-            if (hasError) return;
-            match(SEMICOLON);
-            if (currentToken.lexeme[0] != '\0' && !hasError) {
-                S();
-            }
-            break;
-            
-        case KEY_IF: // if ( C ) { S } else { S }
-            match(KEY_IF);
-            if (hasError) return;
-            match(OPEN_PAREN);
-            if (hasError) return;
-            C();
-            if (hasError) return;
-            match(CLOSE_PAREN);
-            if (hasError) return;
-            match(OPEN_CURL);
-            if (hasError) return;
-            S();
-            if (hasError) return;
-            match(CLOSE_CURL);
-            
-            if (currentToken.token == KEY_ELSE) {
-                match(KEY_ELSE);
-                if (hasError) return;
+// S() function (statements are appended to seq when building a tree)
+void S(Seq* seq) {
+    // Loop over statements so long programs don't recurse once per statement
+    while (!hasError && currentToken.lexeme[0] != '\0') {
+        size_t stmtStart = seq ? seq->cursor : 0;
+        Stmt* node = NULL;
+        
+        switch(currentToken.token) {
+            case IDENT: // V = E;
+                if (seq) node = newStmt(STMT_ASSIGN);
+                V();
+                if (hasError) break;
+                match(ASSIGN_OP);
+                if (hasError) break;
+                E();
+                if (hasError) break;
+                match(SEMICOLON);
+                break;
+                
+            case KEY_IN: // input(V);
+                if (seq) node = newStmt(STMT_INPUT);
+                match(KEY_IN);
+                if (hasError) break;
+                match(OPEN_PAREN);
+                if (hasError) break;
+                V();
+                if (hasError) break;
+                match(CLOSE_PAREN);
+                if (hasError) break;
+                match(SEMICOLON);
+                break;
+                
+            case KEY_OUT: // output(E);
+                if (seq) node = newStmt(STMT_OUTPUT);
+                match(KEY_OUT);
+                if (hasError) break;
+                match(OPEN_PAREN);
+                if (hasError) break;
+                E();
+                if (hasError) break;
+                match(CLOSE_PAREN);
+                if (hasError) break;
+                match(SEMICOLON);
+                break;
+                
+            case KEY_IF: // if ( C ) { S } else { S }
+                if (seq) node = newStmt(STMT_IF);
+                match(KEY_IF);
+                if (hasError) break;
+                match(OPEN_PAREN);
+                if (hasError) break;
+                C();
+                if (hasError) break;
+                match(CLOSE_PAREN);
+                if (hasError) break;
                 match(OPEN_CURL);
-                if (hasError) return;
-                S();
-                if (hasError) return;
+                if (hasError) break;
+                if (node) {
+                    node->thenStart = lastTokenEnd - stmtStart;
+                    node->then = newSeq(lastTokenEnd, node, seq);
+                }
+                S(node ? node->then : NULL);
+                if (hasError) break;
+                if (node) node->then->trailing = currentToken.start - node->then->cursor;
                 match(CLOSE_CURL);
-            }
-            
-            if (currentToken.lexeme[0] != '\0' && !hasError) {
-                S();
-            }
-            break;
-            
-        case '\0': // Empty input
+                
+                if (currentToken.token == KEY_ELSE) {
+                    match(KEY_ELSE);
+                    if (hasError) break;
+                    match(OPEN_CURL);
+                    if (hasError) break;
+                    if (node) {
+                        node->elseStart = lastTokenEnd - stmtStart;
+                        node->otherwise = newSeq(lastTokenEnd, node, seq);
+                    }
+                    S(node ? node->otherwise : NULL);
+                    if (hasError) break;
+                    if (node) node->otherwise->trailing = currentToken.start - node->otherwise->cursor;
+                    match(CLOSE_CURL);
+                }
+                break;
+                
+            default: // Not a statement: the caller decides what follows
+                return;
+        }
+        
+        if (hasError) {
+            freeStmts(node);
             return;
+        }
+        if (node) appendStmt(seq, node);
     }
 }
 
@@ -450,30 +940,14 @@ void N() { // N ::= 0 | 1 | ... | 8 | 9 | 0N | 1N | ... | 8N | 9N ..............
     }
 }
 
-int main(int argc, char *argv[]) {
-    // Check command line arguments
-    if (argc != 2) {
-        printf("Usage: %s <source_file>\n", argv[0]);
-        return 2;
-    }
-    
-    // Try to open the source file
-    sourceFile = fopen(argv[1], "r");
-    if (!sourceFile) {
-        printf("Error: Could not open file %s\n", argv[1]);
-        return 3;
-    }
-    
-    // Print R# header
-    printf("Cooke Parser :: RX\n");
-    
-    // Initialize parsing
-    lineNumber = 1;
+// Parsing a whole program from sourceFile (P plus the trailing-content check)
+void parseProgram(Seq* program) {
     hasError = 0;
+    lastTokenEnd = 0;
     currentToken = getNextToken(sourceFile);
     
     // Start parsing from the root!
-    P();
+    P(program);
     
     // Only check for trailing content if no errors yet
     if (!hasError) {
@@ -488,9 +962,1284 @@ int main(int argc, char *argv[]) {
             nextToken = getNextToken(sourceFile);
         }
     }
+}
+
+// Syntax tree operations
+// Statements of one sequence live in an implicit treap keyed by source
+// position. Each node only knows its own length, so text inserted or removed
+// in front of a subtree shifts it without visiting it.
+
+// Drawing a treap priority (xorshift, deterministic between runs)
+unsigned nextPriority() {
+    static unsigned state = 2463534242u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Subtree byte length
+size_t treeTotal(const Stmt* t) {
+    return t ? t->total : 0;
+}
+
+// Subtree error statement count
+size_t treeErrors(const Stmt* t) {
+    return t ? t->errors : 0;
+}
+
+// Byte length of a whole sequence
+size_t seqTotal(const Seq* seq) {
+    return treeTotal(seq->root) + seq->trailing;
+}
+
+// Recomputing a node's aggregates and re-linking its children
+void updateStmt(Stmt* t) {
+    t->total = treeTotal(t->left) + t->length + treeTotal(t->right);
+    t->errors = treeErrors(t->left) + (t->kind == STMT_ERROR) + treeErrors(t->right);
+    if (t->left) t->left->up = t;
+    if (t->right) t->right->up = t;
+}
+
+// Allocating a statement node
+Stmt* newStmt(StmtKind kind) {
+    Stmt* node = calloc(1, sizeof(Stmt));
+    if (!node) {
+        printf("Error: Out of memory\n");
+        exit(4);
+    }
+    node->kind = kind;
+    node->priority = nextPriority();
+    return node;
+}
+
+// Allocating an empty sequence starting at absolute offset cursor
+Seq* newSeq(size_t cursor, Stmt* owner, Seq* parent) {
+    Seq* seq = calloc(1, sizeof(Seq));
+    if (!seq) {
+        printf("Error: Out of memory\n");
+        exit(4);
+    }
+    seq->cursor = cursor;
+    seq->owner = owner;
+    seq->parent = parent;
+    return seq;
+}
+
+// Releasing a treap and every block below it
+void freeStmts(Stmt* t) {
+    if (!t) return;
+    freeStmts(t->left);
+    freeStmts(t->right);
+    freeSeq(t->then);
+    freeSeq(t->otherwise);
+    free(t->error);
+    free(t);
+}
+
+// Releasing a sequence
+void freeSeq(Seq* seq) {
+    if (!seq) return;
+    freeStmts(seq->root);
+    free(seq);
+}
+
+// Concatenating two treaps (every statement of a precedes every one of b)
+Stmt* mergeStmts(Stmt* a, Stmt* b) {
+    if (!a) return b;
+    if (!b) return a;
+    if (a->priority > b->priority) {
+        a->right = mergeStmts(a->right, b);
+        updateStmt(a);
+        return a;
+    }
+    b->left = mergeStmts(a, b->left);
+    updateStmt(b);
+    return b;
+}
+
+// Splitting a treap at the statement boundary k bytes from its start
+void splitStmts(Stmt* t, size_t k, Stmt** left, Stmt** right) {
+    if (!t) {
+        *left = *right = NULL;
+        return;
+    }
+    size_t through = treeTotal(t->left) + t->length;
+    if (k >= through) {
+        splitStmts(t->right, k - through, &t->right, right);
+        updateStmt(t);
+        *left = t;
+    } else {
+        splitStmts(t->left, k, left, &t->left);
+        updateStmt(t);
+        *right = t;
+    }
+}
+
+// Appending a just-parsed statement (it ends at lastTokenEnd)
+void appendStmt(Seq* seq, Stmt* node) {
+    node->length = lastTokenEnd - seq->cursor;
+    seq->cursor = lastTokenEnd;
+    updateStmt(node);
+    seq->root = mergeStmts(seq->root, node);
+    seq->root->up = NULL;
+}
+
+// Growing the first statement of a treap by n bytes of leading whitespace
+void growFirst(Stmt* t, size_t n) {
+    while (t) {
+        t->total += n;
+        if (!t->left) {
+            t->length += n;
+            return;
+        }
+        t = t->left;
+    }
+}
+
+// Finding the statement whose span holds relative offset p (NULL past the last)
+Stmt* findStmt(Stmt* t, size_t p, size_t* stmtStart) {
+    size_t offset = 0;
+    while (t) {
+        size_t leftTotal = treeTotal(t->left);
+        if (p < offset + leftTotal) {
+            t = t->left;
+        } else if (p < offset + leftTotal + t->length) {
+            *stmtStart = offset + leftTotal;
+            return t;
+        } else {
+            offset += leftTotal + t->length;
+            t = t->right;
+        }
+    }
+    return NULL;
+}
+
+// Re-parenting the blocks of spliced statements to their new sequence
+void adoptStmts(Stmt* t, Seq* seq) {
+    if (!t) return;
+    adoptStmts(t->left, seq);
+    adoptStmts(t->right, seq);
+    if (t->then) t->then->parent = seq;
+    if (t->otherwise) t->otherwise->parent = seq;
+}
+
+// Carrying a length change up through every enclosing if-statement
+void shiftOwners(Seq* seq, ptrdiff_t delta) {
+    while (seq->owner) {
+        Stmt* owner = seq->owner;
+        Stmt* t;
+        owner->length += delta;
+        if (seq == owner->then) owner->elseStart += delta;
+        for (t = owner; t; t = t->up) {
+            t->total += delta;
+        }
+        seq = seq->parent;
+    }
+}
+
+// Incremental parsing
+// Scratch stream for parsing text that is already in memory
+InputStream memorySource;
+
+// Parsing text[0, length) into a statement tree (NULL if it does not validate)
+Seq* buildProgram(const char* text, size_t length) {
+    openMemoryInput(&memorySource, text, 0, length);
+    sourceFile = &memorySource;
+    Seq* program = newSeq(0, NULL, NULL);
+    parseProgram(program);
+    if (hasError) {
+        freeSeq(program);
+        return NULL;
+    }
+    program->trailing = length - program->cursor;
+    return program;
+}
+
+// Parsing text[start, end) as a statement list that must reach the end cleanly
+Seq* parseRegion(const char* text, size_t start, size_t end) {
+    openMemoryInput(&memorySource, text, start, end);
+    sourceFile = &memorySource;
+    hasError = 0;
+    lastTokenEnd = start;
+    currentToken = getNextToken(sourceFile);
+    Seq* seq = newSeq(start, NULL, NULL);
+    S(seq);
+    if (hasError || currentToken.lexeme[0] != '\0') {
+        freeSeq(seq);
+        return NULL;
+    }
+    seq->trailing = end - seq->cursor;
+    return seq;
+}
+
+// Throwing the tree away and parsing the whole text again
+void fullReparse(ParseTree* tree) {
+    freeSeq(tree->program);
+    tree->fullParses++;
+    tree->program = buildProgram(tree->text, tree->length);
+    if (!tree->program) {
+        tree->errorToken = errorToken;
+    }
+}
+
+// Creating a tree for a whole source text
+ParseTree* parseTree(const char* text, size_t length) {
+    ParseTree* tree = calloc(1, sizeof(ParseTree));
+    if (!tree) {
+        printf("Error: Out of memory\n");
+        exit(4);
+    }
+    tree->text = text;
+    tree->length = length;
+    fullReparse(tree);
+    return tree;
+}
+
+// Releasing a tree
+void freeTree(ParseTree* tree) {
+    freeSeq(tree->program);
+    free(tree);
+}
+
+// Replacing the statements in [rs, re) of seq with a freshly parsed list
+void spliceRegion(Seq* seq, size_t rs, size_t re, Seq* fresh) {
+    Stmt *left, *mid, *right;
+    int withTrailing = re > treeTotal(seq->root);
+    splitStmts(seq->root, rs, &left, &mid);
+    splitStmts(mid, re - rs, &mid, &right);
+    freeStmts(mid);
+    adoptStmts(fresh->root, seq);
+    
+    // Whitespace left after the new statements leads into whatever follows
+    if (right) {
+        growFirst(right, fresh->trailing);
+    } else if (withTrailing) {
+        seq->trailing = fresh->trailing;
+    } else {
+        seq->trailing += fresh->trailing;
+    }
+    seq->root = mergeStmts(mergeStmts(left, fresh->root), right);
+    if (seq->root) seq->root->up = NULL;
+    free(fresh);
+}
+
+// Reparsing statements [rs, re) of seq (relative, old text) after a delta-byte edit
+int reparseRegion(ParseTree* tree, Seq* seq, size_t seqStart, size_t rs, size_t re, ptrdiff_t delta) {
+    size_t start = seqStart + rs;
+    size_t end = seqStart + re + delta;
+    int widened = 0;
+    Seq* fresh;
+    
+    while ((fresh = parseRegion(tree->text, start, end)) == NULL) {
+        tree->regionParses++;
+        
+        // Inside a block, let the caller retry with the enclosing if-statement
+        if (seq->owner) return 0;
+        
+        // At the top level an error found before the lexer reached the region
+        // end is the same error a full parse reports, so keep it in place
+        if (hasError && (errorToken.end < end || end == tree->length)) {
+            Stmt* node = newStmt(STMT_ERROR);
+            node->error = malloc(sizeof(Token));
+            if (!node->error) {
+                printf("Error: Out of memory\n");
+                exit(4);
+            }
+            *node->error = errorToken;
+            node->error->start -= start;
+            node->error->end -= start;
+            node->length = end - start;
+            updateStmt(node);
+            fresh = newSeq(end, NULL, NULL);
+            fresh->root = node;
+            break;
+        }
+        
+        // Otherwise the outcome depends on what follows: take in the next statement
+        size_t nextStart = 0;
+        Stmt* next = findStmt(seq->root, re, &nextStart);
+        if (widened++ == MAX_REGION_WIDENING) return 0;
+        if (next) {
+            re = nextStart + next->length;
+        } else if (re < seqTotal(seq)) {
+            re = seqTotal(seq);
+        } else {
+            return 0;
+        }
+        end = seqStart + re + delta;
+    }
+    tree->regionParses++;
+    spliceRegion(seq, rs, re, fresh);
+    shiftOwners(seq, delta);
+    return 1;
+}
+
+// Mapping an edit [a, b) (old text) to the smallest enclosing statements or block
+int reparseIn(ParseTree* tree, Seq* seq, size_t seqStart, size_t a, size_t b, ptrdiff_t delta) {
+    size_t total = treeTotal(seq->root);
+    size_t ra = a - seqStart;
+    size_t rb = b - seqStart;
+    size_t firstStart = 0;
+    size_t lastStart = 0;
+    Stmt* first = findStmt(seq->root, ra, &firstStart);
+    Stmt* last = first;
+    lastStart = firstStart;
+    if (rb > ra + 1) last = findStmt(seq->root, rb - 1, &lastStart);
+    size_t rs = first ? firstStart : total;
+    size_t re = (last && rb <= total) ? lastStart + last->length : total + seq->trailing;
+    
+    // An edit inside one block of a single if-statement only touches that block
+    if (first && first == last && first->kind == STMT_IF) {
+        size_t ifStart = seqStart + firstStart;
+        Seq* blocks[2] = { first->then, first->otherwise };
+        size_t starts[2] = { first->thenStart, first->elseStart };
+        int i;
+        for (i = 0; i < 2; i++) {
+            if (!blocks[i]) continue;
+            size_t inner = ifStart + starts[i];
+            if (a >= inner && b <= inner + seqTotal(blocks[i])) {
+                if (reparseIn(tree, blocks[i], inner, a, b, delta)) return 1;
+                break;
+            }
+        }
+    }
+    return reparseRegion(tree, seq, seqStart, rs, re, delta);
+}
+
+// Applying an edit: old text [start, oldEnd) became text [start, newEnd)
+void applyEdit(ParseTree* tree, const char* text, size_t length, size_t start, size_t oldEnd, size_t newEnd) {
+    tree->text = text;
+    tree->length = length;
+    if (!tree->program ||
+        !reparseIn(tree, tree->program, 0, start, oldEnd, (ptrdiff_t)newEnd - (ptrdiff_t)oldEnd)) {
+        fullReparse(tree);
+    }
+}
+
+// Getting the first syntax error of a tree (returns 0 when the text validates)
+int treeError(const ParseTree* tree, Token* token) {
+    if (!tree->program) {
+        *token = tree->errorToken;
+        return 1;
+    }
+    if (!treeErrors(tree->program->root)) return 0;
+    const Stmt* t = tree->program->root;
+    size_t offset = 0;
+    while (t) {
+        if (treeErrors(t->left)) {
+            t = t->left;
+        } else if (t->kind == STMT_ERROR) {
+            break;
+        } else {
+            offset += treeTotal(t->left) + t->length;
+            t = t->right;
+        }
+    }
+    size_t stmtStart = offset + treeTotal(t->left);
+    *token = *t->error;
+    token->start += stmtStart;
+    token->end += stmtStart;
+    return 1;
+}
+
+// Edit benchmark
+// Reading a monotonic clock in nanoseconds
+long long nowNanos() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Sorting helper for latency percentiles
+int compareLongLong(const void* a, const void* b) {
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+// Writing a synthetic program of about size bytes into text
+size_t generateProgram(char* text, size_t size) {
+    static const char* pieces[] = {
+        "x = x + 1;\n",
+        "output((a + b) % 7);\n",
+        "input(y);\n",
+        "if (x > 10 && y != 3) {\n    output(x * 2);\n    y = y - x;\n} else {\n    z = (z + 4) / 2;\n}\n",
+        "if (!a <= b || c == 2) {\n    if (c == 1) {\n        c = 0;\n    }\n    output(c);\n}\n",
+    };
+    size_t length = 0;
+    unsigned i = 0;
+    while (length < size) {
+        const char* piece = pieces[(i * 7 + i / 3) % 5];
+        size_t n = strlen(piece);
+        memcpy(text + length, piece, n);
+        length += n;
+        i++;
+    }
+    return length;
+}
+
+// Replacing text[start, oldEnd) with replacement in a buffer of length bytes
+size_t editText(char* text, size_t length, size_t start, size_t oldEnd, const char* replacement) {
+    size_t n = strlen(replacement);
+    memmove(text + start + n, text + oldEnd, length - oldEnd);
+    memcpy(text + start, replacement, n);
+    return length - (oldEnd - start) + n;
+}
+
+// Checking an incremental result against a from-scratch parse
+int matchesFullParse(const ParseTree* tree) {
+    ParseTree* fresh = parseTree(tree->text, tree->length);
+    Token a, b;
+    int errA = treeError(tree, &a);
+    int errB = treeError(fresh, &b);
+    int same = errA == errB &&
+               (!errA || (a.start == b.start && a.token == b.token && strcmp(a.lexeme, b.lexeme) == 0));
+    freeTree(fresh);
+    return same;
+}
+
+// Timing single-character-scale edits on programs from 1 KB up to maxBytes
+int runEditBenchmark(size_t maxBytes) {
+    static const size_t sizes[] = { 1 << 10, 64 << 10, 1 << 20, 16 << 20, 50 << 20 };
+    const int edits = 2000;
+    long long* samples = calloc(edits, sizeof(long long));
+    int failures = 0;
+    size_t s;
+    
+    printf("Cooke Parser :: incremental edit benchmark\n");
+    printf("%12s %12s %12s %12s %12s %12s %10s\n", "bytes", "lines (ms)", "full (ms)", "edit mean", "edit p50", "edit p99", "fallbacks");
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && sizes[s] <= maxBytes; s++) {
+        char* text = malloc(sizes[s] + 65536);
+        size_t length = generateProgram(text, sizes[s]);
+        size_t startLength = length;
+        unsigned rng = 12345;
+        LineIndex index = {0};
+        long long started = nowNanos();
+        indexText(&index, text, length);
+        long long indexNanos = nowNanos() - started;
+        freeLineIndex(&index);
+        started = nowNanos();
+        ParseTree* tree = parseTree(text, length);
+        long long fullNanos = nowNanos() - started;
+        long fullBefore = tree->fullParses;
+        int i;
+        
+        for (i = 0; i < edits; i++) {
+            rng = rng * 1103515245u + 12345u;
+            size_t at = (rng >> 4) % length;
+            size_t oldEnd;
+            const char* replacement;
+            
+            // Rotating between literal rewrites, statement inserts and broken-then-fixed lines
+            if (i % 4 == 3) {
+                while (at < length && text[at] != ';') at++;
+                at = (at == length) ? 0 : at + 1;
+                oldEnd = at;
+                replacement = " w = w + 1;";
+            } else if (i % 4 == 2) {
+                while (at < length && text[at] != ';') at++;
+                if (at == length) continue;
+                oldEnd = at + 1;
+                replacement = "";
+            } else {
+                while (at < length && !isdigit((unsigned char)text[at])) at++;
+                if (at == length) continue;
+                oldEnd = at + 1;
+                replacement = (i & 1) ? "42" : "7";
+            }
+            size_t newLength = editText(text, length, at, oldEnd, replacement);
+            started = nowNanos();
+            applyEdit(tree, text, newLength, at, oldEnd, at + strlen(replacement));
+            samples[i] = nowNanos() - started;
+            length = newLength;
+            
+            // Putting removed semicolons back so the program keeps validating
+            if (i % 4 == 2) {
+                length = editText(text, length, at, at, ";");
+                applyEdit(tree, text, length, at, at, at + 1);
+            }
+            if (sizes[s] <= (64 << 10) && !matchesFullParse(tree)) failures++;
+        }
+        if (!matchesFullParse(tree)) failures++;
+        
+        long long sum = 0;
+        int counted = 0;
+        for (i = 0; i < edits; i++) {
+            if (samples[i] > 0) {
+                samples[counted++] = samples[i];
+                sum += samples[i];
+            }
+        }
+        qsort(samples, counted, sizeof(long long), compareLongLong);
+        printf("%12zu %12.2f %12.2f %10.2fus %10.2fus %10.2fus %10ld\n", startLength, indexNanos / 1e6, fullNanos / 1e6,
+               counted ? sum / 1e3 / counted : 0.0, counted ? samples[counted / 2] / 1e3 : 0.0,
+               counted ? samples[counted * 99 / 100] / 1e3 : 0.0, tree->fullParses - fullBefore);
+        for (i = 0; i < edits; i++) samples[i] = 0;
+        freeTree(tree);
+        free(text);
+    }
+    free(samples);
+    if (failures) {
+        printf("Error: %d incremental results differed from a full parse\n", failures);
+        return 1;
+    }
+    return 0;
+}
+
+// Interpreter
+// Source of the running program (for runtime error lines and the profile listing)
+LineIndex programLines;
+const ExecStmt* runningStmt = NULL;
+
+RuntimeIO runtimeIO;
+void flushOutput();
+
+#if COOKE_PROFILE
+// Profile still owed if the program stops on a runtime error
+typedef struct {
+    const char* prefix;
+    const Program* program;
+    const char* text;
+    size_t length;
+} PendingProfile;
+PendingProfile pendingProfile;
+int writeProfile(const char* prefix, const Program* program, const char* text, size_t length);
+#endif
+
+// Stopping the program on a runtime error
+void runtimeError(const char* message) {
+    uint64_t line = 0, column = 0;
+    if (runningStmt) lineColumn(&programLines, runningStmt->offset, &line, &column);
+    flushOutput();
+    fprintf(stderr, "Error: %s on line %" PRIu64 "\n", message, line);
+#if COOKE_PROFILE
+    // Keeping the profile of the run up to the error
+    if (pendingProfile.prefix) {
+        writeProfile(pendingProfile.prefix, pendingProfile.program, pendingProfile.text, pendingProfile.length);
+    }
+#endif
+    exit(5);
+}
+
+// Hashing a variable name
+unsigned hashName(const char* name) {
+    unsigned h = 2166136261u;
+    while (*name) {
+        h = (h ^ (unsigned char)*name++) * 16777619u;
+    }
+    return h;
+}
+
+// Finding (or adding) the slot of a variable
+int variableSlot(Program* program, const char* name) {
+    unsigned mask = program->tableSize - 1;
+    unsigned i = hashName(name) & mask;
+    while (program->table[i]) {
+        int slot = program->table[i] - 1;
+        if (strcmp(program->names[slot], name) == 0) return slot;
+        i = (i + 1) & mask;
+    }
+    
+    // Growing the variable arrays, then the table once it is half full
+    if (program->variables == program->capacity) {
+        program->capacity = program->capacity ? program->capacity * 2 : 64;
+        program->names = realloc(program->names, program->capacity * sizeof(*program->names));
+        program->values = realloc(program->values, program->capacity * sizeof(long long));
+        if (!program->names || !program->values) {
+            printf("Error: Out of memory\n");
+            exit(4);
+        }
+    }
+    int slot = program->variables++;
+    strcpy(program->names[slot], name);
+    program->values[slot] = 0;
+    program->table[i] = slot + 1;
+    if (program->variables * 2 > program->tableSize) {
+        int* old = program->table;
+        int oldSize = program->tableSize;
+        int j;
+        program->tableSize *= 2;
+        program->table = calloc(program->tableSize, sizeof(int));
+        if (!program->table) {
+            printf("Error: Out of memory\n");
+            exit(4);
+        }
+        for (j = 0; j < oldSize; j++) {
+            if (!old[j]) continue;
+            unsigned k = hashName(program->names[old[j] - 1]) & (program->tableSize - 1);
+            while (program->table[k]) k = (k + 1) & (program->tableSize - 1);
+            program->table[k] = old[j];
+        }
+        free(old);
+    }
+    return slot;
+}
+
+// Allocating an expression node
+Expr* newExpr(ExprKind kind, Expr* left, Expr* right) {
+    Expr* e = calloc(1, sizeof(Expr));
+    if (!e) {
+        printf("Error: Out of memory\n");
+        exit(4);
+    }
+    e->kind = kind;
+    e->left = left;
+    e->right = right;
+    return e;
+}
+
+// Compiling functions (the source already validated, so they follow the grammar blindly)
+Expr* compileE(Program* program);
+
+// F ::= (E) | N | V
+Expr* compileF(Program* program) {
+    Expr* e;
+    if (currentToken.token == OPEN_PAREN) {
+        match(OPEN_PAREN);
+        e = compileE(program);
+        match(CLOSE_PAREN);
+    } else if (currentToken.token == INT_LIT) {
+        e = newExpr(EXPR_NUM, NULL, NULL);
+        e->value = strtoll(currentToken.lexeme, NULL, 10);
+        match(INT_LIT);
+    } else {
+        e = newExpr(EXPR_VAR, NULL, NULL);
+        e->slot = variableSlot(program, currentToken.lexeme);
+        match(IDENT);
+    }
+    return e;
+}
+
+// T ::= F | T * F | T / F | T % F
+Expr* compileT(Program* program) {
+    Expr* e = compileF(program);
+    while (currentToken.token == MULT_OP || currentToken.token == DIV_OP || currentToken.token == MOD_OP) {
+        ExprKind kind = (currentToken.token == MULT_OP) ? EXPR_MUL :
+                        (currentToken.token == DIV_OP) ? EXPR_DIV : EXPR_MOD;
+        match(currentToken.token);
+        e = newExpr(kind, e, compileF(program));
+    }
+    return e;
+}
+
+// E ::= T | E + T | E - T
+Expr* compileE(Program* program) {
+    Expr* e = compileT(program);
+    while (currentToken.token == ADD_OP || currentToken.token == SUB_OP) {
+        ExprKind kind = (currentToken.token == ADD_OP) ? EXPR_ADD : EXPR_SUB;
+        match(currentToken.token);
+        e = newExpr(kind, e, compileT(program));
+    }
+    return e;
+}
+
+// C ::= !C | E [relop E] [&& C | || C]
+Expr* compileC(Program* program) {
+    if (currentToken.token == BOOL_NOT) {
+        match(BOOL_NOT);
+        return newExpr(EXPR_NOT, compileC(program), NULL);
+    }
+    Expr* e = compileE(program);
+    ExprKind kind;
+    switch (currentToken.token) {
+        case LESSER_OP: kind = EXPR_LT; break;
+        case GREATER_OP: kind = EXPR_GT; break;
+        case EQUAL_OP: kind = EXPR_EQ; break;
+        case NEQUAL_OP: kind = EXPR_NE; break;
+        case LEQUAL_OP: kind = EXPR_LE; break;
+        case GEQUAL_OP: kind = EXPR_GE; break;
+        default: kind = EXPR_NUM; break;
+    }
+    if (kind != EXPR_NUM) {
+        match(currentToken.token);
+        e = newExpr(kind, e, compileE(program));
+    }
+    if (currentToken.token == BOOL_AND || currentToken.token == BOOL_OR) {
+        kind = (currentToken.token == BOOL_AND) ? EXPR_AND : EXPR_OR;
+        match(currentToken.token);
+        e = newExpr(kind, e, compileC(program));
+    }
+    return e;
+}
+
+// S ::= statements up to the end of the block
+ExecStmt* compileS(Program* program) {
+    ExecStmt* head = NULL;
+    ExecStmt** tail = &head;
+    for (;;) {
+        ExecStmt* s;
+        TokenType first = currentToken.token;
+        if (currentToken.lexeme[0] == '\0' ||
+            (first != IDENT && first != KEY_IN && first != KEY_OUT && first != KEY_IF)) {
+            return head;
+        }
+        s = calloc(1, sizeof(ExecStmt));
+        if (!s) {
+            printf("Error: Out of memory\n");
+            exit(4);
+        }
+        s->offset = currentToken.start;
+        switch (first) {
+            case IDENT: // V = E;
+                s->kind = STMT_ASSIGN;
+                s->slot = variableSlot(program, currentToken.lexeme);
+                match(IDENT);
+                match(ASSIGN_OP);
+                s->expr = compileE(program);
+                match(SEMICOLON);
+                break;
+            case KEY_IN: // input(V);
+                s->kind = STMT_INPUT;
+                match(KEY_IN);
+                match(OPEN_PAREN);
+                s->slot = variableSlot(program, currentToken.lexeme);
+                match(IDENT);
+                match(CLOSE_PAREN);
+                match(SEMICOLON);
+                break;
+            case KEY_OUT: // output(E);
+                s->kind = STMT_OUTPUT;
+                match(KEY_OUT);
+                match(OPEN_PAREN);
+                s->expr = compileE(program);
+                match(CLOSE_PAREN);
+                match(SEMICOLON);
+                break;
+            default: // if ( C ) { S } else { S }
+                s->kind = STMT_IF;
+                match(KEY_IF);
+                match(OPEN_PAREN);
+                s->expr = compileC(program);
+                match(CLOSE_PAREN);
+                match(OPEN_CURL);
+                s->then = compileS(program);
+                match(CLOSE_CURL);
+                if (currentToken.token == KEY_ELSE) {
+                    match(KEY_ELSE);
+                    match(OPEN_CURL);
+                    s->otherwise = compileS(program);
+                    match(CLOSE_CURL);
+                }
+                break;
+        }
+        *tail = s;
+        tail = &s->next;
+    }
+}
+
+// Releasing compiled code
+void freeExpr(Expr* e) {
+    if (!e) return;
+    freeExpr(e->left);
+    freeExpr(e->right);
+    free(e);
+}
+
+void freeExec(ExecStmt* s) {
+    while (s) {
+        ExecStmt* next = s->next;
+        freeExpr(s->expr);
+        freeExec(s->then);
+        freeExec(s->otherwise);
+        free(s);
+        s = next;
+    }
+}
+
+// Evaluating an expression (conditions yield 0 or 1)
+long long evalExpr(const Program* program, const Expr* e) {
+    long long a, b;
+    switch (e->kind) {
+        case EXPR_NUM: return e->value;
+        case EXPR_VAR: return program->values[e->slot];
+        case EXPR_NOT: return !evalExpr(program, e->left);
+        case EXPR_AND: return evalExpr(program, e->left) && evalExpr(program, e->right);
+        case EXPR_OR: return evalExpr(program, e->left) || evalExpr(program, e->right);
+        default: break;
+    }
+    a = evalExpr(program, e->left);
+    b = evalExpr(program, e->right);
+    switch (e->kind) {
+        case EXPR_ADD:
+            if (__builtin_add_overflow(a, b, &a)) runtimeError("Integer overflow in addition");
+            return a;
+        case EXPR_SUB:
+            if (__builtin_sub_overflow(a, b, &a)) runtimeError("Integer overflow in subtraction");
+            return a;
+        case EXPR_MUL:
+            if (__builtin_mul_overflow(a, b, &a)) runtimeError("Integer overflow in multiplication");
+            return a;
+        case EXPR_DIV:
+        case EXPR_MOD:
+            if (b == 0) runtimeError("Division by zero");
+            if (b == -1 && a == LLONG_MIN) runtimeError("Integer overflow in division");
+            return (e->kind == EXPR_DIV) ? a / b : a % b;
+        case EXPR_LT: return a < b;
+        case EXPR_GT: return a > b;
+        case EXPR_EQ: return a == b;
+        case EXPR_NE: return a != b;
+        case EXPR_LE: return a <= b;
+        default: return a >= b;
+    }
+}
+
+// Runtime I/O
+// Writing the output block to stdout
+void flushOutput() {
+    size_t done = 0;
+    while (done < runtimeIO.outLen) {
+        ssize_t n = write(STDOUT_FILENO, runtimeIO.out + done, runtimeIO.outLen - done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            runtimeIO.outLen = 0;
+            runtimeError("output() could not write");
+        }
+        done += n;
+    }
+    runtimeIO.outLen = 0;
+}
+
+// Refilling the input block (pending output goes first unless in pipe mode, so prompts show)
+int fillInput() {
+    ssize_t n;
+    if (runtimeIO.inEof) return 0;
+    if (!runtimeIO.pipe) flushOutput();
+    do {
+        n = read(STDIN_FILENO, runtimeIO.in, IO_BLOCK_SIZE);
+    } while (n < 0 && errno == EINTR);
+    runtimeIO.inPos = 0;
+    runtimeIO.inLen = (n > 0) ? (size_t)n : 0;
+    if (n <= 0) runtimeIO.inEof = 1;
+    return n > 0;
+}
+
+// Parsing one decimal integer (leading whitespace and a sign allowed, like scanf)
+long long readInteger() {
+    unsigned long long value = 0;
+    int negative = 0;
+    int digits = 0;
+    int c;
+    for (;;) {
+        if (runtimeIO.inPos == runtimeIO.inLen && !fillInput()) runtimeError("input() found no integer");
+        c = runtimeIO.in[runtimeIO.inPos];
+        if (!isspace(c)) break;
+        runtimeIO.inPos++;
+    }
+    if (c == '-' || c == '+') {
+        negative = (c == '-');
+        runtimeIO.inPos++;
+    }
+    for (;;) {
+        if (runtimeIO.inPos == runtimeIO.inLen && !fillInput()) break;
+        c = runtimeIO.in[runtimeIO.inPos];
+        if (c < '0' || c > '9') break;
+        value = value * 10 + (c - '0');
+        runtimeIO.inPos++;
+        digits++;
+    }
+    if (!digits) runtimeError("input() found no integer");
+    return negative ? (long long)(0 - value) : (long long)value;
+}
+
+// Reading one little-endian int32 record
+long long readRecord() {
+    uint32_t value = 0;
+    int i;
+    for (i = 0; i < 4; i++) {
+        if (runtimeIO.inPos == runtimeIO.inLen && !fillInput()) {
+            runtimeError(i ? "input() found a partial record" : "input() found no record");
+        }
+        value |= (uint32_t)runtimeIO.in[runtimeIO.inPos++] << (8 * i);
+    }
+    return (int32_t)value;
+}
+
+// Formatting one integer and a newline (two digits per step)
+void writeInteger(long long value) {
+    static const char digitPairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+    char digits[24];
+    char* p = digits + sizeof(digits);
+    unsigned long long u = (value < 0) ? 0 - (unsigned long long)value : (unsigned long long)value;
+    if (runtimeIO.outLen + sizeof(digits) > IO_BLOCK_SIZE) flushOutput();
+    *--p = '\n';
+    while (u >= 100) {
+        p -= 2;
+        memcpy(p, digitPairs + (u % 100) * 2, 2);
+        u /= 100;
+    }
+    if (u >= 10) {
+        p -= 2;
+        memcpy(p, digitPairs + u * 2, 2);
+    } else {
+        *--p = (char)('0' + u);
+    }
+    if (value < 0) *--p = '-';
+    memcpy(runtimeIO.out + runtimeIO.outLen, p, digits + sizeof(digits) - p);
+    runtimeIO.outLen += digits + sizeof(digits) - p;
+}
+
+// Writing one little-endian int32 record (values are truncated to 32 bits)
+void writeRecord(long long value) {
+    uint32_t v = (uint32_t)value;
+    if (runtimeIO.outLen + 4 > IO_BLOCK_SIZE) flushOutput();
+    runtimeIO.out[runtimeIO.outLen++] = (char)(v & 0xFF);
+    runtimeIO.out[runtimeIO.outLen++] = (char)((v >> 8) & 0xFF);
+    runtimeIO.out[runtimeIO.outLen++] = (char)((v >> 16) & 0xFF);
+    runtimeIO.out[runtimeIO.outLen++] = (char)(v >> 24);
+}
+
+#if COOKE_PROFILE
+// Profiler state (counting is a branch on profiling; cycles are sampled)
+int profiling = 0;
+int profileCycles = 0;
+uint64_t profileTick = 0;
+
+// Reading the cycle counter (a monotonic clock where there is no rdtsc)
+#if defined(__x86_64__) || defined(__i386__)
+#define CYCLE_UNIT "cycles"
+uint64_t readCycles() {
+    return __rdtsc();
+}
+#else
+#define CYCLE_UNIT "ns"
+uint64_t readCycles() {
+    return (uint64_t)nowNanos();
+}
+#endif
+#endif
+
+// Running a block (an if is charged only for its condition; the branch taken charges itself)
+void execStmts(Program* program, ExecStmt* s) {
+    for (; s; s = s->next) {
+#if COOKE_PROFILE
+        uint64_t started = 0;
+        int sampled = 0;
+        if (profiling) {
+            s->count++;
+            if (profileCycles && (++profileTick & (PROFILE_SAMPLE_PERIOD - 1)) == 0) {
+                sampled = 1;
+                started = readCycles();
+            }
+        }
+#endif
+        runningStmt = s;
+        switch (s->kind) {
+            case STMT_ASSIGN:
+                program->values[s->slot] = evalExpr(program, s->expr);
+                break;
+            case STMT_INPUT:
+                program->values[s->slot] = runtimeIO.binary ? readRecord() : readInteger();
+                break;
+            case STMT_OUTPUT:
+                if (runtimeIO.binary) {
+                    writeRecord(evalExpr(program, s->expr));
+                } else {
+                    writeInteger(evalExpr(program, s->expr));
+                }
+                break;
+            default: {
+                int taken = evalExpr(program, s->expr) != 0;
+#if COOKE_PROFILE
+                if (profiling) s->taken += taken;
+                if (sampled) {
+                    s->cycles += (readCycles() - started) * PROFILE_SAMPLE_PERIOD;
+                    sampled = 0;
+                }
+#endif
+                execStmts(program, taken ? s->then : s->otherwise);
+                break;
+            }
+        }
+#if COOKE_PROFILE
+        if (sampled) s->cycles += (readCycles() - started) * PROFILE_SAMPLE_PERIOD;
+#endif
+    }
+}
+
+#if COOKE_PROFILE
+// Naming a statement kind for profile frames
+const char* stmtKindName(StmtKind kind) {
+    switch (kind) {
+        case STMT_ASSIGN: return "assign";
+        case STMT_INPUT: return "input";
+        case STMT_OUTPUT: return "output";
+        case STMT_IF: return "if";
+        default: return "error";
+    }
+}
+
+// Writing folded stacks (frame;frame;frame value) for flame graph tools
+void writeFolded(FILE* out, const ExecStmt* s, char* stack, size_t depth, size_t size) {
+    for (; s; s = s->next) {
+        uint64_t line, column;
+        uint64_t value = profileCycles ? s->cycles : s->count;
+        lineColumn(&programLines, s->offset, &line, &column);
+        int n = snprintf(stack + depth, size - depth, ";%s@%" PRIu64, stmtKindName(s->kind), line);
+        if (n < 0 || depth + n + 8 >= size) continue;
+        if (value) fprintf(out, "%s %" PRIu64 "\n", stack, value);
+        if (s->kind == STMT_IF) {
+            strcpy(stack + depth + n, ":then");
+            writeFolded(out, s->then, stack, depth + n + 5, size);
+            strcpy(stack + depth + n, ":else");
+            writeFolded(out, s->otherwise, stack, depth + n + 5, size);
+        }
+        stack[depth] = '\0';
+    }
+}
+
+// Adding statement counters to their source lines
+void sumLines(const ExecStmt* s, uint64_t* execs, uint64_t* taken, uint64_t* branches, uint64_t* cycles) {
+    for (; s; s = s->next) {
+        uint64_t line, column;
+        lineColumn(&programLines, s->offset, &line, &column);
+        execs[line - 1] += s->count;
+        cycles[line - 1] += s->cycles;
+        if (s->kind == STMT_IF) {
+            taken[line - 1] += s->taken;
+            branches[line - 1] += s->count;
+            sumLines(s->then, execs, taken, branches, cycles);
+            sumLines(s->otherwise, execs, taken, branches, cycles);
+        }
+    }
+}
+
+// Writing the source with execution, branch and cycle columns
+void writeListing(FILE* out, const Program* program, const char* text, size_t length) {
+    size_t lines = programLines.lines + 1;
+    uint64_t* execs = calloc(lines, sizeof(uint64_t));
+    uint64_t* taken = calloc(lines, sizeof(uint64_t));
+    uint64_t* branches = calloc(lines, sizeof(uint64_t));
+    uint64_t* cycles = calloc(lines, sizeof(uint64_t));
+    size_t line = 0;
+    size_t at = 0;
+    if (!execs || !taken || !branches || !cycles) {
+        printf("Error: Out of memory\n");
+        exit(4);
+    }
+    sumLines(program->body, execs, taken, branches, cycles);
+    
+    fprintf(out, "%12s %23s %14s  %6s | source\n", "execs", "taken/not taken", profileCycles ? CYCLE_UNIT : "", "line");
+    while (at < length || line == 0) {
+        const char* end = memchr(text + at, '\n', length - at);
+        size_t n = end ? (size_t)(end - (text + at)) : length - at;
+        char count[24] = "", branch[48] = "", cost[24] = "";
+        if (execs[line]) snprintf(count, sizeof(count), "%" PRIu64, execs[line]);
+        if (branches[line]) {
+            snprintf(branch, sizeof(branch), "%" PRIu64 "/%" PRIu64, taken[line], branches[line] - taken[line]);
+        }
+        if (profileCycles && cycles[line]) snprintf(cost, sizeof(cost), "%" PRIu64, cycles[line]);
+        fprintf(out, "%12s %23s %14s  %6zu | %.*s\n", count, branch, cost, line + 1, (int)n, text + at);
+        at += n + 1;
+        line++;
+        if (!end) break;
+    }
+    free(execs);
+    free(taken);
+    free(branches);
+    free(cycles);
+}
+
+// Writing <prefix>.folded and <prefix>.txt
+int writeProfile(const char* prefix, const Program* program, const char* text, size_t length) {
+    size_t size = strlen(prefix) + 16;
+    char* path = malloc(size);
+    char stack[4096] = "program";
+    FILE* out;
+    snprintf(path, size, "%s.folded", prefix);
+    out = fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "Error: Could not write profile %s\n", path);
+        free(path);
+        return 0;
+    }
+    writeFolded(out, program->body, stack, strlen(stack), sizeof(stack));
+    fclose(out);
+    snprintf(path, size, "%s.txt", prefix);
+    out = fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "Error: Could not write profile %s\n", path);
+        free(path);
+        return 0;
+    }
+    writeListing(out, program, text, length);
+    fclose(out);
+    free(path);
+    return 1;
+}
+#endif
+
+// Reading a whole source into memory (any input openInput accepts)
+char* loadSource(InputStream* in, size_t* length) {
+    size_t capacity = INPUT_BLOCK_SIZE;
+    char* text = malloc(capacity);
+    size_t n = 0;
+    int c;
+    if (!text) {
+        printf("Error: Out of memory\n");
+        exit(4);
+    }
+    while ((c = readChar(in)) != EOF) {
+        if (n == capacity) {
+            capacity *= 2;
+            text = realloc(text, capacity);
+            if (!text) {
+                printf("Error: Out of memory\n");
+                exit(4);
+            }
+        }
+        text[n++] = (char)c;
+    }
+    *length = n;
+    return text;
+}
+
+// Running a program: cooke_parser --run [--profile prefix] [--cycles] [--binary] [--pipe] <source_file | ->
+int runMain(int argc, char* argv[]) {
+    const char* profilePrefix = NULL;
+    const char* path = NULL;
+    int cycles = 0;
+    int i;
+    for (i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profilePrefix = argv[++i];
+        } else if (strcmp(argv[i], "--cycles") == 0) {
+            cycles = 1;
+        } else if (strcmp(argv[i], "--binary") == 0) {
+            runtimeIO.binary = 1;
+        } else if (strcmp(argv[i], "--pipe") == 0) {
+            runtimeIO.pipe = 1;
+        } else if (!path) {
+            path = argv[i];
+        } else {
+            path = NULL;
+            break;
+        }
+    }
+    if (!path) {
+        printf("Usage: %s --run [--profile <prefix>] [--cycles] [--binary] [--pipe] <source_file | ->\n", argv[0]);
+        return 2;
+    }
+#if !COOKE_PROFILE
+    if (profilePrefix || cycles) {
+        printf("Error: profiling is not supported by this build (rebuild without PROFILE=0)\n");
+        return 2;
+    }
+#endif
+    
+    // Loading the source
+    InputStream* in = openInput(path);
+    if (!in) {
+        printf("Error: Could not open file %s\n", path);
+        return 3;
+    }
+    size_t length = 0;
+    char* text = in->error ? NULL : loadSource(in, &length);
+    if (in->error) {
+        printf("Error: Could not read file %s: %s\n", path, in->error);
+        closeInput(in);
+        free(text);
+        return 3;
+    }
+    closeInput(in);
+    indexText(&programLines, text, length);
+    
+    // Validating before anything runs
+    openMemoryInput(&memorySource, text, 0, length);
+    sourceFile = &memorySource;
+    parseProgram(NULL);
+    if (hasError) {
+        uint64_t line, column;
+        lineColumn(&programLines, errorToken.start, &line, &column);
+        printError(&errorToken, line, column);
+        free(text);
+        freeLineIndex(&programLines);
+        return 1;
+    }
+    
+    // Compiling and running
+    Program program = {0};
+    program.tableSize = 64;
+    program.table = calloc(program.tableSize, sizeof(int));
+    if (!program.table) {
+        printf("Error: Out of memory\n");
+        exit(4);
+    }
+    openMemoryInput(&memorySource, text, 0, length);
+    currentToken = getNextToken(sourceFile);
+    program.body = compileS(&program);
+#if COOKE_PROFILE
+    profiling = profilePrefix != NULL;
+    profileCycles = cycles;
+    pendingProfile = (PendingProfile){profilePrefix, &program, text, length};
+#endif
+    execStmts(&program, program.body);
+    flushOutput();
+    
+    int status = 0;
+#if COOKE_PROFILE
+    if (profilePrefix && !writeProfile(profilePrefix, &program, text, length)) status = 3;
+#endif
+    freeExec(program.body);
+    free(program.names);
+    free(program.values);
+    free(program.table);
+    freeLineIndex(&programLines);
+    free(text);
+    return status;
+}
+
+int main(int argc, char *argv[]) {
+    // Edit benchmark: cooke_parser --bench [max_megabytes]
+    if (argc >= 2 && strcmp(argv[1], "--bench") == 0) {
+        size_t maxMegabytes = (argc >= 3) ? strtoul(argv[2], NULL, 10) : 50;
+        return runEditBenchmark(maxMegabytes << 20);
+    }
+    
+    // Interpreter: cooke_parser --run [options] <source_file | ->
+    if (argc >= 2 && strcmp(argv[1], "--run") == 0) {
+        return runMain(argc, argv);
+    }
+    
+    // Check command line arguments
+    if (argc != 2) {
+        printf("Usage: %s <source_file | ->\n", argv[0]);
+        return 2;
+    }
+    
+    // Try to open the source file (plain, gzip or zstd; "-" reads stdin)
+    sourceFile = openInput(argv[1]);
+    if (!sourceFile) {
+        printf("Error: Could not open file %s\n", argv[1]);
+        return 3;
+    }
+    if (sourceFile->error) {
+        printf("Error: Could not read file %s: %s\n", argv[1], sourceFile->error);
+        closeInput(sourceFile);
+        return 3;
+    }
+    
+    // Print R# header
+    printf("Cooke Parser :: RX\n");
+    
+    // Validate without building a tree
+    parseProgram(NULL);
+    if (hasError) {
+        uint64_t line, column;
+        lineColumn(&sourceFile->lines, errorToken.start, &line, &column);
+        printError(&errorToken, line, column);
+    }
+    
+    // A decompression failure means the parse saw a cut-off program
+    if (sourceFile->error) {
+        printf("Error: Could not read file %s: %s\n", argv[1], sourceFile->error);
+        closeInput(sourceFile);
+        return 3;
+    }
     
     // Close file
-    fclose(sourceFile);
+    closeInput(sourceFile);
     
     // Print result and return exit code
     if (!hasError) {
@@ -0,0 +1,65 @@
+/*
+ * host.h
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host simulation header */
+#ifndef HOST_H_
+#define HOST_H_
+
+#include <stdint.h>                                                                         // Including integer-size C control
+#include <stddef.h>                                                                         // Including size_t and NULL
+#include <stdbool.h>                                                                        // Including boolean operations
+#include <time.h>                                                                           // Including timespec
+#include <pthread.h>                                                                        // Including POSIX threads
+
+/* Declaring host macro variables */
+#define HOST_SRAM_BASE 0x20000000UL                                                         // Defining simulated SRAM base (matches -memr range)
+#define HOST_SRAM_SIZE 0x40000UL                                                            // Defining simulated SRAM size (256 KB)
+#define HOST_FLASH_BASE 0x10000UL                                                           // Defining lowest mappable flash address on Linux
+#define HOST_FLASH_END 0x100000UL                                                           // Defining simulated flash end (1 MB)
+#define HOST_SPI_HISTORY 256                                                                // Defining DAC word history length
+#define HOST_EOF_GRACE_MS 250                                                               // Defining drain time after UART0 input ends
+
+/* Declaring host structures */
+    // UART endpoint statistics
+typedef struct {
+    uint64_t bytes_written;                                                                 // Declaring bytes written by the shell
+    uint64_t writes;                                                                        // Declaring UART_write calls
+    uint64_t bytes_read;                                                                    // Declaring bytes read by the shell
+} HostUartStats;                                                                            // Declaring struct name as HostUartStats
+    // DAC model statistics
+typedef struct {
+    uint64_t transfers;                                                                     // Declaring SPI_transfer calls
+    uint64_t frames;                                                                        // Declaring frames clocked into the DAC
+    uint16_t last_word;                                                                     // Declaring last DAC word
+    uint16_t history[HOST_SPI_HISTORY];                                                     // Declaring ring of recent DAC words
+    uint32_t history_position;                                                              // Declaring next ring slot
+} HostDacStats;                                                                             // Declaring struct name as HostDacStats
+
+/* Declaring host operations */
+    // CPU model (one core: every task and timer "ISR" runs holding the CPU lock)
+void hostCpuLock(void);                                                                     // Declaring CPU acquire
+void hostCpuUnlock(void);                                                                   // Declaring CPU release
+bool hostCpuHeld(void);                                                                     // Declaring CPU ownership check for this thread
+int hostCpuWait(pthread_cond_t *cond, const struct timespec *deadline);                     // Declaring condition wait with the CPU released (NULL deadline waits forever)
+void hostStart(void);                                                                       // Declaring scheduler start without blocking the caller
+uint64_t hostNowNs(void);                                                                   // Declaring monotonic time in nanoseconds
+    // UART endpoints (unattached UARTs are byte-counting sinks)
+void hostUartAttach(unsigned int index, int read_fd, int write_fd);                         // Declaring UART endpoint attach
+const char *hostUartOpenPty(unsigned int index);                                            // Declaring UART endpoint on a new pty (returns slave path)
+void hostUartStatsGet(unsigned int index, HostUartStats *stats);                            // Declaring UART statistics copy
+    // GPIO, timers, DAC
+void hostGpioPress(unsigned int index);                                                     // Declaring switch press (falling then rising edge)
+unsigned int hostGpioValue(unsigned int index);                                             // Declaring pin level peek
+void hostGpioTrace(bool enable);                                                            // Declaring output pin change trace on stderr
+uint64_t hostTimerOverruns(unsigned int index);                                             // Declaring skipped timer periods
+void hostDacStatsGet(HostDacStats *stats);                                                  // Declaring DAC statistics copy
+void hostDacCapture(uint16_t *buffer, size_t capacity);                                     // Declaring DAC word capture (NULL stops)
+size_t hostDacCaptured(void);                                                               // Declaring DAC words captured so far
+    // Memory map
+bool hostMapMemory(void);                                                                   // Declaring SRAM/flash mapping for -memr
+
+#endif /* HOST_H_ */
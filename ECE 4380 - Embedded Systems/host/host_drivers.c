@@ -0,0 +1,692 @@
+/*
+ * host_drivers.c
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Driver libraries */
+#define _GNU_SOURCE                                                                         // Enabling pty and mmap extensions
+#include <stdint.h>                                                                         // Including integer-size C control
+#include <stdio.h>                                                                          // Including fprintf() functions
+#include <stdlib.h>                                                                         // Including exit() functions
+#include <string.h>                                                                         // Including string handling functions
+#include <errno.h>                                                                          // Including error codes
+#include <fcntl.h>                                                                          // Including open() flags
+#include <time.h>                                                                           // Including clock_nanosleep() functions
+#include <unistd.h>                                                                         // Including read()/write() functions
+#include <termios.h>                                                                        // Including pty raw mode
+#include <sys/mman.h>                                                                       // Including mmap() functions
+#include <pthread.h>                                                                        // Including POSIX threads
+
+/* Driver-Header files */
+#include <ti/drivers/GPIO.h>                                                                // GPIO API header file controls
+#include <ti/drivers/UART.h>                                                                // UART API header file controls
+#include <ti/drivers/Timer.h>                                                               // Timer API header file controls
+#include <ti/drivers/SPI.h>                                                                 // SPI API header file controls
+#include <ti/drivers/Board.h>                                                               // Board API header file controls
+#include "ti_drivers_config.h"                                                              // Hardware mapping peripherals
+#include "host.h"                                                                           // Host simulation controls
+
+/* Declaring driver objects */
+struct UART_Config_ {
+    unsigned int index;                                                                     // Declaring UART index
+    bool open;                                                                              // Declaring open flag
+    bool is_pty;                                                                            // Declaring pty endpoint flag (reads retry instead of ending)
+    int read_fd;                                                                            // Declaring input descriptor (-1 blocks forever)
+    int write_fd;                                                                           // Declaring output descriptor (-1 counts and discards)
+    int pty_slave_fd;                                                                       // Declaring held pty slave (keeps master readable without a client)
+    char pty_path[64];                                                                      // Declaring pty slave path
+    UART_Params params;                                                                     // Declaring open parameters
+    HostUartStats stats;                                                                    // Declaring traffic counters
+    bool rx_started;                                                                        // Declaring receive "ISR" thread created flag
+    bool rx_pending;                                                                        // Declaring callback-mode read in progress
+    bool rx_eof;                                                                            // Declaring end of input reached
+    char *rx_buffer;                                                                        // Declaring callback-mode read buffer
+    size_t rx_size;                                                                         // Declaring callback-mode read size
+    uint64_t rx_line_ns;                                                                    // Declaring time the last received byte finished on the wire
+    pthread_t rx_thread;                                                                    // Declaring receive "ISR" thread
+    pthread_cond_t rx_wake;                                                                 // Declaring read request wake-up condition
+};
+struct Timer_Config_ {
+    unsigned int index;                                                                     // Declaring timer index
+    bool open;                                                                              // Declaring open flag
+    bool running;                                                                           // Declaring running flag
+    bool thread_started; // Declaring "ISR" thread created flag
+    Timer_Params params;                                                                    // Declaring open parameters
+    uint64_t period_ns;                                                                     // Declaring period in nanoseconds
+    uint64_t next_ns;                                                                       // Declaring next expiry
+    uint32_t generation;                                                                    // Declaring start/stop generation (stale expiries are dropped)
+    uint64_t overruns;                                                                      // Declaring skipped periods
+    pthread_t thread; // Declaring "ISR" thread
+    pthread_cond_t wake;                                                                    // Declaring start wake-up condition
+};
+struct SPI_Config_ {
+    bool open;                                                                              // Declaring open flag
+    SPI_Params params;                                                                      // Declaring open parameters
+};
+typedef struct {
+    GPIO_PinConfig config;                                                                  // Declaring pin configuration
+    unsigned int value;                                                                     // Declaring pin level
+    GPIO_CallbackFxn callback;                                                              // Declaring pin callback
+    bool int_enabled;                                                                       // Declaring interrupt enable
+} HostPin;                                                                                  // Declaring struct name as HostPin
+
+/* Global variables */
+#define HOST_UART_UNATTACHED(i) { (i), false, false, -1, -1, -1, "", { 0 }, { 0 } }
+static struct UART_Config_ host_uarts[CONFIG_UART_COUNT] = {
+    HOST_UART_UNATTACHED(CONFIG_UART_0), HOST_UART_UNATTACHED(CONFIG_UART_1)                // Declaring UARTs as sinks until attached
+};
+static struct Timer_Config_ host_timers[CONFIG_TIMER_COUNT];                                // Declaring timer array
+static bool host_timers_ready = false;                                                      // Declaring timer initialization flag
+static struct SPI_Config_ host_spis[CONFIG_SPI_COUNT];                                      // Declaring SPI array
+static HostDacStats host_dac;                                                               // Declaring DAC model
+static uint16_t *host_dac_capture;                                                          // Declaring DAC word capture buffer (NULL when off)
+static size_t host_dac_capacity;                                                            // Declaring capture buffer length
+static size_t host_dac_captured;                                                            // Declaring words captured
+static HostPin host_pins[CONFIG_GPIO_COUNT];                                                // Declaring GPIO array
+static bool host_gpio_trace = false;                                                        // Declaring pin trace flag
+static const char *host_pin_names[CONFIG_GPIO_COUNT] = {                                    // Declaring pin names for trace
+    "LED0", "LED1", "LED2", "LED3", "PK5", "PD4", "SW1", "SW2"
+};
+
+/* Board operations */
+    // Board initialization
+void Board_init(void) {
+}
+
+/* UART operations */
+    // UART endpoint attach
+void hostUartAttach(unsigned int index, int read_fd, int write_fd) {
+    if (index >= CONFIG_UART_COUNT) {                                                       // For invalid index
+        return;                                                                             // Return from function
+    }
+    host_uarts[index].read_fd = read_fd;                                                    // Declaring input descriptor
+    host_uarts[index].write_fd = write_fd;                                                  // Declaring output descriptor
+}
+    // UART endpoint on a new pty
+const char *hostUartOpenPty(unsigned int index) {
+    struct termios raw;                                                                     // Declaring slave line settings
+    if (index >= CONFIG_UART_COUNT) {                                                       // For invalid index
+        return NULL;                                                                        // Returning no path
+    }
+    int master = posix_openpt(O_RDWR | O_NOCTTY);                                           // Opening pty master
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {                      // For pty allocation failure
+        if (master >= 0) close(master);                                                     // Closing partial master
+        return NULL;                                                                        // Returning no path
+    }
+    struct UART_Config_ *uart = &host_uarts[index];                                         // Declaring UART endpoint
+    snprintf(uart->pty_path, sizeof(uart->pty_path), "%s", ptsname(master));                // Copying slave path
+    uart->pty_slave_fd = open(uart->pty_path, O_RDWR | O_NOCTTY);                           // Holding slave open
+    if (uart->pty_slave_fd >= 0 && tcgetattr(uart->pty_slave_fd, &raw) == 0) {              // For slave settings
+        cfmakeraw(&raw);                                                                    // Declaring raw line (no echo, no line editing)
+        tcsetattr(uart->pty_slave_fd, TCSANOW, &raw);                                       // Applying raw line
+    }
+    uart->read_fd = master;                                                                 // Declaring master as input
+    uart->write_fd = master;                                                                // Declaring master as output
+    uart->is_pty = true;                                                                    // Declaring pty endpoint
+    return uart->pty_path;                                                                  // Returning slave path
+}
+    // UART statistics copy
+void hostUartStatsGet(unsigned int index, HostUartStats *stats) {
+    bool held = hostCpuHeld();                                                              // Saving ownership
+    if (index >= CONFIG_UART_COUNT) {                                                       // For invalid index
+        memset(stats, 0, sizeof(*stats));                                                   // Clearing statistics
+        return;                                                                             // Return from function
+    }
+    if (!held) hostCpuLock();                                                               // Acquiring core for a consistent copy
+    *stats = host_uarts[index].stats;                                                       // Copying statistics
+    if (!held) hostCpuUnlock();                                                             // Restoring unlocked caller
+}
+    // UART driver initialization
+void UART_init(void) {
+}
+    // UART parameter defaults (TI defaults)
+void UART_Params_init(UART_Params *params) {
+    memset(params, 0, sizeof(*params));                                                     // Clearing parameters
+    params->readMode = UART_MODE_BLOCKING;                                                  // Declaring blocking reads
+    params->writeMode = UART_MODE_BLOCKING;                                                 // Declaring blocking writes
+    params->readTimeout = UART_WAIT_FOREVER;                                                // Declaring infinite read timeout
+    params->writeTimeout = UART_WAIT_FOREVER;                                               // Declaring infinite write timeout
+    params->readReturnMode = UART_RETURN_NEWLINE;                                           // Declaring newline read return
+    params->readDataMode = UART_DATA_TEXT;                                                  // Declaring text reads
+    params->writeDataMode = UART_DATA_TEXT;                                                 // Declaring text writes
+    params->readEcho = UART_ECHO_ON;                                                        // Declaring echoed reads
+    params->baudRate = 115200;                                                              // Declaring baud rate
+    params->dataLength = UART_LEN_8;                                                        // Declaring 8 data bits
+    params->stopBits = UART_STOP_ONE;                                                       // Declaring one stop bit
+    params->parityType = UART_PAR_NONE;                                                     // Declaring no parity
+}
+    // UART open
+UART_Handle UART_open(uint_least8_t index, UART_Params *params) {
+    if (index >= CONFIG_UART_COUNT || host_uarts[index].open) {                             // For invalid or already open UART
+        return NULL;                                                                        // Returning NULL handle as on target
+    }
+    struct UART_Config_ *uart = &host_uarts[index];                                         // Declaring UART endpoint
+    if (params == NULL) {                                                                   // For default parameters
+        UART_Params_init(&uart->params);                                                    // Initializing defaults
+    } else {                                                                                // For caller parameters
+        uart->params = *params;                                                             // Copying parameters
+    }
+    if (!uart->rx_started) {                                                                // For first open
+        pthread_cond_init(&uart->rx_wake, NULL);                                            // Initializing read request condition
+    }
+    uart->open = true;                                                                      // Declaring UART open
+    return uart;                                                                            // Returning UART handle
+}
+    // UART close
+void UART_close(UART_Handle handle) {
+    if (handle != NULL) {                                                                   // For valid handle
+        handle->open = false;                                                               // Declaring UART closed
+    }
+}
+    // Write all bytes to a descriptor
+static void uart_write_fd(int fd, const char *data, size_t size) {
+    while (size > 0) {                                                                      // While bytes remain
+        ssize_t written = write(fd, data, size);                                            // Writing bytes
+        if (written < 0) {                                                                  // For write failure
+            if (errno == EINTR) continue;                                                   // Retrying interrupted write
+            return;                                                                         // Dropping output on a closed endpoint
+        }
+        data += written;                                                                    // Advancing data pointer
+        size -= (size_t)written;                                                            // Decrementing remaining size
+    }
+}
+    // UART write
+int_fast32_t UART_write(UART_Handle handle, const void *buffer, size_t size) {
+    const char *data = buffer;                                                              // Declaring byte view of buffer
+    size_t i, start = 0;                                                                    // Declaring scan positions
+    if (handle == NULL || !handle->open) {                                                  // For invalid handle
+        return UART_ERROR;                                                                  // Returning error
+    }
+    handle->stats.writes++;                                                                 // Counting write call
+    handle->stats.bytes_written += size;                                                    // Counting written bytes
+    if (handle->write_fd < 0) {                                                             // For sink endpoint
+        return (int_fast32_t)size;                                                          // Returning bytes accepted
+    }
+    if (handle->params.writeDataMode == UART_DATA_TEXT) {                                   // For text mode (\n becomes \r\n)
+        for (i = 0; i < size; i++) {                                                        // Scanning for newlines
+            if (data[i] == '\n') {                                                          // For newline
+                uart_write_fd(handle->write_fd, data + start, i - start);                   // Writing text before newline
+                uart_write_fd(handle->write_fd, "\r\n", 2);                                 // Writing expanded newline
+                start = i + 1;                                                              // Advancing past newline
+            }
+        }
+    }
+    uart_write_fd(handle->write_fd, data + start, size - start);                            // Writing remaining bytes
+    return (int_fast32_t)size;                                                              // Returning bytes written
+}
+    // Sleep with the core released
+static void uart_idle_ms(unsigned int ms) {
+    struct timespec delay = { ms / 1000, (long)(ms % 1000) * 1000000L };                    // Declaring relative delay
+    bool held = hostCpuHeld();                                                              // Saving ownership
+    if (held) hostCpuUnlock();                                                              // Releasing core
+    nanosleep(&delay, NULL);                                                                // Sleeping
+    if (held) hostCpuLock();                                                                // Reacquiring core
+}
+    // UART end of input (terminal input ends the session once the shell asks for more)
+static void uart_end_of_input(UART_Handle handle) {
+    if (handle->index == CONFIG_UART_0) {                                                   // For end of terminal input
+        uart_idle_ms(HOST_EOF_GRACE_MS);                                                    // Letting scripts and tickers drain
+        exit(0);                                                                            // Ending session
+    }
+    handle->read_fd = -1;                                                                   // Blocking forever from now on
+}
+    // UART receive "ISR" thread (callback mode: bytes arrive at the configured baud rate)
+static void *uart_rx_entry(void *arg) {
+    UART_Handle uart = arg;                                                                 // Declaring UART from thread argument
+    char data[64];                                                                          // Declaring received bytes
+    hostCpuLock();                                                                          // Acquiring core
+    for (;;) {                                                                              // Servicing reads forever
+        while (!uart->rx_pending || uart->read_fd < 0) {                                    // While no read is requested or input is detached
+            hostCpuWait(&uart->rx_wake, NULL);                                              // Waiting for UART_read()
+        }
+        int fd = uart->read_fd;                                                             // Declaring input descriptor
+        size_t size = uart->rx_size < sizeof(data) ? uart->rx_size : sizeof(data);          // Declaring read size
+        uint32_t baud = uart->params.baudRate ? uart->params.baudRate : 115200;             // Declaring line rate
+        uint64_t byte_ns = 10 * 1000000000ULL / baud;                                       // Declaring 10 bit times per byte
+        hostCpuUnlock();                                                                    // Releasing core while the line is idle
+        uint64_t asked = hostNowNs();                                                       // Declaring read start
+        ssize_t n = read(fd, data, size);                                                   // Reading available bytes
+        int read_errno = errno;                                                             // Saving read error
+        if (n > 0) {                                                                        // For received bytes
+            uint64_t now = hostNowNs();                                                     // Declaring arrival time
+            if (now - asked > byte_ns || uart->rx_line_ns + 1000000ULL < now) {             // For bytes that waited on the sender (idle line)
+                uart->rx_line_ns = now;                                                     // Starting the line clock again
+            }
+            uart->rx_line_ns += (uint64_t)n * byte_ns;                                      // Declaring bytes on the wire back to back
+            struct timespec wire = { (time_t)(uart->rx_line_ns / 1000000000ULL), (long)(uart->rx_line_ns % 1000000000ULL) };
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wire, NULL) == EINTR);  // Pacing to the line rate (sleep overhead not accumulated)
+        } else if (n < 0 && read_errno == EINTR) {                                          // For interrupted read
+            hostCpuLock();                                                                  // Reacquiring core
+            continue;                                                                       // Retrying read
+        } else if (uart->is_pty) {                                                          // For pty without a client
+            uart_idle_ms(50);                                                               // Polling until a client writes
+        }
+        hostCpuLock();                                                                      // Taking core as the interrupt
+        if (n <= 0 && uart->is_pty) {                                                       // For idle pty
+            continue;                                                                       // Reading again
+        }
+        if (!uart->rx_pending) {                                                            // For read cancelled meanwhile
+            continue;                                                                       // Dropping bytes as an idle receiver does
+        }
+        uart->rx_pending = false;                                                           // Completing read
+        if (n <= 0) {                                                                       // For end of input
+            uart->rx_eof = true;                                                            // Declaring end of input
+            uart->params.readCallback(uart, uart->rx_buffer, 0);                            // Completing read with no bytes
+            continue;
+        }
+        memcpy(uart->rx_buffer, data, (size_t)n);                                           // Copying received bytes
+        uart->stats.bytes_read += (uint64_t)n;                                              // Counting read bytes
+        uart->params.readCallback(uart, uart->rx_buffer, (size_t)n);                        // Running callback as the interrupt
+    }
+    return NULL;                                                                            // Unreachable
+}
+    // UART callback-mode read (returns at once, completes on the receive thread)
+static int_fast32_t uart_read_callback(UART_Handle handle, void *buffer, size_t size) {
+    bool held = hostCpuHeld();                                                              // Saving ownership
+    if (handle->rx_eof) {                                                                   // For input already ended
+        uart_end_of_input(handle);                                                          // Ending the session or blocking forever
+        return 0;                                                                           // Returning with the read never completing
+    }
+    if (!held) hostCpuLock();                                                               // Acquiring core
+    handle->rx_buffer = buffer;                                                             // Declaring read buffer
+    handle->rx_size = size;                                                                 // Declaring read size
+    handle->rx_pending = true;                                                              // Declaring read in progress
+    if (!handle->rx_started) {                                                              // For first read
+        pthread_attr_t attrs;                                                               // Declaring thread attributes
+        pthread_attr_init(&attrs);                                                          // Initializing attributes
+        pthread_attr_setdetachstate(&attrs, PTHREAD_CREATE_DETACHED);                       // Detaching receive thread
+        handle->rx_started = (pthread_create(&handle->rx_thread, &attrs, uart_rx_entry, handle) == 0);
+        pthread_attr_destroy(&attrs);                                                       // Releasing attributes
+    }
+    pthread_cond_signal(&handle->rx_wake);                                                  // Waking receive thread
+    if (!held) hostCpuUnlock();                                                             // Restoring unlocked caller
+    return 0;                                                                               // Returning 0 as callback-mode reads do
+}
+    // UART read (blocks with the core released)
+int_fast32_t UART_read(UART_Handle handle, void *buffer, size_t size) {
+    char *data = buffer;                                                                    // Declaring byte view of buffer
+    size_t got = 0;                                                                         // Declaring bytes read
+    if (handle == NULL || !handle->open) {                                                  // For invalid handle
+        return UART_ERROR;                                                                  // Returning error
+    }
+    if (handle->params.readMode == UART_MODE_CALLBACK && handle->params.readCallback != NULL) {
+        return uart_read_callback(handle, buffer, size);                                    // Queuing callback-mode read
+    }
+    while (got < size) {                                                                    // Until request is satisfied
+        if (handle->read_fd < 0) {                                                          // For unattached input
+            uart_idle_ms(1000);                                                             // Blocking forever, one second at a time
+            continue;                                                                       // Waiting again
+        }
+        bool held = hostCpuHeld();                                                          // Saving ownership
+        if (held) hostCpuUnlock();                                                          // Releasing core while the line is idle
+        ssize_t n = read(handle->read_fd, data + got, size - got);                          // Reading available bytes
+        int read_errno = errno;                                                             // Saving read error
+        if (held) hostCpuLock();                                                            // Reacquiring core
+        if (n > 0) {                                                                        // For received bytes
+            size_t i, end = got + (size_t)n;                                                // Declaring new byte range
+            bool newline = false;                                                           // Declaring newline seen flag
+            for (i = got; i < end; i++) {                                                   // Processing each byte
+                if (handle->params.readDataMode == UART_DATA_TEXT) {                        // For text mode
+                    if (data[i] == '\r') data[i] = '\n';                                    // Converting carriage return
+                    if (handle->params.readEcho == UART_ECHO_ON) {                          // For echoed reads
+                        UART_write(handle, &data[i], 1);                                    // Echoing byte
+                    }
+                }
+                newline |= (data[i] == '\n');                                               // Tracking newline
+            }
+            handle->stats.bytes_read += (uint64_t)n;                                        // Counting read bytes
+            got = end;                                                                      // Advancing read position
+            if (newline && handle->params.readReturnMode == UART_RETURN_NEWLINE) {          // For newline return mode
+                break;                                                                      // Returning partial read
+            }
+        } else if (n < 0 && read_errno == EINTR) {                                          // For interrupted read
+            continue;                                                                       // Retrying read
+        } else if (handle->is_pty) {                                                        // For pty without a client
+            uart_idle_ms(50);                                                               // Polling until a client writes
+        } else {                                                                            // For end of input
+            uart_end_of_input(handle);                                                      // Ending the session or blocking forever
+        }
+    }
+    return (int_fast32_t)got;                                                               // Returning bytes read
+}
+    // UART read cancel
+void UART_readCancel(UART_Handle handle) {
+    if (handle == NULL || !handle->rx_pending) {                                            // For no callback-mode read (blocking reads cannot be cancelled)
+        return;                                                                             // Return from function
+    }
+    bool held = hostCpuHeld();                                                              // Saving ownership
+    if (!held) hostCpuLock();                                                               // Acquiring core
+    if (handle->rx_pending) {                                                               // For read still in progress
+        handle->rx_pending = false;                                                         // Cancelling read
+        handle->params.readCallback(handle, handle->rx_buffer, 0);                          // Completing read with no bytes
+    }
+    if (!held) hostCpuUnlock();                                                             // Restoring unlocked caller
+}
+
+/* Timer operations */
+    // Period conversion
+static uint64_t timer_period_ns(const Timer_Params *params) {
+    uint64_t ns;                                                                            // Declaring period
+    switch (params->periodUnits) {                                                          // Converting by unit
+        case Timer_PERIOD_US:                                                               // Microseconds
+            ns = (uint64_t)params->period * 1000ULL;                                        // Converting microseconds
+            break;                                                                          // Breaking case operation
+        case Timer_PERIOD_HZ:                                                               // Hertz
+            ns = params->period ? 1000000000ULL / params->period : 0;                       // Converting frequency
+            break;                                                                          // Breaking case operation
+        default:                                                                            // 120 MHz counts
+            ns = (uint64_t)params->period * 1000ULL / 120ULL;                               // Converting counts
+            break;                                                                          // Breaking case operation
+    }
+    return ns < 1000 ? 1000 : ns;                                                           // Clamping to 1 us
+}
+    // Timer "ISR" thread
+static void *timer_entry(void *arg) {
+    Timer_Handle timer = arg;                                                               // Declaring timer from thread argument
+    hostCpuLock();                                                                          // Acquiring core
+    for (;;) {                                                                              // Servicing expiries forever
+        while (!timer->running) {                                                           // While stopped
+            hostCpuWait(&timer->wake, NULL);                                                // Waiting for Timer_start()
+        }
+        uint32_t generation = timer->generation;                                            // Saving generation
+        struct timespec expiry = {                                                          // Declaring absolute expiry
+            (time_t)(timer->next_ns / 1000000000ULL), (long)(timer->next_ns % 1000000000ULL)
+        };
+        hostCpuUnlock();                                                                    // Releasing core until expiry
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &expiry, NULL) == EINTR);    // Sleeping to expiry
+        hostCpuLock();                                                                      // Taking core as the interrupt
+        if (!timer->running || generation != timer->generation) {                           // For stop or restart while sleeping
+            continue;                                                                       // Dropping stale expiry
+        }
+        uint64_t now = hostNowNs();                                                         // Reading current time
+        timer->next_ns += timer->period_ns;                                                 // Scheduling next expiry
+        if (timer->next_ns <= now) {                                                        // For missed periods
+            uint64_t missed = (now - timer->next_ns) / timer->period_ns + 1;                // Counting missed periods
+            timer->overruns += missed;                                                      // Recording overruns
+            timer->next_ns += missed * timer->period_ns;                                    // Skipping missed periods
+        }
+        if (timer->params.timerMode != Timer_CONTINUOUS_CALLBACK) {                         // For one-shot modes
+            timer->running = false;                                                         // Stopping after this expiry
+        }
+        if (timer->params.timerCallback != NULL) {                                          // For callback modes
+            timer->params.timerCallback(timer, Timer_STATUS_SUCCESS);                       // Running callback as the interrupt
+        }
+    }
+    return NULL;                                                                            // Unreachable
+}
+    // Timer driver initialization
+void Timer_init(void) {
+    int i;                                                                                  // Declaring loop variable
+    if (host_timers_ready) {                                                                // For repeated initialization
+        return;                                                                             // Return from function
+    }
+    for (i = 0; i < CONFIG_TIMER_COUNT; i++) {                                              // For all timers
+        host_timers[i].index = (unsigned int)i;                                             // Declaring timer index
+        pthread_cond_init(&host_timers[i].wake, NULL);                                      // Initializing wake condition
+    }
+    host_timers_ready = true;                                                               // Declaring timers ready
+}
+    // Timer parameter defaults (TI defaults)
+void Timer_Params_init(Timer_Params *params) {
+    params->timerMode = Timer_ONESHOT_BLOCKING;                                             // Declaring one-shot blocking mode
+    params->periodUnits = Timer_PERIOD_COUNTS;                                              // Declaring period in counts
+    params->timerCallback = NULL;                                                           // Declaring no callback
+    params->period = (uint16_t)~0;                                                          // Declaring maximum 16-bit period
+}
+    // Timer open
+Timer_Handle Timer_open(uint_least8_t index, Timer_Params *params) {
+    Timer_init();                                                                           // Ensuring timers are initialized
+    if (index >= CONFIG_TIMER_COUNT || host_timers[index].open || params == NULL) {         // For invalid or already open timer
+        return NULL;                                                                        // Returning NULL handle as on target
+    }
+    Timer_Handle timer = &host_timers[index];                                               // Declaring timer
+    timer->params = *params;                                                                // Copying parameters
+    timer->period_ns = timer_period_ns(params);                                             // Converting period
+    timer->running = false;                                                                 // Declaring timer stopped
+    timer->open = true;                                                                     // Declaring timer open
+    return timer;                                                                           // Returning timer handle
+}
+    // Timer start
+int32_t Timer_start(Timer_Handle handle) {
+    if (handle == NULL || !handle->open) {                                                  // For invalid handle
+        return Timer_STATUS_ERROR;                                                          // Returning error
+    }
+    bool held = hostCpuHeld();                                                              // Saving ownership
+    if (!held) hostCpuLock();                                                               // Acquiring core
+    handle->generation++;                                                                   // Invalidating pending expiry
+    handle->next_ns = hostNowNs() + handle->period_ns;                                      // Scheduling first expiry
+    handle->running = true;                                                                 // Declaring timer running
+    if (!handle->thread_started) {                                                          // For first start
+        pthread_attr_t attrs;                                                               // Declaring thread attributes
+        pthread_attr_init(&attrs);                                                          // Initializing attributes
+        pthread_attr_setdetachstate(&attrs, PTHREAD_CREATE_DETACHED);                       // Detaching timer thread
+        handle->thread_started = (pthread_create(&handle->thread, &attrs, timer_entry, handle) == 0);
+        pthread_attr_destroy(&attrs);                                                       // Releasing attributes
+    }
+    pthread_cond_signal(&handle->wake);                                                     // Waking timer thread
+    if (!held) hostCpuUnlock();                                                             // Restoring unlocked caller
+    return handle->thread_started ? Timer_STATUS_SUCCESS : Timer_STATUS_ERROR;              // Returning start status
+}
+    // Timer stop (safe from its own callback)
+void Timer_stop(Timer_Handle handle) {
+    if (handle != NULL) {                                                                   // For valid handle
+        handle->running = false;                                                            // Declaring timer stopped
+        handle->generation++;                                                               // Dropping pending expiry
+    }
+}
+    // Timer close
+void Timer_close(Timer_Handle handle) {
+    if (handle != NULL) {                                                                   // For valid handle
+        Timer_stop(handle);                                                                 // Stopping timer
+        handle->open = false;                                                               // Declaring timer closed
+    }
+}
+    // Timer count
+uint32_t Timer_getCount(Timer_Handle handle) {
+    if (handle == NULL || !handle->running) {                                               // For stopped timer
+        return 0;                                                                           // Returning zero count
+    }
+    uint64_t remaining = handle->next_ns > hostNowNs() ? handle->next_ns - hostNowNs() : 0; // Declaring time to expiry
+    return (uint32_t)((handle->period_ns - remaining) * 120ULL / 1000ULL);                  // Returning elapsed 120 MHz counts
+}
+    // Timer overruns
+uint64_t hostTimerOverruns(unsigned int index) {
+    return index < CONFIG_TIMER_COUNT ? host_timers[index].overruns : 0;                    // Returning skipped periods
+}
+
+/* GPIO operations */
+    // Output trace
+static void gpio_trace(uint_least8_t index, unsigned int previous) {
+    if (host_gpio_trace && previous != host_pins[index].value) {                            // For traced level change
+        fprintf(stderr, "[gpio] %s = %u\n", host_pin_names[index], host_pins[index].value); // Printing level change
+    }
+}
+    // Output trace enable
+void hostGpioTrace(bool enable) {
+    host_gpio_trace = enable;                                                               // Declaring trace flag
+}
+    // GPIO driver initialization
+void GPIO_init(void) {
+}
+    // Pin configuration
+int_fast16_t GPIO_setConfig(uint_least8_t index, GPIO_PinConfig pinConfig) {
+    if (index >= CONFIG_GPIO_COUNT) {                                                       // For invalid pin
+        return -1;                                                                          // Returning error
+    }
+    unsigned int previous = host_pins[index].value;                                         // Saving level
+    host_pins[index].config = pinConfig;                                                    // Declaring configuration
+    if (pinConfig & GPIO_CFG_INPUT) {                                                       // For input pins
+        host_pins[index].value = ((pinConfig & GPIO_CFG_IN_PU) == GPIO_CFG_IN_PU) ? 1 : 0;  // Declaring idle level from pull
+    } else {                                                                                // For output pins
+        host_pins[index].value = (pinConfig & GPIO_CFG_OUT_HIGH) ? 1 : 0;                   // Declaring initial output level
+    }
+    gpio_trace(index, previous);                                                            // Tracing level change
+    return 0;                                                                               // Returning success
+}
+    // Pin callback
+void GPIO_setCallback(uint_least8_t index, GPIO_CallbackFxn callback) {
+    if (index < CONFIG_GPIO_COUNT) {                                                        // For valid pin
+        host_pins[index].callback = callback;                                               // Declaring callback
+    }
+}
+    // Pin interrupt enable
+void GPIO_enableInt(uint_least8_t index) {
+    if (index < CONFIG_GPIO_COUNT) {                                                        // For valid pin
+        host_pins[index].int_enabled = true;                                                // Enabling interrupt
+    }
+}
+    // Pin interrupt disable
+void GPIO_disableInt(uint_least8_t index) {
+    if (index < CONFIG_GPIO_COUNT) {                                                        // For valid pin
+        host_pins[index].int_enabled = false;                                               // Disabling interrupt
+    }
+}
+    // Pin interrupt clear
+void GPIO_clearInt(uint_least8_t index) {
+    (void)index;                                                                            // No latched interrupts on host
+}
+    // Pin read
+uint_fast8_t GPIO_read(uint_least8_t index) {
+    return index < CONFIG_GPIO_COUNT ? (uint_fast8_t)host_pins[index].value : 0;            // Returning pin level
+}
+    // Pin write
+void GPIO_write(uint_least8_t index, unsigned int value) {
+    if (index >= CONFIG_GPIO_COUNT || (host_pins[index].config & GPIO_CFG_INPUT)) {         // For invalid or input pin
+        return;                                                                             // Writes to inputs are ignored
+    }
+    unsigned int previous = host_pins[index].value;                                         // Saving level
+    host_pins[index].value = value ? 1 : 0;                                                 // Declaring output level
+    gpio_trace(index, previous);                                                            // Tracing level change
+}
+    // Pin toggle
+void GPIO_toggle(uint_least8_t index) {
+    if (index < CONFIG_GPIO_COUNT) {                                                        // For valid pin
+        GPIO_write(index, !host_pins[index].value);                                         // Writing inverted level
+    }
+}
+    // Switch press
+void hostGpioPress(unsigned int index) {
+    if (index >= CONFIG_GPIO_COUNT || !(host_pins[index].config & GPIO_CFG_INPUT)) {        // For invalid or output pin
+        return;                                                                             // Return from function
+    }
+    HostPin *pin = &host_pins[index];                                                       // Declaring pressed pin
+    uint32_t edges = pin->config & GPIO_CFG_INT_MASK;                                       // Declaring enabled edges
+    hostCpuLock();                                                                          // Taking core as the interrupt
+    pin->value = 0;                                                                         // Pulling pin low
+    if (pin->int_enabled && pin->callback && (edges & GPIO_CFG_IN_INT_FALLING)) {           // For falling-edge interrupt
+        pin->callback((uint_least8_t)index);                                                // Running callback
+    }
+    pin->value = 1;                                                                         // Releasing pin
+    if (pin->int_enabled && pin->callback && (edges & GPIO_CFG_IN_INT_RISING)) {            // For rising-edge interrupt
+        pin->callback((uint_least8_t)index);                                                // Running callback
+    }
+    hostCpuUnlock();                                                                        // Returning from interrupt
+}
+    // Pin level peek
+unsigned int hostGpioValue(unsigned int index) {
+    return index < CONFIG_GPIO_COUNT ? host_pins[index].value : 0;                          // Returning pin level
+}
+
+/* SPI operations */
+    // SPI driver initialization
+void SPI_init(void) {
+}
+    // SPI parameter defaults (TI defaults)
+void SPI_Params_init(SPI_Params *params) {
+    memset(params, 0, sizeof(*params));                                                     // Clearing parameters
+    params->transferMode = SPI_MODE_BLOCKING;                                               // Declaring blocking transfers
+    params->transferTimeout = ~0U;                                                          // Declaring infinite timeout
+    params->mode = SPI_MASTER;                                                              // Declaring master role
+    params->bitRate = 1000000;                                                              // Declaring 1 MHz
+    params->dataSize = 8;                                                                   // Declaring 8-bit frames
+    params->frameFormat = SPI_POL0_PHA0;                                                    // Declaring mode 0
+}
+    // SPI open
+SPI_Handle SPI_open(uint_least8_t index, SPI_Params *params) {
+    if (index >= CONFIG_SPI_COUNT || host_spis[index].open) {                               // For invalid or already open SPI
+        return NULL;                                                                        // Returning NULL handle as on target
+    }
+    if (params == NULL) {                                                                   // For default parameters
+        SPI_Params_init(&host_spis[index].params);                                          // Initializing defaults
+    } else {                                                                                // For caller parameters
+        host_spis[index].params = *params;                                                  // Copying parameters
+    }
+    host_spis[index].open = true;                                                           // Declaring SPI open
+    return &host_spis[index];                                                               // Returning SPI handle
+}
+    // SPI close
+void SPI_close(SPI_Handle handle) {
+    if (handle != NULL) {                                                                   // For valid handle
+        handle->open = false;                                                               // Declaring SPI closed
+    }
+}
+    // SPI transfer into the DAC model (callback mode completes before returning)
+bool SPI_transfer(SPI_Handle handle, SPI_Transaction *transaction) {
+    size_t i;                                                                               // Declaring loop variable
+    if (handle == NULL || !handle->open || transaction == NULL) {                           // For invalid transfer
+        if (transaction) transaction->status = SPI_TRANSFER_FAILED;                         // Declaring failure
+        return false;                                                                       // Returning failure
+    }
+    host_dac.transfers++;                                                                   // Counting transfer
+    host_dac.frames += transaction->count;                                                  // Counting frames
+    for (i = 0; i < transaction->count && transaction->txBuf != NULL; i++) {                // For each transmitted frame
+        uint16_t word = (handle->params.dataSize > 8) ? ((const uint16_t *)transaction->txBuf)[i]
+                                                      : ((const uint8_t *)transaction->txBuf)[i];
+        host_dac.last_word = word;                                                          // Latching DAC word
+        host_dac.history[host_dac.history_position] = word;                                 // Recording DAC word
+        host_dac.history_position = (host_dac.history_position + 1) % HOST_SPI_HISTORY;     // Advancing ring
+        if (host_dac_capture != NULL && host_dac_captured < host_dac_capacity) {            // For capture running
+            host_dac_capture[host_dac_captured++] = word;                                   // Capturing DAC word
+        }
+    }
+    if (transaction->rxBuf != NULL) {                                                       // For full-duplex transfer
+        memset(transaction->rxBuf, 0, transaction->count * (handle->params.dataSize > 8 ? 2 : 1));
+    }
+    transaction->status = SPI_TRANSFER_COMPLETED;                                           // Declaring completion
+    if (handle->params.transferMode == SPI_MODE_CALLBACK && handle->params.transferCallbackFxn != NULL) {
+        handle->params.transferCallbackFxn(handle, transaction);                            // Completing at once (no shift time modeled)
+    }
+    return true;                                                                            // Returning success
+}
+    // DAC word capture (NULL buffer stops; words arrive from the sine timer with the CPU held)
+void hostDacCapture(uint16_t *buffer, size_t capacity) {
+    hostCpuLock();                                                                          // Holding off the sine timer
+    host_dac_capture = buffer;                                                              // Declaring capture buffer
+    host_dac_capacity = (buffer != NULL) ? capacity : 0;
+    host_dac_captured = 0;                                                                  // Restarting capture
+    hostCpuUnlock();
+}
+    // DAC words captured so far
+size_t hostDacCaptured(void) {
+    size_t captured;                                                                        // Declaring count
+    hostCpuLock();                                                                          // Holding off the sine timer
+    captured = host_dac_captured;
+    hostCpuUnlock();
+    return captured;                                                                        // Returning count
+}
+    // DAC statistics copy
+void hostDacStatsGet(HostDacStats *stats) {
+    bool held = hostCpuHeld();                                                              // Saving ownership
+    if (!held) hostCpuLock();                                                               // Acquiring core for a consistent copy
+    *stats = host_dac;                                                                      // Copying statistics
+    if (!held) hostCpuUnlock();                                                             // Restoring unlocked caller
+}
+
+/* Memory operations */
+    // Map SRAM and flash at their MSP432 addresses so -memr can dereference them
+bool hostMapMemory(void) {
+    void *sram = mmap((void *)HOST_SRAM_BASE, HOST_SRAM_SIZE, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);            // Mapping SRAM
+    void *flash = mmap((void *)HOST_FLASH_BASE, HOST_FLASH_END - HOST_FLASH_BASE, PROT_READ,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);           // Mapping flash (reads as erased zeros)
+    if (flash != MAP_FAILED && flash != (void *)HOST_FLASH_BASE) {                          // For relocated flash mapping
+        munmap(flash, HOST_FLASH_END - HOST_FLASH_BASE);                                    // Releasing misplaced mapping
+    }
+    if (sram != MAP_FAILED && sram != (void *)HOST_SRAM_BASE) {                             // For relocated SRAM mapping
+        munmap(sram, HOST_SRAM_SIZE);                                                       // Releasing misplaced mapping
+        return false;                                                                       // Returning unmapped
+    }
+    return sram != MAP_FAILED;                                                              // Returning SRAM mapped
+}
@@ -0,0 +1,320 @@
+/*
+ * host_rtos.c
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Driver libraries */
+#define _GNU_SOURCE                                                                         // Enabling POSIX clock and thread extensions
+#include <stdint.h>                                                                         // Including integer-size C control
+#include <stdlib.h>                                                                         // Including malloc() functions
+#include <string.h>                                                                         // Including memset() functions
+#include <errno.h>                                                                          // Including error codes
+#include <time.h>                                                                           // Including clock_gettime() functions
+#include <unistd.h>                                                                         // Including pause() functions
+#include <sched.h>                                                                          // Including sched_yield() functions
+#include <pthread.h>                                                                        // Including POSIX threads
+
+/* Driver-Header files */
+#include <ti/sysbios/BIOS.h>                                                                // BIOS API header file controls
+#include <ti/sysbios/knl/Task.h>                                                            // Task API header file controls
+#include <ti/sysbios/knl/Clock.h>                                                           // Clock API header file controls
+#include <ti/sysbios/knl/Semaphore.h>                                                       // Semaphore API header file controls
+#include <ti/sysbios/knl/Queue.h>                                                           // Queue API header file controls
+#include "host.h"                                                                           // Host simulation controls
+
+/* Declaring RTOS objects */
+struct Task_Object {
+    Task_FuncPtr fxn;                                                                       // Declaring task entry function
+    UArg arg0;                                                                              // Declaring first task argument
+    UArg arg1;                                                                              // Declaring second task argument
+    Int priority;                                                                           // Declaring recorded priority
+    pthread_t thread;                                                                       // Declaring backing thread
+};
+struct Semaphore_Object {
+    Int count;                                                                              // Declaring semaphore count
+    Semaphore_Mode mode;                                                                    // Declaring counting or binary mode
+    pthread_cond_t wake;                                                                    // Declaring pend wake-up condition (waits on the CPU lock)
+};
+
+/* Global variables */
+static pthread_mutex_t host_cpu = PTHREAD_MUTEX_INITIALIZER;                                // Declaring the single simulated core
+static pthread_cond_t host_start_cond = PTHREAD_COND_INITIALIZER;                           // Declaring scheduler start condition
+static bool host_started = false;                                                           // Declaring scheduler started flag
+static __thread bool cpu_held = false;                                                      // Declaring per-thread CPU ownership flag
+static __thread Task_Handle current_task = NULL;                                            // Declaring per-thread task handle
+
+/* CPU operations */
+    // Acquire the core
+void hostCpuLock(void) {
+    pthread_mutex_lock(&host_cpu);                                                          // Waiting for the core
+    cpu_held = true;                                                                        // Marking core owned by this thread
+}
+    // Release the core
+void hostCpuUnlock(void) {
+    cpu_held = false;                                                                       // Marking core released by this thread
+    pthread_mutex_unlock(&host_cpu);                                                        // Handing the core to the next runnable thread
+}
+    // Check core ownership
+bool hostCpuHeld(void) {
+    return cpu_held;                                                                        // Returning this thread's ownership
+}
+    // Wait on a condition with the core released
+int hostCpuWait(pthread_cond_t *cond, const struct timespec *deadline) {
+    int status;                                                                             // Declaring wait status
+    cpu_held = false;                                                                       // Core released while waiting
+    if (deadline == NULL) {                                                                 // For unbounded wait
+        status = pthread_cond_wait(cond, &host_cpu);                                        // Waiting on the core lock
+    } else {                                                                                // For bounded wait (CLOCK_REALTIME deadline)
+        status = pthread_cond_timedwait(cond, &host_cpu, deadline);                         // Waiting on the core lock until deadline
+    }
+    cpu_held = true;                                                                        // Core reacquired
+    return status;                                                                          // Returning wait status
+}
+    // Start the scheduler
+void hostStart(void) {
+    pthread_mutex_lock(&host_cpu);                                                          // Acquiring core to publish start
+    host_started = true;                                                                    // Declaring scheduler as started
+    pthread_cond_broadcast(&host_start_cond);                                               // Releasing tasks created before start
+    pthread_mutex_unlock(&host_cpu);                                                        // Releasing core
+}
+    // Monotonic nanoseconds
+uint64_t hostNowNs(void) {
+    struct timespec now;                                                                    // Declaring time sample
+    clock_gettime(CLOCK_MONOTONIC, &now);                                                   // Reading monotonic clock
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;                    // Returning nanoseconds
+}
+    // Block for a number of milliseconds with the core released
+static void cpu_sleep_ms(UInt32 ms) {
+    struct timespec delay = { ms / 1000, (long)(ms % 1000) * 1000000L };                    // Declaring relative delay
+    bool held = cpu_held;                                                                   // Saving ownership to restore after sleeping
+    if (held) hostCpuUnlock();                                                              // Releasing core while blocked
+    while (nanosleep(&delay, &delay) != 0 && errno == EINTR);                               // Sleeping through signal interruptions
+    if (held) hostCpuLock();                                                                // Reacquiring core
+}
+
+/* BIOS operations */
+    // Start BIOS (never returns)
+void BIOS_start(void) {
+    hostStart();                                                                            // Starting created tasks
+    for (;;) {                                                                              // Idling main thread forever
+        pause();                                                                            // Waiting for process exit
+    }
+}
+    // Exit BIOS
+void BIOS_exit(Int stat) {
+    exit(stat);                                                                             // Exiting process (restores terminal via atexit handlers)
+}
+    // Current thread context (threads that are not tasks run timer and GPIO "ISRs")
+BIOS_ThreadType BIOS_getThreadType(void) {
+    if (!host_started) {                                                                    // For code before BIOS_start()
+        return BIOS_ThreadType_Main;                                                        // Returning main context
+    }
+    return (current_task != NULL) ? BIOS_ThreadType_Task : BIOS_ThreadType_Hwi;             // Returning task or interrupt context
+}
+
+/* Clock operations */
+    // Clock ticks (1 ms, from the first call)
+UInt32 Clock_getTicks(void) {
+    static uint64_t start = 0;                                                              // Declaring tick origin
+    if (start == 0) {                                                                       // For first call
+        start = hostNowNs();                                                                // Declaring tick origin
+    }
+    return (UInt32)((hostNowNs() - start) / 1000000ULL);                                    // Returning elapsed milliseconds
+}
+
+/* Task operations */
+    // Task parameter defaults
+void Task_Params_init(Task_Params *params) {
+    memset(params, 0, sizeof(*params));                                                     // Clearing parameters
+    params->priority = 1;                                                                   // Declaring default priority
+    params->stackSize = 2048;                                                               // Declaring default stack size
+}
+    // Task thread entry
+static void *task_entry(void *arg) {
+    Task_Handle task = (Task_Handle)arg;                                                    // Declaring task from thread argument
+    current_task = task;                                                                    // Declaring thread-local task handle
+    hostCpuLock();                                                                          // Acquiring core before running task code
+    while (!host_started) {                                                                 // Waiting for BIOS_start()
+        hostCpuWait(&host_start_cond, NULL);                                                // Waiting on the core lock
+    }
+    task->fxn(task->arg0, task->arg1);                                                      // Running task function
+    hostCpuUnlock();                                                                        // Releasing core when task returns
+    return NULL;                                                                            // Returning from thread
+}
+    // Task creation
+Task_Handle Task_create(Task_FuncPtr fxn, const Task_Params *params, Error_Block *eb) {
+    Task_Params defaults;                                                                   // Declaring default parameters
+    pthread_attr_t attrs;                                                                   // Declaring thread attributes
+    (void)eb;                                                                               // Error block unused on host
+    if (params == NULL) {                                                                   // For default parameters
+        Task_Params_init(&defaults);                                                        // Initializing defaults
+        params = &defaults;                                                                 // Using defaults
+    }
+    Task_Handle task = calloc(1, sizeof(*task));                                            // Allocating task object
+    if (task == NULL) {                                                                     // For allocation failure
+        return NULL;                                                                        // Returning NULL handle as on target
+    }
+    task->fxn = fxn;                                                                        // Declaring entry function
+    task->arg0 = params->arg0;                                                              // Declaring first argument
+    task->arg1 = params->arg1;                                                              // Declaring second argument
+    task->priority = params->priority;                                                      // Declaring priority
+    pthread_attr_init(&attrs);                                                              // Initializing thread attributes
+    pthread_attr_setdetachstate(&attrs, PTHREAD_CREATE_DETACHED);                           // Detaching task thread
+    if (pthread_create(&task->thread, &attrs, task_entry, task) != 0) {                     // For thread creation failure
+        pthread_attr_destroy(&attrs);                                                       // Releasing attributes
+        free(task);                                                                         // Freeing task object
+        return NULL;                                                                        // Returning NULL handle
+    }
+    pthread_attr_destroy(&attrs);                                                           // Releasing attributes
+    return task;                                                                            // Returning task handle
+}
+    // Task sleep (1 ms Clock tick)
+void Task_sleep(UInt32 ticks) {
+    if (ticks == 0) {                                                                       // For zero-tick sleep
+        Task_yield();                                                                       // Yielding instead
+        return;                                                                             // Return from function
+    }
+    cpu_sleep_ms(ticks);                                                                    // Sleeping with the core released
+}
+    // Task yield
+void Task_yield(void) {
+    bool held = cpu_held;                                                                   // Saving ownership
+    if (held) hostCpuUnlock();                                                              // Releasing core
+    sched_yield();                                                                          // Letting another thread take the core
+    if (held) hostCpuLock();                                                                // Reacquiring core
+}
+    // Current task
+Task_Handle Task_self(void) {
+    return current_task;                                                                    // Returning thread-local task handle
+}
+    // Task priority change
+Int Task_setPri(Task_Handle handle, Int priority) {
+    if (handle == NULL) {                                                                   // For non-task threads
+        return -1;                                                                          // Returning invalid priority
+    }
+    Int previous = handle->priority;                                                        // Saving previous priority
+    handle->priority = priority;                                                            // Recording new priority
+    return previous;                                                                        // Returning previous priority
+}
+
+/* Semaphore operations */
+    // Semaphore parameter defaults
+void Semaphore_Params_init(Semaphore_Params *params) {
+    memset(params, 0, sizeof(*params));                                                     // Clearing parameters
+    params->mode = Semaphore_Mode_COUNTING;                                                 // Declaring counting mode
+}
+    // Semaphore creation
+Semaphore_Handle Semaphore_create(Int count, const Semaphore_Params *params, Error_Block *eb) {
+    (void)eb;                                                                               // Error block unused on host
+    Semaphore_Handle sem = calloc(1, sizeof(*sem));                                         // Allocating semaphore object
+    if (sem == NULL) {                                                                      // For allocation failure
+        return NULL;                                                                        // Returning NULL handle
+    }
+    sem->count = count;                                                                     // Declaring initial count
+    sem->mode = params ? params->mode : Semaphore_Mode_COUNTING;                            // Declaring mode
+    pthread_cond_init(&sem->wake, NULL);                                                    // Initializing wake condition
+    return sem;                                                                             // Returning semaphore handle
+}
+    // Semaphore deletion
+void Semaphore_delete(Semaphore_Handle *handle) {
+    if (handle && *handle) {                                                                // For valid handle
+        pthread_cond_destroy(&(*handle)->wake);                                             // Destroying wake condition
+        free(*handle);                                                                      // Freeing semaphore object
+        *handle = NULL;                                                                     // Clearing caller handle
+    }
+}
+    // Semaphore pend
+Bool Semaphore_pend(Semaphore_Handle sem, UInt32 timeout) {
+    bool held = cpu_held;                                                                   // Saving ownership (ISR-less callers may pend unlocked)
+    Bool taken = TRUE;                                                                      // Declaring result
+    struct timespec deadline;                                                               // Declaring absolute timeout
+    if (!held) hostCpuLock();                                                               // Acquiring core to inspect count
+    if (timeout != BIOS_WAIT_FOREVER && timeout != BIOS_NO_WAIT) {                          // For bounded timeout
+        clock_gettime(CLOCK_REALTIME, &deadline);                                           // Reading condition clock
+        deadline.tv_sec += timeout / 1000;                                                  // Adding whole seconds
+        deadline.tv_nsec += (long)(timeout % 1000) * 1000000L;                              // Adding remaining milliseconds
+        if (deadline.tv_nsec >= 1000000000L) {                                              // Normalizing nanoseconds
+            deadline.tv_sec++;                                                              // Carrying second
+            deadline.tv_nsec -= 1000000000L;                                                // Removing carried second
+        }
+    }
+    while (sem->count == 0 && taken) {                                                      // Blocking while unavailable
+        if (timeout == BIOS_NO_WAIT) {                                                      // For polling pend
+            taken = FALSE;                                                                  // Failing immediately
+        } else if (timeout == BIOS_WAIT_FOREVER) {                                          // For unbounded pend
+            hostCpuWait(&sem->wake, NULL);                                                  // Waiting for a post
+        } else if (hostCpuWait(&sem->wake, &deadline) == ETIMEDOUT && sem->count == 0) {    // For bounded pend
+            taken = FALSE;                                                                  // Timing out
+        }
+    }
+    if (taken) {                                                                            // For successful pend
+        sem->count = (sem->mode == Semaphore_Mode_BINARY) ? 0 : sem->count - 1;             // Consuming count
+    }
+    if (!held) hostCpuUnlock();                                                             // Restoring unlocked caller
+    return taken;                                                                           // Returning pend result
+}
+    // Semaphore post
+void Semaphore_post(Semaphore_Handle sem) {
+    bool held = cpu_held;                                                                   // Saving ownership
+    if (!held) hostCpuLock();                                                               // Acquiring core to update count
+    sem->count = (sem->mode == Semaphore_Mode_BINARY) ? 1 : sem->count + 1;                 // Releasing count
+    pthread_cond_signal(&sem->wake);                                                        // Waking one pending task
+    if (!held) hostCpuUnlock();                                                             // Restoring unlocked caller
+}
+    // Semaphore count
+Int Semaphore_getCount(Semaphore_Handle sem) {
+    return sem->count;                                                                      // Returning current count
+}
+
+/* Queue operations (callers hold the CPU lock, as interrupts are disabled on target) */
+    // Queue parameter defaults
+void Queue_Params_init(Queue_Params *params) {
+    memset(params, 0, sizeof(*params));                                                     // Clearing parameters
+}
+    // Static queue construction
+void Queue_construct(Queue_Struct *obj, const Queue_Params *params) {
+    (void)params;                                                                           // Parameters unused on host
+    obj->elem.next = &obj->elem;                                                            // Declaring empty circular list
+    obj->elem.prev = &obj->elem;                                                            // Declaring empty circular list
+}
+    // Static queue handle
+Queue_Handle Queue_handle(Queue_Struct *obj) {
+    return obj;                                                                             // Returning queue object as handle
+}
+    // Queue creation
+Queue_Handle Queue_create(const Queue_Params *params, Error_Block *eb) {
+    (void)eb;                                                                               // Error block unused on host
+    Queue_Handle queue = malloc(sizeof(*queue));                                            // Allocating queue object
+    if (queue != NULL) {                                                                    // For successful allocation
+        Queue_construct(queue, params);                                                     // Initializing sentinel
+    }
+    return queue;                                                                           // Returning queue handle
+}
+    // Queue empty check
+Bool Queue_empty(Queue_Handle queue) {
+    return queue->elem.next == &queue->elem;                                                // Returning true when only the sentinel remains
+}
+    // Queue head removal
+Ptr Queue_get(Queue_Handle queue) {
+    Queue_Elem *elem = queue->elem.next;                                                    // Declaring head element
+    queue->elem.next = elem->next;                                                          // Unlinking head forward
+    elem->next->prev = &queue->elem;                                                        // Unlinking head backward
+    return elem;                                                                            // Returning head (the queue itself when empty)
+}
+    // Queue tail insertion
+void Queue_put(Queue_Handle queue, Queue_Elem *elem) {
+    elem->next = &queue->elem;                                                              // Linking new tail forward to sentinel
+    elem->prev = queue->elem.prev;                                                          // Linking new tail backward
+    queue->elem.prev->next = elem;                                                          // Linking old tail to new tail
+    queue->elem.prev = elem;                                                                // Declaring new tail
+}
+    // Queue head peek
+Ptr Queue_head(Queue_Handle queue) {
+    return queue->elem.next;                                                                // Returning head (the queue itself when empty)
+}
+    // Queue next element
+Ptr Queue_next(Ptr elem) {
+    return ((Queue_Elem *)elem)->next;                                                      // Returning successor (the queue itself after the tail)
+}
@@ -0,0 +1,12 @@
+/*
+ * ti/devices/msp432e4/driverlib/gpio.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host driverlib gpio header (the shell only includes it) */
+#ifndef HOST_DRIVERLIB_GPIO_H_
+#define HOST_DRIVERLIB_GPIO_H_
+
+#endif /* HOST_DRIVERLIB_GPIO_H_ */
@@ -0,0 +1,12 @@
+/*
+ * ti/devices/msp432e4/driverlib/pin_map.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host driverlib pin_map header (the shell only includes it) */
+#ifndef HOST_DRIVERLIB_PIN_MAP_H_
+#define HOST_DRIVERLIB_PIN_MAP_H_
+
+#endif /* HOST_DRIVERLIB_PIN_MAP_H_ */
@@ -0,0 +1,12 @@
+/*
+ * ti/devices/msp432e4/driverlib/sysctl.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host driverlib sysctl header (the shell only includes it) */
+#ifndef HOST_DRIVERLIB_SYSCTL_H_
+#define HOST_DRIVERLIB_SYSCTL_H_
+
+#endif /* HOST_DRIVERLIB_SYSCTL_H_ */
@@ -0,0 +1,15 @@
+/*
+ * ti/drivers/Board.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host Board header */
+#ifndef HOST_BOARD_H_
+#define HOST_BOARD_H_
+
+/* Declaring board operations */
+void Board_init(void);                                                                      // Declaring board initialization (no-op on host)
+
+#endif /* HOST_BOARD_H_ */
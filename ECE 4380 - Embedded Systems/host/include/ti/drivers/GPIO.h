@@ -0,0 +1,45 @@
+/*
+ * ti/drivers/GPIO.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host GPIO header */
+#ifndef HOST_GPIO_H_
+#define HOST_GPIO_H_
+
+#include <stdint.h>                                                                         // Including integer-size C control
+
+/* Declaring GPIO configuration flags */
+#define GPIO_CFG_OUTPUT (0x00000000)                                                        // Declaring output pin
+#define GPIO_CFG_OUT_STD (0x00000000)                                                       // Declaring push-pull output
+#define GPIO_CFG_OUT_OD_NOPULL (0x00010000)                                                 // Declaring open-drain output
+#define GPIO_CFG_OUT_LOW (0x00000000)                                                       // Declaring output initially low
+#define GPIO_CFG_OUT_HIGH (0x00080000)                                                      // Declaring output initially high
+#define GPIO_CFG_INPUT (0x00100000)                                                         // Declaring input pin
+#define GPIO_CFG_IN_NOPULL (0x00100000)                                                     // Declaring floating input
+#define GPIO_CFG_IN_PU (0x00300000)                                                         // Declaring pull-up input
+#define GPIO_CFG_IN_PD (0x00500000)                                                         // Declaring pull-down input
+#define GPIO_CFG_IN_INT_NONE (0x00000000)                                                   // Declaring no interrupt
+#define GPIO_CFG_IN_INT_FALLING (0x01000000)                                                // Declaring falling-edge interrupt
+#define GPIO_CFG_IN_INT_RISING (0x02000000)                                                 // Declaring rising-edge interrupt
+#define GPIO_CFG_IN_INT_BOTH_EDGES (0x03000000)                                             // Declaring both-edge interrupt
+#define GPIO_CFG_INT_MASK (0x07000000)                                                      // Declaring interrupt flag mask
+
+/* Declaring GPIO types */
+typedef uint32_t GPIO_PinConfig;                                                            // Declaring pin configuration type
+typedef void (*GPIO_CallbackFxn)(uint_least8_t index);                                      // Declaring pin interrupt callback type
+
+/* Declaring GPIO operations */
+void GPIO_init(void);                                                                       // Declaring GPIO driver initialization
+int_fast16_t GPIO_setConfig(uint_least8_t index, GPIO_PinConfig pinConfig);                 // Declaring pin configuration
+void GPIO_setCallback(uint_least8_t index, GPIO_CallbackFxn callback);                      // Declaring pin callback
+void GPIO_enableInt(uint_least8_t index);                                                   // Declaring pin interrupt enable
+void GPIO_disableInt(uint_least8_t index);                                                  // Declaring pin interrupt disable
+void GPIO_clearInt(uint_least8_t index);                                                    // Declaring pin interrupt clear
+uint_fast8_t GPIO_read(uint_least8_t index);                                                // Declaring pin read
+void GPIO_write(uint_least8_t index, unsigned int value);                                   // Declaring pin write
+void GPIO_toggle(uint_least8_t index);                                                      // Declaring pin toggle
+
+#endif /* HOST_GPIO_H_ */
@@ -0,0 +1,53 @@
+/*
+ * ti/drivers/SPI.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host SPI header */
+#ifndef HOST_SPI_H_
+#define HOST_SPI_H_
+
+#include <stdint.h>                                                                         // Including integer-size C control
+#include <stddef.h>                                                                         // Including size_t and NULL
+#include <stdbool.h>                                                                        // Including boolean operations
+
+/* Declaring SPI types */
+typedef struct SPI_Config_* SPI_Handle;                                                     // Declaring SPI handle
+typedef enum {
+    SPI_TRANSFER_COMPLETED, SPI_TRANSFER_STARTED, SPI_TRANSFER_QUEUED,                      // Declaring transfer states
+    SPI_TRANSFER_FAILED, SPI_TRANSFER_CANCELED, SPI_TRANSFER_PEND_CSN_ASSERTION
+} SPI_Status;                                                                               // Declaring enum name as SPI_Status
+typedef struct {
+    size_t count;                                                                           // Declaring frame count
+    void *txBuf;                                                                            // Declaring transmit buffer
+    void *rxBuf;                                                                            // Declaring receive buffer
+    void *arg;                                                                              // Declaring user argument
+    SPI_Status status;                                                                      // Declaring transfer status
+} SPI_Transaction;                                                                          // Declaring struct name as SPI_Transaction
+typedef void (*SPI_CallbackFxn)(SPI_Handle handle, SPI_Transaction *transaction);           // Declaring transfer callback type
+typedef enum { SPI_MASTER, SPI_SLAVE } SPI_Mode;                                            // Declaring SPI roles
+typedef enum { SPI_MODE_BLOCKING, SPI_MODE_CALLBACK } SPI_TransferMode;                     // Declaring transfer modes
+typedef enum {
+    SPI_POL0_PHA0, SPI_POL0_PHA1, SPI_POL1_PHA0, SPI_POL1_PHA1, SPI_TI, SPI_MW              // Declaring frame formats
+} SPI_FrameFormat;                                                                          // Declaring enum name as SPI_FrameFormat
+typedef struct {
+    SPI_TransferMode transferMode;                                                          // Declaring transfer mode
+    uint32_t transferTimeout;                                                               // Declaring transfer timeout
+    SPI_CallbackFxn transferCallbackFxn;                                                    // Declaring transfer callback
+    SPI_Mode mode;                                                                          // Declaring SPI role
+    uint32_t bitRate;                                                                       // Declaring bit rate (recorded only)
+    uint32_t dataSize;                                                                      // Declaring frame size in bits
+    SPI_FrameFormat frameFormat;                                                            // Declaring frame format
+    void *custom;                                                                           // Declaring custom argument
+} SPI_Params;                                                                               // Declaring struct name as SPI_Params
+
+/* Declaring SPI operations */
+void SPI_init(void);                                                                        // Declaring SPI driver initialization
+void SPI_Params_init(SPI_Params *params);                                                   // Declaring SPI parameter defaults
+SPI_Handle SPI_open(uint_least8_t index, SPI_Params *params);                               // Declaring SPI open
+void SPI_close(SPI_Handle handle);                                                          // Declaring SPI close
+bool SPI_transfer(SPI_Handle handle, SPI_Transaction *transaction);                         // Declaring SPI transfer into the DAC model
+
+#endif /* HOST_SPI_H_ */
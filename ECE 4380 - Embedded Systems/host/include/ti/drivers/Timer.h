@@ -0,0 +1,48 @@
+/*
+ * ti/drivers/Timer.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host Timer header */
+#ifndef HOST_TIMER_H_
+#define HOST_TIMER_H_
+
+#include <stdint.h>                                                                         // Including integer-size C control
+
+/* Declaring timer constants */
+#define Timer_STATUS_SUCCESS (0)                                                            // Declaring success status
+#define Timer_STATUS_ERROR (-1)                                                             // Declaring error status
+
+/* Declaring timer types */
+typedef struct Timer_Config_* Timer_Handle;                                                 // Declaring timer handle
+typedef void (*Timer_CallBackFxn)(Timer_Handle handle, int_fast16_t status);                // Declaring timer callback type
+typedef enum {
+    Timer_ONESHOT_CALLBACK,                                                                 // Declaring one-shot callback mode
+    Timer_ONESHOT_BLOCKING,                                                                 // Declaring one-shot blocking mode
+    Timer_CONTINUOUS_CALLBACK,                                                              // Declaring periodic callback mode
+    Timer_FREE_RUNNING                                                                      // Declaring free-running mode
+} Timer_Mode;                                                                               // Declaring enum name as Timer_Mode
+typedef enum {
+    Timer_PERIOD_US,                                                                        // Declaring period in microseconds
+    Timer_PERIOD_HZ,                                                                        // Declaring period in hertz
+    Timer_PERIOD_COUNTS                                                                     // Declaring period in 120 MHz counts
+} Timer_PeriodUnits;                                                                        // Declaring enum name as Timer_PeriodUnits
+typedef struct {
+    Timer_Mode timerMode;                                                                   // Declaring timer mode
+    Timer_PeriodUnits periodUnits;                                                          // Declaring period units
+    Timer_CallBackFxn timerCallback;                                                        // Declaring timer callback
+    uint32_t period;                                                                        // Declaring timer period
+} Timer_Params;                                                                             // Declaring struct name as Timer_Params
+
+/* Declaring timer operations */
+void Timer_init(void);                                                                      // Declaring timer driver initialization
+void Timer_Params_init(Timer_Params *params);                                               // Declaring timer parameter defaults
+Timer_Handle Timer_open(uint_least8_t index, Timer_Params *params);                         // Declaring timer open (NULL when already open)
+int32_t Timer_start(Timer_Handle handle);                                                   // Declaring timer start
+void Timer_stop(Timer_Handle handle);                                                       // Declaring timer stop (safe from its own callback)
+void Timer_close(Timer_Handle handle);                                                      // Declaring timer close
+uint32_t Timer_getCount(Timer_Handle handle);                                               // Declaring timer count
+
+#endif /* HOST_TIMER_H_ */
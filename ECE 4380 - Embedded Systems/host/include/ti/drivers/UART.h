@@ -0,0 +1,59 @@
+/*
+ * ti/drivers/UART.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host UART header */
+#ifndef HOST_UART_H_
+#define HOST_UART_H_
+
+#include <stdint.h>                                                                         // Including integer-size C control
+#include <stddef.h>                                                                         // Including size_t and NULL
+#include <stdbool.h>                                                                        // Including boolean operations
+
+/* Declaring UART constants */
+#define UART_WAIT_FOREVER (~(0U))                                                           // Declaring infinite read/write timeout
+#define UART_STATUS_SUCCESS (0)                                                             // Declaring success status
+#define UART_STATUS_ERROR (-1)                                                              // Declaring error status
+#define UART_ERROR (UART_STATUS_ERROR)                                                      // Declaring legacy error return
+
+/* Declaring UART types */
+typedef struct UART_Config_* UART_Handle;                                                   // Declaring UART handle
+typedef void (*UART_Callback)(UART_Handle handle, void *buf, size_t count);                 // Declaring callback-mode completion type
+typedef enum { UART_MODE_BLOCKING, UART_MODE_CALLBACK } UART_Mode;                          // Declaring read/write modes
+typedef enum { UART_RETURN_FULL, UART_RETURN_NEWLINE } UART_ReturnMode;                     // Declaring read return modes
+typedef enum { UART_DATA_BINARY, UART_DATA_TEXT } UART_DataMode;                            // Declaring data processing modes
+typedef enum { UART_ECHO_OFF, UART_ECHO_ON } UART_Echo;                                     // Declaring read echo modes
+typedef enum { UART_LEN_5, UART_LEN_6, UART_LEN_7, UART_LEN_8 } UART_LEN;                   // Declaring data lengths
+typedef enum { UART_STOP_ONE, UART_STOP_TWO } UART_STOP;                                    // Declaring stop bits
+typedef enum { UART_PAR_NONE, UART_PAR_EVEN, UART_PAR_ODD, UART_PAR_ZERO, UART_PAR_ONE } UART_PAR;
+typedef struct {
+    UART_Mode readMode;                                                                     // Declaring read mode
+    UART_Mode writeMode;                                                                    // Declaring write mode
+    uint32_t readTimeout;                                                                   // Declaring read timeout
+    uint32_t writeTimeout;                                                                  // Declaring write timeout
+    UART_Callback readCallback;                                                             // Declaring read completion callback
+    UART_Callback writeCallback;                                                            // Declaring write completion callback
+    UART_ReturnMode readReturnMode;                                                         // Declaring read return mode
+    UART_DataMode readDataMode;                                                             // Declaring read data mode
+    UART_DataMode writeDataMode;                                                            // Declaring write data mode
+    UART_Echo readEcho;                                                                     // Declaring read echo
+    uint32_t baudRate;                                                                      // Declaring baud rate (recorded only)
+    UART_LEN dataLength;                                                                    // Declaring data length
+    UART_STOP stopBits;                                                                     // Declaring stop bits
+    UART_PAR parityType;                                                                    // Declaring parity
+    void *custom;                                                                           // Declaring custom argument
+} UART_Params;                                                                              // Declaring struct name as UART_Params
+
+/* Declaring UART operations */
+void UART_init(void);                                                                       // Declaring UART driver initialization
+void UART_Params_init(UART_Params *params);                                                 // Declaring UART parameter defaults
+UART_Handle UART_open(uint_least8_t index, UART_Params *params);                            // Declaring UART open on a host endpoint
+void UART_close(UART_Handle handle);                                                        // Declaring UART close
+int_fast32_t UART_read(UART_Handle handle, void *buffer, size_t size);                      // Declaring UART read
+int_fast32_t UART_write(UART_Handle handle, const void *buffer, size_t size);               // Declaring UART write
+void UART_readCancel(UART_Handle handle);                                                   // Declaring callback-mode read cancel
+
+#endif /* HOST_UART_H_ */
@@ -0,0 +1,31 @@
+/*
+ * ti/sysbios/BIOS.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host BIOS header */
+#ifndef HOST_BIOS_H_
+#define HOST_BIOS_H_
+
+#include <xdc/std.h>                                                                        // Including XDC base types
+
+/* Declaring BIOS timeouts */
+#define BIOS_WAIT_FOREVER (~(UInt)0)                                                        // Declaring infinite pend timeout
+#define BIOS_NO_WAIT ((UInt)0)                                                              // Declaring polling pend timeout
+
+/* Declaring BIOS types */
+typedef enum {
+    BIOS_ThreadType_Hwi,                                                                    // Declaring interrupt context (host timer and GPIO threads)
+    BIOS_ThreadType_Swi,                                                                    // Declaring software interrupt context (unused on host)
+    BIOS_ThreadType_Task,                                                                   // Declaring task context
+    BIOS_ThreadType_Main                                                                    // Declaring context before BIOS_start()
+} BIOS_ThreadType;                                                                          // Declaring enum name as BIOS_ThreadType
+
+/* Declaring BIOS operations */
+void BIOS_start(void);                                                                      // Declaring scheduler start (never returns)
+void BIOS_exit(Int stat);                                                                   // Declaring scheduler exit
+BIOS_ThreadType BIOS_getThreadType(void);                                                   // Declaring current thread context
+
+#endif /* HOST_BIOS_H_ */
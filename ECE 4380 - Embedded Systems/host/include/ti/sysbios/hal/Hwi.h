@@ -0,0 +1,22 @@
+/*
+ * ti/sysbios/hal/Hwi.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host Hwi header */
+#ifndef HOST_HWI_H_
+#define HOST_HWI_H_
+
+#include <xdc/std.h>                                                                        // Including XDC base types
+
+/* Declaring interrupt operations */
+static inline UInt Hwi_disable(void) {                                                      // Timer callbacks already wait on the core lock held by the caller
+    return 0;                                                                               // Returning restore key
+}
+static inline void Hwi_restore(UInt key) {                                                  // Restoring interrupts (no-op on host)
+    (void)key;                                                                              // Ignoring restore key
+}
+
+#endif /* HOST_HWI_H_ */
@@ -0,0 +1,17 @@
+/*
+ * ti/sysbios/knl/Clock.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host Clock header */
+#ifndef HOST_CLOCK_H_
+#define HOST_CLOCK_H_
+
+#include <xdc/std.h>                                                                        // Including XDC base types
+
+/* Declaring clock operations */
+UInt32 Clock_getTicks(void);                                                                // Declaring 1 ms ticks since start
+
+#endif /* HOST_CLOCK_H_ */
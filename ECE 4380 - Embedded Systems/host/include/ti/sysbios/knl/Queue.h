@@ -0,0 +1,39 @@
+/*
+ * ti/sysbios/knl/Queue.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host Queue header */
+#ifndef HOST_QUEUE_H_
+#define HOST_QUEUE_H_
+
+#include <xdc/std.h>                                                                        // Including XDC base types
+
+/* Declaring queue types (circular list with the queue as sentinel, as on target) */
+typedef struct Queue_Elem {
+    struct Queue_Elem *next;                                                                // Declaring next element pointer
+    struct Queue_Elem *prev;                                                                // Declaring previous element pointer
+} Queue_Elem;                                                                               // Declaring struct name as Queue_Elem
+typedef struct Queue_Object {
+    Queue_Elem elem;                                                                        // Declaring sentinel element
+} Queue_Object;                                                                             // Declaring struct name as Queue_Object
+typedef Queue_Object Queue_Struct;                                                          // Declaring static queue storage type
+typedef Queue_Object* Queue_Handle;                                                         // Declaring queue handle
+typedef struct {
+    Ptr instance;                                                                           // Declaring instance name placeholder
+} Queue_Params;                                                                             // Declaring struct name as Queue_Params
+
+/* Declaring queue operations */
+void Queue_Params_init(Queue_Params *params);                                               // Declaring queue parameter defaults
+Queue_Handle Queue_create(const Queue_Params *params, Error_Block *eb);                     // Declaring queue creation
+void Queue_construct(Queue_Struct *obj, const Queue_Params *params);                        // Declaring static queue construction
+Queue_Handle Queue_handle(Queue_Struct *obj);                                               // Declaring static queue handle
+Bool Queue_empty(Queue_Handle queue);                                                       // Declaring queue empty check
+Ptr Queue_get(Queue_Handle queue);                                                          // Declaring atomic head removal (queue itself when empty)
+void Queue_put(Queue_Handle queue, Queue_Elem *elem);                                       // Declaring atomic tail insertion
+Ptr Queue_head(Queue_Handle queue);                                                         // Declaring head peek (queue itself when empty)
+Ptr Queue_next(Ptr elem);                                                                   // Declaring next element (queue itself after the tail)
+
+#endif /* HOST_QUEUE_H_ */
@@ -0,0 +1,33 @@
+/*
+ * ti/sysbios/knl/Semaphore.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host Semaphore header */
+#ifndef HOST_SEMAPHORE_H_
+#define HOST_SEMAPHORE_H_
+
+#include <xdc/std.h>                                                                        // Including XDC base types
+
+/* Declaring semaphore types */
+typedef enum {
+    Semaphore_Mode_COUNTING,                                                                // Declaring counting semaphore mode
+    Semaphore_Mode_BINARY                                                                   // Declaring binary semaphore mode
+} Semaphore_Mode;                                                                           // Declaring enum name as Semaphore_Mode
+typedef struct Semaphore_Object* Semaphore_Handle;                                          // Declaring semaphore handle
+typedef struct {
+    Semaphore_Mode mode;                                                                    // Declaring semaphore mode
+    Ptr instance;                                                                           // Declaring instance name placeholder
+} Semaphore_Params;                                                                         // Declaring struct name as Semaphore_Params
+
+/* Declaring semaphore operations */
+void Semaphore_Params_init(Semaphore_Params *params);                                       // Declaring semaphore parameter defaults
+Semaphore_Handle Semaphore_create(Int count, const Semaphore_Params *params, Error_Block *eb);
+void Semaphore_delete(Semaphore_Handle *handle);                                            // Declaring semaphore deletion
+Bool Semaphore_pend(Semaphore_Handle sem, UInt32 timeout);                                  // Declaring semaphore pend (timeout in ticks)
+void Semaphore_post(Semaphore_Handle sem);                                                  // Declaring semaphore post
+Int Semaphore_getCount(Semaphore_Handle sem);                                               // Declaring semaphore count
+
+#endif /* HOST_SEMAPHORE_H_ */
@@ -0,0 +1,34 @@
+/*
+ * ti/sysbios/knl/Task.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host Task header */
+#ifndef HOST_TASK_H_
+#define HOST_TASK_H_
+
+#include <xdc/std.h>                                                                        // Including XDC base types
+
+/* Declaring task types */
+typedef void (*Task_FuncPtr)(UArg arg0, UArg arg1);                                         // Declaring task entry function type
+typedef struct Task_Object* Task_Handle;                                                    // Declaring task handle (one pthread per task)
+typedef struct {
+    UArg arg0;                                                                              // Declaring first task argument
+    UArg arg1;                                                                              // Declaring second task argument
+    Int priority;                                                                           // Declaring task priority (recorded, not scheduled)
+    Ptr stack;                                                                              // Declaring task stack (unused on host)
+    size_t stackSize;                                                                       // Declaring task stack size (unused on host)
+    Ptr instance;                                                                           // Declaring instance name placeholder
+} Task_Params;                                                                              // Declaring struct name as Task_Params
+
+/* Declaring task operations */
+void Task_Params_init(Task_Params *params);                                                 // Declaring task parameter defaults
+Task_Handle Task_create(Task_FuncPtr fxn, const Task_Params *params, Error_Block *eb);      // Declaring task creation
+void Task_sleep(UInt32 ticks);                                                              // Declaring task sleep in 1 ms clock ticks
+void Task_yield(void);                                                                      // Declaring task yield
+Task_Handle Task_self(void);                                                                // Declaring current task handle
+Int Task_setPri(Task_Handle handle, Int priority);                                          // Declaring task priority change
+
+#endif /* HOST_TASK_H_ */
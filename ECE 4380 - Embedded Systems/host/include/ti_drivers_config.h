@@ -0,0 +1,44 @@
+/*
+ * ti_drivers_config.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host board configuration (indices match the SysConfig output in Debug/syscfg) */
+#ifndef HOST_TI_DRIVERS_CONFIG_H_
+#define HOST_TI_DRIVERS_CONFIG_H_
+
+#include <stdint.h>                                                                         // Including integer-size C control
+#include <ti/drivers/Board.h>                                                               // Including board initialization
+
+/* Declaring GPIO indices */
+#define CONFIG_GPIO_LED_0 0                                                                 // Declaring LED 1
+#define CONFIG_GPIO_LED_1 1                                                                 // Declaring LED 2
+#define CONFIG_GPIO_LED_2 2                                                                 // Declaring LED 3
+#define CONFIG_GPIO_LED_3 3                                                                 // Declaring LED 4
+#define CONFIG_GPIO_PK5 4                                                                   // Declaring PK5
+#define CONFIG_GPIO_PD4 5                                                                   // Declaring PD4 (audio amp enable)
+#define CONFIG_GPIO_SW1 6                                                                   // Declaring SW1
+#define CONFIG_GPIO_SW2 7                                                                   // Declaring SW2
+#define CONFIG_GPIO_COUNT 8                                                                 // Declaring modeled GPIO count
+#define CONFIG_GPIO_LED_ON (1)                                                              // Declaring LED on level
+#define CONFIG_GPIO_LED_OFF (0)                                                             // Declaring LED off level
+
+/* Declaring SPI indices */
+#define CONFIG_SPI_0 0                                                                      // Declaring DAC SPI
+#define CONFIG_SPI_COUNT 1                                                                  // Declaring modeled SPI count
+
+/* Declaring timer indices */
+#define CONFIG_TIMER_1 0                                                                    // Declaring callback timer
+#define CONFIG_TIMER_0 1                                                                    // Declaring sine timer
+#define TICKER_TIMER_1 2                                                                    // Declaring spare ticker timer
+#define TICKER_TIMER_0 3                                                                    // Declaring ticker timer
+#define CONFIG_TIMER_COUNT 4                                                                // Declaring modeled timer count
+
+/* Declaring UART indices */
+#define CONFIG_UART_0 0                                                                     // Declaring UART0 (terminal)
+#define CONFIG_UART_1 1                                                                     // Declaring UART7 (secondary channel)
+#define CONFIG_UART_COUNT 2                                                                 // Declaring modeled UART count
+
+#endif /* HOST_TI_DRIVERS_CONFIG_H_ */
@@ -0,0 +1,30 @@
+/*
+ * xdc/std.h (host simulation)
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Declaring host XDC type header */
+#ifndef HOST_XDC_STD_H_
+#define HOST_XDC_STD_H_
+
+#include <stdint.h>                                                                         // Including integer-size C control
+#include <stdbool.h>                                                                        // Including boolean operations
+#include <stddef.h>                                                                         // Including size_t and NULL
+
+/* Declaring XDC base constants */
+#define TRUE 1                                                                              // Declaring XDC true
+#define FALSE 0                                                                             // Declaring XDC false
+
+/* Declaring XDC base types */
+typedef uintptr_t UArg;                                                                     // Declaring task argument type wide enough for a pointer
+typedef unsigned int UInt;                                                                  // Declaring unsigned int type
+typedef int Int;                                                                            // Declaring int type
+typedef uint32_t UInt32;                                                                    // Declaring 32bit unsigned type
+typedef bool Bool;                                                                          // Declaring bool type
+typedef char* String;                                                                       // Declaring string type
+typedef void* Ptr;                                                                          // Declaring generic pointer type
+typedef struct Error_Block Error_Block;                                                     // Declaring error block (always passed as NULL)
+
+#endif /* HOST_XDC_STD_H_ */
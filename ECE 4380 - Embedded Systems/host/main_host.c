@@ -0,0 +1,117 @@
+/*
+ * main_host.c
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Driver libraries */
+#define _GNU_SOURCE                                                                         // Enabling POSIX signal extensions
+#include <stdint.h>                                                                         // Including integer-size C control
+#include <stdio.h>                                                                          // Including fprintf() functions
+#include <stdlib.h>                                                                         // Including atexit() functions
+#include <string.h>                                                                         // Including strcmp() functions
+#include <signal.h>                                                                         // Including sigwait() functions
+#include <unistd.h>                                                                         // Including isatty() functions
+#include <termios.h>                                                                        // Including terminal raw mode
+#include <pthread.h>                                                                        // Including POSIX threads
+
+/* RTOS header files */
+#include <ti/sysbios/BIOS.h>                                                                // BIOS API header file controls
+#include <ti/drivers/Board.h>                                                               // Board API header file controls
+#include <ti/sysbios/knl/Task.h>                                                            // Task API header file controls
+#include "ti_drivers_config.h"                                                              // Hardware mapping peripherals
+#include "host.h"                                                                           // Host simulation controls
+
+/* Function declarations */
+extern void *mainThread(void *arg0);                                                        // Declaring shell entry point (uartecho.c)
+
+/* Global variables */
+static struct termios saved_termios;                                                        // Declaring terminal settings to restore
+static bool termios_saved = false;                                                          // Declaring terminal saved flag
+
+/* Terminal operations */
+    // Restore terminal on exit
+static void restore_terminal(void) {
+    if (termios_saved) {                                                                    // For modified terminal
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);                                   // Restoring settings
+    }
+}
+    // Raw terminal (the shell echoes and edits lines itself; Ctrl-C still exits)
+static void raw_terminal(void) {
+    struct termios raw;                                                                     // Declaring raw settings
+    if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &saved_termios) != 0) {            // For piped input
+        return;                                                                             // Leaving input untouched
+    }
+    termios_saved = true;                                                                   // Declaring terminal saved
+    atexit(restore_terminal);                                                               // Restoring on exit
+    raw = saved_termios;                                                                    // Copying current settings
+    cfmakeraw(&raw);                                                                        // Declaring raw mode
+    raw.c_lflag |= ISIG;                                                                    // Keeping Ctrl-C / Ctrl-Z
+    tcsetattr(STDIN_FILENO, TCSANOW, &raw);                                                 // Applying raw mode
+}
+
+/* Task operations */
+    // Switch press thread (SIGUSR1 presses SW1, SIGUSR2 presses SW2)
+static void *switch_thread(void *arg) {
+    sigset_t *signals = arg;                                                                // Declaring awaited signals
+    int signal_number;                                                                      // Declaring received signal
+    for (;;) {                                                                              // Waiting forever
+        if (sigwait(signals, &signal_number) != 0) continue;                                // Waiting for a press
+        if (signal_number == SIGUSR1) hostGpioPress(CONFIG_GPIO_SW1);                       // Pressing SW1
+        if (signal_number == SIGUSR2) hostGpioPress(CONFIG_GPIO_SW2);                       // Pressing SW2
+        if (signal_number == SIGINT || signal_number == SIGTERM) exit(0);                   // Ending session (restores terminal)
+    }
+    return NULL;                                                                            // Unreachable
+}
+    // Shell task
+static void shell_task(UArg arg0, UArg arg1) {
+    mainThread(NULL);                                                                       // Running shell unchanged
+}
+
+/* main */
+int main(int argc, char *argv[]) {
+    static sigset_t signals;                                                                // Declaring routed signals
+    pthread_t switches;                                                                     // Declaring switch thread
+    Task_Params taskParams;                                                                 // Declaring shell task parameters
+    bool uart7_pty = true;                                                                  // Declaring UART7 pty flag
+    int i;                                                                                  // Declaring loop variable
+    for (i = 1; i < argc; i++) {                                                            // Parsing options
+        if (strcmp(argv[i], "-n") == 0) {                                                   // For no UART7 endpoint
+            uart7_pty = false;                                                              // Leaving UART7 as a sink
+        } else if (strcmp(argv[i], "-g") == 0) {                                            // For GPIO trace
+            hostGpioTrace(true);                                                            // Tracing output pins on stderr
+        } else {                                                                            // For unknown option
+            fprintf(stderr, "usage: %s [-n] [-g]\n"
+                            "  -n  leave UART7 unattached (no pty)\n"
+                            "  -g  trace LED/PK5/PD4 changes on stderr\n"
+                            "  kill -USR1/-USR2 <pid> presses SW1/SW2\n", argv[0]);
+            return 2;                                                                       // Returning usage error
+        }
+    }
+    sigemptyset(&signals);                                                                  // Clearing routed signals
+    sigaddset(&signals, SIGUSR1);                                                           // Routing SW1 press
+    sigaddset(&signals, SIGUSR2);                                                           // Routing SW2 press
+    sigaddset(&signals, SIGINT);                                                            // Routing Ctrl-C
+    sigaddset(&signals, SIGTERM);                                                           // Routing termination
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);                                             // Blocking routed signals in every thread
+    pthread_create(&switches, NULL, switch_thread, &signals);                               // Starting switch thread
+    Board_init();                                                                           // Initializing board
+    raw_terminal();                                                                         // Declaring raw terminal
+    if (!hostMapMemory()) {                                                                 // For unavailable SRAM mapping
+        fprintf(stderr, "host: SRAM not mapped at 0x%08lX, -memr will fault\n", HOST_SRAM_BASE);
+    }
+    hostUartAttach(CONFIG_UART_0, STDIN_FILENO, STDOUT_FILENO);                             // Declaring UART0 on the terminal
+    if (uart7_pty) {                                                                        // For UART7 pty
+        const char *path = hostUartOpenPty(CONFIG_UART_1);                                  // Opening UART7 pty
+        fprintf(stderr, "host: UART7 on %s (pid %d)\r\n", path ? path : "(unavailable)", (int)getpid());
+    }
+    Task_Params_init(&taskParams);                                                          // Initializing shell task parameters
+    taskParams.priority = 1;                                                                // Declaring shell priority as in main_tirtos.c
+    if (Task_create(shell_task, &taskParams, NULL) == NULL) {                               // For task creation failure
+        fprintf(stderr, "host: failed to create shell task\n");                             // Printing failure
+        return 1;                                                                           // Returning failure
+    }
+    BIOS_start();                                                                           // Starting scheduler (never returns)
+    return 0;                                                                               // Unreachable
+}
@@ -0,0 +1,259 @@
+/*
+ * pcm_feed.c
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Driver libraries */
+#define _GNU_SOURCE                                                                         // Enabling POSIX clock extensions
+#include <stdint.h>                                                                         // Including integer-size C control
+#include <stdio.h>                                                                          // Including printf() functions
+#include <stdlib.h>                                                                         // Including strtol() functions
+#include <string.h>                                                                         // Including string handling functions
+#include <stdbool.h>                                                                        // Including boolean operations
+#include <math.h>                                                                           // Including mathematical operations
+#include <fcntl.h>                                                                          // Including open() functions
+#include <unistd.h>                                                                         // Including pipe() functions
+#include <time.h>                                                                           // Including clock_nanosleep()
+#include <pthread.h>                                                                        // Including POSIX threads
+
+/* RTOS header files */
+#include <ti/sysbios/BIOS.h>                                                                // BIOS API header file controls
+#include <ti/drivers/Board.h>                                                               // Board API header file controls
+#include <ti/sysbios/knl/Task.h>                                                            // Task API header file controls
+#include <ti/drivers/SPI.h>                                                                 // SPI API header file controls
+#include "ti_drivers_config.h"                                                              // Hardware mapping peripherals
+#include "tony.h"                                                                           // Header variable definitions
+#include "host.h"                                                                           // Host simulation controls
+
+/* Function declarations */
+extern void *mainThread(void *arg0);                                                        // Declaring shell entry point (uartecho.c)
+
+/* Declaring macro variables */
+#define FEED_FRAME_SAMPLES 100                                                              // Defining samples per PCM frame
+#define FEED_BAUD 115200                                                                    // Defining UART7 baud (uartecho.c)
+#define FEED_SYNTH_RATE 4000                                                                // Defining built-in signal rate
+#define FEED_SYNTH_SECONDS 2                                                                // Defining built-in signal length
+#define FEED_MATCH_RUN 16                                                                   // Defining samples that align the capture
+#define FEED_TAIL 8                                                                         // Defining samples left buffered when the capture stops (before the final underrun)
+#define FEED_SETTLE_MS 300                                                                  // Defining shell start-up time before commands
+
+/* Global variables */
+static int16_t *feed_samples;                                                               // Declaring source samples
+static size_t feed_count;                                                                   // Declaring source sample count
+static uint32_t feed_rate = FEED_SYNTH_RATE;                                                // Declaring source sample rate
+static uint32_t feed_depth = PCM_DEPTH_DEFAULT;                                             // Declaring jitter buffer depth
+static uint32_t feed_jitter_ms = 20;                                                        // Declaring worst frame delay
+static int uart0_fd, uart7_fd;                                                              // Declaring shell input pipes
+
+/* Source operations */
+    // Little-endian field reads
+static uint32_t le32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static uint16_t le16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+    // RIFF WAVE load (16-bit PCM, first channel)
+static bool load_wav(const char *path) {
+    FILE *file = fopen(path, "rb");                                                         // Declaring WAV file
+    uint8_t header[12], chunk[8], format[16];                                               // Declaring RIFF headers
+    uint16_t channels = 0, bits = 0;                                                        // Declaring sample layout
+    if (file == NULL || fread(header, 1, 12, file) != 12 ||
+        memcmp(header, "RIFF", 4) != 0 || memcmp(header + 8, "WAVE", 4) != 0) {
+        fprintf(stderr, "pcm_feed: %s is not a RIFF WAVE file\n", path);
+        if (file) fclose(file);
+        return false;                                                                       // Returning failure
+    }
+    while (fread(chunk, 1, 8, file) == 8) {                                                 // For each chunk
+        uint32_t size = le32(chunk + 4);                                                    // Declaring chunk size
+        if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16 && fread(format, 1, 16, file) == 16) {
+            if (le16(format) != 1) break;                                                   // Accepting integer PCM only
+            channels = le16(format + 2);
+            feed_rate = le32(format + 4);
+            bits = le16(format + 14);
+            fseek(file, (long)(size - 16 + (size & 1)), SEEK_CUR);                          // Skipping extension bytes
+        } else if (memcmp(chunk, "data", 4) == 0 && channels > 0 && bits == 16) {
+            size_t frames = size / (2u * channels), i;                                      // Declaring sample frames
+            int16_t *data = malloc(size);                                                   // Declaring interleaved samples
+            feed_samples = malloc(frames * sizeof(int16_t));
+            if (data == NULL || feed_samples == NULL) break;
+            frames = fread(data, 2u * channels, frames, file);                              // Reading what the file holds
+            for (i = 0; i < frames; i++) feed_samples[i] = data[i * channels];              // Keeping the first channel
+            feed_count = frames;
+            free(data);
+            fclose(file);
+            return feed_count > 0;                                                          // Returning success
+        } else {
+            fseek(file, (long)(size + (size & 1)), SEEK_CUR);                               // Skipping chunk
+        }
+    }
+    fprintf(stderr, "pcm_feed: %s has no 16-bit PCM data\n", path);
+    fclose(file);
+    return false;                                                                           // Returning failure
+}
+    // Built-in signal (two tones with full-scale impulses every quarter second)
+static void synthesize(void) {
+    size_t i;                                                                               // Declaring loop variable
+    feed_rate = FEED_SYNTH_RATE;
+    feed_count = FEED_SYNTH_RATE * FEED_SYNTH_SECONDS;
+    feed_samples = malloc(feed_count * sizeof(int16_t));
+    for (i = 0; i < feed_count; i++) {
+        double t = (double)i / FEED_SYNTH_RATE;                                             // Declaring sample time
+        double v = 0.45 * sin(2.0 * M_PI * 440.0 * t) + 0.45 * sin(2.0 * M_PI * 1200.0 * t);
+        if (i % (FEED_SYNTH_RATE / 4) == 0) v = (i % (FEED_SYNTH_RATE / 2) == 0) ? 1.0 : -1.0;
+        feed_samples[i] = (int16_t)lround(v * 32767.0);
+    }
+}
+
+/* Link operations */
+    // Write all bytes to a shell pipe
+static void feed_write(int fd, const void *data, size_t length) {
+    const uint8_t *p = data;                                                                // Declaring write position
+    while (length > 0) {
+        ssize_t n = write(fd, p, length);                                                   // Writing to the UART model
+        if (n <= 0) return;                                                                 // Returning on a closed pipe
+        p += n;
+        length -= (size_t)n;
+    }
+}
+    // One PCM frame, SLIP encoded as uartecho.c encodes command frames
+static void feed_frame(uint8_t sequence, const int16_t *samples, size_t count) {
+    uint8_t frame[UART_FRAME_MAX], out[UART_FRAME_ENCODED_MAX];                             // Declaring decoded and encoded frame
+    size_t size = 2 + 2 * count + 2, i, n = 0;                                              // Declaring frame length and output position
+    frame[0] = UART_FRAME_PCM;                                                              // Declaring frame type
+    frame[1] = sequence;                                                                    // Declaring sequence number
+    for (i = 0; i < count; i++) {                                                           // Packing samples little-endian
+        frame[2 + 2 * i] = (uint8_t)samples[i];
+        frame[3 + 2 * i] = (uint8_t)((uint16_t)samples[i] >> 8);
+    }
+    uint16_t crc = crc16_ccitt(frame, size - 2);                                            // Declaring frame CRC
+    frame[size - 2] = (uint8_t)(crc >> 8);                                                  // Appending CRC (big-endian)
+    frame[size - 1] = (uint8_t)crc;
+    out[n++] = UART_FRAME_END;
+    for (i = 0; i < size; i++) {                                                            // For each frame byte
+        uint8_t b = frame[i];                                                               // Declaring frame byte
+        if (b == UART_FRAME_END || b == UART_FRAME_ESC || b == 0) {                         // For bytes the receiver reserves
+            out[n++] = UART_FRAME_ESC;
+            b = (b == UART_FRAME_END) ? UART_FRAME_ESC_END :
+                (b == UART_FRAME_ESC) ? UART_FRAME_ESC_ESC : UART_FRAME_ESC_NUL;
+        }
+        out[n++] = b;
+    }
+    out[n++] = UART_FRAME_END;
+    feed_write(uart7_fd, out, n);                                                           // Queuing bytes at the UART7 baud
+}
+    // Sleep until an absolute monotonic time
+static void sleep_until(uint64_t ns) {
+    struct timespec at = { (time_t)(ns / 1000000000ull), (long)(ns % 1000000000ull) };      // Declaring wake time
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &at, NULL) != 0) { }
+}
+    // Jitter buffer snapshot
+static void pcm_snapshot(PcmBuffer *copy) {
+    hostCpuLock();                                                                          // Holding off the UART7 task and sine timer
+    memcpy(copy, (const void *)&pcm_buffer, sizeof(*copy));
+    hostCpuUnlock();
+}
+
+/* Feed thread */
+static void *feed_thread(void *arg) {
+    size_t capacity = feed_count + 4 * PCM_RING_SIZE;                                       // Declaring capture length
+    uint16_t *capture = malloc(capacity * sizeof(uint16_t));                                // Declaring DAC words seen
+    uint64_t frame_ns = (uint64_t)FEED_FRAME_SAMPLES * 1000000000ull / feed_rate;           // Declaring frame period
+    uint64_t start, deadline;                                                               // Declaring schedule
+    char commands[96];                                                                      // Declaring shell commands
+    size_t sent, captured, i, j, matched = 0, skipped = 0, wrong = 0;                       // Declaring comparison counts
+    uint8_t sequence = 0;                                                                   // Declaring frame sequence
+    PcmBuffer stats;                                                                        // Declaring jitter buffer snapshot
+    srand(4380);                                                                            // Declaring repeatable jitter
+    usleep(FEED_SETTLE_MS * 1000);                                                          // Waiting for the shell prompt
+    snprintf(commands, sizeof(commands), "-sine rate %u\r-pcm start %u\r", feed_rate, feed_depth);
+    feed_write(uart0_fd, commands, strlen(commands));                                       // Starting playback
+    usleep(100 * 1000);
+    hostDacCapture(capture, capacity);                                                      // Capturing from here on
+    start = hostNowNs();
+    for (sent = 0; sent < feed_count; sent += FEED_FRAME_SAMPLES, sequence++) {             // For each frame
+        size_t count = feed_count - sent;                                                   // Declaring frame samples
+        if (count > FEED_FRAME_SAMPLES) count = FEED_FRAME_SAMPLES;
+        uint64_t jitter = feed_jitter_ms ? (uint64_t)(rand() % (feed_jitter_ms * 1000)) * 1000 : 0;
+        sleep_until(start + (sent / FEED_FRAME_SAMPLES) * frame_ns + jitter);               // Sending late by up to the jitter
+        feed_frame(sequence, feed_samples + sent, count);
+    }
+    deadline = hostNowNs() + 5000000000ull;                                                 // Declaring drain limit
+    do {                                                                                    // Waiting for the buffer to play out
+        usleep(1000);
+        pcm_snapshot(&stats);
+    } while ((stats.samples < feed_count || stats.write - stats.read > FEED_TAIL) && hostNowNs() < deadline);
+    captured = hostDacCaptured();                                                           // Declaring DAC words written
+    hostDacCapture(NULL, 0);                                                                // Stopping capture (keeps the words)
+    feed_write(uart0_fd, "-pcm stop\r", 10);
+    for (i = 0; i + FEED_MATCH_RUN <= captured; i++) {                                      // Aligning capture to the source start
+        for (j = 0; j < FEED_MATCH_RUN; j++) {
+            if (capture[i + j] != (uint16_t)(WAVE_OFFSET_MID + (feed_samples[j] >> 2))) break;
+        }
+        if (j == FEED_MATCH_RUN) break;
+    }
+    for (j = 0; i < captured && j < feed_count; ) {                                         // Walking capture against source
+        uint16_t want = (uint16_t)(WAVE_OFFSET_MID + (feed_samples[j] >> 2));               // Declaring expected DAC code
+        if (capture[i] == want) {
+            matched++; i++; j++;
+        } else if (j + 1 < feed_count && capture[i] == (uint16_t)(WAVE_OFFSET_MID + (feed_samples[j + 1] >> 2))) {
+            skipped++; j++;                                                                 // Adaptive drop
+        } else {
+            wrong++; i++; j++;
+        }
+    }
+    printf("pcm_feed: %zu samples at %u Hz, %u-sample frames, depth %u (%u ms), jitter up to %u ms\n",
+           feed_count, feed_rate, FEED_FRAME_SAMPLES, feed_depth, feed_depth * 1000 / feed_rate, feed_jitter_ms);
+    printf("  frames %lu (lost %lu, late %lu), samples %lu, high-water %lu of %d\n",
+           (unsigned long)stats.frames, (unsigned long)stats.lost, (unsigned long)stats.late, (unsigned long)stats.samples,
+           (unsigned long)stats.high, PCM_RING_SIZE);
+    printf("  underruns %lu, overruns %lu, adaptive drops %lu, repeats %lu\n",
+           (unsigned long)stats.underruns, (unsigned long)stats.overruns,
+           (unsigned long)stats.dropped, (unsigned long)stats.repeated);
+    printf("  DAC words %zu: %zu exact, %zu skipped, %zu wrong, %zu unplayed\n",
+           captured, matched, skipped, wrong, feed_count - matched - skipped - wrong);
+    usleep(50 * 1000);
+    exit((matched + skipped + FEED_TAIL >= feed_count && wrong == 0 && stats.underruns == 0 &&
+          stats.lost == 0 && stats.late == 0 && stats.overruns == 0) ? 0 : 1);
+    return arg;                                                                             // Unreachable
+}
+    // Shell task
+static void shell_task(UArg arg0, UArg arg1) {
+    mainThread(NULL);                                                                       // Running shell unchanged
+}
+
+/* main */
+int main(int argc, char *argv[]) {
+    int uart0[2], uart7[2], sink, n;                                                        // Declaring pipes, sink and loop variable
+    bool verbose = false;                                                                   // Declaring shell output shown
+    const char *path = NULL;                                                                // Declaring WAV path
+    pthread_t feeder;                                                                       // Declaring feed thread
+    Task_Params taskParams;                                                                 // Declaring shell task parameters
+    for (n = 1; n < argc; n++) {                                                            // Parsing options
+        if (strcmp(argv[n], "-d") == 0 && n + 1 < argc) feed_depth = (uint32_t)strtoul(argv[++n], NULL, 0);
+        else if (strcmp(argv[n], "-j") == 0 && n + 1 < argc) feed_jitter_ms = (uint32_t)strtoul(argv[++n], NULL, 0);
+        else if (strcmp(argv[n], "-v") == 0) verbose = true;
+        else if (argv[n][0] != '-' && path == NULL) path = argv[n];
+        else {
+            fprintf(stderr, "usage: %s [-d depth] [-j jitter_ms] [-v] [file.wav]\n"
+                            "  streams 16-bit PCM over UART7 to -pcm and checks the DAC words\n"
+                            "  (no file: 2 s of 440 + 1200 Hz at %d Hz)\n", argv[0], FEED_SYNTH_RATE);
+            return 2;                                                                       // Returning usage error
+        }
+    }
+    if (path != NULL ? !load_wav(path) : (synthesize(), false)) return 1;
+    if ((uint64_t)feed_rate * 2 * 11 / 10 > FEED_BAUD / 10) {                               // For more bytes than the link carries
+        fprintf(stderr, "pcm_feed: %u Hz needs more than %d baud; expect underruns\n", feed_rate, FEED_BAUD);
+    }
+    if (pipe(uart0) != 0 || pipe(uart7) != 0) return 1;
+    sink = open("/dev/null", O_WRONLY);                                                     // Declaring discarded output
+    uart0_fd = uart0[1];
+    uart7_fd = uart7[1];
+    Board_init();                                                                           // Initializing board
+    hostUartAttach(CONFIG_UART_0, uart0[0], verbose ? STDOUT_FILENO : sink);                // Declaring UART0 on a pipe
+    hostUartAttach(CONFIG_UART_1, uart7[0], sink);                                          // Declaring UART7 on a pipe
+    Task_Params_init(&taskParams);                                                          // Initializing shell task parameters
+    taskParams.priority = 1;                                                                // Declaring shell priority as in main_tirtos.c
+    if (Task_create(shell_task, &taskParams, NULL) == NULL) return 1;
+    pthread_create(&feeder, NULL, feed_thread, NULL);                                       // Starting feed thread
+    BIOS_start();                                                                           // Starting scheduler (never returns)
+    return 0;                                                                               // Unreachable
+}
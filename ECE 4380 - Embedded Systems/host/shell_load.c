@@ -0,0 +1,242 @@
+/*
+ * shell_load.c
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Driver libraries */
+#define _GNU_SOURCE                                                                         // Enabling POSIX clock extensions
+#include <stdint.h>                                                                         // Including integer-size C control
+#include <stdio.h>                                                                          // Including printf() functions
+#include <stdlib.h>                                                                         // Including strtoul() functions
+#include <string.h>                                                                         // Including string handling functions
+#include <stdbool.h>                                                                        // Including boolean operations
+
+/* Driver-Header files */
+#include <ti/drivers/GPIO.h>                                                                // GPIO API header file controls
+#include <ti/drivers/UART.h>                                                                // UART API header file controls
+#include <ti/drivers/Timer.h>                                                               // Timer API header file controls
+#include <ti/drivers/SPI.h>                                                                 // SPI API header file controls
+#include "ti_drivers_config.h"                                                              // Hardware mapping peripherals
+#include "tony.h"                                                                           // Header variable definitions
+#include "host.h"                                                                           // Host simulation controls
+
+/* Declaring macro variables */
+#define LOAD_MAX_COMMANDS 256                                                               // Defining max distinct commands in a mix
+#define LOAD_DEFAULT_COUNT 200000                                                           // Defining default measured commands
+#define LOAD_WARMUP_COUNT 2000                                                              // Defining unmeasured warm-up commands
+
+/* Declaring structures */
+typedef struct {
+    char command[BUFFER_SIZE];                                                              // Declaring command text
+    CompiledCommand compiled;                                                               // Declaring command compiled once (-c)
+    uint32_t *samples;                                                                      // Declaring latency samples in nanoseconds
+    size_t count;                                                                           // Declaring sample count
+    size_t capacity;                                                                        // Declaring sample capacity
+    uint64_t bytes;                                                                         // Declaring UART0 bytes written by this command
+} LoadCommand;                                                                              // Declaring struct name as LoadCommand
+
+/* Global variables */
+static LoadCommand load_mix[LOAD_MAX_COMMANDS];                                             // Declaring command mix
+static int load_mix_size = 0;                                                               // Declaring command mix size
+static const char *load_default_mix[] = {                                                   // Declaring default mix (no timers or DAC started)
+    "-help", "-help gpio", "-about", "-print hello world", "-error", "-gpio", "-gpio 0 t",
+    "-gpio 1 w 1", "-gpio 6 r", "-reg ADD R1 R1 #1", "-reg MOV R2 #7", "-reg MUL R3 R1 R2",
+    "-reg", "-script 5 -gpio 2 t", "-script 5", "-script 5 x", "-script", "-rem note",
+    "-if R1 > #5 ? -print big : -print small", "-callback", "-ticker", "-uart hello",
+    "-sine", "-bogus", NULL
+};
+
+/* Mix operations */
+    // Add a command to the mix
+static void add_command(const char *command) {
+    if (load_mix_size >= LOAD_MAX_COMMANDS || strlen(command) >= MAX_CMD_LENGTH) {          // For full mix or oversized command
+        fprintf(stderr, "shell_load: skipping '%s'\n", command);                            // Printing skipped command
+        return;                                                                             // Return from function
+    }
+    snprintf(load_mix[load_mix_size].command, BUFFER_SIZE, "%s", command);                  // Copying command
+    load_mix_size++;                                                                        // Incrementing mix size
+}
+    // Load a mix file (one command per line, '#' comments)
+static bool load_file(const char *path) {
+    char line[BUFFER_SIZE * 2];                                                             // Declaring line buffer
+    FILE *file = fopen(path, "r");                                                          // Opening mix file
+    if (file == NULL) {                                                                     // For missing file
+        perror(path);                                                                       // Printing open failure
+        return false;                                                                       // Returning failure
+    }
+    while (fgets(line, sizeof(line), file) != NULL) {                                       // Reading each line
+        line[strcspn(line, "\r\n")] = '\0';                                                 // Trimming newline
+        if (line[0] != '\0' && line[0] != '#') {                                            // For command lines
+            add_command(line);                                                              // Adding command
+        }
+    }
+    fclose(file);                                                                           // Closing mix file
+    return true;                                                                            // Returning success
+}
+    // Record a sample
+static void add_sample(LoadCommand *entry, uint32_t ns) {
+    if (entry->count == entry->capacity) {                                                  // For full sample array
+        entry->capacity = entry->capacity ? entry->capacity * 2 : 1024;                     // Doubling capacity
+        entry->samples = realloc(entry->samples, entry->capacity * sizeof(uint32_t));       // Growing sample array
+        if (entry->samples == NULL) {                                                       // For allocation failure
+            fprintf(stderr, "shell_load: out of memory\n");                                 // Printing failure
+            exit(1);                                                                        // Exiting
+        }
+    }
+    entry->samples[entry->count++] = ns;                                                    // Storing sample
+}
+
+/* Statistics operations */
+    // Sample comparison
+static int compare_samples(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;                            // Declaring compared samples
+    return (x > y) - (x < y);                                                               // Returning ordering
+}
+    // Percentile of sorted samples
+static double percentile_us(const uint32_t *sorted, size_t count, double fraction) {
+    size_t rank = (size_t)(fraction * (double)(count - 1) + 0.5);                           // Declaring nearest rank
+    return sorted[rank] / 1000.0;                                                           // Returning microseconds
+}
+    // Print one statistics row
+static void print_row(const char *name, uint32_t *samples, size_t count, uint64_t bytes) {
+    size_t i;                                                                               // Declaring loop variable
+    uint64_t total = 0;                                                                     // Declaring latency sum
+    if (count == 0) {                                                                       // For unexecuted command
+        return;                                                                             // Return from function
+    }
+    qsort(samples, count, sizeof(uint32_t), compare_samples);                               // Sorting samples
+    for (i = 0; i < count; i++) total += samples[i];                                        // Summing samples
+    printf("%-42.42s %9zu %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.1f\n", name, count,
+           total / 1000.0 / count, percentile_us(samples, count, 0.50), percentile_us(samples, count, 0.90),
+           percentile_us(samples, count, 0.99), percentile_us(samples, count, 0.999),
+           samples[count - 1] / 1000.0, (double)bytes / count);
+}
+
+/* Shell operations */
+    // Shell initialization (mainThread without the UART0 read loop)
+static ShellSession *init_shell(void) {
+    UART_Handle uart;                                                                       // Declaring UART0 handle
+    UART_Params uartParams;                                                                 // Declaring UART parameters
+    SPI_Params spiParams;                                                                   // Declaring SPI parameters
+    GPIO_init();                                                                            // Initializing GPIO driver
+    UART_init();                                                                            // Initializing UART driver
+    Timer_init();                                                                           // Initializing Timer(s) driver
+    SPI_init();                                                                             // Initializing SPI driver
+    hostCpuLock();                                                                          // Running initialization as the main task
+    init_ticker_timer();                                                                    // Initializing Ticker function
+    init_registers();                                                                       // Initializing registers function
+    init_script_system();                                                                   // Initializing script function
+    init_commands();                                                                        // Initializing command registry
+    GPIO_setConfig(GPIO_LED_0, GPIO_CFG_OUT_STD | GPIO_CFG_OUT_LOW);                        // Declaring GPIO LED 1
+    GPIO_setConfig(GPIO_LED_1, GPIO_CFG_OUT_STD | GPIO_CFG_OUT_LOW);                        // Declaring GPIO LED 2
+    GPIO_setConfig(GPIO_LED_2, GPIO_CFG_OUT_STD | GPIO_CFG_OUT_LOW);                        // Declaring GPIO LED 3
+    GPIO_setConfig(GPIO_LED_3, GPIO_CFG_OUT_STD | GPIO_CFG_OUT_LOW);                        // Declaring GPIO LED 4
+    GPIO_setConfig(GPIO_PK5, GPIO_CFG_OUT_STD | GPIO_CFG_OUT_LOW);                          // Declaring GPIO PK5
+    GPIO_setConfig(GPIO_PD4, GPIO_CFG_OUT_STD | GPIO_CFG_OUT_HIGH);                         // Declaring GPIO PD4
+    GPIO_setConfig(GPIO_SWITCH_1, GPIO_CFG_IN_PU | GPIO_CFG_IN_INT_FALLING);                // Declaring Switch 1 (Falling)
+    GPIO_setConfig(GPIO_SWITCH_2, GPIO_CFG_IN_PU | GPIO_CFG_IN_INT_FALLING);                // Declaring Switch 2 (Falling)
+    UART_Params_init(&uartParams);                                                          // Initializing UART parameters
+    uartParams.writeDataMode = UART_DATA_BINARY;                                            // Setting binary writes
+    uartParams.readDataMode = UART_DATA_BINARY;                                             // Setting binary reads
+    uartParams.readReturnMode = UART_RETURN_FULL;                                           // Setting full reads
+    uart = UART_open(CONFIG_UART_0, &uartParams);                                           // Opening UART0 as a byte-counting sink
+    uart7 = UART_open(CONFIG_UART_1, &uartParams);                                          // Opening UART7 as a byte-counting sink
+    SPI_Params_init(&spiParams);                                                            // Initializing SPI parameters
+    spiParams.frameFormat = SPI_POL1_PHA1;                                                  // Mode 3 for DAC8311
+    spiParams.dataSize = 16;                                                                // 16-bit transfers
+    spiHandle = SPI_open(CONFIG_SPI_0, &spiParams);                                         // Opening DAC SPI
+    hostCpuUnlock();                                                                        // Releasing core
+    hostStart();                                                                            // Starting script task
+    shell_sessions[SESSION_UART0].uart = uart;                                              // Writing console output to UART0
+    return &shell_sessions[SESSION_UART0];                                                  // Returning console session
+}
+
+/* main */
+int main(int argc, char *argv[]) {
+    size_t target = LOAD_DEFAULT_COUNT;                                                     // Declaring measured command count
+    double seconds = 0.0;                                                                   // Declaring measured duration (0 uses count)
+    const char *mix_path = NULL;                                                            // Declaring mix file
+    bool compiled = false;                                                                  // Declaring compiled execution (as tickers, callbacks and scripts run)
+    size_t i, executed = 0;                                                                 // Declaring loop and executed counters
+    int opt;                                                                                // Declaring option index
+    for (opt = 1; opt < argc; opt++) {                                                      // Parsing options
+        if (strcmp(argv[opt], "-n") == 0 && opt + 1 < argc) {                               // For command count
+            target = strtoul(argv[++opt], NULL, 10);                                        // Declaring command count
+        } else if (strcmp(argv[opt], "-t") == 0 && opt + 1 < argc) {                        // For duration
+            seconds = strtod(argv[++opt], NULL);                                            // Declaring duration
+        } else if (strcmp(argv[opt], "-f") == 0 && opt + 1 < argc) {                        // For mix file
+            mix_path = argv[++opt];                                                         // Declaring mix file
+        } else if (strcmp(argv[opt], "-c") == 0) {                                          // For compiled execution
+            compiled = true;                                                                // Declaring compiled execution
+        } else {                                                                            // For unknown option
+            fprintf(stderr, "usage: %s [-n commands] [-t seconds] [-f mixfile] [-c]\n", argv[0]);
+            return 2;                                                                       // Returning usage error
+        }
+    }
+    bool mapped = hostMapMemory();                                                          // Mapping SRAM for -memr
+    if (mix_path != NULL) {                                                                 // For mix file
+        if (!load_file(mix_path)) return 1;                                                 // Loading mix file
+    } else {                                                                                // For default mix
+        for (i = 0; load_default_mix[i] != NULL; i++) add_command(load_default_mix[i]);     // Adding default commands
+        if (mapped) add_command("-memr 20000000");                                          // Adding SRAM read when mapped
+    }
+    if (load_mix_size == 0) {                                                               // For empty mix
+        fprintf(stderr, "shell_load: no commands\n");                                       // Printing failure
+        return 1;                                                                           // Returning failure
+    }
+    ShellSession *session = init_shell();                                                   // Initializing shell
+    for (opt = 0; opt < load_mix_size; opt++) {                                             // Compiling every command once
+        compile_command(load_mix[opt].command, &load_mix[opt].compiled);                    // As ticker/callback/script registration does
+    }
+    char buffer[BUFFER_SIZE];                                                               // Declaring per-command input buffer (commands edit their arguments)
+    HostUartStats before, after;                                                            // Declaring UART0 traffic samples
+    uint64_t busy = 0, start, deadline;                                                     // Declaring time accumulators
+    for (i = 0; i < LOAD_WARMUP_COUNT; i++) {                                               // Warming caches and the script task
+        LoadCommand *entry = &load_mix[i % load_mix_size];                                  // Declaring next command
+        memcpy(buffer, entry->command, BUFFER_SIZE);                                        // Copying command
+        hostCpuLock();                                                                      // Taking core as the main task
+        if (compiled) execute_command(session, &entry->compiled, buffer);                   // Executing compiled command
+        else valid_cmd(session, buffer);                                                    // Executing command
+        hostCpuUnlock();                                                                    // Releasing core between commands
+    }
+    start = hostNowNs();                                                                    // Reading start time
+    deadline = start + (uint64_t)(seconds * 1e9);                                           // Declaring end time
+    for (i = 0; seconds > 0.0 ? hostNowNs() < deadline : executed < target; i++) {          // Measuring until count or time is reached
+        LoadCommand *entry = &load_mix[i % load_mix_size];                                  // Declaring next command
+        memcpy(buffer, entry->command, BUFFER_SIZE);                                        // Copying command
+        hostCpuLock();                                                                      // Taking core as the main task
+        hostUartStatsGet(CONFIG_UART_0, &before);                                           // Sampling UART0 traffic
+        uint64_t t0 = hostNowNs();                                                          // Reading command start
+        if (compiled) execute_command(session, &entry->compiled, buffer);                   // Executing compiled command
+        else valid_cmd(session, buffer);                                                    // Executing command
+        uint64_t t1 = hostNowNs();                                                          // Reading command end
+        hostUartStatsGet(CONFIG_UART_0, &after);                                            // Sampling UART0 traffic
+        hostCpuUnlock();                                                                    // Releasing core between commands
+        add_sample(entry, (uint32_t)(t1 - t0 > UINT32_MAX ? UINT32_MAX : t1 - t0));         // Recording latency
+        entry->bytes += after.bytes_written - before.bytes_written;                         // Recording output size
+        busy += t1 - t0;                                                                    // Accumulating core time
+        executed++;                                                                         // Counting command
+    }
+    double wall = (hostNowNs() - start) / 1e9;                                              // Declaring measured wall time
+
+    /* Report */
+    uint32_t *all = malloc((executed ? executed : 1) * sizeof(uint32_t));                   // Declaring merged samples
+    uint64_t all_bytes = 0;                                                                 // Declaring merged output size
+    size_t merged = 0;                                                                      // Declaring merged count
+    printf("%-42s %9s %9s %9s %9s %9s %9s %9s %9s\n", "command", "count", "mean(us)", "p50(us)", "p90(us)",
+           "p99(us)", "p99.9(us)", "max(us)", "bytes");
+    for (opt = 0; opt < load_mix_size; opt++) {                                             // For each command in the mix
+        memcpy(all + merged, load_mix[opt].samples, load_mix[opt].count * sizeof(uint32_t)); // Merging samples
+        merged += load_mix[opt].count;                                                      // Advancing merged count
+        all_bytes += load_mix[opt].bytes;                                                   // Merging output size
+        print_row(load_mix[opt].command, load_mix[opt].samples, load_mix[opt].count, load_mix[opt].bytes);
+    }
+    print_row("(all)", all, merged, all_bytes);                                             // Printing overall row
+    printf("\n%zu commands in %.3f s: %.0f cmds/s wall, %.0f cmds/s in %s\n", executed, wall,
+           executed / wall, busy ? executed / (busy / 1e9) : 0.0, compiled ? "execute_command" : "valid_cmd");
+    printf("ticker timer overruns: %llu\n", (unsigned long long)hostTimerOverruns(TICKER_TIMER)); // Printing timer health
+    free(all);                                                                              // Freeing merged samples
+    return 0;                                                                               // Returning success
+}
@@ -0,0 +1,291 @@
+/*
+ * sine_bench.c
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Driver libraries */
+#define _GNU_SOURCE                                                                         // Enabling POSIX clock extensions
+#include <stdint.h>                                                                         // Including integer-size C control
+#include <stdio.h>                                                                          // Including printf() functions
+#include <stdlib.h>                                                                         // Including strtod() functions
+#include <string.h>                                                                         // Including string handling functions
+#include <stdbool.h>                                                                        // Including boolean operations
+#include <math.h>                                                                           // Including mathematical operations
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>                                                                      // Including __rdtsc() cycle counter
+#endif
+
+/* Driver-Header files */
+#include <ti/drivers/Timer.h>                                                               // Timer API header file controls
+#include "tony.h"                                                                           // Header variable definitions
+#include "waves.h"                                                                          // Waveform table header definitions
+#include "host.h"                                                                           // Host simulation controls
+
+/* Declaring macro variables */
+#define BENCH_SAMPLE_RATE 8000                                                              // Defining -sine sample rate (125 us timer)
+#define BENCH_POINTS 4096                                                                   // Defining spectrum length
+#define BENCH_TIMED_SAMPLES 20000000                                                        // Defining samples per timing run
+#define BENCH_MAINLOBE 4                                                                    // Defining Blackman-Harris mainlobe half-width (bins)
+#define BENCH_PATHS 3                                                                       // Defining compared sample paths
+#define BENCH_SWITCH_SAMPLES 4000                                                           // Defining samples either side of a waveform switch
+#define BENCH_MIX_SAMPLES 2000000                                                           // Defining samples per mixer timing run
+#define LEGACY_LUT_SIZE 256                                                                 // Defining legacy sine.h table size
+#define BENCH_MIN_SFDR 80.0                                                                 // Defining least SFDR for DDS linear (dB)
+#define BENCH_MIN_SINAD 75.0                                                                // Defining least SINAD for DDS linear (dB)
+#define BENCH_MAX_MIX_ERROR 4                                                               // Defining largest mixer error against the exact mix (codes)
+
+/* Legacy path (double accumulator, as sine_timer_callback computed it before the DDS) */
+static uint16_t legacy_lut[LEGACY_LUT_SIZE + 1];                                            // Declaring legacy 14-bit sine table
+static double legacy_accumulator = 0;                                                       // Declaring double phase accumulator
+static double legacy_increment = 0;                                                         // Declaring double phase increment
+    // Legacy table (reproduces the removed sine.h entry for entry)
+static void legacy_build(void) {
+    int i;                                                                                  // Declaring loop variable
+    for (i = 0; i <= LEGACY_LUT_SIZE; i++) {
+        double value = floor(8192 + 8192 * sin(2.0 * M_PI * i / LEGACY_LUT_SIZE) + 0.5);
+        legacy_lut[i] = (uint16_t)(value > 16383 ? 16383 : value);
+    }
+}
+    // Set frequency (whole hertz only)
+static void legacy_set_frequency(uint32_t freq) {
+    legacy_accumulator = 0;
+    legacy_increment = (freq * LEGACY_LUT_SIZE * 125) / 1000000.0;                          // Formula based on the timer period (125 microseconds)
+}
+    // Next sample
+static uint16_t legacy_sample(void) {
+    uint32_t table_index = (uint32_t)legacy_accumulator % LEGACY_LUT_SIZE;                  // Calculate table index
+    uint16_t dac_word = legacy_lut[table_index] & 0x3FFF;                                   // Get value directly from lookup table
+    legacy_accumulator += legacy_increment;                                                 // Phase accumulator for next sample
+    if (legacy_accumulator >= LEGACY_LUT_SIZE)                                              // If LUT greater or equal to
+        legacy_accumulator -= LEGACY_LUT_SIZE;                                              // Decrement from LUT size
+    return dac_word;
+}
+
+/* Compared paths */
+typedef struct {
+    const char *name;                                                                       // Declaring path name
+    int mode;                                                                               // Declaring path (0 legacy, 1 DDS nearest, 2 DDS linear)
+} BenchPath;                                                                                // Declaring struct name as BenchPath
+static const BenchPath bench_paths[BENCH_PATHS] = {
+    { "legacy double", 0 }, { "DDS nearest", 1 }, { "DDS linear", 2 }
+};
+    // Start a path at a frequency
+static void path_start(const BenchPath *path, uint32_t millihertz) {
+    if (path->mode == 0) {                                                                  // For legacy path
+        legacy_set_frequency(millihertz / SINE_MILLIHERTZ);                                 // Legacy path takes whole hertz
+        return;
+    }
+    set_sine_interpolation(path->mode == 2);                                                // Selecting lookup
+    set_sine_frequency(millihertz);                                                         // Declaring DDS phase step
+}
+    // Next sample of a path
+static inline uint16_t path_sample(const BenchPath *path) {
+    return (path->mode == 0) ? legacy_sample() : sine_sample();
+}
+
+/* Spectrum operations */
+    // Blackman-Harris windowed power spectrum (direct DFT, bins 0..N/2)
+static void power_spectrum(const uint16_t *samples, double *power) {
+    static double windowed[BENCH_POINTS], cosines[BENCH_POINTS], sines[BENCH_POINTS];       // Declaring window output and twiddles
+    double mean = 0;                                                                        // Declaring DC level
+    int n, k;                                                                               // Declaring loop variables
+    for (n = 0; n < BENCH_POINTS; n++) mean += samples[n];
+    mean /= BENCH_POINTS;
+    for (n = 0; n < BENCH_POINTS; n++) {                                                    // Windowing without DC
+        double x = 2.0 * M_PI * n / BENCH_POINTS;
+        double w = 0.35875 - 0.48829 * cos(x) + 0.14128 * cos(2 * x) - 0.01168 * cos(3 * x);
+        windowed[n] = (samples[n] - mean) * w;
+        cosines[n] = cos(x);
+        sines[n] = sin(x);
+    }
+    for (k = 0; k <= BENCH_POINTS / 2; k++) {                                               // For each bin
+        double re = 0, im = 0;
+        unsigned step = 0;
+        for (n = 0; n < BENCH_POINTS; n++, step += k) {
+            re += windowed[n] * cosines[step & (BENCH_POINTS - 1)];
+            im -= windowed[n] * sines[step & (BENCH_POINTS - 1)];
+        }
+        power[k] = re * re + im * im;
+    }
+}
+    // Spurious-free dynamic range and SINAD (dB) around the strongest bin
+static void spectral_purity(const double *power, double *sfdr, double *sinad) {
+    int k, peak = 1;                                                                        // Declaring loop variable and carrier bin
+    double carrier = 0, spur = 0, noise = 0;                                                // Declaring carrier, largest spur and the rest
+    for (k = 1; k <= BENCH_POINTS / 2; k++) {
+        if (power[k] > power[peak]) peak = k;                                               // Finding carrier
+    }
+    for (k = BENCH_MAINLOBE; k <= BENCH_POINTS / 2; k++) {                                  // Skipping DC leakage
+        if (abs(k - peak) <= BENCH_MAINLOBE) {
+            carrier += power[k];                                                            // Carrier mainlobe
+        } else {
+            noise += power[k];                                                              // Harmonics, spurs and quantisation
+            if (power[k] > spur) spur = power[k];
+        }
+    }
+    *sfdr = 10.0 * log10(power[peak] / (spur > 0 ? spur : 1e-30));
+    *sinad = 10.0 * log10(carrier / (noise > 0 ? noise : 1e-30));
+}
+
+/* Waveform switching */
+    // Largest step between consecutive samples
+static int max_step(const uint16_t *samples, int count) {
+    int n, step = 0;                                                                        // Declaring loop variable and largest step
+    for (n = 1; n < count; n++) {
+        int d = abs((int)samples[n] - (int)samples[n - 1]);
+        if (d > step) step = d;
+    }
+    return step;
+}
+    // Largest step of one waveform, and across a switch from it to another
+static void switch_steps(int from, int to, uint32_t millihertz, int *steady, int *across) {
+    static uint16_t samples[2 * BENCH_SWITCH_SAMPLES];                                      // Declaring captured samples
+    int n;                                                                                  // Declaring loop variable
+    set_sine_interpolation(true);
+    set_sine_frequency(millihertz);
+    set_sine_wave(from, 100, 0);
+    for (n = 0; n < BENCH_SWITCH_SAMPLES; n++) samples[n] = sine_sample();                  // Playing the first waveform (takes it at a wrap)
+    *steady = max_step(samples + BENCH_SWITCH_SAMPLES / 2, BENCH_SWITCH_SAMPLES / 2);
+    set_sine_wave(to, 100, 0);                                                              // Switching mid-cycle
+    for (; n < 2 * BENCH_SWITCH_SAMPLES; n++) samples[n] = sine_sample();
+    int after = max_step(samples + 3 * BENCH_SWITCH_SAMPLES / 2, BENCH_SWITCH_SAMPLES / 2);
+    if (after > *steady) *steady = after;                                                   // Largest step of either waveform alone
+    *across = max_step(samples + BENCH_SWITCH_SAMPLES / 2, BENCH_SWITCH_SAMPLES);
+}
+
+/* Timing operations */
+    // Host cycle counter (0 when unavailable)
+static inline uint64_t bench_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/* main */
+int main(int argc, char *argv[]) {
+    static const uint32_t default_tones[] = { 440000, 1000000, 261626, 3141593 };           // Declaring default test tones (millihertz)
+    uint32_t tones[16];                                                                     // Declaring test tones
+    int tone_count = 0, t, p, n;                                                            // Declaring tone count and loop variables
+    int failures = 0;                                                                       // Declaring failed checks
+    static uint16_t samples[BENCH_POINTS];                                                  // Declaring captured samples
+    static double power[BENCH_POINTS / 2 + 1];                                              // Declaring power spectrum
+    for (n = 1; n < argc && tone_count < 16; n++) {                                         // Parsing tones in hertz
+        double hz = strtod(argv[n], NULL);
+        if (hz <= 0 || hz >= BENCH_SAMPLE_RATE / 2) {
+            fprintf(stderr, "usage: %s [hz ...]  (0 < hz < %d)\n", argv[0], BENCH_SAMPLE_RATE / 2);
+            return 2;                                                                       // Returning usage error
+        }
+        tones[tone_count++] = (uint32_t)(hz * SINE_MILLIHERTZ + 0.5);
+    }
+    if (tone_count == 0) {                                                                  // For default tones
+        memcpy(tones, default_tones, sizeof(default_tones));
+        tone_count = sizeof(default_tones) / sizeof(default_tones[0]);
+    }
+    legacy_build();                                                                         // Building legacy table
+
+    /* Spectral purity */
+    printf("%-12s %-14s %12s %10s %10s %8s\n", "tone(Hz)", "path", "actual(Hz)", "SFDR(dB)", "SINAD(dB)", "ENOB");
+    for (t = 0; t < tone_count; t++) {
+        for (p = 0; p < BENCH_PATHS; p++) {
+            const BenchPath *path = &bench_paths[p];
+            double sfdr, sinad, actual;
+            path_start(path, tones[t]);
+            for (n = 0; n < BENCH_POINTS; n++) samples[n] = path_sample(path);
+            power_spectrum(samples, power);
+            spectral_purity(power, &sfdr, &sinad);
+            if (path->mode == 0) {                                                          // Legacy step (LUT entries per sample)
+                actual = (tones[t] / SINE_MILLIHERTZ) * LEGACY_LUT_SIZE * 125 / 1000000.0 * BENCH_SAMPLE_RATE / LEGACY_LUT_SIZE;
+            } else {                                                                        // DDS step (2^32 per cycle)
+                uint32_t step = (uint32_t)(((uint64_t)tones[t] << 32) / ((uint64_t)BENCH_SAMPLE_RATE * SINE_MILLIHERTZ));
+                actual = step * (double)BENCH_SAMPLE_RATE / 4294967296.0;
+            }
+            bool low = path->mode == 2 && (sfdr < BENCH_MIN_SFDR || sinad < BENCH_MIN_SINAD); // Checking the default lookup only
+            failures += low;
+            printf("%-12.3f %-14s %12.6f %10.1f %10.1f %8.2f%s\n", tones[t] / 1000.0, path->name, actual,
+                   sfdr, sinad, (sinad - 1.76) / 6.02, low ? "  LOW" : "");
+        }
+    }
+
+    /* Per-sample cost */
+    printf("\n%-14s %12s %14s\n", "path", "ns/sample", "cycles/sample");
+    for (p = 0; p < BENCH_PATHS; p++) {
+        const BenchPath *path = &bench_paths[p];
+        volatile uint16_t sink = 0;                                                         // Declaring sample sink
+        path_start(path, tones[0]);
+        uint64_t c0 = bench_cycles(), t0 = hostNowNs();
+        for (n = 0; n < BENCH_TIMED_SAMPLES; n++) sink = path_sample(path);
+        uint64_t t1 = hostNowNs(), c1 = bench_cycles();
+        (void)sink;
+        printf("%-14s %12.2f %14.2f\n", path->name, (double)(t1 - t0) / BENCH_TIMED_SAMPLES,
+               (double)(c1 - c0) / BENCH_TIMED_SAMPLES);
+    }
+    printf("(host has a double FPU; the M4F runs the legacy path in soft-float)\n");
+
+    /* Per-waveform cost (one table path, so it should not depend on the shape) */
+    static const char *const wave_labels[WAVE_COUNT] = { "sine", "triangle", "saw", "square", "arb" };
+    printf("\n%-14s %12s %14s\n", "waveform", "ns/sample", "cycles/sample");
+    for (p = 0; p < WAVE_COUNT; p++) {
+        volatile uint16_t sink = 0;                                                         // Declaring sample sink
+        set_sine_interpolation(true);
+        set_sine_frequency(tones[0]);
+        set_sine_wave(p, 100, 0);
+        for (n = 0; n < BENCH_POINTS; n++) sink = sine_sample();                            // Taking the shape at a wrap
+        uint64_t c0 = bench_cycles(), t0 = hostNowNs();
+        for (n = 0; n < BENCH_TIMED_SAMPLES; n++) sink = sine_sample();
+        uint64_t t1 = hostNowNs(), c1 = bench_cycles();
+        (void)sink;
+        printf("%-14s %12.2f %14.2f\n", wave_labels[p], (double)(t1 - t0) / BENCH_TIMED_SAMPLES,
+               (double)(c1 - c0) / BENCH_TIMED_SAMPLES);
+    }
+
+    /* Switch glitches (glitch-free when the switch steps no further than either waveform does;
+       the saw and square jump by design, so the continuous shapes are compared) */
+    printf("\n%-12s %-20s %12s %12s\n", "tone(Hz)", "switch", "steady step", "across step");
+    for (t = 0; t < tone_count; t++) {
+        for (p = 0; p < 2; p++) {
+            int steady, across;                                                             // Declaring largest steps
+            switch_steps(p ? WAVE_TRIANGLE : WAVE_SINE, p ? WAVE_SINE : WAVE_TRIANGLE, tones[t], &steady, &across);
+            failures += across > steady;
+            printf("%-12.3f %-20s %12d %12d%s\n", tones[t] / 1000.0, p ? "triangle -> sine" : "sine -> triangle",
+                   steady, across, across > steady ? "  GLITCH" : "");
+        }
+    }
+
+    /* Tone mixer (cost per voice, and saturation against an exact clipped mix) */
+    static const uint32_t chord[TONE_VOICES] = { 261626, 329628, 391995, 523251, 659255, 783991, 1046502, 1318510 };
+    uint32_t gains[TONE_VOICES];                                                            // Declaring voice gains
+    double previous = 0;                                                                    // Declaring cost with one voice fewer
+    printf("\n%-8s %12s %14s %12s %14s  (%s)\n", "voices", "ns/sample", "cycles/sample", "added ns", "worst error", TONE_DSP ? "SMLAD" : "portable C");
+    for (p = 1; p <= TONE_VOICES; p++) {
+        volatile uint16_t sink = 0;                                                         // Declaring sample sink
+        int worst = 0;                                                                      // Declaring largest error against the exact mix
+        for (n = 0; n < p; n++) gains[n] = 100;                                             // Full gain per voice (sums clip)
+        set_tone_voices(chord, gains, p);
+        for (n = 0; n < BENCH_POINTS; n++) {                                                // Comparing with a clipped double mix
+            double exact = 0;
+            for (t = 0; t < p; t++) exact += sin(2.0 * M_PI * ((double)chord[t] / SINE_MILLIHERTZ) * n / BENCH_SAMPLE_RATE);
+            exact = 8192 + 8191 * exact;
+            exact = exact < 0 ? 0 : exact > 16383 ? 16383 : exact;
+            int error = abs((int)tone_sample() - (int)lround(exact));
+            if (error > worst) worst = error;
+        }
+        uint64_t c0 = bench_cycles(), t0 = hostNowNs();
+        for (n = 0; n < BENCH_MIX_SAMPLES; n++) sink = tone_sample();
+        uint64_t t1 = hostNowNs(), c1 = bench_cycles();
+        (void)sink;
+        double ns = (double)(t1 - t0) / BENCH_MIX_SAMPLES;
+        failures += worst > BENCH_MAX_MIX_ERROR;
+        printf("%-8d %12.2f %14.2f %12.2f %14d%s\n", p, ns, (double)(c1 - c0) / BENCH_MIX_SAMPLES, ns - previous, worst,
+               worst > BENCH_MAX_MIX_ERROR ? "  ERROR" : "");
+        previous = ns;
+    }
+
+    /* Checks (timings vary with the host and are reported only) */
+    printf("\nsine_bench: %s (DDS linear SFDR >= %.0f dB and SINAD >= %.0f dB, no switch glitch, mixer error <= %d codes)\n",
+           failures ? "FAIL" : "pass", BENCH_MIN_SFDR, BENCH_MIN_SINAD, BENCH_MAX_MIX_ERROR);
+    return failures ? 1 : 0;                                                                // Returning check result
+}
@@ -0,0 +1,190 @@
+/*
+ * trace_json.c
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Driver libraries */
+#include <stdint.h>                                                                         // Including integer-size C control
+#include <stdio.h>                                                                          // Including printf() functions
+#include <stdlib.h>                                                                         // Including malloc() functions
+#include <string.h>                                                                         // Including string handling functions
+#include <math.h>                                                                           // Including llround()
+#include "tony.h"                                                                           // Header variable definitions (TRACE_* layout)
+
+/* Declaring macro variables */
+#define DUMP_HEADER 18                                                                      // Defining magic, rate, tick, counts and recorded bytes
+#define DUMP_EVENT 16                                                                       // Defining bytes per event
+
+/* Global variables */
+static const char *session_names[] = {                                                      // Declaring sessions in shell_sessions order
+    "UART0", "UART7", "script", "ticker", "timer", "SW1", "SW2"
+};
+#define SESSION_NAMES (sizeof(session_names) / sizeof(session_names[0]))                    // Defining named sessions (later callbacks go unnamed)
+
+/* Dump operations */
+    // Little-endian field reads
+static uint32_t le(const uint8_t *p, int bytes) {
+    uint32_t value = 0;                                                                     // Declaring field
+    while (bytes-- > 0) value = (value << 8) | p[bytes];                                    // High byte last in the dump
+    return value;
+}
+    // CRC-16/CCITT-FALSE (matches uartecho.c)
+static uint16_t crc16(const uint8_t *data, size_t length) {
+    uint16_t crc = 0xFFFF;                                                                  // Declaring CRC register
+    int bit;                                                                                // Declaring loop variable
+    while (length-- > 0) {
+        crc ^= (uint16_t)(*data++ << 8);
+        for (bit = 0; bit < 8; bit++) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;                                                                             // Returning CRC
+}
+    // Dump length at an offset (0 when truncated or failing its CRC)
+static size_t dump_check(const uint8_t *dump, size_t available) {
+    size_t length;                                                                          // Declaring dump length
+    if (available < DUMP_HEADER + 2) return 0;
+    length = DUMP_HEADER + dump[10] * TRACE_NAME_LENGTH + dump[11] * MAX_COMMAND_NAME_LENGTH +
+             le(dump + 12, 2) * DUMP_EVENT;
+    if (available < length + 2) return 0;                                                   // Returning truncated dump
+    if (crc16(dump + 4, length - 4) != (uint16_t)((dump[length] << 8) | dump[length + 1])) return 0;
+    return length;                                                                          // Returning checked length
+}
+    // Semaphore / queue name
+static void object_name(uint16_t object, char *name, size_t size) {
+    unsigned instance = object >> 8;                                                        // Declaring object instance
+    switch (object & 0xFF) {
+    case TRACE_OBJ_TICKER:   snprintf(name, size, "ticker"); break;
+    case TRACE_OBJ_SCRIPT:   snprintf(name, size, "script"); break;
+    case TRACE_OBJ_DAC:      snprintf(name, size, "DAC"); break;
+    case TRACE_OBJ_WRITER:   snprintf(name, size, "UART%c out", instance ? '7' : '0'); break;
+    case TRACE_OBJ_RX:       snprintf(name, size, "UART%c rx", instance ? '7' : '0'); break;
+    case TRACE_OBJ_WINDOW:   snprintf(name, size, "UART7 window"); break;
+    case TRACE_OBJ_CALLBACK: snprintf(name, size, "callback %u", instance); break;
+    default:                 snprintf(name, size, "object %u", object); break;
+    }
+}
+
+/* JSON output */
+static void emit(const uint8_t *dump) {
+    uint32_t rate = le(dump + 4, 4);                                                        // Declaring timebase ticks per second
+    uint32_t tick_us = le(dump + 8, 2);                                                     // Declaring Clock tick period
+    unsigned tasks = dump[10], commands = dump[11], events = le(dump + 12, 2), i;           // Declaring table sizes
+    uint32_t recorded = le(dump + 14, 4);                                                   // Declaring events recorded on the board
+    const uint8_t *names = dump + DUMP_HEADER;                                              // Declaring task names
+    const uint8_t *command_names = names + tasks * TRACE_NAME_LENGTH;                       // Declaring command names
+    const uint8_t *event = command_names + commands * MAX_COMMAND_NAME_LENGTH;              // Declaring first event
+    double ticks_per_us = rate / 1e6;                                                       // Declaring timebase ticks per microsecond
+    int64_t now = 0;                                                                        // Declaring unwrapped time (ticks)
+    uint32_t last_time = 0, last_tick = 0;                                                  // Declaring previous stamps
+    char name[32], text[TRACE_NAME_LENGTH + 1];                                             // Declaring event and task names
+    printf("{\"displayTimeUnit\":\"ns\",\"otherData\":{\"recorded\":%u,\"held\":%u},\"traceEvents\":[\n", recorded, events);
+    printf("{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"MSP432\"}},\n");
+    printf("{\"ph\":\"M\",\"pid\":1,\"tid\":0,\"name\":\"thread_name\",\"args\":{\"name\":\"interrupts\"}},\n");
+    printf("{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":\"other tasks\"}},\n", TRACE_TASKS + 1);
+    for (i = 0; i < tasks; i++) {                                                           // Naming task tracks
+        memcpy(text, names + i * TRACE_NAME_LENGTH, TRACE_NAME_LENGTH);
+        text[TRACE_NAME_LENGTH] = '\0';
+        if (text[0] == '\0') snprintf(text, sizeof(text), "task %u", i + 1);
+        printf("{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"%s\"}},\n", i + 1, text);
+        printf("{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":%u}},\n", i + 1, i + 1);
+    }
+    for (i = 0; i < events; i++, event += DUMP_EVENT) {                                     // For each event, oldest first
+        uint32_t time = le(event, 4), tick = le(event + 4, 4);                              // Declaring stamps
+        uint8_t id = event[8], context = event[9];                                          // Declaring event and writer
+        uint16_t arg0 = (uint16_t)le(event + 10, 2);                                        // Declaring arguments
+        uint32_t arg1 = le(event + 12, 4);
+        if (i > 0) {                                                                        // Unwrapping the 32-bit timebase with the Clock tick
+            uint32_t delta = time - last_time;                                              // Declaring ticks modulo 2^32
+            double expected = (double)(uint32_t)(tick - last_tick) * tick_us * ticks_per_us;
+            long long wraps = llround((expected - (double)delta) / 4294967296.0);           // Declaring whole timebase wraps in the gap
+            now += (int64_t)delta + wraps * 4294967296LL;
+        }
+        last_time = time;
+        last_tick = tick;
+        double ts = now / ticks_per_us;                                                     // Declaring microseconds since the oldest event
+        switch (id) {
+        case TRACE_DISPATCH_BEGIN:
+        case TRACE_DISPATCH_END:
+            snprintf(name, sizeof(name), "-%.*s", MAX_COMMAND_NAME_LENGTH,
+                     arg0 < commands ? (const char *)command_names + arg0 * MAX_COMMAND_NAME_LENGTH : "?");
+            printf("{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"cat\":\"command\",\"name\":\"%s\",\"args\":{\"session\":\"%s\"}},\n",
+                   id == TRACE_DISPATCH_BEGIN ? 'B' : 'E', context, ts, name,
+                   arg1 < SESSION_NAMES ? session_names[arg1] : arg1 < SHELL_SESSION_COUNT ? "callback" : "?");
+            break;
+        case TRACE_SEM_PEND:
+        case TRACE_SEM_TAKE:
+            object_name(arg0, name, sizeof(name));
+            printf("{\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"cat\":\"semaphore\",\"name\":\"pend %s\"",
+                   id == TRACE_SEM_PEND ? 'B' : 'E', context, ts, name);
+            if (id == TRACE_SEM_TAKE) printf(",\"args\":{\"taken\":%u}", arg1);
+            printf("},\n");
+            break;
+        case TRACE_SEM_POST:
+            object_name(arg0, name, sizeof(name));
+            printf("{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"cat\":\"semaphore\",\"name\":\"post %s\"},\n",
+                   context, ts, name);
+            break;
+        case TRACE_QUEUE_PUT:
+        case TRACE_QUEUE_GET:
+            object_name(arg0, name, sizeof(name));
+            printf("{\"ph\":\"C\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"cat\":\"queue\",\"name\":\"%s\",\"args\":{\"depth\":%u}},\n",
+                   context, ts, name, arg1);
+            break;
+        default:
+            printf("{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":\"event %u\",\"args\":{\"arg0\":%u,\"arg1\":%u}},\n",
+                   context, ts, id, arg0, arg1);
+            break;
+        }
+    }
+    printf("{\"ph\":\"M\",\"pid\":1,\"name\":\"process_sort_index\",\"args\":{\"sort_index\":0}}\n]}\n");
+}
+
+/* main */
+int main(int argc, char *argv[]) {
+    FILE *file = stdin;                                                                     // Declaring capture
+    uint8_t *capture = NULL;                                                                // Declaring capture bytes
+    size_t size = 0, capacity = 0, n, at, length, found = 0, dumps = 0;                     // Declaring capture extent and last dump
+    bool have = false;                                                                      // Declaring valid dump seen
+    if (argc > 2 || (argc == 2 && argv[1][0] == '-' && argv[1][1] != '\0')) {
+        fprintf(stderr, "usage: %s [capture] > trace.json\n"
+                        "  decodes the last -trace dump in a UART capture (stdin by default)\n"
+                        "  open the JSON in chrome://tracing or ui.perfetto.dev\n", argv[0]);
+        return 2;                                                                           // Returning usage error
+    }
+    if (argc == 2 && strcmp(argv[1], "-") != 0 && (file = fopen(argv[1], "rb")) == NULL) {
+        perror(argv[1]);
+        return 1;                                                                           // Returning failure
+    }
+    do {                                                                                    // Reading the whole capture
+        if (size == capacity) {
+            capacity = capacity ? capacity * 2 : 65536;
+            capture = realloc(capture, capacity);
+            if (capture == NULL) return 1;
+        }
+        n = fread(capture + size, 1, capacity - size, file);
+        size += n;
+    } while (n > 0);
+    for (at = 0; at + 4 <= size; at++) {                                                    // Finding every intact dump
+        if (memcmp(capture + at, TRACE_MAGIC, 4) != 0) continue;
+        length = dump_check(capture + at, size - at);
+        if (length == 0) {
+            fprintf(stderr, "trace_json: dump at byte %zu is truncated or fails its CRC\n", at);
+            continue;
+        }
+        found = at;
+        have = true;
+        dumps++;
+        at += length + 1;                                                                   // Skipping the dump and its CRC
+    }
+    if (!have) {
+        fprintf(stderr, "trace_json: no intact %s dump found in %zu bytes\n", TRACE_MAGIC, size);
+        return 1;                                                                           // Returning failure
+    }
+    if (dumps > 1) fprintf(stderr, "trace_json: %zu dumps, decoding the last\n", dumps);
+    emit(capture + found);
+    fprintf(stderr, "trace_json: %u events (%u recorded)\n", (unsigned)le(capture + found + 12, 2),
+            (unsigned)le(capture + found + 14, 4));
+    free(capture);
+    return 0;                                                                               // Returning success
+}
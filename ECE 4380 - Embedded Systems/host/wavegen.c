@@ -0,0 +1,94 @@
+/*
+ * wavegen.c
+ *
+ * Christian J. Maldonado
+ *
+ */
+
+/* Driver libraries */
+#include <stdint.h>                                                                         // Including integer-size C control
+#include <stdio.h>                                                                          // Including printf() functions
+#include <stdlib.h>                                                                         // Including strtol() functions
+#include <string.h>                                                                         // Including string handling functions
+#include <math.h>                                                                           // Including mathematical operations
+
+/* Declaring macro variables */
+#define WAVEGEN_SIZE_MIN 16                                                                 // Defining smallest table (entries per cycle)
+#define WAVEGEN_SIZE_MAX 4096                                                               // Defining largest table (entries per cycle)
+#define WAVEGEN_BITS_MIN 4                                                                  // Defining coarsest precision
+#define WAVEGEN_BITS_MAX 16                                                                 // Defining finest precision (full Q15)
+
+/* Standard shapes (phase 0 to 1, all but the square start at zero rising) */
+    // Sine
+static double shape_sine(double phase) {
+    return sin(2.0 * M_PI * phase);
+}
+    // Triangle (peaks at a quarter cycle)
+static double shape_triangle(double phase) {
+    if (phase < 0.25) return 4.0 * phase;
+    if (phase < 0.75) return 2.0 - 4.0 * phase;
+    return 4.0 * phase - 4.0;
+}
+    // Saw (rises to the peak, wraps at half cycle, rises back to zero)
+static double shape_saw(double phase) {
+    return (phase < 0.5) ? 2.0 * phase : 2.0 * phase - 2.0;
+}
+    // Square
+static double shape_square(double phase) {
+    return (phase < 0.5) ? 1.0 : -1.0;
+}
+typedef struct {
+    const char *name;                                                                       // Declaring table name
+    double (*shape)(double phase);                                                          // Declaring shape function
+} WaveTable;                                                                                // Declaring struct name as WaveTable
+static const WaveTable wave_tables[] = {                                                    // Declaring tables in -sine wave order
+    { "waveSine", shape_sine }, { "waveTriangle", shape_triangle },
+    { "waveSaw", shape_saw }, { "waveSquare", shape_square }
+};
+
+/* Table output */
+    // One table (Q15, quantised to bits, guard entry repeats entry 0 for interpolation)
+static void emit_table(const WaveTable *table, int size, int bits) {
+    int i;                                                                                  // Declaring loop variable
+    double full = (double)((1 << (bits - 1)) - 1);                                          // Declaring quantiser full scale
+    printf("static const int16_t %s[WAVE_TABLE_SIZE+1] = {\r\n", table->name);
+    for (i = 0; i <= size; i++) {
+        long value = lround(table->shape((double)(i % size) / size) * full) << (16 - bits);
+        printf("   %ld%s\r\n", value, (i < size) ? "," : "};");
+    }
+    printf("\r\n");
+}
+
+/* main */
+int main(int argc, char *argv[]) {
+    int size = 256, bits = 16, shift = 0, n;                                                // Declaring table size, precision and index shift
+    for (n = 1; n + 1 < argc; n += 2) {                                                     // Parsing options
+        if (strcmp(argv[n], "-n") == 0) size = (int)strtol(argv[n + 1], NULL, 0);
+        else if (strcmp(argv[n], "-b") == 0) bits = (int)strtol(argv[n + 1], NULL, 0);
+        else break;
+    }
+    if (n < argc || size < WAVEGEN_SIZE_MIN || size > WAVEGEN_SIZE_MAX || (size & (size - 1)) != 0 ||
+        bits < WAVEGEN_BITS_MIN || bits > WAVEGEN_BITS_MAX) {
+        fprintf(stderr, "usage: %s [-n size] [-b bits] > waves.h  (size a power of 2, %d to %d; bits %d to %d)\n",
+                argv[0], WAVEGEN_SIZE_MIN, WAVEGEN_SIZE_MAX, WAVEGEN_BITS_MIN, WAVEGEN_BITS_MAX);
+        return 2;                                                                           // Returning usage error
+    }
+    while ((1 << shift) < size) shift++;                                                    // Declaring log2 of the size
+    printf("/*\r\n * waves.h\r\n *\r\n * Christian J. Maldonado\r\n *\r\n"
+           " * Generated by host/wavegen -n %d -b %d (make -C host waves WAVE_SIZE=%d WAVE_BITS=%d)\r\n"
+           " *\r\n */\r\n\r\n", size, bits, size, bits);
+    printf("/* Declaring waveform table header file */\r\n#ifndef WAVES_H_\r\n#define WAVES_H_\r\n\r\n");
+    printf("%-92s// Including integer-size C control\r\n\r\n", "#include <stdint.h>");
+    char line[96];                                                                          // Declaring define line
+    snprintf(line, sizeof(line), "#define WAVE_TABLE_SIZE %d", size);
+    printf("%-92s// Defining entries per cycle\r\n", line);
+    snprintf(line, sizeof(line), "#define WAVE_INDEX_SHIFT %d", 32 - shift);
+    printf("%-92s// Defining phase bits below the table index\r\n", line);
+    snprintf(line, sizeof(line), "#define WAVE_SAMPLE_BITS %d", bits);
+    printf("%-92s// Defining table precision (Q15, low bits zero)\r\n\r\n", line);
+    for (n = 0; n < (int)(sizeof(wave_tables) / sizeof(wave_tables[0])); n++) {
+        emit_table(&wave_tables[n], size, bits);
+    }
+    printf("#endif /* WAVES_H_ */\r\n");
+    return 0;                                                                               // Returning success
+}
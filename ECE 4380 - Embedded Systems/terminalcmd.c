@@ -13,6 +13,7 @@
 #include <stdlib.h>                                                                         // Including strtoul() functions
 #include <stdbool.h>                                                                        // Including boolean operations
 #include <math.h>                                                                           // Including mathematical operations
+#include <ctype.h>                                                                          // Including isalnum() character classes
 
 /* Driver-Header files */
 #include <ti/drivers/GPIO.h>                                                                // GPIO API header file controls
@@ -22,91 +23,400 @@
 #include <ti/sysbios/knl/Task.h>                                                            // Task API header file controls
 #include <ti/sysbios/knl/Semaphore.h>                                                       // Semaphore API header file controls
 #include <ti/sysbios/knl/Queue.h>                                                           // Queue API header file controls
+#include <ti/sysbios/hal/Hwi.h>                                                             // Hwi API header file controls
 #include <ti/drivers/SPI.h>                                                                 // SPI API header file controls
 
 /* Device-GPIO maps */
 #include <ti/devices/msp432e4/driverlib/gpio.h>                                             // Definitions for GPIO_PORTL_BASE and GPIO_PIN_X
 #include <ti/devices/msp432e4/driverlib/pin_map.h>                                          // Definitions for GPIO pin mapping
 #include <ti/devices/msp432e4/driverlib/sysctl.h>                                           // Definitions for SysCtlPeripheralEnable/Ready
+#if TONE_DSP || PERF_DWT
+#include <ti/devices/msp432e4/inc/msp432.h>                                                 // CMSIS core (__SMLAD, __SSAT intrinsics, DWT cycle counter)
+#endif
+#if !PERF_DWT
+#include <time.h>                                                                           // Including clock_gettime() (host -perf and -trace timebase)
+#endif
 
 /* Driver configuration */
 #include "ti_drivers_config.h"                                                              // Hardware mapping peripherals
 #include "tony.h"                                                                           // Header variable definitions
-#include "sine.h"                                                                           // Sine table header definitions
+#include "waves.h"                                                                          // Waveform table header definitions (host/wavegen)
 
 /* Global variables */
 static uint32_t error_counts[ERROR_COUNT_SIZE] = {0};                                       // Global array for multiple errors (initialized to 0)
-char user_prompt[USER_PROMPT_SIZE];                                                         // Global char for command prompts
+ShellSession shell_sessions[SHELL_SESSION_COUNT] = {                                        // Declaring shell sessions (one per command channel)
+    { "UART0" }, { "UART7" }, { "script" }, { "ticker" }, { "timer" }, { "SW1" }, { "SW2" }
+};
 Callback callbacks[MAX_CALLBACKS] = {0};                                                    // Declaring callback index to list
+PayloadArena payload_arena = {0};                                                           // Declaring callback payload arena (tiled on first use)
 Timer_Handle timer1Handle = NULL;                                                           // Global handle for callback 0 timer (declared NULL)
 Ticker tickers[MAX_TICKERS] = {0};                                                          // Declaring ticker index to list
 Timer_Handle ticker_timer_handle = NULL;                                                    // Global handle for ticker timer (declared NULL)
-static uint32_t ticker_time = 0;                                                            // Declaring static ticker timer checker variable
-int32_t registers[NUM_REGISTERS] = {0};                                                     // Declaring registers 1D list values (all as 0)
+static volatile uint32_t ticker_time = 0;                                                   // Declaring wheel time in ticks (1 ms)
+static uint16_t ticker_wheel[TICKER_WHEEL_SLOTS];                                           // Declaring timing-wheel slot heads (level 0, 1, 2)
+static volatile uint16_t ticker_ready[TICKER_READY_SIZE];                                   // Declaring due tickers (ISR to ticker_task)
+static volatile uint32_t ticker_ready_head = 0;                                             // Declaring ring head (written by ISR)
+static volatile uint32_t ticker_ready_tail = 0;                                             // Declaring ring tail (written by ticker_task)
+static Task_Handle tickerTaskHandle = NULL;                                                 // Declaring ticker task handler
+static Semaphore_Handle tickerSem = NULL;                                                   // Declaring ticker semaphore handler
+static uint8_t tickerTaskStack[TICKER_TASK_STACK_SIZE];                                     // Declaring ticker task stack array
+int32_t registers[REG_BANKS][NUM_REGISTERS] = {0};                                          // Declaring register banks (all as 0)
 char reg_names[NUM_REGISTERS][MAX_REG_NAME_LENGTH] = {0};                                   // Declaring registers 2D list values (all as 0)
+static RegAlias reg_aliases[REG_ALIAS_SLOTS];                                               // Declaring register alias hash (open addressing)
 char script_space[SCRIPT_SIZE][MAX_SCRIPT_LINE_LENGTH] = {0};                               // Declaring script space 2D list (all as 0)
+CompiledCommand script_compiled[SCRIPT_SIZE] = {0};                                         // Declaring compiled script lines (parallel to script space)
 static Task_Handle scriptTaskHandle = NULL;                                                 // Declaring script task handler
 static Semaphore_Handle scriptSem = NULL;                                                   // Declaring script semaphore handler
-static Queue_Handle scriptQueue = NULL;                                                     // Declaring script queue handler
-static UART_Handle script_uart = NULL;                                                      // Declaring script UART handler
+static ShellSession *const script_session = &shell_sessions[SESSION_SCRIPT];                // Declaring script task session
 static uint8_t scriptTaskStack[SCRIPT_TASK_STACK_SIZE];                                     // Declaring script task stack array
-static bool is_script_executing __attribute__((unused)) = false;                            // Declaring active script flag (unused attribute - declared within script_task function)
-static bool script_stop __attribute__((unused)) = false;                                    // Declaring script stop flag (unused attribute - declared within script_task function)
-static double phase_accumulator = 0;                                                        // Declaring double phase accumulator
-static double phase_increment = 0;                                                          // Declaring double phase increment
-static uint32_t sample_rate = 8000;                                                         // Declaring sample rate to match 125us period
-static bool sine_active = false;                                                            // Declaring flag for active sine status
+static ProgInstruction program[PROG_SIZE];                                                  // Declaring compiled script micro-program
+static int16_t program_line_pc[SCRIPT_SIZE];                                                // Declaring script line to program index map
+static int program_size = 0;                                                                // Declaring program length
+static volatile int program_start = -1;                                                     // Declaring requested program line (-1 when none)
+static volatile uint32_t program_generation = 0;                                            // Declaring script request count (stops a running program)
+static volatile bool is_script_executing = false;                                           // Declaring active script flag
+static volatile bool script_stop = false;                                                   // Declaring script stop flag
+static volatile int script_pc = -1;                                                         // Declaring next script line (-1 when idle)
+static int8_t script_frames[SCRIPT_CALL_DEPTH];                                             // Declaring static call frame pool (return lines)
+static int script_depth = 0;                                                                // Declaring frames in use
+static int script_depth_high = 0;                                                           // Declaring frame high-water mark
+static uint32_t script_overflows = 0;                                                       // Declaring frame pool overflow count
+static uint32_t script_lines = 0;                                                           // Declaring executed script line count
+static IfExpr if_exprs[IF_EXPR_SLOTS];                                                      // Declaring interned -if conditions (open addressing)
+static uint32_t phase_accumulator = 0;                                                      // Declaring DDS phase (2^32 = one cycle)
+static uint32_t phase_increment = 0;                                                        // Declaring DDS phase step per sample
+static bool sine_interpolate = true;                                                        // Declaring linear interpolation between table entries
+static WaveShape wave_shape = { waveSine, WAVE_GAIN_FULL, WAVE_OFFSET_MID };                // Declaring shape being generated (DAC task)
+static WaveShape wave_next;                                                                 // Declaring shape taken at the next phase wrap
+static volatile bool wave_switch = false;                                                   // Declaring pending shape flag
+static int16_t wave_arbitrary[2][WAVE_TABLE_SIZE + 1];                                      // Declaring uploaded tables (one plays while the other is loaded)
+static uint8_t wave_loaded = 0;                                                             // Declaring most recently loaded table
+static uint8_t wave_selected = WAVE_SINE;                                                   // Declaring selected waveform
+static uint32_t wave_amplitude = 100;                                                       // Declaring amplitude (% of full scale)
+static int32_t wave_offset = 0;                                                             // Declaring offset (% of half scale)
+static uint32_t wave_switches = 0;                                                          // Declaring shapes taken at a phase wrap
+static const char *const wave_names[WAVE_COUNT] = { "sine", "triangle", "saw", "square", "arb" };
+static ToneVoice tone_voices[TONE_VOICES];                                                  // Declaring mixer voices (unused voices have zero gain)
+static uint32_t tone_gains[TONE_VOICES / 2];                                                // Declaring voice gains packed in pairs for SMLAD
+static int tone_count = 0;                                                                  // Declaring voices in use
+static uint16_t (*dac_source)(void) = sine_sample;                                          // Declaring DAC sample source (sine_sample or tone_sample)
+static volatile bool pcm_mode = false;                                                      // Declaring sine timer draining the PCM jitter buffer
+static uint32_t sample_rate = SINE_RATE_DEFAULT;                                            // Declaring sample rate (sine timer frequency)
+static uint32_t sine_millihertz = 0;                                                        // Declaring generated frequency (rate changes recompute the step)
+static volatile bool sine_active = false;                                                   // Declaring flag for active sine status
+static volatile uint16_t dac_buffer[2][DAC_HALF_SIZE];                                      // Declaring sample double buffer (DAC task fills, sine timer plays)
+static volatile bool dac_ready[2] = { false, false };                                       // Declaring filled halves
+static uint8_t dac_half = 0;                                                                // Declaring half being played
+static uint16_t dac_position = 0;                                                           // Declaring next sample in that half
+static bool dac_starved = false;                                                            // Declaring underrun in progress (one error per underrun)
+static volatile uint32_t dac_underruns = 0;                                                 // Declaring sample periods without a filled half
+static volatile uint32_t dac_late = 0;                                                      // Declaring samples dropped with the SPI still busy
+static volatile uint32_t dac_fills = 0;                                                     // Declaring halves filled
+static volatile uint32_t dac_transfers = 0;                                                 // Declaring completed stream transfers
+static uint16_t dac_stream_word = 0x2000;                                                   // Declaring sample in flight (sine timer)
+static uint16_t dac_idle_word = 0x2000;                                                     // Declaring DAC word written from tasks
+static SPI_Transaction dac_stream_transaction = { 1, &dac_stream_word, NULL };              // Declaring sine timer transfer
+static SPI_Transaction dac_idle_transaction = { 1, &dac_idle_word, NULL };                  // Declaring task transfer
+static Task_Handle dacTaskHandle = NULL;                                                    // Declaring DAC task handler
+static Semaphore_Handle dacSem = NULL;                                                      // Declaring DAC refill semaphore
+static uint8_t dacTaskStack[DAC_TASK_STACK_SIZE];                                           // Declaring DAC task stack array
 SPI_Handle spiHandle = NULL;                                                                // Declaring SPI handle as NULL
+PcmBuffer pcm_buffer = { .depth = PCM_DEPTH_DEFAULT };                                      // Declaring PCM jitter buffer
 Timer_Handle timer0Handle = NULL;                                                           // Declaring timer handler 0 (callback 0) as NULL
+#if PERF_ENABLE
+static PerfSite perf_sites[PERF_SITES];                                                     // Declaring timed sites (dispatch, ISRs, then one per command)
+static uint32_t perf_overhead = 0;                                                          // Declaring ticks a back-to-back begin/end pair reads
+#endif
+
+/* Shell session operations */
+    // Session bind (background sessions run with their owner's channel, trace level and bank)
+void bind_session(ShellSession *session, const ShellSession *owner) {
+    if (owner == NULL) {                                                                    // For payloads set before any session
+        owner = &shell_sessions[SESSION_UART0];                                             // Defaulting to the console
+    }
+    session->uart = owner->uart;                                                            // Copying output channel
+    session->verbosity = owner->verbosity;                                                  // Copying trace level
+    session->bank = owner->bank;                                                            // Copying register bank
+}
+
+/* Profiling operations */
+    // Timebase read (DWT cycles on target, nanoseconds on host; deltas survive the 32-bit wrap)
+static inline uint32_t perf_now(void) {
+#if PERF_DWT
+    return DWT->CYCCNT;                                                                     // Returning cycle count
+#else
+    struct timespec now;                                                                    // Declaring time sample
+    clock_gettime(CLOCK_MONOTONIC, &now);                                                   // Reading monotonic clock
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec);        // Returning nanoseconds (low 32 bits)
+#endif
+}
+    // Timebase read for other modules (trace timestamps)
+uint32_t timebase_now(void) {
+    return perf_now();                                                                      // Returning timebase ticks
+}
+#if PERF_ENABLE
+    // Log2 bucket (0 for no ticks, b for 2^(b-1) to 2^b - 1)
+static inline int perf_bucket(uint32_t ticks) {
+    int bucket;                                                                             // Declaring bucket
+    if (ticks == 0) return 0;                                                               // Returning empty bucket
+#if defined(__TI_ARM__)
+    bucket = 32 - __clz(ticks);                                                             // Counting significant bits (CLZ)
+#else
+    bucket = 32 - __builtin_clz(ticks);                                                     // Counting significant bits
+#endif
+    return (bucket < PERF_BUCKETS) ? bucket : PERF_BUCKETS - 1;                             // Returning bucket (long runs share the last)
+}
+    // Record one run (tasks and ISRs share sites, so the update runs with interrupts off)
+static void perf_record(int site, uint32_t start) {
+    uint32_t ticks = perf_now() - start;                                                    // Declaring run length
+    PerfSite *entry = &perf_sites[site];                                                    // Declaring site
+    int bucket;                                                                             // Declaring histogram bucket
+    ticks = (ticks > perf_overhead) ? ticks - perf_overhead : 0;                            // Removing the timebase's own cost
+    bucket = perf_bucket(ticks);
+    UInt key = Hwi_disable();                                                               // Disabling interrupts
+    if (entry->count == 0 || ticks < entry->min) entry->min = ticks;                        // Tracking shortest run
+    if (ticks > entry->max) entry->max = ticks;                                             // Tracking longest run
+    entry->count++;
+    entry->total += ticks;
+    entry->histogram[bucket]++;                                                             // Counting run in its bucket
+    Hwi_restore(key);                                                                       // Restoring interrupts
+}
+#define PERF_BEGIN(start) uint32_t start = perf_now()                                       // Defining run start
+#define PERF_END(site, start) perf_record((site), (start))                                  // Defining run end
+#else
+#define PERF_BEGIN(start)                                                                   // Defining nothing (compiled away)
+#define PERF_END(site, start) ((void)0)                                                     // Defining nothing (compiled away)
+#endif
+    // Timebase start and overhead calibration
+void init_perf(void) {
+#if PERF_DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;                                         // Enabling trace (powers the DWT)
+    DWT->CYCCNT = 0;                                                                        // Clearing cycle counter
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;                                                    // Starting cycle counter
+#endif
+#if PERF_ENABLE
+    uint32_t start, fastest = UINT32_MAX;                                                   // Declaring calibration samples
+    int i;                                                                                  // Declaring loop variable
+    for (i = 0; i < 16; i++) {                                                              // Timing an empty run
+        start = perf_now();
+        uint32_t ticks = perf_now() - start;                                                // Declaring empty run length
+        if (ticks < fastest) fastest = ticks;                                               // Keeping the fastest
+    }
+    perf_overhead = fastest;                                                                // Declaring ticks removed from every run
+#endif
+}
 
 /* Payload-Queue operations */
-    // Queue increment
-void enqueue_payload(Callback *cb, const char *payload) {
-    if (cb->queue_size < QUEUE_SIZE) {                                                      // When queue size is greater than callback
-        strcpy(cb->payload[cb->queue_rear], payload);                                       // Copying payload to rear of queue
-        cb->queue_rear = (cb->queue_rear + 1) % QUEUE_SIZE;                                 // Moving rear pointer as circular queue (returning remainder)
-        cb->queue_size++;                                                                   // Increment queue size
-    }                                                                                       // Payload silently removed if queue is full
-}
-    // Queue decrement
-char* dequeue_payload(Callback *cb) {
+    // Arena block at an offset
+static inline PayloadRecord *arena_block(uint16_t offset) {
+    return (PayloadRecord *)((uint8_t *)payload_arena.heap + offset);                       // Returning block header
+}
+    // Arena tiling (one free block spanning the budget)
+static void arena_ready(void) {
+    PayloadArena *arena = &payload_arena;                                                   // Declaring arena
+    if (arena->ready) {                                                                     // For arena already tiled
+        return;                                                                             // Return from function
+    }
+    PayloadRecord *block = arena_block(0);                                                  // Declaring first block
+    block->size = CALLBACK_ARENA_SIZE;
+    block->next = ARENA_NONE;
+    block->owner = ARENA_FREE;
+    arena->free_head = 0;
+    arena->ready = true;
+}
+    // Arena compaction step (slides the record above the lowest free block down, false when none is left to move)
+static bool arena_compact_step(void) {
+    PayloadArena *arena = &payload_arena;                                                   // Declaring arena
+    uint16_t hole = arena->free_head;                                                       // Declaring lowest free block
+    if (hole == ARENA_NONE) {
+        return false;                                                                       // Returning full arena
+    }
+    uint16_t gap = arena_block(hole)->size, next_free = arena_block(hole)->next;            // Declaring hole extent
+    uint16_t offset = hole + gap;                                                           // Declaring record above (free neighbours are merged)
+    if (offset >= CALLBACK_ARENA_SIZE) {
+        return false;                                                                       // Returning compacted arena
+    }
+    PayloadRecord *block = arena_block(offset);                                             // Declaring record to move
+    Callback *cb = &callbacks[block->owner];                                                // Declaring queue holding it
+    uint16_t size = block->size, prev;                                                      // Declaring record bytes and queue walk
+    if (cb->queue_front == offset) {                                                        // Relinking the record at its new offset
+        cb->queue_front = hole;
+    } else {
+        for (prev = cb->queue_front; arena_block(prev)->next != offset; prev = arena_block(prev)->next);
+        arena_block(prev)->next = hole;
+    }
+    if (cb->queue_rear == offset) {
+        cb->queue_rear = hole;
+    }
+    memmove(arena_block(hole), block, size);                                                // Moving record (destination below source)
+    uint16_t top = hole + size;                                                             // Declaring hole above the moved record
+    PayloadRecord *free_block = arena_block(top);                                           // Declaring moved free block
+    free_block->size = gap;
+    free_block->next = next_free;
+    free_block->owner = ARENA_FREE;
+    if (next_free != ARENA_NONE && top + gap == next_free) {                                // Merging with the free block above
+        free_block->size += arena_block(next_free)->size;
+        free_block->next = arena_block(next_free)->next;
+    }
+    arena->free_head = top;
+    return true;                                                                            // Returning record moved
+}
+    // Arena allocation (first fit, ARENA_NONE when no free block is large enough)
+static uint16_t arena_alloc(uint16_t size, uint8_t owner) {
+    PayloadArena *arena = &payload_arena;                                                   // Declaring arena
+    uint16_t offset, prev;                                                                  // Declaring free-list walk
+    size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);                                   // Rounding to record alignment
+    arena_ready();
+    for (prev = ARENA_NONE, offset = arena->free_head; offset != ARENA_NONE; prev = offset, offset = arena_block(offset)->next) {
+        PayloadRecord *block = arena_block(offset);                                         // Declaring free block
+        if (block->size < size) {
+            continue;                                                                       // Continue to larger block
+        }
+        uint16_t next = block->next;                                                        // Declaring free block after this one
+        if (block->size - size >= sizeof(PayloadRecord)) {                                  // Splitting off the remainder
+            PayloadRecord *rest = arena_block(offset + size);                               // Declaring remainder
+            rest->size = block->size - size;
+            rest->next = next;
+            rest->owner = ARENA_FREE;
+            next = offset + size;
+            block->size = size;
+        }
+        if (prev == ARENA_NONE) {                                                           // Unlinking from the free list
+            arena->free_head = next;
+        } else {
+            arena_block(prev)->next = next;
+        }
+        block->next = ARENA_NONE;
+        block->owner = owner;
+        arena->used += block->size;
+        arena->records++;
+        if (arena->used > arena->high) arena->high = arena->used;                           // Tracking high-water mark
+        return offset;                                                                      // Returning record offset
+    }
+    return ARENA_NONE;                                                                      // Returning failure
+}
+    // Arena release (free list kept in address order, neighbours merged)
+static void arena_free(uint16_t offset) {
+    PayloadArena *arena = &payload_arena;                                                   // Declaring arena
+    PayloadRecord *block = arena_block(offset);                                             // Declaring released block
+    uint16_t prev = ARENA_NONE, next = arena->free_head;                                    // Declaring free neighbours
+    while (next != ARENA_NONE && next < offset) {                                           // Finding the insertion point
+        prev = next;
+        next = arena_block(next)->next;
+    }
+    arena->used -= block->size;
+    arena->records--;
+    block->owner = ARENA_FREE;
+    block->next = next;
+    if (next != ARENA_NONE && offset + block->size == next) {                               // Merging with the block above
+        block->size += arena_block(next)->size;
+        block->next = arena_block(next)->next;
+    }
+    if (prev == ARENA_NONE) {
+        arena->free_head = offset;
+    } else if (prev + arena_block(prev)->size == offset) {                                  // Merging into the block below
+        arena_block(prev)->size += block->size;
+        arena_block(prev)->next = block->next;
+    } else {
+        arena_block(prev)->next = offset;
+    }
+}
+    // Queue increment (false when the queue or arena is full)
+bool enqueue_payload(Callback *cb, const char *payload) {
+    size_t length = strlen(payload) + 1;                                                    // Declaring text bytes
+    uint16_t size = (uint16_t)((sizeof(PayloadRecord) + length + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1)); // Declaring record bytes
+    uint16_t offset;                                                                        // Declaring new record
+    CompiledCommand compiled;                                                               // Declaring compiled payload
+    bool compacting = false;                                                                // Declaring compaction started
+    UInt key;                                                                               // Declaring interrupt key
+    if (cb->queue_size >= QUEUE_SIZE || length > MAX_CMD_LENGTH) {                          // When queue is full
+        return false;                                                                       // Returning failure
+    }
+    compile_command(payload, &compiled);                                                    // Compiling once at registration (spans are text relative)
+    while (true) {                                                                          // Until allocated, one compaction step per critical section
+        key = Hwi_disable();                                                                // Holding off callbacks while records move
+        offset = arena_alloc(size, (uint8_t)(cb - callbacks));
+        if (offset != ARENA_NONE) {
+            break;                                                                          // Linking with interrupts still held off
+        }
+        bool moved = CALLBACK_ARENA_SIZE - payload_arena.used >= size && arena_compact_step(); // Sliding one record when the free space is fragmented
+        if (!moved) {                                                                       // For space that compaction cannot find
+            payload_arena.failures++;
+        } else if (!compacting) {                                                           // For first step of this compaction
+            payload_arena.compactions++;
+            compacting = true;
+        }
+        Hwi_restore(key);                                                                   // Letting callbacks run between steps
+        if (!moved) {
+            release_command(&compiled);                                                     // Releasing its -if condition
+            return false;                                                                   // Returning failure
+        }
+    }
+    PayloadRecord *record = arena_block(offset);                                            // Declaring record
+    memcpy(record->text, payload, length);                                                  // Copying payload to rear of queue
+    record->compiled = compiled;                                                            // Storing compiled payload
+    if (cb->queue_size == 0) {                                                              // Linking record as rear of queue
+        cb->queue_front = offset;
+    } else {
+        arena_block(cb->queue_rear)->next = offset;
+    }
+    cb->queue_rear = offset;
+    cb->queue_size++;                                                                       // Increment queue size
+    Hwi_restore(key);
+    trace_event(TRACE_QUEUE_PUT, TRACE_OBJECT(TRACE_OBJ_CALLBACK, cb - callbacks), cb->queue_size);
+    return true;                                                                            // Returning success
+}
+    // Queue decrement (front record released)
+bool dequeue_payload(Callback *cb) {
+    UInt key = Hwi_disable();                                                               // Declaring interrupt key
     if (cb->queue_size > 0) {                                                               // When queue size is greater than 0
-        char *payload = cb->payload[cb->queue_front];                                       // Declaring payload to front of queue
-        cb->queue_front = (cb->queue_front + 1) % QUEUE_SIZE;                               // Moving front pointer as circular queue (returning remainder)
+        uint16_t offset = cb->queue_front;                                                  // Declaring front record
+        cb->queue_front = arena_block(offset)->next;                                        // Moving front to the next record
         cb->queue_size--;                                                                   // Decrement queue size
-        return payload;                                                                     // Return payload variable
+        release_command(&arena_block(offset)->compiled);                                    // Releasing its -if condition
+        arena_free(offset);
+        Hwi_restore(key);
+        trace_event(TRACE_QUEUE_GET, TRACE_OBJECT(TRACE_OBJ_CALLBACK, cb - callbacks), cb->queue_size);
+        return true;                                                                        // Returning success
+    }
+    Hwi_restore(key);
+    return false;                                                                           // Returning false if queue is empty
+}
+    // Queue release (all records)
+void clear_payloads(Callback *cb) {
+    while (dequeue_payload(cb)) {                                                           // Releasing front until empty
     }
-    return NULL;                                                                            // Returning NULL if queue is empty
 }
     // Payload returner
 char* peek_payload(Callback *cb) {
     if (cb->queue_size > 0) {                                                               // Returning front payload
-        return cb->payload[cb->queue_front];                                                // without removing from queue
+        return arena_block(cb->queue_front)->text;                                          // without removing from queue
     }
     return NULL;                                                                            // Returning NULL if queue is empty
 }
     // Output-Queue
 void execute_callback(Callback *cb) {
+    ShellSession *session = &shell_sessions[SESSION_CALLBACK + (cb - callbacks)];           // Declaring callback session
     if (cb->count != 0 && cb->queue_size > 0 && !cb->is_executing) {                        // Checking if callback should execute
         cb->is_executing = true;                                                            // Searching when callback execution is true
         if (cb->output_length == 0) {                                                       // If no current output
             char *payload = peek_payload(cb);                                               // Preparing next payload
             if (payload != NULL) {                                                          // When payload already initialized
-                user_prompt[0] = '\0';                                                      // Tab empty user prompt
-                valid_cmd(cb->uart, payload);                                               // Executing valid command
-                strcpy(cb->output_buffer, user_prompt);                                     // Storing result
-                cb->output_length = strlen(cb->output_buffer);                              // Calculate and store length
+                session->prompt[0] = '\0';                                                  // Tab empty user prompt
+                bind_session(session, cb->owner);                                           // Running for the session that set the callback
+                execute_command(session, &arena_block(cb->queue_front)->compiled, payload); // Executing compiled payload
+                cb->output_length = strlen(session->prompt);                                // Result stays in the callback session prompt
                 cb->output_position = 0;                                                    // Initializing output position back to front of buffer
             }
         }
         if (cb->is_button_callback || cb->is_large_interval) {                              // When button callbacks or large timer intervals
                                                                                             // Write the entire output at once
-            UART_write(cb->uart, cb->output_buffer + cb->output_position, cb->output_length - cb->output_position);
+            uart_output(session->uart, session->prompt + cb->output_position, cb->output_length - cb->output_position);
             cb->output_position = cb->output_length;                                        // Declaring position to length
         } else {                                                                            // For small timer intervals
             int remaining = cb->output_length - cb->output_position;                        // Provide use in chunked output
             int to_write = (remaining > MAX_OUTPUT_CHUNK) ? MAX_OUTPUT_CHUNK : remaining;
-            UART_write(cb->uart, cb->output_buffer + cb->output_position, to_write);
+            uart_output(session->uart, session->prompt + cb->output_position, to_write);
             cb->output_position += to_write;                                                // Update position for next operation to write
         }
         if (cb->output_position >= cb->output_length) {                                     // Declaring next execution to complete output
@@ -116,8 +426,7 @@ void execute_callback(Callback *cb) {
                 cb->count--;
             }
             if (cb->count == 0) {                                                           // When count reaches 0
-                cb->queue_front = (cb->queue_front + 1) % QUEUE_SIZE;                       // Removing current payload from queue
-                cb->queue_size--;
+                dequeue_payload(cb);                                                        // Removing current payload from queue
             }
         }
         cb->is_executing = false;                                                           // Setting callback execute flag as inactive
@@ -157,56 +466,192 @@ void timer_callback(Timer_Handle handle, int_fast16_t status) {
 }
     // SW1
 void sw1_callback(uint_least8_t index) {
+    PERF_BEGIN(start);                                                                      // Timing callback
     if (!callbacks[SW1_CALLBACK].is_executing) {                                            // Executing Callback 1 (if not already)
         execute_callback(&callbacks[SW1_CALLBACK]);                                         // Declaring callback execution
     }
+    PERF_END(PERF_SITE_SW1, start);
 }
     // SW2
 void sw2_callback(uint_least8_t index) {
+    PERF_BEGIN(start);                                                                      // Timing callback
     if (!callbacks[SW2_CALLBACK].is_executing) {                                            // Executing Callback 1 (if not already)
         execute_callback(&callbacks[SW2_CALLBACK]);                                         // Declaring callback execution
     }
+    PERF_END(PERF_SITE_SW2, start);
 }
 
 /* Ticker operations */
+    // Wheel slot for a ticker's next execution (level 0: 1 ms, level 1: 256 ms, level 2: 16.384 s)
+static uint16_t ticker_bucket(uint32_t expires) {
+    uint32_t delta = expires - ticker_time;                                                 // Declaring ticks until execution
+    if (delta < (1u << TICKER_WHEEL0_BITS)) {                                               // Within the level-0 wheel
+        return (uint16_t)(expires & ((1u << TICKER_WHEEL0_BITS) - 1));
+    }
+    if (delta < (1u << (TICKER_WHEEL0_BITS + TICKER_WHEELN_BITS))) {                        // Within the level-1 wheel
+        return (uint16_t)((1u << TICKER_WHEEL0_BITS) +
+                          ((expires >> TICKER_WHEEL0_BITS) & ((1u << TICKER_WHEELN_BITS) - 1)));
+    }
+    if (delta >= (1u << (TICKER_WHEEL0_BITS + 2 * TICKER_WHEELN_BITS))) {                   // Beyond the wheel (re-cascaded until in range)
+        expires = ticker_time + (1u << (TICKER_WHEEL0_BITS + 2 * TICKER_WHEELN_BITS)) - 1;
+    }
+    return (uint16_t)((1u << TICKER_WHEEL0_BITS) + (1u << TICKER_WHEELN_BITS) +
+                      ((expires >> (TICKER_WHEEL0_BITS + TICKER_WHEELN_BITS)) & ((1u << TICKER_WHEELN_BITS) - 1)));
+}
+    // Wheel link (interrupts disabled or in the timer ISR)
+static void ticker_link(uint16_t index) {
+    Ticker *ticker = &tickers[index];                                                       // Declaring ticker handle to index
+    uint16_t bucket = ticker_bucket(ticker->next_execution);                                // Declaring wheel slot
+    ticker->bucket = bucket;                                                                // Recording slot for unlink
+    ticker->prev = TICKER_NONE;                                                             // Linking at slot head
+    ticker->next = ticker_wheel[bucket];
+    if (ticker->next != TICKER_NONE) {                                                      // For non-empty slot
+        tickers[ticker->next].prev = index;
+    }
+    ticker_wheel[bucket] = index;                                                           // Declaring new slot head
+}
+    // Wheel unlink (interrupts disabled or in the timer ISR)
+static void ticker_unlink(uint16_t index) {
+    Ticker *ticker = &tickers[index];                                                       // Declaring ticker handle to index
+    if (ticker->bucket == TICKER_NONE) {                                                    // For unlinked ticker
+        return;                                                                             // Return from function
+    }
+    if (ticker->prev != TICKER_NONE) {                                                      // For mid-slot ticker
+        tickers[ticker->prev].next = ticker->next;
+    } else {                                                                                // For slot head
+        ticker_wheel[ticker->bucket] = ticker->next;
+    }
+    if (ticker->next != TICKER_NONE) {                                                      // For following ticker
+        tickers[ticker->next].prev = ticker->prev;
+    }
+    ticker->bucket = TICKER_NONE;                                                           // Marking unlinked
+}
+    // Ticker schedule (from task context)
+void schedule_ticker(int index, uint32_t delay) {
+    UInt key = Hwi_disable();                                                               // Holding off the wheel ISR
+    ticker_unlink((uint16_t)index);                                                         // Dropping any earlier schedule
+    tickers[index].next_execution = ticker_time + (delay ? delay : 1);                      // Earliest execution is the next tick
+    if (tickers[index].active) {                                                            // For active ticker
+        ticker_link((uint16_t)index);                                                       // Linking into the wheel
+    }
+    Hwi_restore(key);                                                                       // Restoring interrupts
+}
     // Ticker timer
 void init_ticker_timer() {
+    int i;                                                                                  // Declaring loop variable
+    for (i = 0; i < TICKER_WHEEL_SLOTS; i++) {                                              // For all wheel slots
+        ticker_wheel[i] = TICKER_NONE;                                                      // Emptying slot
+    }
+    for (i = 0; i < MAX_TICKERS; i++) {                                                     // For all tickers
+        tickers[i].bucket = TICKER_NONE;                                                    // Marking unlinked
+    }
+    Semaphore_Params semParams;                                                             // Creating semaphore for due tickers
+    Semaphore_Params_init(&semParams);                                                      // Declaring semaphore parameter initialization
+    semParams.mode = Semaphore_Mode_BINARY;                                                 // One wake drains every due ticker
+    tickerSem = Semaphore_create(0, &semParams, NULL);                                      // Declaring ticker semaphore
+    Task_Params taskParams;                                                                 // Creating ticker execution task
+    Task_Params_init(&taskParams);                                                          // Declaring task parameter
+    taskParams.stackSize = TICKER_TASK_STACK_SIZE;                                          // Declaring task stack size
+    taskParams.priority = TICKER_TASK_PRIORITY;                                             // Declaring task priority
+    taskParams.stack = &tickerTaskStack;                                                    // Declaring task parameter to stack size
+    tickerTaskHandle = Task_create(ticker_task, &taskParams, NULL);                         // Creating ticker task handler to parameter
     Timer_Params params;                                                                    // Declaring ticker timer parameters
     Timer_Params_init(&params);                                                             // Initializing timer to parameter
-    params.period = 10000;                                                                  // 10 ms
+    params.period = TICKER_TICK_US;                                                         // 1 ms wheel tick
     params.periodUnits = Timer_PERIOD_US;                                                   // Declaring period library
     params.timerMode = Timer_CONTINUOUS_CALLBACK;                                           // Declaring timer mode
     params.timerCallback = ticker_timer_callback;                                           // Declaring ticker callback function to parameter operation
     ticker_timer_handle = Timer_open(TICKER_TIMER, &params);                                // Declaring open ticker timer handle
-    if (ticker_timer_handle == NULL) {                                                      // If ticker timer declared as NULL
+    if (ticker_timer_handle == NULL || tickerTaskHandle == NULL) {                          // If ticker timer or task failed
         increment_error(ERR_TICKER);                                                        // Incrementing ticker error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Failed to open the ticker timer.\r\n");
         return;                                                                             // Return from loop
     } else {                                                                                // For successful ticker input
         Timer_start(ticker_timer_handle);                                                   // Starting ticker timer
     }
 }
-    // Ticker callback
+    // Ticker callback (advances the wheel; due tickers run on ticker_task)
 void ticker_timer_callback(Timer_Handle handle, int_fast16_t status) {
-    int i;                                                                                  // Declare the loop variable at start of the function
-    ticker_time += 1;                                                                       // Increment by 1 (10 ms) each time ticker callback is called
-    for (i = 0; i < MAX_TICKERS; i++) {                                                     // For input within ticker count
-        if (tickers[i].active && ticker_time >= tickers[i].next_execution) {                // If active ticker and next execution is ready for execution
-            execute_ticker(i);                                                              // Declaring user input ticker to execute
+    PERF_BEGIN(start);                                                                      // Timing tick
+    uint16_t index, next;                                                                   // Declaring slot walk variables
+    bool posted = false;                                                                    // Declaring task wake flag
+    ticker_time += 1;                                                                       // Increment by 1 (1 ms) each time ticker callback is called
+    if ((ticker_time & ((1u << TICKER_WHEEL0_BITS) - 1)) == 0) {                            // Level-0 wheel wrapped
+        uint32_t level1 = (ticker_time >> TICKER_WHEEL0_BITS) & ((1u << TICKER_WHEELN_BITS) - 1);
+        uint16_t cascade[2];                                                                // Declaring slots to re-sort (level 2 first)
+        int levels = 0, i;                                                                  // Declaring cascade count
+        if (level1 == 0) {                                                                  // Level-1 wheel wrapped
+            cascade[levels++] = (uint16_t)((1u << TICKER_WHEEL0_BITS) + (1u << TICKER_WHEELN_BITS) +
+                ((ticker_time >> (TICKER_WHEEL0_BITS + TICKER_WHEELN_BITS)) & ((1u << TICKER_WHEELN_BITS) - 1)));
+        }
+        cascade[levels++] = (uint16_t)((1u << TICKER_WHEEL0_BITS) + level1);
+        for (i = 0; i < levels; i++) {                                                      // Re-sorting each slot into finer wheels
+            index = ticker_wheel[cascade[i]];                                               // Detaching slot list
+            ticker_wheel[cascade[i]] = TICKER_NONE;
+            while (index != TICKER_NONE) {                                                  // For every ticker in slot
+                next = tickers[index].next;                                                 // Saving next ticker
+                ticker_link(index);                                                         // Linking at its new level
+                index = next;                                                               // Moving to next ticker
+            }
+        }
+    }
+    uint16_t slot = (uint16_t)(ticker_time & ((1u << TICKER_WHEEL0_BITS) - 1));             // Declaring due slot
+    index = ticker_wheel[slot];                                                             // Detaching due list
+    ticker_wheel[slot] = TICKER_NONE;
+    while (index != TICKER_NONE) {                                                          // For every due ticker
+        Ticker *ticker = &tickers[index];                                                   // Declaring ticker handle to index
+        next = ticker->next;                                                                // Saving next ticker
+        ticker->bucket = TICKER_NONE;                                                       // Marking unlinked
+        if (ticker->active) {                                                               // For active ticker
+            if (ticker_ready_head - ticker_ready_tail < TICKER_READY_SIZE) {                // Posting to ticker_task
+                ticker_ready[ticker_ready_head & (TICKER_READY_SIZE - 1)] = index;
+                ticker_ready_head++;
+                trace_event(TRACE_QUEUE_PUT, TRACE_OBJECT(TRACE_OBJ_TICKER, 0), ticker_ready_head - ticker_ready_tail);
+                posted = true;                                                              // Flagging task wake
+            } else {                                                                        // For ticker_task falling behind
+                increment_error(ERR_TICKER);                                                // Incrementing ticker error (execution dropped)
+            }
+            if (ticker->count > 0) {                                                        // If not -1 (infinite loop)
+                ticker->count--;                                                            // Decrementing count
+                if (ticker->count == 0) {                                                   // If count reaches end
+                    ticker->active = false;                                                 // Deactivating finished ticker
+                }
+            }
+            if (ticker->active) {                                                           // Re-arming from this tick (no drift)
+                uint32_t period = ticker->period * TICKER_TICKS_PER_UNIT;                   // Declaring period in wheel ticks
+                if (period == 0) period = TICKER_TICKS_PER_UNIT;                            // Period 0 repeats every 10 ms unit
+                ticker->next_execution = ticker_time + period;
+                ticker_link(index);                                                         // Linking for next execution
+            }
+        }
+        index = next;                                                                       // Moving to next ticker
+    }
+    if (posted) {                                                                           // For due tickers
+        trace_event(TRACE_SEM_POST, TRACE_OBJECT(TRACE_OBJ_TICKER, 0), 0);
+        Semaphore_post(tickerSem);                                                          // Waking ticker_task
+    }
+    PERF_END(PERF_SITE_TICKER, start);
+}
+    // Ticker task handler
+void ticker_task(UArg arg0, UArg arg1) {
+    trace_task_name("ticker");                                                              // Naming task in trace dumps
+    while (1) {                                                                             // Infinite loop
+        trace_event(TRACE_SEM_PEND, TRACE_OBJECT(TRACE_OBJ_TICKER, 0), 0);
+        Semaphore_pend(tickerSem, BIOS_WAIT_FOREVER);                                       // Waiting for due tickers
+        trace_event(TRACE_SEM_TAKE, TRACE_OBJECT(TRACE_OBJ_TICKER, 0), 1);
+        while (ticker_ready_tail != ticker_ready_head) {                                    // Draining due tickers in order
+            uint16_t index = ticker_ready[ticker_ready_tail & (TICKER_READY_SIZE - 1)];     // Declaring next due ticker
+            ticker_ready_tail++;                                                            // Releasing ring entry
+            trace_event(TRACE_QUEUE_GET, TRACE_OBJECT(TRACE_OBJ_TICKER, 0), ticker_ready_head - ticker_ready_tail);
+            execute_ticker(index);                                                          // Executing ticker payload
         }
     }
 }
     // Ticker executable
 void execute_ticker(int index) {
     Ticker *ticker = &tickers[index];                                                       // Declaring ticker handle to input index
-    valid_cmd(ticker->uart, ticker->payload);                                               // Executing ticker payload via valid command
-    ticker->next_execution = ticker_time + ticker->period;                                  // Calculating next execution time for current ticker
-    if (ticker->count > 0) {                                                                // If not -1 (infinite loop)
-        ticker->count--;                                                                    // Decrementing count
-        if (ticker->count == 0) {                                                           // If count reaches end
-            ticker->active = false;                                                         // Deactivating finished ticker
-        }
-    }
+    ShellSession *session = &shell_sessions[SESSION_TICKER];                                // Declaring ticker task session
+    bind_session(session, ticker->owner);                                                   // Running for the session that set the ticker
+    execute_command(session, &ticker->compiled, ticker->payload);                           // Executing compiled ticker payload
 }
 
 /* Register operations */
@@ -216,33 +661,74 @@ void init_registers() {
     for (i = 0; i < NUM_REGISTERS; i++) {                                                   // For all usable registers
         snprintf(reg_names[i], MAX_REG_NAME_LENGTH, "R%d", i);                              // Printing register to assigned digit
     }
+    for (i = 0; i < REG_ALIAS_SLOTS; i++) {                                                 // For all alias slots
+        reg_aliases[i].name[0] = '\0';                                                      // Emptying slot
+    }
 }
-    // Register grab
-int32_t get_reg_value(const char *reg_name) {
-    int i;                                                                                  // Declaring loop variable
-    for (i = 0; i < NUM_REGISTERS; i++) {                                                   // For all usable registers
-        if (strcmp(reg_names[i], reg_name) == 0) {                                          // If register is assigned to name
-            return registers[i];                                                            // Return assigned registers
+    // Register alias hash (FNV-1a)
+static uint32_t reg_alias_hash(const char *name) {
+    uint32_t hash = 2166136261u;                                                            // Declaring FNV offset basis
+    while (*name != '\0') {                                                                 // For each name character
+        hash = (hash ^ (uint8_t)*name++) * 16777619u;                                       // Mixing character
+    }
+    return hash & (REG_ALIAS_SLOTS - 1);                                                    // Returning slot
+}
+    // Register index (R0-R31 parsed directly, aliases hashed)
+int reg_index(const char *name) {
+    if (name[0] == 'R' && name[1] >= '0' && name[1] <= '9') {                               // For Rn names
+        int index = name[1] - '0';                                                          // Declaring first digit
+        if (name[2] == '\0') {                                                              // For R0-R9
+            return index;                                                                   // Returning register index
+        }
+        if (index != 0 && name[2] >= '0' && name[2] <= '9' && name[3] == '\0') {            // For R10-R99 (no leading zero)
+            index = index * 10 + (name[2] - '0');                                           // Declaring two-digit index
+            return (index < NUM_REGISTERS) ? index : -1;                                    // Returning register index
+        }
+        return -1;                                                                          // Returning -1 for malformed Rn
+    }
+    uint32_t slot = reg_alias_hash(name);                                                   // Hashing alias name
+    int probes;                                                                             // Declaring probe count
+    for (probes = 0; probes < REG_ALIAS_SLOTS && reg_aliases[slot].name[0] != '\0'; probes++) {
+        if (strcmp(reg_aliases[slot].name, name) == 0) {                                    // For matching alias
+            return reg_aliases[slot].index;                                                 // Returning aliased register index
         }
+        slot = (slot + 1) & (REG_ALIAS_SLOTS - 1);                                          // Moving to next slot
     }
-    return 0;                                                                               // Return 0 if register not found
+    return -1;                                                                              // Returning -1 if register not found
 }
-    // Register set
-void set_reg_value(const char *reg_name, int32_t value) {
-    int i;                                                                                  // Declaring loop variable
-    for (i = 0; i < NUM_REGISTERS; i++) {                                                   // For all usable registers
-        if (strcmp(reg_names[i], reg_name) == 0) {                                          // If register is assigned to name
-            registers[i] = value;                                                           // Declaring set register to value
-            return;                                                                         // Return from loop
+    // Register alias set
+bool set_reg_alias(const char *name, int index) {
+    uint32_t slot = reg_alias_hash(name);                                                   // Hashing alias name
+    int probes;                                                                             // Declaring probe count
+    for (probes = 0; probes < REG_ALIAS_SLOTS; probes++) {                                  // Probing for name or empty slot
+        if (reg_aliases[slot].name[0] == '\0' || strcmp(reg_aliases[slot].name, name) == 0) {
+            strncpy(reg_aliases[slot].name, name, MAX_REG_NAME_LENGTH - 1);                 // Storing alias name
+            reg_aliases[slot].name[MAX_REG_NAME_LENGTH - 1] = '\0';                         // Ensuring NULL of alias name
+            reg_aliases[slot].index = (int8_t)index;                                        // Storing register index
+            return true;                                                                    // Returning stored alias
         }
+        slot = (slot + 1) & (REG_ALIAS_SLOTS - 1);                                          // Moving to next slot
+    }
+    return false;                                                                           // Returning false if table is full
+}
+    // Register grab
+int32_t get_reg_value(const ShellSession *session, const char *reg_name) {
+    int index = reg_index(reg_name);                                                        // Resolving register index
+    return (index >= 0) ? registers[session->bank][index] : 0;                              // Return 0 if register not found
+}
+    // Register set
+void set_reg_value(ShellSession *session, const char *reg_name, int32_t value) {
+    int index = reg_index(reg_name);                                                        // Resolving register index
+    if (index >= 0) {                                                                       // If register is assigned to name
+        registers[session->bank][index] = value;                                            // Declaring set register to value
     }
 }
     // Register immediate constant
-int32_t parse_operand(const char *operand) {
+int32_t parse_operand(const ShellSession *session, const char *operand) {
     if (operand[0] == '#') {                                                                // If immediate '#' detected
         return atoi(operand + 1);                                                           // Parse immediate value
     } else {                                                                                // If not immediate
-        return get_reg_value(operand);                                                      // Get register value
+        return get_reg_value(session, operand);                                             // Get register value
     }
 }
 
@@ -251,10 +737,8 @@ int32_t parse_operand(const char *operand) {
 void init_script_system(void) {
     Semaphore_Params semParams;                                                             // Creating semaphore for script execution
     Semaphore_Params_init(&semParams);                                                      // Declaring semaphore parameter initialization
+    semParams.mode = Semaphore_Mode_BINARY;                                                 // One wake runs from the current program counter
     scriptSem = Semaphore_create(0, &semParams, NULL);                                      // Declaring script semaphore
-    Queue_Params queueParams;                                                               // Creating queue for script commands
-    Queue_Params_init(&queueParams);                                                        // Declaring queue parameter to initialization parameter
-    scriptQueue = Queue_create(NULL, NULL);                                                 // Declaring script queue as NULL
     Task_Params taskParams;                                                                 // Creating script execution task
     Task_Params_init(&taskParams);                                                          // Declaring task parameter
     taskParams.stackSize = SCRIPT_TASK_STACK_SIZE;                                          // Declaring task stack size
@@ -266,176 +750,705 @@ void init_script_system(void) {
         return;                                                                             // Return from loop
     }
 }
-    // Script task handler
+    // "-script <line> x" call target (-1 for other lines)
+static int script_call_target(const char *command) {
+    int line_num;                                                                           // Declaring line number variable
+    char execute_flag[2];                                                                   // Declaring execution flags
+    if (strncmp(command, "-script", 7) != 0) {                                              // If not a script command
+        return -1;                                                                          // Returning no target
+    }
+    const char *args = command + 7;                                                         // Declaring argument pointer
+    while (*args == ' ') args++;                                                            // Skip whitespaces to arguments
+    if (sscanf(args, "%d %1s", &line_num, execute_flag) == 2 && execute_flag[0] == 'x' &&
+        line_num >= 0 && line_num < SCRIPT_SIZE) {                                          // Declaring scanner to execution variables in script space
+        return line_num;                                                                    // Returning target line
+    }
+    return -1;                                                                              // Returning no target
+}
+    // Script task handler (runs script_space in place from script_pc)
 void script_task(UArg arg0, UArg arg1) {
+    trace_task_name("script");                                                              // Naming task in trace dumps
     while (1) {                                                                             // Infinite loop
+        trace_event(TRACE_SEM_PEND, TRACE_OBJECT(TRACE_OBJ_SCRIPT, 0), 0);
         Semaphore_pend(scriptSem, BIOS_WAIT_FOREVER);                                       // Waiting for semaphore signal
-        while (!Queue_empty(scriptQueue)) {                                                 // Processing commands in queue
-            Queue_Elem *elem = Queue_get(scriptQueue);                                      // Getting next command from queue
-            ScriptQueueElement *queueElem = (ScriptQueueElement *)elem;                     // Declaring script element to queue pointer
-            script_uart = queueElem->cmd.uart;                                              // Storing UART handle
-            if (queueElem->cmd.command[0] != '\0') {                                        // Execute the command
-                char cmd_copy[MAX_CMD_LENGTH];                                              // Declaring copied command as array variable
-                strncpy(cmd_copy, queueElem->cmd.command, MAX_CMD_LENGTH-1);                // Check if this is a script execution command before executing
-                cmd_copy[MAX_CMD_LENGTH-1] = '\0';                                          // Declaring execution tabs to copied command array
-                if (strncmp(cmd_copy, "-script", 7) == 0) {                                 // If its a script command to execute
-                    char *args = cmd_copy + 7;                                              // Declaring argument pointer
-                    while (*args == ' ') args++;                                            // Skip whitespaces to arguments
-                    int line_num;                                                           // Declaring line number variable
-                    char execute_flag[2];                                                   // Declaring execution flags
-                    if (sscanf(args, "%d %1s", &line_num, execute_flag) == 2 && execute_flag[0] == 'x' &&
-                        line_num >= 0 && line_num < SCRIPT_SIZE) {                          // Declaring scanner to execution variables in script space
-                        if (strncmp(script_space[line_num], "-script", 7) == 0) {           // For infinite loop (when script executes another script)
-                            queue_script_command(script_space[line_num]);                   // Queue the command from current line
-                            queue_script_command(queueElem->cmd.command);                   // Re-queue the original script command to maintain the loop
-                        } else {                                                            // For sequential execution
-                            int current_line = line_num;                                    // Queue all subsequent non-empty commands
-                            while (current_line < SCRIPT_SIZE && script_space[current_line][0] != '\0') {
-                                queue_script_command(script_space[current_line]);           // Declaring queue script in script space to each script line
-                                current_line++;                                             // Incrementing from current line
-                            }
-                        }
-                    }
-                } else {                                                                    // Execute non-script commands normally
-                    valid_cmd(script_uart, queueElem->cmd.command);                         // Declaring valid command processing to script space through UART to elements in queue
+        trace_event(TRACE_SEM_TAKE, TRACE_OBJECT(TRACE_OBJ_SCRIPT, 0), 1);
+        is_script_executing = true;                                                         // Declaring active script flag (program or interpreter)
+        if (program_start >= 0) {                                                           // For a new execute_script request
+            int start = program_start;                                                      // Declaring start line
+            uint32_t generation = program_generation;                                       // Declaring request being served
+            program_start = -1;                                                             // Consuming request
+            if (compile_program(start)) {                                                   // For -reg/-if/-rem/-script x only scripts (program[] only written here)
+                if (program_generation == generation) {                                     // For no newer request while compiling
+                    run_program(program_line_pc[start], generation);                        // Running until END or a new request
                 }
+            } else if (program_generation == generation) {                                  // For other scripts
+                script_pc = start;                                                          // Running script_space in place
             }
-            free(queueElem);                                                                // Free the queue element
-            Task_sleep(20);                                                                 // Add a small delay between commands
         }
+        int lines = 0;                                                                      // Declaring slice line count
+        while (script_pc >= 0 && !script_stop) {                                            // Until the run ends or stop_script
+            int line = script_pc;                                                           // Declaring current line
+            if (line >= SCRIPT_SIZE || script_space[line][0] == '\0') {                     // For end of run (empty line)
+                script_pc = (script_depth > 0) ? script_frames[--script_depth] : -1;        // Returning to caller or finishing
+                continue;
+            }
+            script_pc = line + 1;                                                           // Advancing before execution (commands may redirect)
+            int target = script_call_target(script_space[line]);                            // Declaring nested -script <line> x
+            if (target < 0) {                                                               // Execute non-script commands normally
+                execute_command(script_session, &script_compiled[line], script_space[line]);
+            } else if (script_pc >= SCRIPT_SIZE || script_space[script_pc][0] == '\0') {    // For last line of a run (loops)
+                script_pc = target;                                                         // Jumping without a frame
+            } else if (script_depth < SCRIPT_CALL_DEPTH) {                                  // For nested call
+                script_frames[script_depth++] = (int8_t)script_pc;                          // Taking a frame for the return line
+                if (script_depth > script_depth_high) {                                     // For new high-water mark
+                    script_depth_high = script_depth;                                       // Recording high-water mark
+                }
+                script_pc = target;                                                         // Calling target run
+            } else {                                                                        // For exhausted frame pool
+                script_overflows++;                                                         // Counting overflow
+                increment_error(ERR_SCRIPT);                                                // Incrementing script error
+                snprintf(script_session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Script calls nested deeper than %d.\r\n", SCRIPT_CALL_DEPTH);
+                uart_output(script_session->uart, script_session->prompt, strlen(script_session->prompt)); // Writing from UART
+                script_pc = -1;                                                             // Ending script
+            }
+            script_lines++;                                                                 // Counting executed line
+            if (++lines >= SCRIPT_SLICE_LINES) {                                            // For spent time slice
+                lines = 0;                                                                  // Starting next slice
+                Task_sleep(1);                                                              // Letting lower-priority tasks run
+            }
+        }
+        if (script_stop) {                                                                  // For stop_script
+            script_pc = -1;                                                                 // Dropping program counter
+        }
+        script_depth = 0;                                                                   // Releasing all frames
+        is_script_executing = false;                                                        // Declaring script finished
     }
-}
-    // Queue script command
-bool queue_script_command(const char *command) {
-    if (strlen(command) >= MAX_CMD_LENGTH) {                                                // If processed command is greater than or equal to max command length
-        return false;                                                                       // Return false flag from loop
-    }
-    ScriptQueueElement *queueElem = malloc(sizeof(ScriptQueueElement));                     // Declaring script queue pointer to elements via malloc
-    if (!queueElem) {                                                                       // If queue element not detected
-        return false;                                                                       // Return false flag from loop
-    }
-    strncpy(queueElem->cmd.command, command, MAX_CMD_LENGTH - 1);                           // Copying elements in queue command
-    queueElem->cmd.command[MAX_CMD_LENGTH - 1] = '\0';                                      // Executing tabs to queue elements
-    queueElem->cmd.uart = script_uart;                                                      // Executing UART to queue elements
-    Queue_put(scriptQueue, &queueElem->elem);                                               // Putting queue elements to script space
-    return true;                                                                            // Return true flag from loop
 }
     // Execute script
-void execute_script(UART_Handle uart, int start_line) {
-    while (!Queue_empty(scriptQueue)) {                                                     // Clear any existing queue
-        Queue_Elem *elem = Queue_get(scriptQueue);                                          // Declaring element pointer in queue
-        free((ScriptQueueElement *)elem);                                                   // Freeing elements in script queue
-    }
-    script_uart = uart;                                                                     // Store UART handle for the script task
-    int current_line = start_line;                                                          // Queue all commands from start_line until we hit an empty line
-    while (current_line < SCRIPT_SIZE && script_space[current_line][0] != '\0') {           // While current line in script line isn't tabbed/executed
-        if (!queue_script_command(script_space[current_line])) {                            // If queue command not in script space
-            increment_error(ERR_SCRIPT);                                                    // Incrementing script error
-            snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Failed to queue script command.\r\n");
-            UART_write(uart, user_prompt, strlen(user_prompt));                             // Writing from UART
-            return;                                                                         // Return from loop
-        }
-        current_line++;                                                                     // Incrementing current line
-    }
-    script_stop = false;                                                                    // Post to semaphore to start execution
+void execute_script(ShellSession *session, int start_line) {
+    if (session != script_session) {                                                        // For a script started from another session
+        bind_session(script_session, session);                                              // Running the script for the launching session
+    }
+    script_stop = false;                                                                    // Clearing stop request
+    script_depth = 0;                                                                       // Releasing all frames (restart)
+    program_generation++;                                                                   // Stopping any running micro-program
+    script_pc = -1;                                                                         // Stopping the line interpreter
+    program_start = start_line;                                                             // Requesting a run (script_task compiles it)
+    trace_event(TRACE_SEM_POST, TRACE_OBJECT(TRACE_OBJ_SCRIPT, 0), 0);
     Semaphore_post(scriptSem);                                                              // Declaring semaphore post to script space
 }
     // Stop script
 void stop_script(void) {
     script_stop = true;                                                                     // Declaring script stop flag as true
+    program_start = -1;                                                                     // Dropping a pending micro-program
+    program_generation++;                                                                   // Stopping a running micro-program
 }
 
 /* Conditional operations */
-    // Evaluation condition
-bool evaluate_condition(UART_Handle uart, const char *operand1, const char *condition, const char *operand2) {
-    int32_t value1, value2;                                                                 // Declaring condition values
-    char reg_name[MAX_REG_NAME_LENGTH];                                                     // Declaring reg array
-    snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nDebug: evaluating: %s %s %s\r\n",          // Debug print for input values (noting correct order)
-             operand1, condition, operand2);
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Writing from uart
-    if (operand1[0] == '#') {                                                               // Parse first operand
-        value1 = atoi(operand1 + 1);                                                        // Pointing value1 variable to operand
-    } else if (strncmp(operand1, "R", 1) == 0) {                                            // For register input
-        value1 = get_reg_value(operand1);                                                   // Declaring value1 to register value operand
-    } else {                                                                                // For single register
-        snprintf(reg_name, MAX_REG_NAME_LENGTH, "R%s", operand1);                           // Printing register status
-        value1 = get_reg_value(reg_name);                                                   // Pointing value1 variable to operand
-    }
-    if (operand2[0] == '#') {                                                               // Parse second operand (operand2, not condition)
-        value2 = atoi(operand2 + 1);                                                        // Declaring value2 variable converting operand to string
-    } else if (strncmp(operand2, "R", 1) == 0) {                                            // For detected register
-        value2 = get_reg_value(operand2);                                                   // Declaring value2 from register value
-    } else {                                                                                // For register and string detected
-        snprintf(reg_name, MAX_REG_NAME_LENGTH, "R%s", operand2);                           // Printing register status
-        value2 = get_reg_value(reg_name);                                                   // Declaring value2 variable to register value
-    }
-    snprintf(user_prompt, USER_PROMPT_SIZE, "Debug: values: %d %s %d\r\n",                  // Debug print for parsed values
-             value1, condition, value2);
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Writing from uart
-    bool result = false;                                                                    // Evaluate condition ('condition' parameter)
-    if (strcmp(condition, ">") == 0) {                                                      // For >
-        result = value1 > value2;                                                           // Declaring result variable
-    } else if (strcmp(condition, "=") == 0) {                                               // For =
-        result = value1 == value2;                                                          // Declaring result variable
-    } else if (strcmp(condition, "<") == 0) {                                               // For <
-        result = value1 < value2;                                                           // Declaring result variable
-    }
-    snprintf(user_prompt, USER_PROMPT_SIZE, "Debug: result: %d\r\n", result);               // Debug print for result
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Writing from uart
-    return result;                                                                          // Return result variable
-}
-    // Execute conditional destination
-void execute_conditional_dest(UART_Handle uart, const char *dest, bool is_true) {
-    if (dest == NULL || strlen(dest) == 0) {                                                // If destination is null/empty
-        return;                                                                             // Returning nothing
+static const uint8_t if_precedence[IF_NODE_COUNT] = {                                       // Declaring binding strength (IF_NODE_* order, C-like)
+    0, 0, 6, 6, 6, 5, 5, 4, 4, 4, 4, 3, 3, 2, 1
+};
+typedef struct {
+    char text[3];                                                                           // Declaring operator spelling
+    uint8_t code;                                                                           // Declaring node kind
+} IfOperator;                                                                               // Declaring struct name as IfOperator
+static const IfOperator if_operators[] = {                                                  // Declaring operators (two-character spellings first)
+    { "<=", IF_NODE_LE }, { ">=", IF_NODE_GE }, { "==", IF_NODE_EQ }, { "!=", IF_NODE_NE },
+    { "&&", IF_NODE_AND }, { "||", IF_NODE_OR }, { "<", IF_NODE_LT }, { ">", IF_NODE_GT },
+    { "=", IF_NODE_EQ }, { "+", IF_NODE_ADD }, { "-", IF_NODE_SUB }, { "*", IF_NODE_MUL },
+    { "/", IF_NODE_DIV }, { "%", IF_NODE_REM }
+};
+    // Node append
+static bool if_emit(IfExpr *expr, uint8_t code, uint8_t arg) {
+    if (expr->count >= IF_EXPR_NODES) {                                                     // For oversized condition
+        expr->limit = IF_LIMIT_NODES;                                                       // Reporting the node limit
+        return false;                                                                       // Returning failed append
+    }
+    expr->code[expr->count] = code;                                                         // Storing node kind
+    expr->arg[expr->count++] = arg;                                                         // Storing node argument
+    return true;                                                                            // Returning appended node
+}
+static bool if_parse(const char **pos, IfExpr *expr, uint8_t min_precedence);
+    // Operand parse (#imm, register, bare register number, alias or parenthesis)
+static bool if_parse_operand(const char **pos, IfExpr *expr) {
+    char name[MAX_REG_NAME_LENGTH];                                                         // Declaring register name
+    const char *start = *pos;                                                               // Declaring token start
+    char *endptr;                                                                           // Declaring number end pointer
+    size_t length = 0;                                                                      // Declaring name length
+    while (*start == ' ') start++;                                                          // Skipping whitespaces
+    if (*start == '(') {                                                                    // For parenthesis
+        *pos = start + 1;                                                                   // Consuming '('
+        if (!if_parse(pos, expr, 1)) {                                                      // Parsing inner condition
+            return false;                                                                   // Returning failed parse
+        }
+        while (**pos == ' ') (*pos)++;                                                      // Skipping whitespaces
+        return *(*pos)++ == ')';                                                            // Consuming ')'
+    }
+    if (*start == '#') {                                                                    // For immediate value
+        long value = strtol(start + 1, &endptr, 10);                                        // Parsing immediate once
+        if (endptr == start + 1) {                                                          // For missing digits
+            return false;                                                                   // Returning failed parse
+        }
+        if (expr->imm_count >= IF_EXPR_IMMS) {                                              // For full immediates
+            expr->limit = IF_LIMIT_IMMS;                                                    // Reporting the immediate limit
+            return false;                                                                   // Returning failed parse
+        }
+        expr->imm[expr->imm_count] = (int32_t)value;                                        // Storing immediate
+        *pos = endptr;                                                                      // Consuming immediate
+        return if_emit(expr, IF_NODE_IMM, expr->imm_count++);
     }
-    char *endptr;                                                                           // Declaring variable to check if destination is a script line number
-    long line_num = strtol(dest, &endptr, 10);                                              // Convert string to long
-    if (*endptr == '\0') {                                                                  // If conversion was successful
-        if (line_num >= 0 && line_num < SCRIPT_SIZE) {                                      // Valid script line
-            if (script_space[line_num][0] != '\0') {                                        // If line is not empty
-                valid_cmd(uart, script_space[line_num]);                                    // Executing this line
+    if (*start >= '0' && *start <= '9') {                                                   // For bare register number ("5" reads R5)
+        name[length++] = 'R';
+    }
+    while ((isalnum((unsigned char)*start) || *start == '_') && length < sizeof(name) - 1) {
+        name[length++] = *start++;                                                          // Copying register name
+    }
+    name[length] = '\0';                                                                    // Ensuring NULL of name
+    int reg = (isalnum((unsigned char)*start) || *start == '_') ? -1 : reg_index(name);     // Resolving register once (oversized names fail)
+    if (reg < 0) {                                                                          // For unknown register
+        return false;                                                                       // Returning failed parse
+    }
+    *pos = start;                                                                           // Consuming name
+    return if_emit(expr, IF_NODE_REG, (uint8_t)reg);
+}
+    // Condition parse (precedence climbing into reverse Polish)
+static bool if_parse(const char **pos, IfExpr *expr, uint8_t min_precedence) {
+    if (!if_parse_operand(pos, expr)) {                                                     // Parsing left operand
+        return false;                                                                       // Returning failed parse
+    }
+    while (1) {                                                                             // For each binary operator
+        const IfOperator *op = NULL;                                                        // Declaring matched operator
+        size_t i;                                                                           // Declaring loop variable
+        while (**pos == ' ') (*pos)++;                                                      // Skipping whitespaces
+        for (i = 0; i < sizeof(if_operators) / sizeof(if_operators[0]); i++) {              // Matching operator spelling
+            size_t length = strlen(if_operators[i].text);                                   // Declaring spelling length
+            if (strncmp(*pos, if_operators[i].text, length) == 0) {
+                op = &if_operators[i];
+                break;
             }
         }
-    } else {                                                                                // Not line number (treated as command)
-        valid_cmd(uart, (char *)dest);                                                      // Execute as regular command
+        if (op == NULL || if_precedence[op->code] < min_precedence) {                       // For end of this precedence level
+            return true;                                                                    // Returning parsed operand
+        }
+        *pos += strlen(op->text);                                                           // Consuming operator
+        if (!if_parse(pos, expr, if_precedence[op->code] + 1) || !if_emit(expr, op->code, 0)) {
+            return false;                                                                   // Returning failed parse
+        }
+    }
+}
+    // Condition compile (returns NULL or the error text)
+#define IF_LIMIT_TEXT(value) #value                                                         // Defining limit spelling for error text
+#define IF_LIMIT_VALUE(value) IF_LIMIT_TEXT(value)
+static const char *if_compile_expr(const char *start, const char *end, IfExpr *expr) {
+    static const char invalid[] = "Invalid condition (operands: Rn, n, alias, #imm)";       // Declaring syntax error
+    const char *pos = expr->text;                                                           // Declaring parse position
+    while (start < end && *start == ' ') start++;                                           // Trimming leading spaces
+    while (end > start && *(end - 1) == ' ') end--;                                         // Trimming trailing spaces
+    if (end == start) {                                                                     // For empty condition
+        return invalid;                                                                     // Returning failed compile
+    }
+    if ((size_t)(end - start) >= IF_COND_LENGTH) {                                          // For oversized condition
+        return "Condition too long (" IF_LIMIT_VALUE(IF_COND_LENGTH) " characters or more)";
+    }
+    memcpy(expr->text, start, end - start);                                                 // Copying condition text
+    expr->text[end - start] = '\0';                                                         // Ensuring NULL of condition text
+    expr->count = 0;                                                                        // Clearing nodes
+    expr->imm_count = 0;                                                                    // Clearing immediates
+    expr->limit = 0;                                                                        // Clearing limit
+    if (!if_parse(&pos, expr, 1)) {                                                         // Parsing whole condition
+        if (expr->limit == IF_LIMIT_IMMS) {                                                 // For too many immediates
+            return "Too many immediates in condition (more than " IF_LIMIT_VALUE(IF_EXPR_IMMS) ")";
+        }
+        if (expr->limit == IF_LIMIT_NODES) {                                                // For too many operands and operators
+            return "Condition too complex (more than " IF_LIMIT_VALUE(IF_EXPR_NODES) " operands and operators)";
+        }
+        return invalid;                                                                     // Returning failed compile
+    }
+    while (*pos == ' ') pos++;                                                              // Skipping whitespaces
+    return (*pos == '\0') ? NULL : invalid;                                                 // Returning compiled (no trailing text)
+}
+    // Destination resolve (script line number or command span)
+static void if_resolve_dest(const char *text, const char *start, const char *end, CompiledCommand *compiled, int side) {
+    char *endptr;                                                                           // Declaring number end pointer
+    while (start < end && *start == ' ') start++;                                           // Trimming leading spaces
+    while (end > start && *(end - 1) == ' ') end--;                                         // Trimming trailing spaces
+    compiled->src[side] = IF_DEST_NONE;                                                     // Defaulting to nothing to execute
+    if (end == start) {                                                                     // For empty destination
+        return;                                                                             // Returning from function
+    }
+    long line = strtol(start, &endptr, 10);                                                 // Checking for a script line number
+    if (endptr != end) {                                                                    // For command destination
+        compiled->src[side] = IF_DEST_TEXT;                                                 // Executing the span from the text
+        compiled->imm[side] = (int32_t)(((start - text) << 16) | (end - start));            // Storing span offset and length
+    } else if (line >= 0 && line < SCRIPT_SIZE) {                                           // For valid script line
+        compiled->src[side] = (uint8_t)line;                                                // Storing script line
+    }
+}
+    // -if compile (returns NULL or the error text)
+const char *compile_if(const char *text, const char *args, IfExpr *expr, CompiledCommand *compiled) {
+    const char *question_mark = strchr(args, '?');                                          // Parsing conditional part '?'
+    const char *colon = (question_mark != NULL) ? strchr(question_mark, ':') : NULL;        // Parsing conditional part ':'
+    memset(compiled, 0, sizeof(*compiled));                                                 // Defaulting to CMD_OP_TEXT
+    if (colon == NULL) {                                                                    // For missing ? or :
+        return "Invalid if syntax. Missing ? or :";
+    }
+    const char *error = if_compile_expr(args, question_mark, expr);                         // Compiling condition once
+    if (error != NULL) {                                                                    // For invalid or over-limit condition
+        return error;                                                                       // Returning condition error
+    }
+    if_resolve_dest(text, question_mark + 1, colon, compiled, 0);                           // Resolving true destination
+    if_resolve_dest(text, colon + 1, colon + strlen(colon), compiled, 1);                   // Resolving false destination
+    compiled->opcode = CMD_OP_IF;                                                           // Conditional operation
+    return NULL;                                                                            // Returning compiled -if
+}
+    // Condition node match (aliases are resolved at compile time, so equal text may differ)
+static bool if_same_nodes(const IfExpr *a, const IfExpr *b) {
+    return a->count == b->count && a->imm_count == b->imm_count &&
+           memcmp(a->code, b->code, a->count) == 0 && memcmp(a->arg, b->arg, a->count) == 0 &&
+           memcmp(a->imm, b->imm, a->imm_count * sizeof(a->imm[0])) == 0;
+}
+    // Condition interning (identical conditions share a counted slot, -1 when full)
+static int if_intern(const IfExpr *expr) {
+    const char *name = expr->text;                                                          // Declaring hash cursor
+    uint32_t hash = 2166136261u;                                                            // Declaring FNV offset basis
+    int i, slot = -1;                                                                       // Declaring loop and slot variables
+    while (*name != '\0') {                                                                 // For each condition character
+        hash = (hash ^ (uint8_t)*name++) * 16777619u;                                       // Mixing character
+    }
+    hash &= IF_EXPR_SLOTS - 1;                                                              // Declaring home slot
+    UInt key = Hwi_disable();                                                               // Holding off other compiling tasks
+    for (i = 0; i < IF_EXPR_SLOTS; i++) {                                                   // Probing every slot once (released slots leave gaps)
+        int probe = (int)((hash + i) & (IF_EXPR_SLOTS - 1));                                // Declaring candidate slot
+        IfExpr *entry = &if_exprs[probe];
+        if (entry->text[0] == '\0') {                                                       // For free slot
+            if (slot < 0) slot = probe;                                                     // Remembering first free slot
+        } else if (strcmp(entry->text, expr->text) == 0 && if_same_nodes(entry, expr)) {    // For same condition and resolved registers
+            slot = probe;
+            break;
+        }
+    }
+    if (slot >= 0) {                                                                        // For shared or free slot
+        if (if_exprs[slot].text[0] == '\0') {                                               // For free slot
+            if_exprs[slot] = *expr;                                                         // Storing condition
+            if_exprs[slot].refs = 0;
+        }
+        if_exprs[slot].refs++;                                                              // Counting user
+    }
+    Hwi_restore(key);                                                                       // Restoring interrupts
+    return slot;                                                                            // Returning slot
+}
+    // Condition release (slot freed with its last user)
+static void if_release(int slot) {
+    UInt key = Hwi_disable();                                                               // Holding off other compiling tasks
+    if (if_exprs[slot].refs > 0 && --if_exprs[slot].refs == 0) {                            // For last user
+        if_exprs[slot].text[0] = '\0';                                                      // Freeing slot
+    }
+    Hwi_restore(key);                                                                       // Restoring interrupts
+}
+    // Condition evaluation
+int32_t evaluate_if(const ShellSession *session, const IfExpr *expr) {
+    int32_t stack[IF_EXPR_NODES];                                                           // Declaring value stack
+    const int32_t *bank = registers[session->bank];                                         // Declaring session register bank
+    int i, top = 0;                                                                         // Declaring loop and stack variables
+    for (i = 0; i < expr->count; i++) {                                                     // For each node
+        uint8_t code = expr->code[i];                                                       // Declaring node kind
+        if (code == IF_NODE_REG) {                                                          // For register operand
+            stack[top++] = bank[expr->arg[i]];
+            continue;
+        }
+        if (code == IF_NODE_IMM) {                                                          // For immediate operand
+            stack[top++] = expr->imm[expr->arg[i]];
+            continue;
+        }
+        int32_t b = stack[--top], a = stack[top - 1];                                       // Declaring operator inputs
+        int32_t result;                                                                     // Declaring operator result
+        switch (code) {                                                                     // Declaring switch for operators
+            case IF_NODE_MUL: result = (int32_t)((uint32_t)a * (uint32_t)b); break;         // Wrapping (signed overflow is undefined)
+            case IF_NODE_DIV:
+            case IF_NODE_REM:
+                if (b == 0 || (b == -1 && a == INT32_MIN)) {                                // Declaring division by 0 or overflow (evaluates as 0)
+                    increment_error(ERR_IF);                                                // Increment conditional error
+                    result = 0;
+                } else {
+                    result = (code == IF_NODE_DIV) ? a / b : a % b;
+                }
+                break;
+            case IF_NODE_ADD: result = (int32_t)((uint32_t)a + (uint32_t)b); break;
+            case IF_NODE_SUB: result = (int32_t)((uint32_t)a - (uint32_t)b); break;
+            case IF_NODE_LT: result = a < b; break;
+            case IF_NODE_LE: result = a <= b; break;
+            case IF_NODE_GT: result = a > b; break;
+            case IF_NODE_GE: result = a >= b; break;
+            case IF_NODE_EQ: result = a == b; break;
+            case IF_NODE_NE: result = a != b; break;
+            case IF_NODE_AND: result = a && b; break;
+            default: result = a || b; break;                                                // IF_NODE_OR
+        }
+        stack[top - 1] = result;                                                            // Replacing inputs with result
+    }
+    return stack[0];                                                                        // Returning condition value
+}
+    // Condition trace (-debug 1 and up)
+static void if_trace(ShellSession *session, const IfExpr *expr, int32_t value) {
+    snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nDebug: if %s -> %ld (%s)\r\n",         // Debug print for evaluated condition
+             expr->text, (long)value, value ? "true" : "false");
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from uart
+}
+    // Destination span copy
+static void if_dest_text(const char *text, int32_t span, char *out) {
+    size_t length = (size_t)(span & 0xFFFF);                                                // Declaring span length
+    memcpy(out, text + (span >> 16), length);                                               // Copying destination command
+    out[length] = '\0';                                                                     // Ensuring NULL of destination
+}
+    // Execute compiled -if
+void execute_if(ShellSession *session, const CompiledCommand *compiled, const IfExpr *expr, char *text) {
+    char dest[MAX_CMD_LENGTH];                                                              // Declaring command destination copy
+    int32_t value = evaluate_if(session, expr);                                             // Evaluating condition
+    int side = value ? 0 : 1;                                                               // Declaring taken destination
+    uint8_t line = compiled->src[side];                                                     // Declaring destination line or IF_DEST_*
+    if (session->verbosity > 0) {                                                           // For enabled tracing
+        if_trace(session, expr, value);
+    }
+    if (line == IF_DEST_NONE) {                                                             // For empty destination
+        return;                                                                             // Returning nothing
+    }
+    if (line == IF_DEST_TEXT) {                                                             // For command destination
+        if_dest_text(text, compiled->imm[side], dest);
+        if (session->verbosity > 1) {                                                       // For destination tracing
+            snprintf(session->prompt, USER_PROMPT_SIZE, "Debug: if destination '%s'\r\n", dest);
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing from uart
+        }
+        valid_cmd(session, dest);                                                           // Execute as regular command
+    } else if (script_space[line][0] != '\0') {                                             // For non-empty script line
+        if (session->verbosity > 1) {                                                       // For destination tracing
+            snprintf(session->prompt, USER_PROMPT_SIZE, "Debug: if destination line %d\r\n", line);
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing from uart
+        }
+        execute_command(session, &script_compiled[line], script_space[line]);               // Executing this line
     }
 }
 
 /* Sine operations */
-    // Set frequency for sine wave
-void set_sine_frequency(uint32_t freq) {
-    if (freq > (sample_rate / 2)) {                                                         // Check Nyquist limit
+    // Set frequency for sine wave (millihertz, phase step = f / fs * 2^32)
+void set_sine_frequency(uint32_t millihertz) {
+    if (millihertz > sample_rate * (SINE_MILLIHERTZ / 2)) {                                 // Check Nyquist limit
         increment_error(ERR_SINE);                                                          // Incrementing sine error
         return;                                                                             // Return for loop
     }
-    phase_increment = (freq * LUT_SIZE * 125) / 1000000.0;                                  // New formula based on the timer period (125 microseconds)
+    phase_increment = (uint32_t)(((uint64_t)millihertz << 32) / ((uint64_t)sample_rate * SINE_MILLIHERTZ));
+}
+    // Select table lookup (nearest entry or linear interpolation)
+void set_sine_interpolation(bool interpolate) {
+    sine_interpolate = interpolate;                                                         // Declaring lookup mode
+}
+    // Select waveform, amplitude and offset (taken at the next phase wrap, so the output never jumps)
+void set_sine_wave(int wave, uint32_t amplitude, int32_t offset) {
+    WaveShape shape;                                                                        // Declaring new shape
+    shape.table = (wave == WAVE_TRIANGLE) ? waveTriangle : (wave == WAVE_SAW) ? waveSaw :
+                  (wave == WAVE_SQUARE) ? waveSquare : (wave == WAVE_ARB) ? wave_arbitrary[wave_loaded] : waveSine;
+    shape.gain = (int32_t)(amplitude * WAVE_GAIN_FULL / 100);                               // Declaring gain (Q15)
+    shape.offset = WAVE_OFFSET_MID + offset * WAVE_OFFSET_MID / 100;                        // Declaring mid-point (DAC code)
+    UInt key = Hwi_disable();                                                               // Holding off the DAC task mid-copy
+    wave_next = shape;                                                                      // Publishing shape
+    wave_switch = true;
+    Hwi_restore(key);
+    wave_selected = (uint8_t)wave;                                                          // Declaring selection
+    wave_amplitude = amplitude;
+    wave_offset = offset;
+}
+    // Take a pending shape
+static void wave_take(void) {
+    wave_shape = wave_next;                                                                 // Declaring shape being generated
+    wave_switch = false;
+    wave_switches++;                                                                        // Counting switch
+}
+    // Next DAC sample (top phase bits index the table, the next 15 bits interpolate; same work for every waveform)
+uint16_t sine_sample(void) {
+    uint32_t phase = phase_accumulator;                                                     // Declaring current phase
+    uint32_t index = phase >> WAVE_INDEX_SHIFT;                                             // Declaring table index
+    const int16_t *table = wave_shape.table;                                                // Declaring waveform table
+    int32_t sample = table[index];                                                          // Get value directly from lookup table
+    if (sine_interpolate) {                                                                 // For interpolation (table[WAVE_TABLE_SIZE] closes the cycle)
+        int32_t fraction = (int32_t)((phase >> (WAVE_INDEX_SHIFT - 15)) & 0x7FFF);          // Declaring position between entries (Q15)
+        sample += ((table[index + 1] - sample) * fraction) >> 15;                           // Interpolating toward the next entry
+    }
+    int32_t code = wave_shape.offset + ((sample * wave_shape.gain) >> 17);                  // Scaling Q15 to the 14-bit half scale
+    code = (code < 0) ? 0 : (code > WAVE_DAC_MAX) ? WAVE_DAC_MAX : code;                    // Clipping to the DAC range
+    phase_accumulator = phase + phase_increment;                                            // Phase accumulator wraps at one cycle
+    if (phase_accumulator < phase && wave_switch) wave_take();                              // Switching shape at the wrap (every shape starts at phase 0)
+    return (uint16_t)code;                                                                  // Format for DAC8311: Upper 2 bits must be 0, followed by 14-bit data
+}
+
+/* Tone mixer operations */
+#if TONE_DSP
+#define tone_smlad(x, y, sum) (int32_t)__SMLAD((x), (y), (uint32_t)(sum))                   // Dual 16-bit multiply-accumulate
+#define tone_ssat(x) __SSAT((x), TONE_SAT_BITS)                                             // Signed saturation to the DAC half scale
+#else
+    // Dual 16-bit multiply-accumulate (portable __SMLAD)
+static inline int32_t tone_smlad(uint32_t x, uint32_t y, int32_t sum) {
+    return sum + (int16_t)x * (int16_t)y + (int16_t)(x >> 16) * (int16_t)(y >> 16);
+}
+    // Signed saturation to the DAC half scale (portable __SSAT)
+static inline int32_t tone_ssat(int32_t x) {
+    const int32_t limit = (1 << (TONE_SAT_BITS - 1)) - 1;                                   // Declaring positive limit
+    return (x > limit) ? limit : (x < -limit - 1) ? -limit - 1 : x;
+}
+#endif
+    // Set mixer voices (frequencies in millihertz, gains in % of full scale; phases restart)
+bool set_tone_voices(const uint32_t *millihertz, const uint32_t *gain, int count) {
+    ToneVoice voices[TONE_VOICES];                                                          // Declaring new voices
+    uint32_t gains[TONE_VOICES / 2];                                                        // Declaring packed gains
+    int v;                                                                                  // Declaring loop variable
+    if (count < 0 || count > TONE_VOICES) return false;                                     // Returning for too many voices
+    memset(voices, 0, sizeof(voices));
+    for (v = 0; v < count; v++) {                                                           // For each voice
+        if (millihertz[v] > sample_rate * (SINE_MILLIHERTZ / 2) || gain[v] > 100) return false;
+        voices[v].millihertz = millihertz[v];
+        voices[v].increment = (uint32_t)(((uint64_t)millihertz[v] << 32) / ((uint64_t)sample_rate * SINE_MILLIHERTZ));
+        voices[v].gain = (int16_t)(gain[v] * INT16_MAX / 100);                              // Declaring gain (Q15)
+    }
+    for (v = 0; v < TONE_VOICES; v += 2) {                                                  // Packing gain pairs (low half first voice)
+        gains[v / 2] = (uint16_t)voices[v].gain | ((uint32_t)(uint16_t)voices[v + 1].gain << 16);
+    }
+    UInt key = Hwi_disable();                                                               // Holding off the DAC task mid-copy
+    memcpy(tone_voices, voices, sizeof(voices));                                            // Publishing voices
+    memcpy(tone_gains, gains, sizeof(gains));
+    tone_count = count;
+#if PERF_ENABLE
+    memset(&perf_sites[PERF_SITE_MIX], 0, sizeof(PerfSite));                                // Restarting mixer timing for the new voice count
+#endif
+    Hwi_restore(key);
+    return true;                                                                            // Returning success
+}
+    // Recompute voice steps after a sample rate change
+static void tone_retune(void) {
+    int v;                                                                                  // Declaring loop variable
+    for (v = 0; v < tone_count; v++) {
+        tone_voices[v].increment = (uint32_t)(((uint64_t)tone_voices[v].millihertz << 32) / ((uint64_t)sample_rate * SINE_MILLIHERTZ));
+    }
+}
+    // One voice (interpolated sine, Q15)
+static inline int32_t tone_voice_sample(ToneVoice *voice) {
+    uint32_t phase = voice->phase;                                                          // Declaring current phase
+    uint32_t index = phase >> WAVE_INDEX_SHIFT;                                             // Declaring table index
+    int32_t sample = waveSine[index];                                                       // Get value directly from lookup table
+    int32_t fraction = (int32_t)((phase >> (WAVE_INDEX_SHIFT - 15)) & 0x7FFF);              // Declaring position between entries (Q15)
+    sample += ((waveSine[index + 1] - sample) * fraction) >> 15;                            // Interpolating toward the next entry
+    voice->phase = phase + voice->increment;                                                // Phase accumulator wraps at one cycle
+    return sample;
+}
+    // Next mixed DAC sample (voices in pairs: two lookups and one SMLAD per pair; TONE_VOICE_CYCLES per voice)
+uint16_t tone_sample(void) {
+    int32_t sum = 0;                                                                        // Declaring mix (Q15)
+    int v;                                                                                  // Declaring loop variable
+    for (v = 0; v < tone_count; v += 2) {                                                   // For each voice pair (an odd last voice pairs with a silent one)
+        uint32_t samples = (uint16_t)tone_voice_sample(&tone_voices[v]) |
+                           ((uint32_t)(uint16_t)tone_voice_sample(&tone_voices[v + 1]) << 16);
+        sum += tone_smlad(samples, tone_gains[v / 2], 0) >> 15;                             // Both products fit 32 bits; the pair sum drops to Q15
+    }
+    return (uint16_t)(WAVE_OFFSET_MID + tone_ssat(sum >> 2));                               // Saturating Q15 to 14 bits around mid-scale
+}
+
+/* PCM playback operations */
+    // Jitter buffer reset (playback primes to the target depth again)
+static void pcm_reset(void) {
+    uint32_t depth = pcm_buffer.depth;                                                      // Saving target depth
+    memset((void *)&pcm_buffer, 0, sizeof(pcm_buffer));                                     // Clearing samples and statistics
+    pcm_buffer.depth = depth;
+    pcm_buffer.priming = true;                                                              // Declaring buffer filling
+}
+    // Received PCM samples (16-bit little-endian; UART7 task, any transport can feed it)
+void pcm_receive(uint8_t sequence, const uint8_t *payload, size_t length) {
+    PcmBuffer *pcm = &pcm_buffer;                                                           // Declaring jitter buffer
+    uint32_t write = pcm->write;                                                            // Declaring producer position
+    size_t i;                                                                               // Declaring loop variable
+    if (!pcm_mode) {                                                                        // For playback not started
+        pcm->ignored++;                                                                     // Counting ignored frame
+        return;                                                                             // Return from function
+    }
+    if (pcm->sequence_valid) {                                                              // Checking order against the last frame
+        int8_t delta = (int8_t)(sequence - pcm->sequence);                                  // Declaring frames ahead (negative when behind)
+        if (delta <= 0) {                                                                   // For duplicate or reordered frame
+            pcm->late++;                                                                    // Counting late frame (its samples would play out of order)
+            return;                                                                         // Return from function
+        }
+        pcm->lost += (uint32_t)(delta - 1);                                                 // Counting frames missing in between
+    }
+    pcm->sequence = sequence;                                                               // Declaring last frame
+    pcm->sequence_valid = true;
+    pcm->frames++;                                                                          // Counting frame
+    for (i = 0; i + 1 < length; i += 2) {                                                   // For each sample
+        if (write - pcm->read >= PCM_RING_SIZE) {                                           // For full buffer (sender far ahead)
+            pcm->overruns++;                                                                // Counting dropped sample
+            continue;
+        }
+        int16_t sample = (int16_t)(payload[i] | (payload[i + 1] << 8));                     // Declaring sample
+        pcm->ring[write & (PCM_RING_SIZE - 1)] = (uint16_t)(WAVE_OFFSET_MID + (sample >> 2)); // Storing 14-bit DAC code
+        write++;
+        pcm->samples++;                                                                     // Counting sample
+    }
+    pcm->write = write;                                                                     // Publishing samples to the sine timer
+    if (write - pcm->read > pcm->high) pcm->high = write - pcm->read;                       // Tracking high-water mark
+}
+    // Sine timer PCM drain (prime, play, and slip one sample per window when the fill drifts)
+static void pcm_drain(void) {
+    PcmBuffer *pcm = &pcm_buffer;                                                           // Declaring jitter buffer
+    uint32_t read = pcm->read;                                                              // Declaring consumer position
+    uint32_t level = pcm->write - read;                                                     // Declaring fill
+    if (pcm->priming) {                                                                     // For buffer filling (DAC holds its value)
+        if (level < pcm->depth) return;                                                     // Return until the target depth
+        pcm->priming = false;                                                               // Declaring playback
+        pcm->window = 0;
+        pcm->window_low = level;
+    }
+    if (level == 0) {                                                                       // For buffer run dry
+        pcm->underruns++;                                                                   // Counting underrun
+        pcm->priming = true;                                                                // Refilling before playing again
+        increment_error(ERR_SINE);                                                          // Incrementing sine error once per underrun
+        return;                                                                             // Return from function
+    }
+    if (level < pcm->window_low) pcm->window_low = level;                                   // Tracking lowest fill in the window
+    if (++pcm->window == PCM_ADAPT_WINDOW) {                                                // For window end
+        uint32_t low = pcm->window_low;                                                     // Declaring lowest fill
+        pcm->window = 0;
+        pcm->window_low = level;
+        if (low > pcm->depth && level > 1) {                                                // For fill never below target (sender clock fast)
+            read++;                                                                         // Skipping one sample
+            pcm->dropped++;
+        } else if (low < pcm->depth / 4) {                                                  // For fill nearly run dry (sender clock slow)
+            pcm->repeated++;                                                                // Holding one sample
+            return;                                                                         // Return from function
+        }
+    }
+    dac_stream_word = pcm->ring[read & (PCM_RING_SIZE - 1)];                                // Declaring next sample
+    pcm->read = read + 1;                                                                   // Returning slot to the producer
+    if (!SPI_transfer(spiHandle, &dac_stream_transaction)) {                                // Starting transfer (returns at once in callback mode)
+        dac_late++;                                                                         // Counting sample lost to a busy SPI
+    }
+}
+    // Fill one half of the sample buffer
+static void dac_fill(int half) {
+    int i;                                                                                  // Declaring loop variable
+    uint16_t (*source)(void) = dac_source;                                                  // Declaring source for the whole half
+    PERF_BEGIN(start);
+    for (i = 0; i < DAC_HALF_SIZE; i++) {                                                   // For each sample
+        dac_buffer[half][i] = source();                                                     // Get next sample from the phase accumulator or mixer
+    }
+    if (source == tone_sample) PERF_END(PERF_SITE_MIX, start);                              // Timing mixer halves only (-tone reads them)
+    dac_ready[half] = true;                                                                 // Publishing half to the sine timer
+    dac_fills++;                                                                            // Counting fill
+}
+    // DAC task handler (refills halves the sine timer has played)
+void dac_task(UArg arg0, UArg arg1) {
+    trace_task_name("DAC");                                                                 // Naming task in trace dumps
+    while (1) {                                                                             // Infinite loop
+        trace_event(TRACE_SEM_PEND, TRACE_OBJECT(TRACE_OBJ_DAC, 0), 0);
+        Semaphore_pend(dacSem, BIOS_WAIT_FOREVER);                                          // Waiting for a played half
+        trace_event(TRACE_SEM_TAKE, TRACE_OBJECT(TRACE_OBJ_DAC, 0), 1);
+        int half = dac_half;                                                                // Declaring half the timer needs first
+        if (sine_active && !dac_ready[half]) dac_fill(half);                                // Refilling a starved half
+        if (sine_active && !dac_ready[half ^ 1]) dac_fill(half ^ 1);                        // Refilling the played half
+    }
+}
+    // DAC stream start (task and semaphore; the sine timer is opened by -sine)
+void init_dac_stream(void) {
+    Semaphore_Params semParams;                                                             // Creating semaphore for played halves
+    Semaphore_Params_init(&semParams);                                                      // Declaring semaphore parameter initialization
+    semParams.mode = Semaphore_Mode_BINARY;                                                 // One wake refills every played half
+    dacSem = Semaphore_create(0, &semParams, NULL);                                         // Declaring DAC semaphore
+    Task_Params taskParams;                                                                 // Creating DAC refill task
+    Task_Params_init(&taskParams);                                                          // Declaring task parameter
+    taskParams.stackSize = DAC_TASK_STACK_SIZE;                                             // Declaring task stack size
+    taskParams.priority = DAC_TASK_PRIORITY;                                                // Declaring task priority
+    taskParams.stack = &dacTaskStack;                                                       // Declaring task parameter to stack size
+    dacTaskHandle = (dacSem != NULL) ? Task_create(dac_task, &taskParams, NULL) : NULL;     // Creating DAC task handler to parameter
+    if (dacTaskHandle == NULL) {                                                            // If DAC task failed
+        increment_error(ERR_SINE);                                                          // Incrementing sine error
+    }
+}
+    // DAC transfer completion (SPI callback mode, DMA-driven on target)
+void dac_transfer_callback(SPI_Handle handle, SPI_Transaction *transaction) {
+    if (transaction == &dac_stream_transaction) {                                           // For sine timer transfer
+        dac_transfers++;                                                                    // Counting completed transfer
+    }
+}
+    // DAC write from a task (waits out a stream transfer in flight)
+void dac_write(uint16_t word) {
+    int tries;                                                                              // Declaring retry count
+    dac_idle_word = word;                                                                   // Declaring DAC word
+    for (tries = 0; !SPI_transfer(spiHandle, &dac_idle_transaction) && tries < 3; tries++) {
+        Task_sleep(1);                                                                      // Letting the transfer in flight finish
+    }
+}
+    // One sine timer period (plays the buffer, never computes samples)
+static inline void sine_timer_play(void) {
+    if (!sine_active) return;                                                               // If sine appears inactive return from loop
+    if (pcm_mode) {                                                                         // For PCM playback
+        pcm_drain();                                                                        // Playing from the jitter buffer
+        return;                                                                             // Return from function
+    }
+    uint8_t half = dac_half;                                                                // Declaring half being played
+    if (!dac_ready[half]) {                                                                 // For half not refilled in time (DAC holds its value)
+        dac_underruns++;                                                                    // Counting starved sample
+        if (!dac_starved) {                                                                 // For first starved sample
+            dac_starved = true;
+            increment_error(ERR_SINE);                                                      // Incrementing sine error once per underrun
+            trace_event(TRACE_SEM_POST, TRACE_OBJECT(TRACE_OBJ_DAC, 0), 0);
+            Semaphore_post(dacSem);                                                         // Waking DAC task
+        }
+        return;                                                                             // Return from function
+    }
+    dac_starved = false;
+    dac_stream_word = dac_buffer[half][dac_position];                                       // Declaring next sample
+    if (++dac_position == DAC_HALF_SIZE) {                                                  // For half played out
+        dac_position = 0;
+        dac_ready[half] = false;                                                            // Returning half to the DAC task
+        dac_half = half ^ 1;                                                                // Switching to the other half
+        trace_event(TRACE_SEM_POST, TRACE_OBJECT(TRACE_OBJ_DAC, 0), 0);
+        Semaphore_post(dacSem);                                                             // Waking DAC task
+    }
+    if (!SPI_transfer(spiHandle, &dac_stream_transaction)) {                                // Starting transfer (returns at once in callback mode)
+        dac_late++;                                                                         // Counting sample lost to a busy SPI
+    }
 }
     // Timer callback for sine wave
 void sine_timer_callback(Timer_Handle handle, int_fast16_t status) {
-    if (!sine_active) return;                                                               // If sine appears inactive return from loop
-    uint32_t table_index = (uint32_t)phase_accumulator % LUT_SIZE;                          // Calculate table index
-    uint16_t dac_value = sineLUT[table_index];                                              // Get value directly from lookup table
-    uint16_t dac_word = dac_value & 0x3FFF;                                                 // Format for DAC8311: Upper 2 bits must be 0, followed by 14-bit data
-    SPI_Transaction transaction;                                                            // Perform SPI transfer
-    transaction.count = 1;                                                                  // Declaring transaction count
-    transaction.txBuf = &dac_word;                                                          // Declaring transaction TX buffer
-    transaction.rxBuf = NULL;                                                               // Declaring transaction RX buffer
-    SPI_transfer(spiHandle, &transaction);                                                  // Declaring SPI handler transfer
-    phase_accumulator += phase_increment;                                                   // Phase accumulator for next sample
-    if (phase_accumulator >= LUT_SIZE)                                                      // If LUT greater or equal to
-        phase_accumulator -= LUT_SIZE;                                                      // Decrement from LUT size
+    PERF_BEGIN(start);                                                                      // Timing period
+    sine_timer_play();
+    PERF_END(PERF_SITE_SINE, start);
+}
+    // Sine timer open at the current sample rate
+static bool sine_open_timer(void) {
+    Timer_Params params;                                                                    // Declaring timer parameters
+    Timer_Params_init(&params);                                                             // Initializing timer paramters
+    params.period = sample_rate;                                                            // Declaring sample rate
+    params.periodUnits = Timer_PERIOD_HZ;                                                   // Declaring period
+    params.timerMode = Timer_CONTINUOUS_CALLBACK;                                           // Declaring timer mode as forever callback
+    params.timerCallback = sine_timer_callback;                                             // Declaring timer callback to callback function
+    timer0Handle = Timer_open(CONFIG_TIMER_0, &params);                                     // Declaring timer handler as opener to parameters
+    return timer0Handle != NULL;                                                            // Returning open status
+}
+    // Sine stream start (both halves filled before the first sample)
+static void sine_start_stream(void) {
+    if (wave_switch) wave_take();                                                           // Stopped output takes a new shape at once
+    dac_half = 0;                                                                           // Playing from the first half
+    dac_position = 0;
+    dac_starved = false;
+    dac_fill(0);                                                                            // Filling both halves
+    dac_fill(1);
+    sine_active = true;                                                                     // Declaring sine as active
+    Timer_start(timer0Handle);                                                              // Starting timer handler for sine wave
 }
 
 /* Terminal operation functions */
     // Input processing
-void processUserInput(UART_Handle uart) {
+void processUserInput(ShellSession *session) {
     char inputBuffer[MAX_CMD_LENGTH + 1];                                                   // +1 for null terminator
     int index = 0;                                                                          // Declaring empty index
     char c;                                                                                 // Declaring empty char
     bool overflow = false;                                                                  // Declaring false overflow
     while (1) {
-        UART_read(uart, &c, 1);                                                             // Reading each character in UART
+        UART_read(session->uart, &c, 1);                                                    // Reading each character in UART
         if (c == '\r' || c == '\n') {                                                       // Including tab commands
             inputBuffer[index] = '\0';                                                      // Including tab to terminal
             break;                                                                          // Break loop
@@ -449,9 +1462,9 @@ void processUserInput(UART_Handle uart) {
     if (overflow) {                                                                         // When overflow is detected
         increment_error(ERR_BUFFER_OVERFLOW);                                               // Incrementing error count
         const char *overflowMsg = "\033[31mError\033[0m: Input too long. Command ignored.\r\n";
-        UART_write(uart, overflowMsg, strlen(overflowMsg));                                 // Writing overflow prompt to UART
+        uart_output(session->uart, overflowMsg, strlen(overflowMsg));                       // Writing overflow prompt to UART
     } else if (index > 0) {                                                                 // No overflow detected
-        valid_cmd(uart, inputBuffer);                                                       // Pushing valid_cmd function
+        valid_cmd(session, inputBuffer);                                                    // Pushing valid_cmd function
     }
 }
     // Error incrementing
@@ -461,10 +1474,708 @@ void increment_error(int error_type) {
     }
 }
 
+/* Command registry */
+    // -help entry
+static void help_entry(ShellSession *session, char *args) {
+    help_cmd(session, (*args != '\0') ? args + 1 : NULL);                                   // Declaring subcommand after the separator
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing user prompt from -help into UART
+}
+    // -about entry
+static void about_entry(ShellSession *session, char *args) {
+    about_cmd(session);                                                                     // Executing -about
+}
+    // -clear entry
+static void clear_entry(ShellSession *session, char *args) {
+    const char *clearScreen = "\033[2J\033[H";                                              // Declaring ANSI esc sequence for clearing
+    uart_output(session->uart, clearScreen, strlen(clearScreen));                           // Send -clear command to UART
+    const char *promptMsg = "        \033[35m.....Terminal Cleared.....\033[0m\r\n";        // User prompt for successful terminal clearing
+    uart_output(session->uart, promptMsg, strlen(promptMsg));                               // Displaying cleared message to terminal
+}
+    // -print entry
+static void print_entry(ShellSession *session, char *args) {
+    print_cmd(session, (*args != '\0') ? args + 1 : NULL);                                  // Declaring substring after the separator
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing UART into user prompt variable
+}
+    // -memr entry
+static void memr_entry(ShellSession *session, char *args) {
+    while (*args == ' ') args++;                                                            // Skipping any additional spaces
+    memr_cmd(session, args);                                                                // Processing address string
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing session prompt to UART
+}
+    // -error entry
+static void error_entry(ShellSession *session, char *args) {
+    error_cmd(session);                                                                     // Processing to UART
+}
+    // Command table (listing order of -help)
+static const Command commands[] = {
+    { "help", 4, CMD_ARGS_OPTIONAL, help_entry, "Displays valid commands",
+      "\r\n-help command       |       Print available commands.\r\n" },
+    { "about", 5, CMD_ARGS_NONE, about_entry, "Displays system info",
+      "\r\n-about command      |       Print build info.\r\n" },
+    { "clear", 5, CMD_ARGS_NONE, clear_entry, "Clears the terminal",
+      "\r\n-clear command      |       Clear characters in terminal.\r\n" },
+    { "print", 5, CMD_ARGS_OPTIONAL, print_entry, "Prints user message",
+      "\r\n-print command      |       Print user typed characters.\r\n" },
+    { "memr", 4, CMD_ARGS_REQUIRED, memr_entry, "Reads memory location",
+      "\r\n-memr command       |       Read memory at specified address.\r\n" },
+    { "error", 5, CMD_ARGS_NONE, error_entry, "Displays error info",
+      "\r\n-error command      |       Display error counts.\r\n" },
+    { "gpio", 4, CMD_ARGS_OPTIONAL, gpio_cmd, "Displays GPIO info",
+      "\r\n-gpio command      |       Displays GPIO info.\r\n"
+      "  -gpio         (read all GPIOs)\r\n"
+      "  -gpio <number> <operation> [value]\r\n"
+      "  number: 0-3 (LEDs), 4 (PK5), 5 (PD4), 6-7 (Switches)\r\n"
+      "  operation: r (read), w (write), t (toggle)\r\n"
+      "  value: 0 or 1 (for write operation)\r\n"
+      "  Examples:\r\n"
+      "   -gpio 0 r    (read LED 0)\r\n"
+      "   -gpio 1 w 1  (turn on LED 1)\r\n"
+      "   -gpio 2 t    (toggle LED 2)\r\n"
+      "   -gpio 6 r    (read Switch 1)\r\n" },
+    { "timer", 5, CMD_ARGS_OPTIONAL, timer_cmd, "Controls the periodic timer",
+      "\r\n-timer command      |       -timer <period_ms>\r\n"
+      "  Sets up a periodic timer with the specified period in milliseconds.\r\n" },
+    { "callback", 8, CMD_ARGS_OPTIONAL, callback_cmd, "Sets callbacks to timer and switches",
+      "\r\n-callback command      |       -callback <index> <count> <payload>\r\n"
+      "  Sets up a callback with the specified index (0-2), count, and payload.\r\n"
+      "  Index 0:  Timer callback\r\n"
+      "  Index 1:  SW1 (right switch) callback\r\n"
+      "  Index 2:  SW2 (left switch) callback\r\n"
+      "  Count:    Number of times to execute (-1 for infinite)\r\n"
+      "  Payload:  Command to execute when callback is triggered\r\n"
+      "  -callback alone lists callbacks and the payload arena budget\r\n" },
+    { "reset", 5, CMD_ARGS_OPTIONAL, reset_cmd, "Resets callbacks and stops timer",
+      "\r\n-reset command      |       -reset [index]\r\n"
+      "  Resets all LEDs & the specified callback or all callbacks if no index provided.\r\n"
+      "  Also stops the timer if the timer callback is reset.\r\n"
+      "  Index: 0 (Timer), 1 (SW1), 2 (SW2)\r\n" },
+    { "ticker", 6, CMD_ARGS_OPTIONAL, ticker_cmd, "Sets periodic-command executions",
+      "\r\n-ticker     |     -ticker <index> <initial_delay> <period> <count> <payload>\r\n"
+      "  index: 0-15 (ticker number)\r\n"
+      "  initial_delay: Initial delay in 10ms units (100 = 1 second)\r\n"
+      "  period: Repeat period in 10ms units (100 = 1 second)\r\n"
+      "  count: Number of repeats (-1 for infinite)\r\n"
+      "  payload: Valid command to execute\r\n"
+      "  Example: -ticker 3 100 100 5 -gpio 2 t\r\n" },
+    { "reg", 3, CMD_ARGS_OPTIONAL, reg_cmd, "Perform register operations",
+      "\r\n-reg command       |       Perform register operations\r\n"
+      "  Usage: -reg <operation> <dest> <src1> [src2]\r\n"
+      "  Operations: MOV, XCG, INC, DEC, ADD, SUB, NEG, NOT,\r\n              AND, IOR, XOR, MUL, DIV, REM, MAX, MIN\r\n"
+      "  Registers: R0 to R31 (alias with -reg ALS <name> <register>)\r\n"
+      "  Banks: -reg BNK <0-3> selects this channel's register bank\r\n"
+      "  Immediate values: Use # prefix (e.g., #10)\r\n"
+      "  Example: -reg ADD R0 R1 #5\r\n" },
+    { "script", 6, CMD_ARGS_OPTIONAL, script_cmd, "Manage and execute scripts",
+      "\r\n-script command    |       Manage and execute scripts\r\n"
+      "  Usage: -script [line_number] [payload]\r\n"
+      "  - Without arguments: Display entire script space\r\n"
+      "  - With line_number only: Execute script from that line\r\n"
+      "  - With line_number and payload: Set script line content\r\n"
+      "  - A -script <line> x line calls that run and resumes (jumps when last)\r\n"
+      "  - stop: Halt execution, stats: Show lines and call depth\r\n"
+      "  Example: -script 17 -gpio 0 t\r\n" },
+    { "rem", 3, CMD_ARGS_OPTIONAL, rem_cmd, "Add remarks in scripts",
+      "\r\n-rem command       |       Add remarks in scripts\r\n"
+      "  Usage: -rem [remark text]\r\n"
+      "  - Adds a non-executable comment in scripts\r\n" },
+    { "if", 2, CMD_ARGS_OPTIONAL, if_cmd, "Conditional executions",
+      "\r\n-if command        |       Conditional execution\r\n"
+      "  Usage: -if CONDITION ? DESTT : DESTF\r\n"
+      "  Operands: Register (R0-R31, n, alias) or immediate values (#n)\r\n"
+      "  Operators: * / %, + -, < <= > >=, = == !=, &&, || and ( )\r\n"
+      "  DESTT: Command/Script line to execute if true (non-zero)\r\n"
+      "  DESTF: Command/Script line to execute if false\r\n"
+      "  Example: -if R0 + #1 >= R2 && R3 != #0 ? -script 10 : -print false\r\n" },
+    { "debug", 5, CMD_ARGS_OPTIONAL, debug_cmd, "Sets trace level",
+      "\r\n-debug command      |       Set trace level\r\n"
+      "  Usage: -debug [level]\r\n"
+      "  - 0: Off, 1: Trace -if results, 2: Also trace -if destinations\r\n"
+      "  - Applies to this channel and the scripts, tickers and callbacks it starts\r\n"
+      "  - Without arguments: Display current level\r\n" },
+    { "uart", 4, CMD_ARGS_OPTIONAL, uart_cmd, "UART7 payload executions",
+      "\r\n-uart command       |       Send payload through UART7\r\n"
+      "  Usage: -uart <payload>\r\n"
+      "  - Sends the specified payload through UART7\r\n"
+      "  - Will process any incoming messages from UART7\r\n"
+      "  - Requires proper TX/RX/GND connections for communication\r\n"
+      "  - Without a payload: Display receive and frame statistics\r\n"
+      "  Usage: -uart frame <command> [; <command>]...\r\n"
+      "  - Sends the commands as one framed batch (SLIP, sequence number, CRC-16)\r\n"
+      "  - The peer runs the batch and acknowledges it; damaged frames are resent\r\n"
+      "  - The first batch after a restart is preceded by a sync frame (resets the peer's duplicate check)\r\n"
+      "  - Plain text lines are still accepted from the peer (auto-detected)\r\n"
+      "  Examples:\r\n"
+      "   -uart hello        (sends 'hello' through UART7)\r\n"
+      "   -uart frame -gpio 0 t; -reg INC R1   (two commands, one frame)\r\n"
+      "   -uart -gpio 0 t    (sends GPIO toggle command through UART7)\r\n" },
+    { "output", 6, CMD_ARGS_NONE, output_cmd, "Shows UART output queues",
+      "\r\n-output command     |       Show UART output queue statistics\r\n"
+      "  - Records and bytes written by each UART writer task\r\n"
+      "  - Records/bytes dropped on a full ring (interrupts never wait)\r\n"
+      "  - Ring high-water mark and enqueue to written latency (ms)\r\n" },
+    { "sine", 4, CMD_ARGS_OPTIONAL, sine_cmd, "Generate sine wave audio output",
+      "\r\n-sine command       |       Generate sine wave through audio output\r\n"
+      "  Usage: -sine FREQ\r\n"
+      "  FREQ: Frequency in Hz (0 to stop)\r\n"
+      "  - Uses Timer0 for sample rate control\r\n"
+      "  - Maximum frequency limited by Nyquist rate (sample_rate/2)\r\n"
+      "  - Frequency accepts up to 3 decimals (32-bit phase accumulator)\r\n"
+      "  - -sine rate HZ: sample rate 1000 to 128000 Hz (default 8000)\r\n"
+      "  - Samples are double buffered; underruns count as sine errors\r\n"
+      "  - nearest: table entry only, linear: interpolate between entries (default)\r\n"
+      "  - -sine wave sine|triangle|saw|square|arb: waveform (switches at a phase wrap)\r\n"
+      "  - -sine amp PCT / -sine offset PCT: amplitude 0-100%, offset -100-100% of half scale\r\n"
+      "  - -sine load START V1 V2 ...: upload arb entries (Q15, -32767 to 32767)\r\n"
+      "  - Uses SPI DAC for high-quality output\r\n"
+      "  Examples:\r\n"
+      "   -sine 440     (generate 440 Hz sine wave - A4 note)\r\n"
+      "   -sine 1000    (generate 1 kHz test tone)\r\n"
+      "   -sine 261.626 (generate middle C)\r\n"
+      "   -sine wave triangle (switch to a triangle wave)\r\n"
+      "   -sine 0       (stop sine wave generation)\r\n" },
+    { "tone", 4, CMD_ARGS_OPTIONAL, tone_cmd, "Mix up to 8 tones (DTMF/chords)",
+      "\r\n-tone command       |       Mix simultaneous tones through audio output\r\n"
+      "  Usage: -tone F1[:PCT] F2[:PCT] ... | -tone dtmf KEY | -tone off\r\n"
+      "  F: Frequency in Hz, up to 3 decimals; PCT: voice gain (default shares the rest of 100%)\r\n"
+      "  - 1 to 8 voices, each with its own phase accumulator and gain\r\n"
+      "  - Sums saturate at full scale instead of wrapping\r\n"
+      "  - Shares the DAC stream and sample rate with -sine (-sine 0 also stops)\r\n"
+      "  - -tone alone lists voices, the estimated CPU share and the share timed on the DAC task\r\n"
+      "  Examples:\r\n"
+      "   -tone dtmf 5           (770 Hz + 1336 Hz)\r\n"
+      "   -tone 261.626 329.628 391.995 (C major chord)\r\n"
+      "   -tone 440:80 880:20    (A4 with a quieter octave)\r\n" },
+    { "pcm", 3, CMD_ARGS_OPTIONAL, pcm_cmd, "Play PCM streamed over UART7",
+      "\r\n-pcm command        |       Play PCM samples streamed over UART7\r\n"
+      "  Usage: -pcm start [DEPTH] | -pcm stop | -pcm depth DEPTH\r\n"
+      "  DEPTH: Samples buffered before playback starts (32 to 2048, default 400)\r\n"
+      "  - Samples arrive in UART7 frames of type 4 (16-bit little-endian, up to 126 per frame)\r\n"
+      "  - The sine timer plays one sample per period at the -sine rate\r\n"
+      "  - Underruns refill to DEPTH before playing again (counted as sine errors)\r\n"
+      "  - Adaptive fill skips or holds one sample per 1024 when the fill drifts\r\n"
+      "  - 115200 baud carries about 5000 samples/s; set -sine rate to match\r\n"
+      "  - -pcm alone shows fill, frame, underrun and overrun counts\r\n"
+      "  Examples:\r\n"
+      "   -sine rate 4000\r\n"
+      "   -pcm start 400         (100 ms of buffering at 4 kHz)\r\n" },
+    { "perf", 4, CMD_ARGS_OPTIONAL, perf_cmd, "Displays handler and ISR timing",
+      "\r\n-perf command       |       Display handler, dispatch and ISR timing\r\n"
+      "  Usage: -perf [reset | SITE]\r\n"
+      "  SITE: dispatch (valid_cmd), sine, ticker (timer ISRs), sw1, sw2, mix (DAC task mixer fills), or -COMMAND (its handler)\r\n"
+      "  - Ticks are DWT cycles on the board and nanoseconds in host builds\r\n"
+      "  - Each site keeps count, min, mean, max and a log2 histogram\r\n"
+      "  - reset prints every site, then clears them\r\n"
+      "  - Build with PERF_ENABLE=0 to compile the timing out\r\n"
+      "  Examples:\r\n"
+      "   -perf\r\n"
+      "   -perf sine             (histogram of sine timer periods)\r\n"
+      "   -perf -gpio\r\n" },
+    { "trace", 5, CMD_ARGS_OPTIONAL, trace_cmd, "Records task and ISR events",
+      "\r\n-trace command      |       Record task and ISR events in a binary ring\r\n"
+      "  Usage: -trace on | off | clear | dump\r\n"
+      "  - Records command entry and exit, queue put and get, semaphore post and pend\r\n"
+      "  - Holds the last 512 events; tasks and interrupts write without locks\r\n"
+      "  - dump streams the ring in binary (TRC1 header, CRC-16 trailer)\r\n"
+      "  - host/trace_json turns a captured dump into Chrome trace JSON\r\n"
+      "  - -trace alone shows the recording state\r\n"
+      "  Examples:\r\n"
+      "   -trace clear\r\n"
+      "   -trace dump            (capture the port, then trace_json capture > trace.json)\r\n" },
+};
+#define COMMAND_COUNT (sizeof(commands) / sizeof(commands[0]))                              // Defining registered command count
+_Static_assert(COMMAND_COUNT < COMMAND_SLOTS, "COMMAND_SLOTS must exceed the command count (a full table never ends a probe; PERF_SITES is sized from it)");
+static int8_t command_slots[COMMAND_SLOTS];                                                 // Declaring hash slots (index into commands, -1 when empty)
+static char command_list[HELP_LIST_SIZE];                                                   // Declaring -help list (generated once from the table)
+    // Command name hash (collision-free for the table above; probing covers additions)
+static uint32_t command_hash(const char *name, size_t length) {
+    return (uint32_t)(length * 6 + (uint8_t)name[0] * 11 + (uint8_t)name[length - 1]) & (COMMAND_SLOTS - 1);
+}
+    // Command registry initialization
+void init_commands(void) {
+    int i;                                                                                  // Declaring loop variable
+    memset(command_slots, -1, sizeof(command_slots));                                       // Clearing all slots
+    for (i = 0; i < (int)COMMAND_COUNT; i++) {                                              // For all registered commands
+        uint32_t slot = command_hash(commands[i].name, commands[i].length);                 // Hashing command name
+        while (command_slots[slot] >= 0) {                                                  // Probing past occupied slots
+            slot = (slot + 1) & (COMMAND_SLOTS - 1);                                        // Moving to next slot
+        }
+        command_slots[slot] = (int8_t)i;                                                    // Storing command index
+    }
+    char name[MAX_COMMAND_NAME_LENGTH + 3];                                                 // Declaring "-name:" column
+    int length = snprintf(command_list, HELP_LIST_SIZE,                                     // Formatting -help header
+                          "\r\n----------HELP----------\r\n"
+                          ".....Command List.....\r\n");
+    for (i = 0; i < (int)COMMAND_COUNT && length < HELP_LIST_SIZE; i++) {                   // Listing every registered command
+        snprintf(name, sizeof(name), "-%s:", commands[i].name);                             // Formatting command column
+        length += snprintf(command_list + length, HELP_LIST_SIZE - length,                  // Appending command summary
+                           "%-14s|       %s\r\n", name, commands[i].summary);
+    }
+}
+    // Command lookup
+const Command *find_command(const char *name, size_t length) {
+    if (length == 0 || length > MAX_COMMAND_NAME_LENGTH) {                                  // For impossible names
+        return NULL;                                                                        // Returning no command
+    }
+    uint32_t slot = command_hash(name, length);                                             // Hashing command name
+    while (command_slots[slot] >= 0) {                                                      // Until an empty slot ends the probe
+        const Command *entry = &commands[command_slots[slot]];                              // Declaring candidate command
+        if (entry->length == length && memcmp(entry->name, name, length) == 0) {            // For exact name match
+            return entry;                                                                   // Returning command
+        }
+        slot = (slot + 1) & (COMMAND_SLOTS - 1);                                            // Moving to next slot
+    }
+    return NULL;                                                                            // Returning no command
+}
+    // Command table index (stable within a build only: -perf sites and trace dumps)
+int command_id(const Command *entry) {
+    return (int)(entry - commands);                                                         // Returning table index
+}
+    // Command lookup by table index
+const Command *command_by_id(int id) {
+    return (id >= 0 && id < (int)COMMAND_COUNT) ? &commands[id] : NULL;                     // Returning command (NULL when out of range)
+}
+
+/* Compiled command operations */
+static const uint32_t gpio_pins[8] = {                                                      // Declaring GPIO number to driver index map
+    GPIO_LED_0, GPIO_LED_1, GPIO_LED_2, GPIO_LED_3,
+    GPIO_PK5, GPIO_PD4, GPIO_SWITCH_1, GPIO_SWITCH_2
+};
+static const char reg_ops[REG_OP_COUNT][4] = {                                              // Declaring register operation names (REG_OP_* order)
+    "MOV", "XCG", "INC", "DEC", "ADD", "SUB", "NEG", "NOT",
+    "AND", "IOR", "XOR", "MUL", "DIV", "REM", "MAX", "MIN"
+};
+typedef struct {
+    const char *text;                                                                       // Declaring reply template (same text as gpio_cmd)
+    uint8_t length;                                                                         // Declaring template length
+    uint8_t number_at;                                                                      // Declaring GPIO number digit offset
+    uint8_t value_at;                                                                       // Declaring value digit offset
+} GpioReply;                                                                                // Declaring struct name as GpioReply
+static const GpioReply gpio_replies[3] = {                                                  // Declaring replies (CMD_OP_GPIO_* order)
+    { "GPIO 0 value: 0\r\n", 17, 5, 14 },
+    { "\033[35mGPIO 0 set to 0\033[0m\r\n", 26, 10, 19 },
+    { "\033[35mGPIO 0 toggled to 0\033[0m\r\n", 30, 10, 23 },
+};
+    // Register operand compile
+static bool compile_operand(const char *operand, CompiledCommand *compiled, int index) {
+    if (operand[0] == '#') {                                                                // If immediate '#' detected
+        compiled->immediate |= (uint8_t)(1 << index);                                       // Flagging immediate source
+        compiled->imm[index] = atoi(operand + 1);                                           // Parsing immediate once
+        return true;                                                                        // Returning compiled operand
+    }
+    int reg = reg_index(operand);                                                           // Resolving register name once
+    if (reg < 0) {                                                                          // For unknown registers
+        return false;                                                                       // Leaving to text path
+    }
+    compiled->src[index] = (uint8_t)reg;                                                    // Storing register index
+    return true;                                                                            // Returning compiled operand
+}
+    // -gpio compile
+static bool compile_gpio(char *args, CompiledCommand *compiled) {
+    int gpio_num, value;                                                                    // Declaring GPIO number and value
+    char operation;                                                                         // Declaring operation char
+    if (sscanf(args, "%d %c", &gpio_num, &operation) != 2 || gpio_num < 0 || gpio_num > 7) {
+        return false;                                                                       // Leaving errors to gpio_cmd
+    }
+    if (gpio_num >= 6 && operation != 'r') {                                                // Switches can only be read
+        return false;                                                                       // Leaving errors to gpio_cmd
+    }
+    compiled->number = (uint8_t)gpio_num;                                                   // Storing GPIO number
+    compiled->pin = (uint8_t)gpio_pins[gpio_num];                                           // Resolving driver index once
+    switch (operation) {                                                                    // Declaring switch for GPIO operations
+        case 'r': compiled->opcode = CMD_OP_GPIO_READ; return true;                         // Read operation
+        case 't': compiled->opcode = CMD_OP_GPIO_TOGGLE; return true;                       // Toggle operation
+        case 'w':                                                                           // Write operation
+            if (sscanf(args, "%d %c %d", &gpio_num, &operation, &value) != 3 || (value != 0 && value != 1)) {
+                return false;                                                               // Leaving errors to gpio_cmd
+            }
+            compiled->value = (uint8_t)value;                                               // Storing write value
+            compiled->opcode = CMD_OP_GPIO_WRITE;                                           // Write operation
+            return true;                                                                    // Returning compiled write
+        default:                                                                            // Declaring default function
+            return false;                                                                   // Leaving errors to gpio_cmd
+    }
+}
+    // -reg compile
+static bool compile_reg(char *args, CompiledCommand *compiled) {
+    char op[10], dest[MAX_REG_NAME_LENGTH], src1[MAX_REG_NAME_LENGTH], src2[MAX_REG_NAME_LENGTH];
+    int num_args = sscanf(args, "%9s %9s %9s %9s", op, dest, src1, src2);                   // Tokenising as reg_cmd does
+    int i, reg;                                                                             // Declaring loop and register variables
+    if (num_args < 2 || strlen(op) > 3 || strlen(dest) >= MAX_REG_NAME_LENGTH - 1) {        // For short forms and oversized tokens
+        return false;                                                                       // Leaving to reg_cmd
+    }
+    for (i = 0; i < REG_OP_COUNT && strcmp(reg_ops[i], op) != 0; i++);                      // Resolving operation once
+    reg = reg_index(dest);                                                                  // Resolving destination once
+    if (i == REG_OP_COUNT || reg < 0 || strcmp(reg_names[reg], dest) != 0) {                // For unknown operation, destination or alias reply
+        return false;                                                                       // Leaving errors to reg_cmd
+    }
+    compiled->number = (uint8_t)i;                                                          // Storing operation
+    compiled->dest = (uint8_t)reg;                                                          // Storing destination index
+    compiled->arg_count = (uint8_t)num_args;                                                // Storing argument count
+    if (i != REG_OP_INC && i != REG_OP_DEC) {                                               // For operations with sources
+        if (num_args < 3 || strlen(src1) >= MAX_REG_NAME_LENGTH - 1 || !compile_operand(src1, compiled, 0)) {
+            return false;                                                                   // Leaving to reg_cmd
+        }
+        if (i == REG_OP_XCG && (compiled->immediate & 1)) {                                 // XCG writes back to its source
+            return false;                                                                   // Leaving to reg_cmd
+        }
+        if (num_args == 4 && (strlen(src2) >= MAX_REG_NAME_LENGTH - 1 || !compile_operand(src2, compiled, 1))) {
+            return false;                                                                   // Leaving to reg_cmd
+        }
+    }
+    compiled->opcode = CMD_OP_REG;                                                          // Register operation
+    return true;                                                                            // Returning compiled operation
+}
+    // Command compile
+bool compile_command(const char *text, CompiledCommand *compiled) {
+    char command[MAX_CMD_LENGTH];                                                           // Declaring working copy for sscanf
+    size_t length = 0;                                                                      // Declaring command name length
+    memset(compiled, 0, sizeof(*compiled));                                                 // Defaulting to CMD_OP_TEXT
+    if (strlen(text) >= MAX_CMD_LENGTH) {                                                   // For commands beyond the working copy
+        return false;                                                                       // Executing through valid_cmd
+    }
+    strncpy(command, text, MAX_CMD_LENGTH - 1);                                             // Copying stored command
+    command[MAX_CMD_LENGTH - 1] = '\0';                                                     // Ensuring NULL of command string
+    while (command[length] != '\0' && command[length] != ' ') length++;                     // Tokenising as valid_cmd does
+    const Command *entry = (command[0] == '-') ? find_command(command + 1, length - 1) : NULL;
+    char *args = command + length;                                                          // Declaring arguments (keeps leading separator)
+    if (entry == NULL || args[strspn(args, " ")] == '\0') {                                 // For unknown or bare commands
+        return false;                                                                       // Executing through valid_cmd
+    }
+    if (entry->handler == gpio_cmd && compile_gpio(args, compiled)) {                       // For -gpio <n> <r|w|t>
+        return true;                                                                        // Returning compiled GPIO
+    }
+    if (entry->handler == reg_cmd && compile_reg(args, compiled)) {                         // For -reg <op> <dest> ...
+        return true;                                                                        // Returning compiled register op
+    }
+    if (entry->handler == if_cmd) {                                                         // For -if <condition> ? <dest> : <dest>
+        IfExpr expr;                                                                        // Declaring compiled condition
+        int slot;                                                                           // Declaring interned slot
+        if (compile_if(command, args, &expr, compiled) == NULL && (slot = if_intern(&expr)) >= 0) {
+            compiled->number = (uint8_t)slot;                                               // Storing condition slot
+            return true;                                                                    // Returning compiled -if
+        }
+    }
+    memset(compiled, 0, sizeof(*compiled));                                                 // Dropping partial compile
+    return false;                                                                           // Executing through valid_cmd
+}
+    // Command release (before a compiled command is overwritten or dropped)
+void release_command(CompiledCommand *compiled) {
+    if (compiled->opcode == CMD_OP_IF) {                                                    // For interned -if condition
+        if_release(compiled->number);
+    }
+    memset(compiled, 0, sizeof(*compiled));                                                 // Leaving CMD_OP_TEXT
+}
+    // Decimal formatter (no stdio on the hot path)
+static size_t format_int(char *out, int32_t value) {
+    char digits[11];                                                                        // Declaring reversed digit buffer
+    uint32_t magnitude = (value < 0) ? 0u - (uint32_t)value : (uint32_t)value;              // Declaring absolute value
+    size_t count = 0, length = 0;                                                           // Declaring digit and output counts
+    do {
+        digits[count++] = (char)('0' + magnitude % 10);                                     // Storing next digit
+        magnitude /= 10;                                                                    // Dropping stored digit
+    } while (magnitude != 0);
+    if (value < 0) {                                                                        // For negative values
+        out[length++] = '-';                                                                // Writing sign
+    }
+    while (count > 0) {                                                                     // Reversing digits into output
+        out[length++] = digits[--count];
+    }
+    return length;                                                                          // Returning written length
+}
+    // Register operation execute (reply false inside micro-programs: errors only)
+static void execute_reg(ShellSession *session, const CompiledCommand *compiled, bool reply) {
+    int32_t value1, value2 = 0;                                                             // Declaring operand values
+    int32_t result = 0;                                                                     // Declaring result variable
+    int32_t *bank = registers[session->bank];                                               // Declaring session register bank
+    if (compiled->number == REG_OP_INC || compiled->number == REG_OP_DEC) {                 // Treating the dest as src1 for INC/DEC
+        value1 = bank[compiled->dest];
+    } else {                                                                                // For source operands
+        value1 = (compiled->immediate & 1) ? compiled->imm[0] : bank[compiled->src[0]];
+        if (compiled->arg_count == 4) {                                                     // For second source
+            value2 = (compiled->immediate & 2) ? compiled->imm[1] : bank[compiled->src[1]];
+        }
+    }
+    switch (compiled->number) {                                                             // Declaring switch for register operations
+        case REG_OP_MOV: result = value1; break;
+        case REG_OP_XCG:                                                                    // Exchanging destination and source
+            bank[compiled->src[0]] = bank[compiled->dest];
+            result = value1;
+            break;
+        case REG_OP_INC: result = (int32_t)((uint32_t)value1 + 1); break;                   // Wrapping (signed overflow is undefined)
+        case REG_OP_DEC: result = (int32_t)((uint32_t)value1 - 1); break;
+        case REG_OP_ADD: result = (int32_t)((uint32_t)value1 + (uint32_t)value2); break;
+        case REG_OP_SUB: result = (int32_t)((uint32_t)value1 - (uint32_t)value2); break;
+        case REG_OP_NEG: result = (int32_t)(0u - (uint32_t)value1); break;
+        case REG_OP_NOT: result = ~value1; break;
+        case REG_OP_AND: result = value1 & value2; break;
+        case REG_OP_IOR: result = value1 | value2; break;
+        case REG_OP_XOR: result = value1 ^ value2; break;
+        case REG_OP_MUL: result = (int32_t)((uint32_t)value1 * (uint32_t)value2); break;
+        case REG_OP_DIV:
+        case REG_OP_REM:
+            if (value2 == 0 || (value2 == -1 && value1 == INT32_MIN)) {                     // Declaring division by 0 or overflow error
+                increment_error(ERR_REG);                                                   // Increment error count
+                snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: %s.\r\n",
+                         value2 == 0 ? "Division by zero" : "Integer overflow in division");
+                uart_output(session->uart, session->prompt, strlen(session->prompt));       // Writing user prompt to UART
+                return;                                                                     // Return from function
+            }
+            result = (compiled->number == REG_OP_DIV) ? value1 / value2 : value1 % value2;
+            break;
+        case REG_OP_MAX: result = (value1 > value2) ? value1 : value2; break;
+        case REG_OP_MIN: result = (value1 < value2) ? value1 : value2; break;
+    }
+    bank[compiled->dest] = result;                                                          // Storing result
+    if (!reply) {                                                                           // For silent micro-program step
+        return;                                                                             // Return from function
+    }
+    static const char completed[] = "\r\nOperation completed. ";                            // Declaring reply prefix (same text as reg_cmd)
+    size_t length = sizeof(completed) - 1;                                                  // Declaring reply length
+    size_t name_length = strlen(reg_names[compiled->dest]);                                 // Declaring register name length
+    memcpy(session->prompt, completed, length);                                             // Copying reply prefix
+    memcpy(session->prompt + length, reg_names[compiled->dest], name_length);               // Copying register name
+    length += name_length;
+    memcpy(session->prompt + length, " = ", 3);                                             // Copying separator
+    length += 3;
+    length += format_int(session->prompt + length, result);                                 // Formatting result
+    memcpy(session->prompt + length, "\r\n", 3);                                            // Copying line end and NULL
+    uart_output(session->uart, session->prompt, length + 2);                                // Writing user prompt to UART
+}
+    // Compiled command execute
+void execute_command(ShellSession *session, const CompiledCommand *compiled, char *text) {
+    const GpioReply *reply;                                                                 // Declaring GPIO reply template
+    int value;                                                                              // Declaring GPIO value
+    switch (compiled->opcode) {                                                             // Dispatching on pre-resolved opcode
+        case CMD_OP_GPIO_READ:                                                              // Read operation
+            value = GPIO_read(compiled->pin);
+            break;
+        case CMD_OP_GPIO_WRITE:                                                             // Write operation
+            value = compiled->value;
+            GPIO_write(compiled->pin, value);
+            break;
+        case CMD_OP_GPIO_TOGGLE:                                                            // Toggle operation
+            value = !GPIO_read(compiled->pin);
+            GPIO_write(compiled->pin, value);
+            break;
+        case CMD_OP_REG:                                                                    // Register operation
+            execute_reg(session, compiled, true);
+            return;                                                                         // Return from function
+        case CMD_OP_IF:                                                                     // Conditional operation
+            execute_if(session, compiled, &if_exprs[compiled->number], text);
+            return;                                                                         // Return from function
+        default:                                                                            // Commands without a compiled form
+            valid_cmd(session, text);                                                       // Executing through valid command
+            return;                                                                         // Return from function
+    }
+    reply = &gpio_replies[compiled->opcode - CMD_OP_GPIO_READ];                             // Selecting reply template
+    memcpy(session->prompt, reply->text, reply->length + 1);                                // Copying reply with NULL
+    session->prompt[reply->number_at] = (char)('0' + compiled->number);                     // Patching GPIO number
+    session->prompt[reply->value_at] = (char)('0' + (value != 0));                          // Patching GPIO value
+    uart_output(session->uart, session->prompt, reply->length);                             // Writing from uart
+}
+
+/* Script micro-program operations */
+    // Instruction emit
+static int prog_emit(uint8_t op, int16_t target, const CompiledCommand *operands) {
+    if (program_size >= PROG_SIZE) {                                                        // For full program
+        return -1;                                                                          // Returning no instruction
+    }
+    ProgInstruction *ins = &program[program_size];                                          // Declaring next instruction
+    ins->op = op;                                                                           // Storing operation
+    ins->first = 0;                                                                         // Marked by compile_program
+    ins->target = target;                                                                   // Storing branch target
+    if (operands != NULL) {                                                                 // For operand instructions
+        ins->operands = *operands;                                                          // Copying resolved operands
+    } else {                                                                                // For control instructions
+        memset(&ins->operands, 0, sizeof(ins->operands));                                   // Clearing operands
+    }
+    return program_size++;                                                                  // Returning instruction index
+}
+    // "-script <line> x" target (-1 when not an exact execute request)
+static int prog_script_target(const char *text) {
+    char *endptr;                                                                           // Declaring number end pointer
+    if (strncmp(text, "-script ", 8) != 0) {                                                // For other commands
+        return -1;                                                                          // Returning no target
+    }
+    long line = strtol(text + 8, &endptr, 10);                                              // Parsing line number
+    if (endptr == text + 8 || line < 0 || line >= SCRIPT_SIZE) {                            // For missing or invalid line
+        return -1;                                                                          // Returning no target
+    }
+    while (*endptr == ' ') endptr++;                                                        // Skipping whitespaces
+    return (strcmp(endptr, "x") == 0) ? (int)line : -1;                                     // Returning target line
+}
+    // Command compile as run by valid_cmd (-reg, -rem, -script <line> x)
+static bool prog_compile_command(const char *text) {
+    CompiledCommand compiled;                                                               // Declaring resolved -reg operands
+    int line = prog_script_target(text);                                                    // Declaring jump line
+    if (line >= 0) {                                                                        // For -script <line> x (restarts the script)
+        return script_space[line][0] != '\0' && prog_emit(PROG_OP_GOTO, (int16_t)line, NULL) >= 0;
+    }
+    if (strncmp(text, "-rem", 4) == 0 && (text[4] == ' ' || text[4] == '\0')) {             // For remarks
+        return prog_emit(PROG_OP_REM, 0, NULL) >= 0;
+    }
+    if (compile_command(text, &compiled) && compiled.opcode == CMD_OP_REG) {                // For register operations
+        return prog_emit(compiled.number, 0, &compiled) >= 0;
+    }
+    release_command(&compiled);                                                             // Releasing a nested -if condition
+    return false;                                                                           // Leaving to the interpreter
+}
+    // -if destination compile (as execute_if runs it)
+static bool prog_compile_dest(const char *text, const CompiledCommand *compiled, int side) {
+    char dest[MAX_CMD_LENGTH];                                                              // Declaring command destination copy
+    uint8_t line = compiled->src[side];                                                     // Declaring destination line or IF_DEST_*
+    if (line == IF_DEST_NONE) {                                                             // For empty or invalid destination
+        return true;                                                                        // Nothing to execute
+    }
+    if (line == IF_DEST_TEXT) {                                                             // For command destination
+        if_dest_text(text, compiled->imm[side], dest);
+        return prog_compile_command(dest);
+    }
+    return script_space[line][0] == '\0' || prog_compile_command(script_space[line]);       // Executing that single line
+}
+    // -if compile (condition branch, true action, skip, false action)
+static bool prog_compile_if(const char *args) {
+    IfExpr expr;                                                                            // Declaring compiled condition
+    CompiledCommand compiled;                                                               // Declaring condition slot and destinations
+    int slot;                                                                               // Declaring interned slot
+    if (compile_if(args, args, &expr, &compiled) != NULL || (slot = if_intern(&expr)) < 0) {
+        return false;                                                                       // Leaving errors (or a full pool) to if_cmd
+    }
+    compiled.number = (uint8_t)slot;                                                        // Storing condition slot
+    int branch = prog_emit(PROG_OP_IF, 0, &compiled);                                       // Branching to false action when condition fails
+    if (branch < 0) {                                                                       // For full program
+        if_release(slot);                                                                   // Releasing condition no instruction holds
+        return false;                                                                       // Leaving to the interpreter
+    }
+    if (!prog_compile_dest(args, &compiled, 0)) {                                           // Compiling true action
+        return false;                                                                       // Leaving to the interpreter
+    }
+    int skip = prog_emit(PROG_OP_SKIP, 0, NULL);                                            // Skipping false action
+    if (skip < 0) {                                                                         // For full program
+        return false;                                                                       // Leaving to the interpreter
+    }
+    program[branch].target = (int16_t)program_size;                                         // Linking false action
+    if (!prog_compile_dest(args, &compiled, 1)) {                                           // Compiling false action
+        return false;                                                                       // Leaving to the interpreter
+    }
+    program[skip].target = (int16_t)program_size;                                           // Linking next line
+    return true;                                                                            // Returning compiled -if
+}
+    // Program truncate (releases -if conditions held by dropped instructions)
+static void prog_truncate(int size) {
+    while (program_size > size) {                                                           // For each dropped instruction
+        ProgInstruction *ins = &program[--program_size];                                    // Declaring dropped instruction
+        if (ins->op == PROG_OP_IF) {
+            if_release(ins->operands.number);
+        }
+    }
+}
+    // Program compile (whole script space, then reachability from start_line)
+bool compile_program(int start_line) {
+    static int16_t pending[PROG_SIZE];                                                      // Declaring reachability work list
+    static uint8_t visited[PROG_SIZE / 8];                                                  // Declaring reachability bitmap
+    int line, count = 0;                                                                    // Declaring loop and work list variables
+    prog_truncate(0);                                                                       // Clearing program
+    for (line = 0; line < SCRIPT_SIZE; line++) {                                            // For every script line
+        const char *text = script_space[line];                                              // Declaring line text
+        int target = prog_script_target(text);                                              // Declaring plain -script <line> x target
+        bool last = (line + 1 == SCRIPT_SIZE || script_space[line + 1][0] == '\0');         // Declaring end of run
+        bool compiled;                                                                      // Declaring line result
+        program_line_pc[line] = (int16_t)program_size;                                      // Mapping line to first instruction
+        if (text[0] == '\0') {                                                              // For empty line (end of run)
+            compiled = prog_emit(PROG_OP_END, 0, NULL) >= 0;
+        } else if (strncmp(text, "-if ", 4) == 0) {                                         // For -if lines
+            compiled = prog_compile_if(text + 3);
+        } else if (target >= 0) {                                                           // For script_task's -script <line> x (a jump only as the last line, calls stay interpreted)
+            compiled = last && prog_emit(PROG_OP_GOTO, (int16_t)target, NULL) >= 0;
+        } else {                                                                            // For other commands
+            compiled = prog_compile_command(text);
+        }
+        if (!compiled) {                                                                    // For lines left to the interpreter
+            prog_truncate(program_line_pc[line]);                                           // Dropping partial instructions
+            if (prog_emit(PROG_OP_TEXT, 0, NULL) < 0) {                                     // For full program
+                return false;                                                               // Using the interpreter
+            }
+        }
+        if (text[0] != '\0' && program_line_pc[line] < program_size) {                      // For executed line (end of run is not counted)
+            program[program_line_pc[line]].first = 1;
+        }
+        if (line + 1 == SCRIPT_SIZE && text[0] != '\0' && prog_emit(PROG_OP_END, 0, NULL) < 0) {
+            return false;                                                                   // Using the interpreter (no room to end the last run)
+        }
+    }
+    for (line = 0; line < program_size; line++) {                                           // Resolving line jumps
+        if (program[line].op == PROG_OP_GOTO) {
+            program[line].target = program_line_pc[program[line].target];
+        }
+    }
+    memset(visited, 0, sizeof(visited));                                                    // Clearing reachability bitmap
+    pending[count++] = program_line_pc[start_line];                                         // Starting from the requested line
+    while (count > 0) {                                                                     // Walking every reachable instruction
+        int pc = pending[--count];                                                          // Declaring next instruction
+        while (!(visited[pc >> 3] & (1 << (pc & 7)))) {                                     // Following fall-through until seen
+            visited[pc >> 3] |= (uint8_t)(1 << (pc & 7));                                   // Marking instruction
+            uint8_t op = program[pc].op;                                                    // Declaring operation
+            if (op == PROG_OP_TEXT) {                                                       // For reachable uncompiled line
+                return false;                                                               // Using the interpreter
+            } else if (op == PROG_OP_END) {                                                 // For end of run
+                break;
+            } else if (op == PROG_OP_GOTO || op == PROG_OP_SKIP) {                          // For unconditional jump
+                pc = program[pc].target;
+            } else {                                                                        // For fall-through (and branch)
+                if (op == PROG_OP_IF && count < PROG_SIZE) {
+                    pending[count++] = program[pc].target;                                  // Queuing false action
+                }
+                pc++;
+            }
+        }
+    }
+    return true;                                                                            // Returning runnable program
+}
+    // Program run (on script_task, budgeted slices)
+void run_program(int pc, uint32_t generation) {
+    int steps = 0;                                                                          // Declaring slice step count
+    int32_t value;                                                                          // Declaring -if condition value
+    while (1) {                                                                             // Until END or a new script request
+        const ProgInstruction *ins = &program[pc];                                          // Declaring current instruction
+        script_lines += ins->first;                                                         // Counting executed line (as the interpreter does)
+        switch (ins->op) {                                                                  // Dispatching on operation
+            case PROG_OP_END:                                                               // End of run
+                return;                                                                     // Return from function
+            case PROG_OP_REM:                                                               // Remark
+                rem_cmd(script_session, NULL);
+                pc++;
+                break;
+            case PROG_OP_GOTO:                                                              // -script <line> x
+            case PROG_OP_SKIP:                                                              // -if true action done
+                pc = ins->target;
+                break;
+            case PROG_OP_IF:                                                                // -if condition
+                value = evaluate_if(script_session, &if_exprs[ins->operands.number]);
+                if (script_session->verbosity > 0) {                                        // For enabled tracing
+                    if_trace(script_session, &if_exprs[ins->operands.number], value);
+                }
+                pc = value ? pc + 1 : ins->target;
+                break;
+            default:                                                                        // Register operations (REG_OP_*, replies only when debugging)
+                execute_reg(script_session, &ins->operands, script_session->verbosity > 0);
+                pc++;
+                break;
+        }
+        if (++steps >= PROG_SLICE_STEPS) {                                                  // For spent time slice
+            steps = 0;                                                                      // Starting next slice
+            Task_sleep(1);                                                                  // Letting lower-priority tasks run
+            if (program_generation != generation) {                                         // For new script request or clear
+                return;                                                                     // Return from function
+            }
+        }
+    }
+}
+
 /* Command functions */
     // -error
-void error_cmd(UART_Handle uart) {
-    snprintf(user_prompt, USER_PROMPT_SIZE,                                                 // Printing error prompt/count
+void error_cmd(ShellSession *session) {
+    snprintf(session->prompt, USER_PROMPT_SIZE,                                             // Printing error prompt/count
              "\r\n----------ERROR COUNTS----------\r\n"
              "Unknown commands:         %lu\r\n"
              "Buffer overflows:         %lu\r\n"
@@ -494,20 +2205,20 @@ void error_cmd(UART_Handle uart) {
              error_counts[ERR_UART],                                                        // UART7 error count
              error_counts[ERR_SINE],                                                        // Sine-DAC error count
              error_counts[ERR_NET]);                                                        // UDP error count
-       UART_write(uart, user_prompt, strlen(user_prompt));                                  // Writing UART from user_prompt
+       uart_output(session->uart, session->prompt, strlen(session->prompt));                // Writing UART from session prompt
 }
     // -print
-void print_cmd(UART_Handle uart, char *substring) {                                         // Declaring function for -print command
+void print_cmd(ShellSession *session, char *substring) {                                    // Declaring function for -print command
     if (substring == NULL) {                                                                // User prompt for empty substring
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[33mWarning\033[0m: No text detected with -print command.\r\n");
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[33mWarning\033[0m: No text detected with -print command.\r\n");
     }
     else {
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n%s\r\n", substring);                   // Printing user input in -print substring
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n%s\r\n", substring);               // Printing user input in -print substring
     }
 }
     // -about
-void about_cmd(UART_Handle uart) {                                                          // Declaring function for -about command
-    snprintf(user_prompt, USER_PROMPT_SIZE,                                                 // Formatting user_prompt array
+void about_cmd(ShellSession *session) {                                                     // Declaring function for -about command
+    snprintf(session->prompt, USER_PROMPT_SIZE,                                             // Formatting session prompt array
             "\r\n----------ABOUT----------\r\n"
             "Username       |       %s\r\n"
             "Assignment #   |       %s\r\n"
@@ -515,179 +2226,35 @@ void about_cmd(UART_Handle uart) {
             "Date           |       %s on %s\r\n"
             "Updates        |       UDP Network messaging\r\n",
             USER, ASSIGNMENT, VERSION_SUB, __TIME__, __DATE__);                             // Preprocessor macros
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Sending formatted message to UART
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Sending formatted message to UART
 }
     // -help
-void help_cmd(UART_Handle uart, char *subcmd) {                                             // Declaring function for -help command
+void help_cmd(ShellSession *session, char *subcmd) {                                        // Declaring function for -help command
     if (subcmd == NULL) {                                                                   // If subcommand is missing
-    snprintf(user_prompt, USER_PROMPT_SIZE,                                                 // Formatting user_prompt array
-             "\r\n----------HELP----------\r\n"
-             ".....Command List.....\r\n"
-             "-help:        |       Displays valid commands\r\n"
-             "-about:       |       Displays system info\r\n"
-             "-clear:       |       Clears the terminal\r\n"
-             "-print:       |       Prints user message\r\n"
-             "-memr:        |       Reads memory location\r\n"
-             "-error:       |       Displays error info\r\n"
-             "-gpio:        |       Displays GPIO info\r\n"
-             "-timer:       |       Controls the periodic timer\r\n"
-             "-callback:    |       Sets callbacks to timer and switches\r\n"
-             "-reset:       |       Resets callbacks and stops timer\r\n"
-             "-ticker:      |       Sets periodic-command executions\r\n"
-             "-reg:         |       Perform register operations\r\n"
-             "-script:      |       Manage and execute scripts\r\n"
-             "-rem:         |       Add remarks in scripts\r\n"
-             "-if:          |       Conditional executions\r\n"
-             "-uart:        |       UART7 payload executions\r\n"
-             "-sine:        |       Generate sine wave audio output\r\n"
-             "-netudp:      |       Send UDP message\r\n"
-             );
-    }
-    else if (strcmp(subcmd, "about") == 0) {                                                // Printing -about substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n-about command      |       Print build info.\r\n");
-    }
-    else if (strcmp(subcmd, "help") == 0) {                                                 // Printing -help substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n-help command       |       Print available commands.\r\n");
-    }
-    else if (strcmp(subcmd, "clear") == 0) {                                                // Printing -clear substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n-clear command      |       Clear characters in terminal.\r\n");
-    }
-    else if (strcmp(subcmd, "print") == 0) {                                                // Printing -print substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n-print command      |       Print user typed characters.\r\n");
-    }
-    else if (strcmp(subcmd, "memr") == 0) {                                                 // Printing -memr substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n-memr command       |       Read memory at specified address.\r\n");
-    }
-    else if (strcmp(subcmd, "error") == 0) {                                                // Printing -error substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n-error command      |       Display error counts.\r\n");
-    }
-    else if (strcmp(subcmd, "gpio") == 0) {                                                 // Printing -gpio substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE,
-                 "\r\n-gpio command      |       Displays GPIO info.\r\n"
-                 "  -gpio         (read all GPIOs)\r\n"
-                 "  -gpio <number> <operation> [value]\r\n"
-                 "  number: 0-3 (LEDs), 4 (PK5), 5 (PD4), 6-7 (Switches)\r\n"
-                 "  operation: r (read), w (write), t (toggle)\r\n"
-                 "  value: 0 or 1 (for write operation)\r\n"
-                 "  Examples:\r\n"
-                 "   -gpio 0 r    (read LED 0)\r\n"
-                 "   -gpio 1 w 1  (turn on LED 1)\r\n"
-                 "   -gpio 2 t    (toggle LED 2)\r\n"
-                 "   -gpio 6 r    (read Switch 1)\r\n");
-    }
-    else if (strcmp(subcmd, "timer") == 0) {                                                // Printing -timer substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n-timer command      |       -timer <period_ms>\r\n"
-                 "  Sets up a periodic timer with the specified period in milliseconds.\r\n");
-    }
-    else if (strcmp(subcmd, "callback") == 0) {                                             // Printing -callback substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n-callback command      |       -callback <index> <count> <payload>\r\n"
-                 "  Sets up a callback with the specified index (0-2), count, and payload.\r\n"
-                 "  Index 0:  Timer callback\r\n"
-                 "  Index 1:  SW1 (right switch) callback\r\n"
-                 "  Index 2:  SW2 (left switch) callback\r\n"
-                 "  Count:    Number of times to execute (-1 for infinite)\r\n"
-                 "  Payload:  Command to execute when callback is triggered\r\n");
-    }
-    else if (strcmp(subcmd, "reset") == 0) {                                                // Printing -reset substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n-reset command      |       -reset [index]\r\n"
-                 "  Resets all LEDs & the specified callback or all callbacks if no index provided.\r\n"
-                 "  Also stops the timer if the timer callback is reset.\r\n"
-                 "  Index: 0 (Timer), 1 (SW1), 2 (SW2)\r\n");
-    }
-    else if (strcmp(subcmd, "ticker") == 0) {                                               // Printing -ticker substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE,
-                 "\r\n-ticker     |     -ticker <index> <initial_delay> <period> <count> <payload>\r\n"
-                 "  index: 0-15 (ticker number)\r\n"
-                 "  initial_delay: Initial delay in 10ms units (100 = 1 second)\r\n"
-                 "  period: Repeat period in 10ms units (100 = 1 second)\r\n"
-                 "  count: Number of repeats (-1 for infinite)\r\n"
-                 "  payload: Valid command to execute\r\n"
-                 "  Example: -ticker 3 100 100 5 -gpio 2 t\r\n");
-    }
-    else if (strcmp(subcmd, "reg") == 0) {                                                  // Printing -reg substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE,
-                 "\r\n-reg command       |       Perform register operations\r\n"
-                 "  Usage: -reg <operation> <dest> <src1> [src2]\r\n"
-                 "  Operations: MOV, XCG, INC, DEC, ADD, SUB, NEG, NOT,\r\n              AND, IOR, XOR, MUL, DIV, REM, MAX, MIN\r\n"
-                 "  Registers: R0 to R31\r\n"
-                 "  Immediate values: Use # prefix (e.g., #10)\r\n"
-                 "  Example: -reg ADD R0 R1 #5\r\n");
-    }
-    else if (strcmp(subcmd, "script") == 0) {                                               // Printing -script substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE,
-                 "\r\n-script command    |       Manage and execute scripts\r\n"
-                 "  Usage: -script [line_number] [payload]\r\n"
-                 "  - Without arguments: Display entire script space\r\n"
-                 "  - With line_number only: Execute script from that line\r\n"
-                 "  - With line_number and payload: Set script line content\r\n"
-                 "  Example: -script 17 -gpio 0 t\r\n");
-    }
-    else if (strcmp(subcmd, "rem") == 0) {                                                  // Printing -rem substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE,
-                 "\r\n-rem command       |       Add remarks in scripts\r\n"
-                 "  Usage: -rem [remark text]\r\n"
-                 "  - Adds a non-executable comment in scripts\r\n");
-    }
-    else if (strcmp(subcmd, "if") == 0) {                                                   // Printing -if substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE,
-                 "\r\n-if command        |       Conditional execution\r\n"
-                 "  Usage: -if A COND B ? DESTT : DESTF\r\n"
-                 "  A, B: Register (R0-R31) or immediate values\r\n"
-                 "  COND: Condition (>, =, <)\r\n"
-                 "  DESTT: Command/Script line to execute if true\r\n"
-                 "  DESTF: Command/Script line to execute if false\r\n"
-                 "  Example: -if R0 > #5 ? -script 10 : -print false\r\n");
-    }
-    else if (strcmp(subcmd, "uart") == 0) {                                                 // Printing -uart substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE,
-                 "\r\n-uart command       |       Send payload through UART7\r\n"
-                 "  Usage: -uart <payload>\r\n"
-                 "  - Sends the specified payload through UART7\r\n"
-                 "  - Will process any incoming messages from UART7\r\n"
-                 "  - Requires proper TX/RX/GND connections for communication\r\n"
-                 "  Examples:\r\n"
-                 "   -uart hello        (sends 'hello' through UART7)\r\n"
-                 "   -uart -gpio 0 t    (sends GPIO toggle command through UART7)\r\n");
-    }
-    else if (strcmp(subcmd, "sine") == 0) {                                                   // Printing -sine substring info
-        snprintf(user_prompt, USER_PROMPT_SIZE,
-            "\r\n-sine command       |       Generate sine wave through audio output\r\n"
-            "  Usage: -sine FREQ\r\n"
-            "  FREQ: Frequency in Hz (0 to stop)\r\n"
-            "  - Uses Timer0 for sample rate control\r\n"
-            "  - Maximum frequency limited by Nyquist rate (sample_rate/2)\r\n"
-            "  - Uses SPI DAC for high-quality output\r\n"
-            "  Examples:\r\n"
-            "   -sine 440     (generate 440 Hz sine wave - A4 note)\r\n"
-            "   -sine 1000    (generate 1 kHz test tone)\r\n"
-            "   -sine 0       (stop sine wave generation)\r\n");
-    }
-    else if (strcmp(subcmd, "netudp") == 0) {
-        snprintf(user_prompt, USER_PROMPT_SIZE,
-                "\r\n-netudp command      |       Send UDP messages\r\n"
-                "  Usage: -netudp IPADDR:PORT payload\r\n"
-                "  - Sends the specified payload through UDP\r\n"
-                "  - Will process any incoming UDP messages\r\n"
-                "  Examples:\r\n"
-                "   -netudp 192.168.1.100:1000 hello\r\n"
-                "   -netudp 192.168.1.100:1000 -gpio 0 t\r\n");
+        uart_output(session->uart, command_list, strlen(command_list));                     // Writing list generated from command table
+        session->prompt[0] = '\0';                                                          // Nothing left for the caller to write
+        return;                                                                             // Return from function
+    }
+    const Command *entry = find_command(subcmd, strlen(subcmd));                            // Looking up subcommand
+    if (entry != NULL) {                                                                    // Printing subcommand usage
+        snprintf(session->prompt, USER_PROMPT_SIZE, "%s", entry->usage);                    // Copying usage from command table
     }
     else {                                                                                  // Printing no substring prompt
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[33mWarning\033[0m: Unknown subcommand. Type -help for available commands.\r\n");
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[33mWarning\033[0m: Unknown subcommand. Type -help for available commands.\r\n");
     }
 }
     // -memr
-void memr_cmd(UART_Handle uart, char *address_str) {
+void memr_cmd(ShellSession *session, char *address_str) {
     char *endCnt;                                                                           // Declaring end pointer
     uint32_t address = strtoul(address_str, &endCnt, 16);                                   // Changing base from 32 to 16 for hex input
     if (*endCnt != '\0') {                                                                  // If format is invalid
                                                                                             // Printing user prompt for format error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid address format: %s\r\n", address_str);
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid address format: %s\r\n", address_str);
         increment_error(ERR_INVALID_ADDRESS);                                               // Incrementing error prompt
         return;                                                                             // Returning operation
         }
     if ((address > 0xFFFFC && address < 0x20000000) || address > 0x2003FFFC) {              // Flash and SRAM address limit
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Address out of allowed range (0x0 to 0xFFFFC | 0x20000000 to 0x2003FFFC).\r\n");
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Address out of allowed range (0x0 to 0xFFFFC | 0x20000000 to 0x2003FFFC).\r\n");
         increment_error(ERR_INVALID_ADDRESS);                                               // Incrementing GPIO error
         return;                                                                             // Returning loop operation
         }
@@ -695,16 +2262,16 @@ void memr_cmd(UART_Handle uart, char *address_str) {
     if ((address < 0x000FFFFF) ||                                                           // Flash address limit
        (address >= 0x20000000 && address < 0x2003FFFC)) {                                   // SRAM address limit
             volatile uint32_t *ptr = (volatile uint32_t *)address;                          // Safely cast the address to 32-bit pointer                                                                                // Reading/Formatting output string
-            snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nMemory at 0x%08lX: 0x%08X\r\n", address, *ptr);
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nMemory at 0x%08lX: 0x%08X\r\n", address, *ptr);
         } else {                                                                            // Else statement for out-of-range address input
-            snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[33mWarning\033[0m: Address may not be in a valid memory region.\r\n");
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[33mWarning\033[0m: Address may not be in a valid memory region.\r\n");
             volatile uint32_t *ptr = (volatile uint32_t *)address;                          // Declaring volatile read to address
-            snprintf(user_prompt + strlen(user_prompt), USER_PROMPT_SIZE - strlen(user_prompt),
+            snprintf(session->prompt + strlen(session->prompt), USER_PROMPT_SIZE - strlen(session->prompt),
                       "Memory at 0x%08lX: 0x%08X\r\n", address, *ptr);
         }
 }
     // -gpio
-void gpio_cmd(UART_Handle uart, char *args) {
+void gpio_cmd(ShellSession *session, char *args) {
     int gpio_num;                                                                           // Declaring GPIO variable
     char operation;                                                                         // Declaring operation char
     uint32_t gpio_pin;                                                                      // Declaring 32bit GPIO pin variable
@@ -731,13 +2298,13 @@ void gpio_cmd(UART_Handle uart, char *args) {
             offset += snprintf(buffer + offset, sizeof(buffer) - offset,                    // Printing to terminal with offset
                                "GPIO %d: %d\r\n", i, value);
         }
-        UART_write(uart, buffer, strlen(buffer));                                           // Writing to UART
+        uart_output(session->uart, buffer, strlen(buffer));                                 // Writing to UART
         return;                                                                             // Returning loop
     }
     if (sscanf(args, "%d %c", &gpio_num, &operation) != 2) {                                // Use prompt for input error
         increment_error(ERR_GPIO);                                                          // Incrementing GPIO error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid GPIO command format. Use: -gpio <number> <r|w|t> [value]\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing user_prompt to UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid GPIO command format. Use: -gpio <number> <r|w|t> [value]\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing session prompt to UART
         return;                                                                             // Returning loop
     }
     switch(gpio_num) {                                                                      // Declaring switch function for GPIO cases
@@ -751,55 +2318,60 @@ void gpio_cmd(UART_Handle uart, char *args) {
         case 7: gpio_pin = GPIO_SWITCH_2; is_switch = true; break;                          // SW2
         default:                                                                            // Declaring default function
             increment_error(ERR_GPIO);                                                      // Incrementing GPIO error
-            snprintf(user_prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid GPIO number.\r\n");
-            UART_write(uart, user_prompt, strlen(user_prompt));                             // Writing user_prompt to UART
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid GPIO number.\r\n");
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing session prompt to UART
             return;                                                                         // Returning function
     }
     if (is_switch && operation != 'r') {                                                    // Declaring statement for switches
         increment_error(ERR_GPIO);                                                          // Incrementing GPIO error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Switches can only be read. Use: -gpio %d r\r\n", gpio_num);
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing user_prompt to UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Switches can only be read. Use: -gpio %d r\r\n", gpio_num);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing session prompt to UART
         return;                                                                             // Returning statement
     }
     switch(operation) {                                                                     // Declaring switch function for user inputs
         case 'r':                                                                           // Read operation
             {
                 int value = GPIO_read(gpio_pin);                                            // Declaring user input as value read
-                snprintf(user_prompt, USER_PROMPT_SIZE, "GPIO %d value: %d\r\n", gpio_num, value);
-            }                                                                               // Printing user input as user_prompt
+                snprintf(session->prompt, USER_PROMPT_SIZE, "GPIO %d value: %d\r\n", gpio_num, value);
+            }                                                                               // Printing user input as session prompt
             break;                                                                          // Breaking operation
         case 'w':                                                                           // Write operation
             {
                 int value;                                                                  // Declaring value variable
                 if (sscanf(args, "%d %c %d", &gpio_num, &operation, &value) != 3) {         // Declaring user boundaries to cmd
                     increment_error(ERR_GPIO);                                              // Incrementing GPIO error
-                    snprintf(user_prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid write command. Use: -gpio <number> w <0|1>\r\n");
+                    snprintf(session->prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid write command. Use: -gpio <number> w <0|1>\r\n");
             } else {
                 GPIO_write(gpio_pin, value);                                                // Writing GPIO pin to user value
-                snprintf(user_prompt, USER_PROMPT_SIZE, "\033[35mGPIO %d set to %d\033[0m\r\n", gpio_num, value);
-                }                                                                           // Printing user input as user_prompt
+                snprintf(session->prompt, USER_PROMPT_SIZE, "\033[35mGPIO %d set to %d\033[0m\r\n", gpio_num, value);
+                }                                                                           // Printing user input as session prompt
             }
             break;                                                                          // Breaking operation
         case 't':                                                                           // Toggle operation
             {
                 int value = GPIO_read(gpio_pin);                                            // Declaring user input as value read
                 GPIO_write(gpio_pin, !value);                                               // Writing GPIO pin to user value
-                snprintf(user_prompt, USER_PROMPT_SIZE, "\033[35mGPIO %d toggled to %d\033[0m\r\n", gpio_num, !value);
+                snprintf(session->prompt, USER_PROMPT_SIZE, "\033[35mGPIO %d toggled to %d\033[0m\r\n", gpio_num, !value);
             }                                                                               // Printing user input
             break;                                                                          // Breaking operation
         default:                                                                            // Declaring default function
             increment_error(ERR_GPIO);                                                      // Incrementing GPIO error
-            snprintf(user_prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid operation. Use r (read), w (write), or t (toggle).\r\n");
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid operation. Use r (read), w (write), or t (toggle).\r\n");
     }                                                                                       // User prompt for error
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Writing from uart
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from uart
 }
     // -callback
-void callback_cmd(UART_Handle uart, char *args) {
+void callback_cmd(ShellSession *session, char *args) {
     int index, count;                                                                       // Declaring index and count variables
     char payload[MAX_CMD_LENGTH];                                                           // Declaring payload array
     int i = 0;                                                                              // Declaring increment variable for loop
     if (args == NULL || *args == '\0' || *args == '\r' || *args == '\n') {                  // Check parameters for args
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n----- Callback Status -----\r\n");     // User prompt
+        PayloadArena *arena = &payload_arena;                                               // Declaring payload arena
+        uint16_t offset, largest = 0;                                                       // Declaring free-list walk
+        unsigned blocks = 0;                                                                // Declaring free blocks
+        UInt key;                                                                           // Declaring interrupt key
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n----- Callback Status -----\r\n"); // User prompt
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing to UART
         while (i < MAX_CALLBACKS) {                                                         // Continue if less than MAX_CALLBACKS
             char status[64];                                                                // Declaring status array
             if (callbacks[i].count != 0) {                                                  // Checking if count is not 0
@@ -807,39 +2379,67 @@ void callback_cmd(UART_Handle uart, char *args) {
             } else {                                                                        // Checking for inactive callback(s)
                 snprintf(status, sizeof(status), "Inactive");                               // Printing inactive status to list
             }
+            key = Hwi_disable();                                                            // Copying payload before a compaction can move it
             char *current_payload = peek_payload(&callbacks[i]);                            // Declaring payload detector
-            snprintf(user_prompt, USER_PROMPT_SIZE, "Callback %d: %s\r\n"                   // User prompt with ternary operator (checks if payload isn't NULL)
-                         "   Payload: %s\r\n", i, status, current_payload != NULL ? current_payload : "None");
-            UART_write(uart, user_prompt, strlen(user_prompt));                             // Writing to UART
+            snprintf(payload, sizeof(payload), "%s", current_payload != NULL ? current_payload : "None");
+            Hwi_restore(key);
+            snprintf(session->prompt, USER_PROMPT_SIZE, "Callback %d: %s\r\n"               // User prompt for each callback
+                         "   Payload: %s\r\n", i, status, payload);
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing to UART
             i++;                                                                            // Increment count
             }
+            key = Hwi_disable();                                                            // Walking free list
+            for (offset = arena->ready ? arena->free_head : ARENA_NONE; offset != ARENA_NONE; offset = arena_block(offset)->next) {
+                uint16_t size = arena_block(offset)->size;                                  // Declaring free block size
+                if (size > largest) largest = size;
+                blocks++;
+            }
+            Hwi_restore(key);
+            if (!arena->ready) {                                                            // For arena not yet tiled
+                largest = CALLBACK_ARENA_SIZE;
+                blocks = 1;
+            }
+            snprintf(session->prompt, USER_PROMPT_SIZE, "Payload arena: %u of %u bytes in %u records (high %u)\r\n"
+                     "   Free: %u bytes in %u blocks (largest %u), %lu compactions, %lu refused\r\n"
+                     "   RAM: %u arena + %u callbacks = %u bytes (fixed %d-deep queues: %u bytes)\r\n",
+                     arena->used, CALLBACK_ARENA_SIZE, arena->records, arena->high,
+                     CALLBACK_ARENA_SIZE - arena->used, blocks, largest,
+                     (unsigned long)arena->compactions, (unsigned long)arena->failures,
+                     (unsigned)sizeof(PayloadArena), (unsigned)sizeof(callbacks), (unsigned)(sizeof(PayloadArena) + sizeof(callbacks)),
+                     QUEUE_SIZE, (unsigned)(MAX_CALLBACKS * (QUEUE_SIZE * (MAX_CMD_LENGTH + sizeof(CompiledCommand)) + USER_PROMPT_SIZE)));
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing to UART
             return;                                                                         // Return from loop
     }
     while (args && *args == ' ') args++;                                                    // Skip leading spaces in args
     if (sscanf(args, "%d %d %[^\n]", &index, &count, payload) != 3) {                       // Checking for 3 arguments reading
         increment_error(ERR_CALLBACK);                                                      // Incrementing callback error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid callback command. Use: -callback <index> <count> <payload>\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing user prompt to UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid callback command. Use: -callback <index> <count> <payload>\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing user prompt to UART
         return;                                                                             // Return operation
     }
     if (index < 0 || index >= MAX_CALLBACKS) {                                              // Checking for index within valid range
         increment_error(ERR_CALLBACK);                                                      // Incrementing callback error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid callback index. Use 0, 1, or 2.\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing user prompt to UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid callback index. Use 0, 1, or 2.\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing user prompt to UART
         return;                                                                             // Returning operation
     }
     callbacks[index].count = 0;                                                             // Resetting count for callbacks
-    callbacks[index].queue_front = 0;                                                       // Resetting front queue for callbacks
-    callbacks[index].queue_rear = 0;                                                        // Resetting rear queue for callbacks
-    callbacks[index].queue_size = 0;                                                        // Resetting queue size for callbacks
+    clear_payloads(&callbacks[index]);                                                      // Releasing queued payloads for callbacks
     callbacks[index].output_length = 0;                                                     // Resetting length for callbacks
     callbacks[index].output_position = 0;                                                   // Resetting position for callbacks
     callbacks[index].index = index;                                                         // Setting index for callbacks
     callbacks[index].count = count;                                                         // Setting new count for callbacks
-    callbacks[index].uart = uart;                                                           // Setting uart for callbacks
+    callbacks[index].owner = session;                                                       // Setting owning session for callbacks
     callbacks[index].is_executing = false;                                                  // Setting execution flag for callbacks
     callbacks[index].is_button_callback = (index == SW1_CALLBACK || index == SW2_CALLBACK); // Setting button callbacks
-    enqueue_payload(&callbacks[index], payload);                                            // Declaring enqueue function to callbacks
+    if (!enqueue_payload(&callbacks[index], payload)) {                                     // Storing payload in the shared arena
+        increment_error(ERR_CALLBACK);                                                      // Incrementing callback error
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Callback payload arena full (%u of %u bytes used).\r\n",
+                 payload_arena.used, CALLBACK_ARENA_SIZE);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing user prompt to UART
+        callbacks[index].count = 0;                                                         // Leaving callback inactive
+        return;                                                                             // Returning operation
+    }
     switch(index) {                                                                         // Setting up each callback index
         case TIMER_CALLBACK:                                                                // Timer callback set in timer_cmd function
             break;                                                                          // Breaking case
@@ -852,22 +2452,22 @@ void callback_cmd(UART_Handle uart, char *args) {
             GPIO_enableInt(GPIO_SWITCH_2);                                                  // Enable interrupts for SW2
             break;                                                                          // Breaking case
     }
-    snprintf(user_prompt, USER_PROMPT_SIZE, "\033[35mCallback %d set with count %d and payload\033[0m: %s\r\n", index, count, payload);
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Writing user prompt to UART
+    snprintf(session->prompt, USER_PROMPT_SIZE, "\033[35mCallback %d set with count %d and payload\033[0m: %s\r\n", index, count, payload);
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing user prompt to UART
 }
     // -timer
-void timer_cmd(UART_Handle uart, char *args) {
+void timer_cmd(ShellSession *session, char *args) {
     int period;                                                                             // Declaring callback 0 period
     if (sscanf(args, "%d", &period) != 1) {                                                 // Scanning for value not set as 1
         increment_error(ERR_TIMER);                                                         // Incrementing timer error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid timer command. Use: -timer <period_ms>\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing user prompt to UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid timer command. Use: -timer <period_ms>\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing user prompt to UART
         return;                                                                             // Returning from loop
     }
     if (period < 5) {                                                                       // When callback 0 timer has value less than 5 ms
         increment_error(ERR_TIMER);                                                         // Incrementing timer error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Failed to open timer. Period must be at least 5 ms.\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing user prompt to UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Failed to open timer. Period must be at least 5 ms.\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing user prompt to UART
         return;                                                                             // Returning from loop
     }
     if (timer1Handle != NULL) {                                                             // When callback 0 timer not NULL
@@ -884,18 +2484,18 @@ void timer_cmd(UART_Handle uart, char *args) {
     timer1Handle = Timer_open(CONFIG_TIMER_1, &params);                                     // Attempting to open timer with specified parameters
     if (timer1Handle == NULL) {                                                             // Checking for timer failure
         increment_error(ERR_TIMER);                                                         // Incrementing timer error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Failed to open timer.\r\n");
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Failed to open timer.\r\n");
     } else {
         callbacks[TIMER_CALLBACK].is_large_interval = (period >= 100);                      // Considering intervals >= 100ms as large
         callbacks[TIMER_CALLBACK].output_length = 0;                                        // Resetting output buffer length
         callbacks[TIMER_CALLBACK].output_position = 0;                                      // Resetting output buffer position
         Timer_start(timer1Handle);                                                          // Starting callback 0 timer
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\033[35mTimer started with period %d ms.\033[0m\r\n", period);
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\033[35mTimer started with period %d ms.\033[0m\r\n", period);
     }
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Writing user prompt to UART
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing user prompt to UART
 }
     // -reset
-void reset_cmd(UART_Handle uart, char *args) {
+void reset_cmd(ShellSession *session, char *args) {
     int index = -1;                                                                         // Declaring index variable as infinite value
     int i;                                                                                  // Declare i variable for loops
     GPIO_write(GPIO_LED_0, 0);                                                              // Writing LED 1 off
@@ -905,45 +2505,42 @@ void reset_cmd(UART_Handle uart, char *args) {
     if (sscanf(args, "%d", &index) == 1) {                                                  // Scanning arguments toggled as 1
         if (index >= 0 && index < MAX_CALLBACKS) {                                          // For index options
             callbacks[index].count = 0;                                                     // Resetting count for callbacks
-            callbacks[index].queue_front = 0;                                               // Resetting front queue for callbacks
-            callbacks[index].queue_rear = 0;                                                // Resetting rear queue for callbacks
-            callbacks[index].queue_size = 0;                                                // Resetting queue size for callbacks
+            clear_payloads(&callbacks[index]);                                              // Releasing queued payloads for callbacks
             if (index == TIMER_CALLBACK && timer1Handle != NULL) {                          // For inactive/expired timer
                 Timer_stop(timer1Handle);                                                   // Stopping timer operations
             }
-            snprintf(user_prompt, USER_PROMPT_SIZE, "\033[35mCallback %d has been reset & LEDs toggled off.\033[0m\r\n", index);
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\033[35mCallback %d has been reset & LEDs toggled off.\033[0m\r\n", index);
         } else {                                                                            // Error prompt for invalid index
             increment_error(ERR_RESET);                                                     // Incrementing reset error
-            snprintf(user_prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid callback index.\r\n");
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\033[31mError\033[0m: Invalid callback index.\r\n");
         }
     } else {                                                                                // Reset all callbacks & stop timer
         for (i = 0; i < MAX_CALLBACKS; i++) {                                               // 'i' declared outside loop
             callbacks[i].count = 0;                                                         // Resetting count for i callbacks
-            callbacks[i].queue_front = 0;                                                   // Resetting front queue for i callbacks
-            callbacks[i].queue_rear = 0;                                                    // Resetting rear queue for i callbacks
-            callbacks[i].queue_size = 0;                                                    // Resetting queue size for i callbacks
+            clear_payloads(&callbacks[i]);                                                  // Releasing queued payloads for i callbacks
         }
         if (timer1Handle != NULL) {                                                         // When timer is value greater than NULL
             Timer_stop(timer1Handle);                                                       // Stopping timer operations
         }
         for (i = 0; i < MAX_TICKERS; i++) {                                                 // For tickers detected active
             tickers[i].active = false;                                                      // Resetting active ticker flag
+            schedule_ticker(i, 0);                                                          // Unlinking from the wheel
         }
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\033[35mAll callbacks, timers, & LEDs are deactivated.\033[0m\r\n");
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\033[35mAll callbacks, timers, & LEDs are deactivated.\033[0m\r\n");
     }
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Writing user prompt to UART
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing user prompt to UART
 }
     // -ticker
-void ticker_cmd(UART_Handle uart, char *args) {
+void ticker_cmd(ShellSession *session, char *args) {
     int i, index, initial_delay, period, count;                                             // Declaring ticker variables
     char payload[MAX_CMD_LENGTH];                                                           // Declaring ticker payload array
     if (args == NULL || *args == '\0' || *args == '\r' || *args == '\n') {                  // If ticker declared alone
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n----- Ticker Status -----\r\n");       // Printing ticker status prompt
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing user prompt to UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n----- Ticker Status -----\r\n");   // Printing ticker status prompt
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing user prompt to UART
         for (i = 0; i < MAX_TICKERS; i++) {                                                 // Checking all tickers
             Ticker *ticker = &tickers[i];                                                   // Point each ticker
             if (ticker->active) {                                                           // If ticker is active
-                snprintf(user_prompt, USER_PROMPT_SIZE,                                     // Printing active ticker status
+                snprintf(session->prompt, USER_PROMPT_SIZE,                                 // Printing active ticker status
                          "Ticker %d: Active\r\n"
                          "  Initial Delay: %d\r\n"
                          "  Period:        %d\r\n"
@@ -951,83 +2548,117 @@ void ticker_cmd(UART_Handle uart, char *args) {
                          "  Payload:       %s\r\n",
                          i, ticker->initial_delay, ticker->period, ticker->count, ticker->payload);
             } else {                                                                        // If ticker is inactive
-                snprintf(user_prompt, USER_PROMPT_SIZE, "Ticker %d: Inactive\r\n", i);
+                snprintf(session->prompt, USER_PROMPT_SIZE, "Ticker %d: Inactive\r\n", i);
             }
-            UART_write(uart, user_prompt, strlen(user_prompt));                             // Writing to UART
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing to UART
         }
         return;                                                                             // Return from loop
     }
                                                                                             // For incorrect ticker command format
     if (sscanf(args, "%d %d %d %d %[^\n]", &index, &initial_delay, &period, &count, payload) != 5) {
         increment_error(ERR_TICKER);                                                        // Incrementing ticker error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid ticker command format.\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing user prompt to UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid ticker command format.\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing user prompt to UART
         return;                                                                             // Return from loop
     }
     if (index < 0 || index >= MAX_TICKERS) {                                                // For incorrect ticker index input
         increment_error(ERR_TICKER);                                                        // Incrementing ticker error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid ticker index.\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing user prompt to UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid ticker index.\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing user prompt to UART
         return;                                                                             // Return from loop
     }
     Ticker *ticker = &tickers[index];                                                       // Getting pointer to specified ticker index
-    ticker->active = true;                                                                  // Activate ticker
+    ticker->active = false;                                                                 // Parking ticker while it is rewritten
+    schedule_ticker(index, 0);                                                              // Unlinking from the wheel
     ticker->initial_delay = initial_delay;                                                  // Setting initial delay
     ticker->period = period;                                                                // Period for subsequent executions
     ticker->count = count;                                                                  // Setting execution count
     strncpy(ticker->payload, payload, MAX_CMD_LENGTH - 1);                                  // Copying payload for ticker
     ticker->payload[MAX_CMD_LENGTH - 1] = '\0';                                             // Ensuring NULL of payload string
-    ticker->next_execution = ticker_time + initial_delay;                                   // Calculate first execution for ticker
-    ticker->uart = uart;                                                                    // Set UART handle for ticker
-    snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nTicker %d set with...\r\n initial delay: %d\r\n period: %d\r\n count: %d\r\n payload: %s\r\n",
+    release_command(&ticker->compiled);                                                     // Releasing the payload it replaces
+    compile_command(ticker->payload, &ticker->compiled);                                    // Compiling payload once at registration
+    ticker->owner = session;                                                                // Set UART handle for ticker
+    ticker->active = true;                                                                  // Activate ticker
+    schedule_ticker(index, initial_delay * TICKER_TICKS_PER_UNIT);                          // Linking first execution into the wheel
+    snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nTicker %d set with...\r\n initial delay: %d\r\n period: %d\r\n count: %d\r\n payload: %s\r\n",
              index, initial_delay, period, count, payload);                                 // Printing active ticker prompt
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Writing user prompt to UART
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing user prompt to UART
 }
     // -reg
-void reg_cmd(UART_Handle uart, char *args) {                                                // Declaring operation array to dest, src1 and src2 lengths
+void reg_cmd(ShellSession *session, char *args) {                                           // Declaring operation array to dest, src1 and src2 lengths
     char op[10], dest[MAX_REG_NAME_LENGTH], src1[MAX_REG_NAME_LENGTH], src2[MAX_REG_NAME_LENGTH];
     if (args == NULL || *args == '\0' || *args == '\r' || *args == '\n') {                  // Reading all registers if no values after command
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n----- Register Status -----\r\n");     // Print status prompt
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing user prompt to UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n----- Register Status (bank %d) -----\r\n", session->bank);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing user prompt to UART
         int i;                                                                              // Declaring loop variable
         for (i = 0; i < NUM_REGISTERS; i++) {                                               // For all usable registers
-            snprintf(user_prompt, USER_PROMPT_SIZE, "%s: %d\r\n", reg_names[i], registers[i]);
-            UART_write(uart, user_prompt, strlen(user_prompt));                             // Writing user prompt to UART
+            snprintf(session->prompt, USER_PROMPT_SIZE, "%s: %d\r\n", reg_names[i], registers[session->bank][i]);
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing user prompt to UART
         }
         return;                                                                             // Return from loop
     }
     int num_args = sscanf(args, "%s %s %s %s", op, dest, src1, src2);                       // Assigning variables to string characters
     if (num_args < 2) {                                                                     // If two or more inputs to command arguments
         increment_error(ERR_REG);                                                           // Incrementing error count
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid register command format.\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing user prompt to UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid register command format.\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing user prompt to UART
+        return;                                                                             // Return from loop
+    }
+    if (strcmp(op, "BNK") == 0) {                                                           // Declaring BNK operation (-reg BNK <bank>)
+        char *endptr;                                                                       // Declaring number end pointer
+        long bank = strtol(dest, &endptr, 10);                                              // Parsing bank number
+        if (num_args != 2 || *endptr != '\0' || bank < 0 || bank >= REG_BANKS) {            // For invalid bank
+            increment_error(ERR_REG);                                                       // Increment error count
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Register bank must be 0 to %d.\r\n", REG_BANKS - 1);
+        } else {                                                                            // For selected bank
+            session->bank = (uint8_t)bank;                                                  // Selecting bank for this session
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nRegister bank %d selected.\r\n", session->bank);
+        }
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing user prompt to UART
+        return;                                                                             // Return from loop
+    }
+    if (strcmp(op, "ALS") == 0) {                                                           // Declaring ALS operation (-reg ALS <alias> <register>)
+        int index = (num_args >= 3) ? reg_index(src1) : -1;                                 // Resolving aliased register
+        if (index < 0 || dest[0] == '#' || (dest[0] >= '0' && dest[0] <= '9') ||            // For invalid register or alias name
+            (dest[0] == 'R' && dest[1] >= '0' && dest[1] <= '9') || !set_reg_alias(dest, index)) {
+            increment_error(ERR_REG);                                                       // Increment error count
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid register alias.\r\n");
+        } else {                                                                            // For stored alias
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nAlias %s set to %s.\r\n", dest, reg_names[index]);
+        }
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing user prompt to UART
+        return;                                                                             // Return from loop
+    }
+    CompiledCommand compiled;                                                               // Declaring resolved operation
+    if (compile_reg(args, &compiled)) {                                                     // For register-only operands
+        execute_reg(session, &compiled, true);                                              // Executing on register indices
         return;                                                                             // Return from loop
     }
     int32_t value1, value2;                                                                 // Declaring values to INC/DEC operations
         if (strcmp(op, "INC") == 0 || strcmp(op, "DEC") == 0) {                             // If INC/DEC operation is detected
-            value1 = get_reg_value(dest);                                                   // Treating the dest as src1 for INC/DEC
+            value1 = get_reg_value(session, dest);                                          // Treating the dest as src1 for INC/DEC
             value2 = 0;                                                                     // Declaring 0 (Since not used for INC/DEC)
         } else {                                                                            // For src2 input usage
-            value1 = parse_operand(src1);                                                   // Declaring parse to src1 variable
-            value2 = (num_args == 4) ? parse_operand(src2) : 0;                             // Declaring src2 operations
+            value1 = parse_operand(session, src1);                                          // Declaring parse to src1 variable
+            value2 = (num_args == 4) ? parse_operand(session, src2) : 0;                    // Declaring src2 operations
         }
         int32_t result = 0;                                                                 // Declaring result as 0 for other operations
         if (strcmp(op, "MOV") == 0) {                                                       // Declaring MOV operation
             result = value1;
         } else if (strcmp(op, "XCG") == 0) {                                                // Declaring XCG operation
-            result = get_reg_value(dest);
-            set_reg_value(src1, result);
+            result = get_reg_value(session, dest);
+            set_reg_value(session, src1, result);
             result = value1;
         } else if (strcmp(op, "INC") == 0) {                                                // Declaring INC operation
-            result = value1 + 1;
+            result = (int32_t)((uint32_t)value1 + 1);                                       // Wrapping (signed overflow is undefined)
         } else if (strcmp(op, "DEC") == 0) {                                                // Declaring DEC operation
-            result = value1 - 1;
+            result = (int32_t)((uint32_t)value1 - 1);
         } else if (strcmp(op, "ADD") == 0) {                                                // Declaring ADD operation
-            result = value1 + value2;
+            result = (int32_t)((uint32_t)value1 + (uint32_t)value2);
         } else if (strcmp(op, "SUB") == 0) {                                                // Declaring SUB operation
-            result = value1 - value2;
+            result = (int32_t)((uint32_t)value1 - (uint32_t)value2);
         } else if (strcmp(op, "NEG") == 0) {                                                // Declaring NEG operation
-            result = -value1;
+            result = (int32_t)(0u - (uint32_t)value1);
         } else if (strcmp(op, "NOT") == 0) {                                                // Declaring NOT operation
             result = ~value1;
         } else if (strcmp(op, "AND") == 0) {                                                // Declaring AND operation
@@ -1037,20 +2668,22 @@ void reg_cmd(UART_Handle uart, char *args) {
         } else if (strcmp(op, "XOR") == 0) {                                                // Declaring XOR operation
             result = value1 ^ value2;
         } else if (strcmp(op, "MUL") == 0) {                                                // Declaring MUL operation
-            result = value1 * value2;
+            result = (int32_t)((uint32_t)value1 * (uint32_t)value2);
         } else if (strcmp(op, "DIV") == 0) {                                                // Declaring DIV operation
-            if (value2 == 0) {                                                              // Declaring division by 0 error
+            if (value2 == 0 || (value2 == -1 && value1 == INT32_MIN)) {                     // Declaring division by 0 or overflow error
                 increment_error(ERR_REG);                                                   // Increment error count
-                snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Division by zero.\r\n");
-                UART_write(uart, user_prompt, strlen(user_prompt));                         // Writing user prompt to UART
+                snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: %s.\r\n",
+                         value2 == 0 ? "Division by zero" : "Integer overflow in division");
+                uart_output(session->uart, session->prompt, strlen(session->prompt));       // Writing user prompt to UART
                 return;                                                                     // Return from loop
             }
             result = value1 / value2;
         } else if (strcmp(op, "REM") == 0) {                                                // Declaring REM operations
-            if (value2 == 0) {                                                              // Declaring division by 0 error
+            if (value2 == 0 || (value2 == -1 && value1 == INT32_MIN)) {                     // Declaring division by 0 or overflow error
                 increment_error(ERR_REG);                                                   // Increment error count
-                snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Division by zero.\r\n");
-                UART_write(uart, user_prompt, strlen(user_prompt));                         // Writing user prompt to UART
+                snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: %s.\r\n",
+                         value2 == 0 ? "Division by zero" : "Integer overflow in division");
+                uart_output(session->uart, session->prompt, strlen(session->prompt));       // Writing user prompt to UART
                 return;                                                                     // Return from loop
             }
             result = value1 % value2;
@@ -1060,39 +2693,51 @@ void reg_cmd(UART_Handle uart, char *args) {
             result = (value1 < value2) ? value1 : value2;
         } else {                                                                            // Declaring invalid operation
             increment_error(ERR_REG);                                                       // Increment error count
-            snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Unknown operation %s.\r\n", op);
-            UART_write(uart, user_prompt, strlen(user_prompt));                             // Writing user prompt to UART
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Unknown operation %s.\r\n", op);
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing user prompt to UART
             return;                                                                         // Return from loop
         }
-        set_reg_value(dest, result);                                                        // Using dest as register to modify (for INC/DEC)
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nOperation completed. %s = %d\r\n", dest, result);
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing user prompt to UART
+        set_reg_value(session, dest, result);                                               // Using dest as register to modify (for INC/DEC)
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nOperation completed. %s = %d\r\n", dest, result);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing user prompt to UART
 }
     // -script
-void script_cmd(UART_Handle uart, char *args) {
+void script_cmd(ShellSession *session, char *args) {
     int line_number;                                                                        // Declaring line number variable
     char payload[MAX_SCRIPT_LINE_LENGTH];                                                   // Declaring payload array to script length
     if (args != NULL && strncmp(args, " clear", 6) == 0) {                                  // Handling "clear" command
         int i;                                                                              // Declaring loop variable
-        while (!Queue_empty(scriptQueue)) {                                                 // Clearing the script queue first
-            Queue_Elem *elem = Queue_get(scriptQueue);                                      // Declaring queue element variable
-            free((ScriptQueueElement *)elem);                                               // Freeing the script queue elements
-        }
+        stop_script();                                                                      // Halting the script first
         for (i = 0; i < SCRIPT_SIZE; i++) {                                                 // Clearing all script lines
             script_space[i][0] = '\0';                                                      // Clearing each line
+            release_command(&script_compiled[i]);                                           // Clearing compiled line
         }
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nEntire script space cleared and script execution halted.\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing from UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nEntire script space cleared and script execution halted.\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from UART
+        return;                                                                             // Return from loop
+    }
+    if (args != NULL && strcmp(args, " stop") == 0) {                                       // Handling "stop" command
+        stop_script();                                                                      // Halting the script
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nScript execution stopped.\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from UART
+        return;                                                                             // Return from loop
+    }
+    if (args != NULL && strcmp(args, " stats") == 0) {                                      // Handling "stats" command
+        snprintf(session->prompt, USER_PROMPT_SIZE,
+                "\r\nScript %s, lines executed: %lu, call depth high-water: %d/%d, overflows: %lu\r\n",
+                is_script_executing ? "running" : "idle", (unsigned long)script_lines,
+                script_depth_high, SCRIPT_CALL_DEPTH, (unsigned long)script_overflows);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from UART
         return;                                                                             // Return from loop
     }
     if (args == NULL || *args == '\0') {                                                    // Display entire script space if no arguments
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n----- Script Space -----\r\n");        // Script space prompt
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing from UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n----- Script Space -----\r\n");    // Script space prompt
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from UART
         int i;                                                                              // Declaring loop variable
         for (i = 0; i < SCRIPT_SIZE; i++) {                                                 // Declaring script space scanner
             if (script_space[i][0] != '\0') {                                               // Omitting empty script spaces
-                snprintf(user_prompt, USER_PROMPT_SIZE, "%2d: %s\r\n", i, script_space[i]); // Printing script spaces that are full
-                UART_write(uart, user_prompt, strlen(user_prompt));                         // Writing from UART
+                snprintf(session->prompt, USER_PROMPT_SIZE, "%2d: %s\r\n", i, script_space[i]); // Printing script spaces that are full
+                uart_output(session->uart, session->prompt, strlen(session->prompt));       // Writing from UART
             }
         }
         return;                                                                             // Return from loop
@@ -1101,17 +2746,17 @@ void script_cmd(UART_Handle uart, char *args) {
     int args_read = sscanf(args, "%d %[^\n]", &line_number, payload);                       // Declaring read arguments as scan functions
     if (line_number < 0 || line_number >= SCRIPT_SIZE) {                                    // Validating line number
         increment_error(ERR_SCRIPT);                                                        // Incrementing script error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid script line number.\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing from UART
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid script line number.\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from UART
         return;                                                                             // Return from loop
     }
     if (args_read == 1) {                                                                   // Handle different command cases
         if (script_space[line_number][0] != '\0') {                                         // Display single line
-            snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nLine %d: %s\r\n", line_number, script_space[line_number]);
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nLine %d: %s\r\n", line_number, script_space[line_number]);
         } else {                                                                            // For empty script lines
-            snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nLine %d: <empty>\r\n", line_number);
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nLine %d: <empty>\r\n", line_number);
         }
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing from UART
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from UART
     }
     else if (args_read >= 2) {                                                              // For read arguments greater than or 2
         rest_of_line = args;                                                                // Finding first non-space character after the line number
@@ -1121,18 +2766,19 @@ void script_cmd(UART_Handle uart, char *args) {
         if (strcmp(rest_of_line, "x") == 0 || strcmp(rest_of_line, "c") == 0) {             // Checking if it's an execution command
             if (rest_of_line[0] == 'c') {                                                   // For if it's a clear command
                 script_space[line_number][0] = '\0';                                        // Clearing line
-                snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nScript line %d cleared.\r\n", line_number);
-                UART_write(uart, user_prompt, strlen(user_prompt));                         // Writing from UART
+                release_command(&script_compiled[line_number]);                             // Clearing compiled line
+                snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nScript line %d cleared.\r\n", line_number);
+                uart_output(session->uart, session->prompt, strlen(session->prompt));       // Writing from UART
             } else {                                                                        // Executing from declaring line
                 if (script_space[line_number][0] == '\0') {                                 // Execute from this line
                     increment_error(ERR_SCRIPT);                                            // Incrementing script error
-                    snprintf(user_prompt, USER_PROMPT_SIZE,                                 // Printing error prompt
+                    snprintf(session->prompt, USER_PROMPT_SIZE,                             // Printing error prompt
                             "\r\n\033[31mError\033[0m: Cannot execute empty script line.\r\n");
-                    UART_write(uart, user_prompt, strlen(user_prompt));                     // Writing from UART
-                } else {                                                                    // Queue script execution request
-                    execute_script(uart, line_number);                                      // Declaring script execution to UART
-                    snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nScript execution started.\r\n");
-                    UART_write(uart, user_prompt, strlen(user_prompt));                     // Writing from UART
+                    uart_output(session->uart, session->prompt, strlen(session->prompt));   // Writing from UART
+                } else {                                                                    // Start script execution request
+                    execute_script(session, line_number);                                   // Declaring script execution to UART
+                    snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nScript execution started.\r\n");
+                    uart_output(session->uart, session->prompt, strlen(session->prompt));   // Writing from UART
                 }
             }
         } else {                                                                            // Add dash if not present and not a remark
@@ -1142,286 +2788,690 @@ void script_cmd(UART_Handle uart, char *args) {
                 strncpy(script_space[line_number], rest_of_line, MAX_SCRIPT_LINE_LENGTH - 1);
             }
             script_space[line_number][MAX_SCRIPT_LINE_LENGTH - 1] = '\0';                   // Tabs to script space
-            snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nScript line %d set to: %s\r\n",    // Printing script line prompt
+            release_command(&script_compiled[line_number]);                                 // Releasing the line it replaces
+            compile_command(script_space[line_number], &script_compiled[line_number]);      // Compiling script line once
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nScript line %d set to: %s\r\n", // Printing script line prompt
                     line_number, script_space[line_number]);                                // Printing script line prompt
-            UART_write(uart, user_prompt, strlen(user_prompt));                             // Writing from UART
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing from UART
         }
     }
 }
     // -rem
-void rem_cmd(UART_Handle uart, char *args) {
-    snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nRemark acknowledged.\r\n");                // Printing successful remark prompt
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Do nothing for remarks, only acknowledge!
+void rem_cmd(ShellSession *session, char *args) {
+    snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nRemark acknowledged.\r\n");            // Printing successful remark prompt
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Do nothing for remarks, only acknowledge!
 }
     // -if
-void if_cmd(UART_Handle uart, char *args) {
+void if_cmd(ShellSession *session, char *args) {
+    IfExpr expr;                                                                            // Declaring compiled condition
+    CompiledCommand compiled;                                                               // Declaring resolved destinations
     if (args == NULL || *args == '\0') {                                                    // For invalid format
         increment_error(ERR_IF);                                                            // Increment conditional error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid if command format.\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing from uart
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid if command format.\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
         return;                                                                             // Return from loop
     }
-    snprintf(user_prompt, USER_PROMPT_SIZE, "Debug: if command args='%s'\r\n", args);       // Debug print for input args
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Writing from uart
-    char operand1[32], condition[8], operand2[32];                                          // Declaring operands and condition arrays
-    char destt[MAX_CMD_LENGTH] = "", destf[MAX_CMD_LENGTH] = "";                            // Declaring destination variables
-    char *question_mark = strchr(args, '?');                                                // Parsing conditional part '?'
-    char *colon = strchr(args, ':');                                                        // Parsing conditional part ':'
-    if (!question_mark || !colon) {                                                         // For missing ? or :
+    const char *error = compile_if(args, args, &expr, &compiled);                           // Compiling condition and destinations
+    if (error != NULL) {                                                                    // For invalid syntax or condition
         increment_error(ERR_IF);                                                            // Increment conditional error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid if syntax. Missing ? or :\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing from uart
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: %s\r\n", error);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
         return;                                                                             // Return from loop
     }
-    char cond_part[MAX_CMD_LENGTH];                                                         // Creating a temporary copy of the condition part for parsing
-    size_t cond_len = question_mark - args;                                                 // ^
-    strncpy(cond_part, args, cond_len);                                                     // ^
-    cond_part[cond_len] = '\0';                                                             // ^
-    snprintf(user_prompt, USER_PROMPT_SIZE, "Debug: condition part='%s'\r\n", cond_part);   // Debugging print for condition part
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Writing from uart
-    char *cond_symbol = NULL;                                                               // Finding condition symbol (>, =, <)
-    if (strchr(cond_part, '>')) cond_symbol = strchr(cond_part, '>');                       // For '>'
-    else if (strchr(cond_part, '=')) cond_symbol = strchr(cond_part, '=');                  // For '='
-    else if (strchr(cond_part, '<')) cond_symbol = strchr(cond_part, '<');                  // For '<'
-    if (!cond_symbol) {                                                                     // For missing conditional symbol
-        increment_error(ERR_IF);                                                            // Increment conditional error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Missing condition operator (>, =, <)\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing from uart
-        return;                                                                             // Returning from loop
+    execute_if(session, &compiled, &expr, args);                                            // Evaluate and execute destination
+}
+    // -debug
+void debug_cmd(ShellSession *session, char *args) {
+    char *endptr;                                                                           // Declaring number end pointer
+    while (*args == ' ') args++;                                                            // Skipping leading spaces
+    if (*args != '\0') {                                                                    // For new level
+        long level = strtol(args, &endptr, 10);                                             // Parsing level
+        while (*endptr == ' ') endptr++;                                                    // Skipping trailing spaces
+        if (endptr == args || *endptr != '\0' || level < 0 || level > DEBUG_LEVEL_MAX) {    // For invalid level
+            increment_error(ERR_IF);                                                        // Increment conditional error
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Debug level must be 0 to %d.\r\n", DEBUG_LEVEL_MAX);
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing from uart
+            return;                                                                         // Return from loop
+        }
+        session->verbosity = (uint8_t)level;                                                // Storing level for this session
+    }
+    snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nDebug level: %d\r\n", session->verbosity); // Printing current level
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from uart
+}
+    // -uart frame (';'-separated commands pre-encoded into one acknowledged frame)
+static void uart_frame_cmd(ShellSession *session, char *list) {
+    uint8_t payload[UART_FRAME_MAX - UART_FRAME_OVERHEAD];                                  // Declaring batch records
+    size_t size = 0;                                                                        // Declaring batch size
+    int count = 0;                                                                          // Declaring batch commands
+    char *next;                                                                             // Declaring next command
+    for (; list != NULL; list = next) {                                                     // For each command in the list
+        next = strchr(list, ';');                                                           // Finding separator
+        if (next != NULL) {
+            *next++ = '\0';                                                                 // Ending this command
+        }
+        while (*list == ' ') list++;                                                        // Skipping leading spaces
+        size_t length = strcspn(list, " ");                                                 // Declaring command name length
+        if (length == 0) {                                                                  // For empty entry
+            continue;
+        }
+        char *cmd_args = list + length + strspn(list + length, " ");                        // Declaring arguments without the separator
+        size_t arg_length = strlen(cmd_args);                                               // Declaring argument length
+        while (arg_length > 0 && cmd_args[arg_length - 1] == ' ') arg_length--;             // Trimming trailing spaces
+        const Command *entry = (list[0] == '-') ? find_command(list + 1, length - 1) : NULL;
+        if (entry == NULL || (entry->schema == CMD_ARGS_NONE && arg_length > 0) ||          // For command a peer could not run
+            (entry->schema == CMD_ARGS_REQUIRED && arg_length == 0) ||
+            1 + length + arg_length > 255 || size + 1 + length + arg_length > sizeof(payload)) { // or a batch that no longer fits
+            increment_error(ERR_UART);                                                      // Incrementing uart error
+            snprintf(session->prompt, USER_PROMPT_SIZE,
+                     "\r\n\033[31mError\033[0m: Cannot frame %.*s (unknown, bad arguments or batch full)\r\n", (int)length, list);
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing from uart
+            return;                                                                         // Return from function
+        }
+        payload[size++] = (uint8_t)(length + arg_length);                                   // Record length (name length, name and arguments)
+        payload[size++] = (uint8_t)(length - 1);                                            // Record name length
+        memcpy(payload + size, list + 1, length - 1);                                       // Record command name (table order may differ on the peer)
+        size += length - 1;
+        memcpy(payload + size, cmd_args, arg_length);                                       // Record arguments
+        size += arg_length;
+        count++;
+    }
+    if (count == 0) {                                                                       // For empty batch
+        increment_error(ERR_UART);                                                          // Incrementing uart error
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Must attach commands to -uart frame\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
+        return;                                                                             // Return from function
     }
-    size_t op1_len = cond_symbol - cond_part;                                               // Extract operand1 (everything before the condition symbol)
-    strncpy(operand1, cond_part, op1_len);                                                  // ^
-    operand1[op1_len] = '\0';                                                               // ^
-    condition[0] = *cond_symbol;                                                            // Extract the condition (0)
-    condition[1] = '\0';                                                                    // Extract the condition (1)
-    strcpy(operand2, cond_symbol + 1);                                                      // Extract operand2 (everything after the condition symbol until detected ?)
-    char *start, *end;                                                                      // Trimming whitespace from operands
-    start = operand1;                                                                       // Trim operand1
-    while (*start == ' ') start++;                                                          // Incrementing start
-    end = start + strlen(start) - 1;                                                        // Declaring end variable
-    while (end > start && *end == ' ') end--;                                               // Decrementing end while greater than start variable
-    *(end + 1) = '\0';                                                                      // Tabbing pointer
-    strcpy(operand1, start);                                                                // Copying operand to start variable
-    start = operand2;                                                                       // Trim operand2 (may cause errors but hasn't from how i've tested)
-    while (*start == ' ') start++;                                                          // Incrementing start
-    end = start + strlen(start) - 1;                                                        // Declaring end variable
-    while (end > start && *end == ' ') end--;                                               // Decrementing end while greater than start variable
-    *(end + 1) = '\0';                                                                      // Tab pointer
-    strcpy(operand2, start);                                                                // Copying operand to start variable
-    char *true_start = question_mark + 1;                                                   // Extract true destination
-    while (*true_start == ' ') true_start++;                                                // Incrementing true start
-    char *true_end = colon;                                                                 // Declaring true end variable pointer
-    while (true_end > true_start && *(true_end - 1) == ' ') true_end--;                     // Decrementing true end variable
-    if (true_end > true_start) {                                                            // While end is greater than start
-        strncpy(destt, true_start, true_end - true_start);                                  // Copy destination from subtracted end to start
-        destt[true_end - true_start] = '\0';                                                // Tab destination
-    }
-    char *false_start = colon + 1;                                                          // Extract true destination
-    while (*false_start == ' ') false_start++;                                              // Incrementing false start
-    if (strlen(false_start) > 0) {                                                          // While false start is greater than 0
-        strcpy(destf, false_start);                                                         // Copying destination from false start
-    }
-                                                                                            // Debug prints
-    snprintf(user_prompt, USER_PROMPT_SIZE, "Debug: parsed: operand1='%s', condition='%s', operand2='%s'\r\n",
-             operand1, condition, operand2);
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Writing from uart
-    snprintf(user_prompt, USER_PROMPT_SIZE, "Debug: destinations: true='%s', false='%s'\r\n",
-             destt, destf);
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Writing from uart
-    bool result = evaluate_condition(uart, operand1, condition, operand2);                  // Evaluate condition
-    if (result) {                                                                           // For detected result
-        execute_conditional_dest(uart, destt, true);                                        // Execute appropriate destination
-    } else {                                                                                // For undetected result
-        execute_conditional_dest(uart, destf, false);                                       // No result execution
+    int sequence = uart_frame_send(payload, size);                                          // Sending batch
+    if (sequence < 0) {                                                                     // For previous frame still unacknowledged
+        increment_error(ERR_UART);                                                          // Incrementing uart error
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: UART7 frame not sent (link busy)\r\n");
+    } else {
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nFrame %d sent through UART7: %d command(s), %u bytes\r\n",
+                 sequence, count, (unsigned)size);
     }
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from uart
 }
     // -uart
-void uart_cmd(UART_Handle uart, char *args) {
+void uart_cmd(ShellSession *session, char *args) {
     char *command = args;                                                                   // Declaring command pointer as parsed arguments in uart7
     while (*command == ' ') command++;                                                      // Skipping leading spaces
+    if (strncmp(command, "frame", 5) == 0 && (command[5] == ' ' || command[5] == '\0')) {   // Framed batch path
+        uart_frame_cmd(session, command + 5);
+        return;                                                                             // Return from loop
+    }
     if (*command != '\0') {                                                                 // Success path
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nPayload sent through UART7: %s\r\n", command);
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing from uart
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nPayload sent through UART7: %s\r\n", command);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
         strcat(command, "\n");                                                              // Adding newline and send command
-        UART_write(uart7, command, strlen(command));                                        // Writing command from uart7
+        uart_output(uart7, command, strlen(command));                                       // Writing command from uart7
         return;                                                                             // Return from loop
-    } else {                                                                                // Error path
-        increment_error(ERR_UART);                                                          // Incrementing uart error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Must attach a payload to -uart\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing from uart
+    }
+    int i, length;                                                                          // Declaring loop and length variables
+    length = snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n----------UART RECEIVE----------\r\n");
+    for (i = 0; i < UART_RX_COUNT && length < USER_PROMPT_SIZE; i++) {                      // For each receiver
+        const UartRx *rx = &uart_receivers[i];                                              // Declaring receiver
+        if (rx->uart == NULL) {                                                             // For unused receiver
+            continue;
+        }
+        length += snprintf(session->prompt + length, USER_PROMPT_SIZE - length,             // Appending receiver statistics
+                "%s: %lu bytes, %lu lines, %lu frames, overruns %lu, dropped %lu, ring high-water %lu/%d\r\n",
+                rx->name, rx->bytes, rx->lines, rx->frames, rx->overruns, rx->dropped_lines,
+                rx->high_water, UART_RX_RING_SIZE);
+    }
+    const UartLink *link = &uart_link;                                                      // Declaring UART7 framed link
+    snprintf(session->prompt + length, USER_PROMPT_SIZE - length,                           // Appending framed link statistics
+             "Frames: %lu sent (%lu retransmits, %lu failed), %lu received, %lu commands run\r\n"
+             "        %lu acks, %lu nacks, %lu CRC errors, %lu duplicates\r\n",
+             link->frames_sent, link->retransmits, link->failures, link->frames_received, link->commands,
+             link->acks, link->nacks, link->crc_errors, link->duplicates);
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from uart
+}
+    // -output
+void output_cmd(ShellSession *session, char *args) {
+    int i, length;                                                                          // Declaring loop and length variables
+    length = snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n----------UART OUTPUT----------\r\n");
+    for (i = 0; i < UART_WRITER_COUNT && length < USER_PROMPT_SIZE; i++) {                  // For each writer
+        const UartWriter *writer = &uart_writers[i];                                        // Declaring writer
+        if (writer->uart == NULL) {                                                         // For unused writer
+            continue;
+        }
+        length += snprintf(session->prompt + length, USER_PROMPT_SIZE - length,             // Appending writer statistics
+                "%s: %lu records, %lu bytes, dropped %lu records (%lu bytes), waits %lu\r\n"
+                "       ring high-water %lu/%d, latency max %lu ms, mean %lu ms\r\n",
+                writer->name, writer->records, writer->bytes, writer->dropped_records,
+                writer->dropped_bytes, writer->waits, writer->high_water, UART_OUT_RING_SIZE,
+                writer->latency_max, writer->records ? writer->latency_total / writer->records : 0);
+    }
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from uart
+}
+    // DAC output start, or source switch when already running (NULL source plays PCM; prints its own error)
+static bool dac_stream_start(ShellSession *session, uint16_t (*source)(void)) {
+    dac_source = (source != NULL) ? source : sine_sample;                                   // Declaring sample source (next half filled uses it)
+    pcm_mode = (source == NULL);                                                            // Declaring jitter buffer playback
+    if (sine_active) return true;                                                           // Returning for running output
+    if (dacTaskHandle == NULL) {                                                            // If DAC task never started
+        increment_error(ERR_SINE);                                                          // Incrementing sine error
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: DAC stream not initialized\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from UART
+        return false;                                                                       // Returning failure
+    }
+    if (timer0Handle == NULL && !sine_open_timer()) {                                       // If timer is NULL
+        increment_error(ERR_SINE);                                                          // Incrementing sine error
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Failed to initialize timer\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from UART
+        return false;                                                                       // Returning failure
+    }
+    GPIO_write(GPIO_PD4, 1);                                                                // Enable audio amp first
+    Task_sleep(1);                                                                          // Brief delay for amp to stabilize
+    dac_write(0x2000);                                                                      // Starting with mid-scale DAC value
+    Task_sleep(1);                                                                          // Another brief delay
+    sine_start_stream();                                                                    // Filling buffer and starting the sine timer
+    return true;                                                                            // Returning success
+}
+    // DAC output stop (mid-scale, amp off)
+static void dac_stream_stop(void) {
+    sine_active = false;                                                                    // Declaring active sine flag as false
+    pcm_mode = false;                                                                       // Declaring no PCM playback
+    if (timer0Handle != NULL) {                                                             // If timer handler is not empty
+        Timer_stop(timer0Handle);                                                           // Stopping timer handler
+    }
+    dac_write(0x2000);                                                                      // Setting DAC to mid-scale value
+    Task_sleep(1);                                                                          // Brief delay before disabling amp
+    GPIO_write(GPIO_PD4, 0);                                                                // Disable audio amp
+}
+    // -sine rate (sample timer frequency; a running wave is restarted at the new rate)
+static void sine_rate_cmd(ShellSession *session, char *args) {
+    uint32_t rate;                                                                          // Declaring requested sample rate
+    if (sscanf(args, "%u", &rate) != 1 || rate < SINE_RATE_MIN || rate > SINE_RATE_MAX) {   // For missing or out of range rate
+        increment_error(ERR_SINE);                                                          // Incrementing sine error
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Sample rate must be %d to %d Hz\r\n",
+                 SINE_RATE_MIN, SINE_RATE_MAX);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
         return;                                                                             // Return from loop
     }
+    uint32_t highest = sine_millihertz;                                                     // Declaring highest sine or voice frequency
+    int v;                                                                                  // Declaring loop variable
+    for (v = 0; v < tone_count; v++) {
+        if (tone_voices[v].millihertz > highest) highest = tone_voices[v].millihertz;
+    }
+    if (highest > rate * (SINE_MILLIHERTZ / 2)) {                                           // If the running frequency would exceed Nyquist
+        increment_error(ERR_SINE);                                                          // Incrementing sine error
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Sample rate %u Hz is below twice the current frequency\r\n", rate);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
+        return;                                                                             // Return from loop
+    }
+    bool was_active = sine_active;                                                          // Declaring running wave
+    sine_active = false;                                                                    // Pausing the stream
+    if (timer0Handle != NULL) {                                                             // For sine timer opened at the old rate
+        Timer_close(timer0Handle);                                                          // Closing timer (reopened at the new rate)
+        timer0Handle = NULL;
+    }
+    sample_rate = rate;                                                                     // Declaring sample rate
+    set_sine_frequency(sine_millihertz);                                                    // Recomputing phase step
+    tone_retune();                                                                          // Recomputing voice steps
+    if (was_active) {                                                                       // For running wave
+        if (!sine_open_timer()) {                                                           // If timer is NULL
+            increment_error(ERR_SINE);                                                      // Incrementing sine error
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Failed to initialize timer\r\n");
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing from UART
+            return;                                                                         // Return from loop
+        }
+        sine_start_stream();                                                                // Restarting stream
+    }
+    snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nSample rate: %u Hz (Nyquist limit %u Hz)\r\n", rate, rate / 2);
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from UART
+}
+    // -sine wave/amp/offset (waveform shape)
+static void sine_shape_cmd(ShellSession *session, const char *option, char *args) {
+    int wave = wave_selected;                                                               // Declaring waveform
+    uint32_t amplitude = wave_amplitude;                                                    // Declaring amplitude
+    int32_t offset = wave_offset;                                                           // Declaring offset
+    char name[10] = "";                                                                     // Declaring waveform name
+    bool valid = false;                                                                     // Declaring parse status
+    if (strcmp(option, "wave") == 0 && sscanf(args, "%9s", name) == 1) {                    // For waveform name
+        for (wave = 0; wave < WAVE_COUNT && strcmp(name, wave_names[wave]) != 0; wave++);
+        valid = wave < WAVE_COUNT;
+    } else if (strcmp(option, "amp") == 0) {                                                // For amplitude
+        valid = sscanf(args, "%u", &amplitude) == 1 && amplitude <= 100;
+    } else if (strcmp(option, "offset") == 0) {                                             // For offset
+        valid = sscanf(args, "%d", &offset) == 1 && offset >= -100 && offset <= 100;
+    }
+    if (!valid) {                                                                           // For unknown waveform or out of range value
+        increment_error(ERR_SINE);                                                          // Incrementing sine error
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid %s (wave sine|triangle|saw|square|arb, amp 0-100, offset -100-100)\r\n", option);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
+        return;                                                                             // Return from loop
+    }
+    set_sine_wave(wave, amplitude, offset);                                                 // Publishing shape
+    snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nWaveform: %s, amplitude %u%%, offset %d%%\r\n",
+             wave_names[wave], amplitude, offset);
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from UART
+}
+    // Arbitrary table to load (never the one playing or about to play)
+static int16_t *wave_upload_table(void) {
+    int16_t *last = wave_arbitrary[wave_loaded];                                            // Declaring most recently loaded table
+    int16_t *other = wave_arbitrary[wave_loaded ^ 1];                                       // Declaring other table
+    UInt key = Hwi_disable();                                                               // Holding off a switch mid-check
+    bool last_busy = last == wave_shape.table || (wave_switch && last == wave_next.table);
+    bool other_busy = other == wave_shape.table || (wave_switch && other == wave_next.table);
+    Hwi_restore(key);
+    if (!last_busy) return last;                                                            // Editing in place
+    if (other_busy) return NULL;                                                            // Both in use until the pending switch
+    memcpy(other, last, sizeof(wave_arbitrary[0]));                                         // Carrying earlier entries over
+    wave_loaded ^= 1;                                                                       // Declaring other table as loaded
+    return other;                                                                           // Returning table
+}
+    // -sine load (arbitrary table entries; -sine wave arb plays them)
+static void sine_load_cmd(ShellSession *session, char *args) {
+    char *cursor = args, *end;                                                              // Declaring parse position
+    int16_t values[WAVE_TABLE_SIZE];                                                        // Declaring parsed entries
+    uint32_t start, count = 0;                                                              // Declaring first entry and entry count
+    long value;                                                                             // Declaring parsed entry
+    start = (uint32_t)strtoul(cursor, &end, 0);                                             // Scanning first entry index
+    bool valid = end != cursor && start < WAVE_TABLE_SIZE;                                  // Declaring parse status
+    for (cursor = end; valid; cursor = end) {                                               // For each entry
+        value = strtol(cursor, &end, 0);
+        if (end == cursor) break;                                                           // End of entries
+        if (value < -32767 || value > 32767 || start + count >= WAVE_TABLE_SIZE) valid = false;
+        else values[count++] = (int16_t)value;
+    }
+    if (!valid || count == 0 || cursor[strspn(cursor, " ")] != '\0') {                      // For bad index, entry or trailing text
+        increment_error(ERR_SINE);                                                          // Incrementing sine error
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Usage -sine load START V1 V2 ... (START+count <= %d, V -32767 to 32767)\r\n", WAVE_TABLE_SIZE);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
+        return;                                                                             // Return from loop
+    }
+    int16_t *table = wave_upload_table();                                                   // Declaring table to load
+    if (table == NULL) {                                                                    // For switch still pending
+        increment_error(ERR_SINE);                                                          // Incrementing sine error
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Waveform switch pending, retry\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
+        return;                                                                             // Return from loop
+    }
+    memcpy(&table[start], values, count * sizeof(values[0]));                               // Loading entries
+    table[WAVE_TABLE_SIZE] = table[0];                                                      // Closing the cycle for interpolation
+    snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nLoaded arb entries %u-%u (-sine wave arb to play)\r\n",
+             start, start + count - 1);
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from UART
 }
     // -sine
-void sine_cmd(UART_Handle uart, char *args) {
-    if (args == NULL || *args == '\0') {                                                    // Nothing detected after -sine
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nUsage: -sine FREQ\r\n"                 // Printing -sine usage prompts
-                "FREQ: Frequency in Hz (0 to stop)\r\n"
-                "Maximum frequency: %d Hz (Nyquist limit)\r\n", sample_rate/2);
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing from uart
+void sine_cmd(ShellSession *session, char *args) {
+    if (args == NULL || args[strspn(args, " ")] == '\0') {                                  // Nothing detected after -sine
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nUsage: -sine FREQ [nearest|linear] | -sine rate HZ\r\n"
+                "       -sine wave NAME | amp PCT | offset PCT | load START V1 V2 ...\r\n"
+                "FREQ: Frequency in Hz, up to 3 decimals (0 to stop)\r\n"
+                "Maximum frequency: %d Hz (Nyquist limit)\r\n"
+                "Waveform: %s, amplitude %u%%, offset %d%%, table %d x %d bits, switches: %lu\r\n"
+                "Sample rate: %u Hz, buffer 2 x %d samples\r\n"
+                "Underruns: %lu samples, late transfers: %lu, halves filled: %lu, sent: %lu\r\n",
+                sample_rate/2, wave_names[wave_selected], wave_amplitude, wave_offset, WAVE_TABLE_SIZE,
+                WAVE_SAMPLE_BITS, wave_switches, sample_rate, DAC_HALF_SIZE, dac_underruns, dac_late, dac_fills, dac_transfers);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
+        return;                                                                             // Return from loop
+    }
+    args += strspn(args, " ");                                                              // Skipping leading spaces
+    if (strncmp(args, "rate", 4) == 0 && (args[4] == ' ' || args[4] == '\0')) {             // For sample rate
+        sine_rate_cmd(session, args + 4);
+        return;                                                                             // Return from loop
+    }
+    if (strncmp(args, "load", 4) == 0 && (args[4] == ' ' || args[4] == '\0')) {             // For arbitrary table entries
+        sine_load_cmd(session, args + 4);
         return;                                                                             // Return from loop
     }
-    uint32_t freq;                                                                          // Declaring 32bit frequency variable
-    if (sscanf(args, "%u", &freq) != 1) {                                                   // For error detected in frequency scan
+    static const char *const shape_options[] = { "wave", "amp", "offset" };                 // Declaring shape options
+    int option;                                                                             // Declaring option index
+    for (option = 0; option < 3; option++) {                                                // For each shape option
+        size_t length = strlen(shape_options[option]);
+        if (strncmp(args, shape_options[option], length) == 0 && (args[length] == ' ' || args[length] == '\0')) {
+            sine_shape_cmd(session, shape_options[option], args + length);
+            return;                                                                         // Return from loop
+        }
+    }
+    uint32_t freq, millihertz;                                                              // Declaring whole and millihertz frequency
+    char fraction[4] = "000";                                                               // Declaring frequency decimals (zero padded)
+    char mode[8] = "";                                                                      // Declaring lookup mode
+    int parsed = sscanf(args, "%u.%3[0-9] %7s", &freq, fraction, mode);                     // Scanning frequency with decimals
+    if (parsed == 1) {                                                                      // For whole frequency
+        sscanf(args, "%*u %7s", mode);                                                      // Scanning lookup mode
+    }
+    while (strlen(fraction) < 3) strcat(fraction, "0");                                     // Padding decimals to millihertz
+    if (parsed < 1 || freq > UINT32_MAX / SINE_MILLIHERTZ ||                                // For error detected in frequency scan
+        (mode[0] != '\0' && strcmp(mode, "nearest") != 0 && strcmp(mode, "linear") != 0)) {
         increment_error(ERR_SINE);                                                          // Incrementing sine error
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid frequency format\r\n");
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing from uart
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Invalid frequency format\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
         return;                                                                             // Return from loop
     }
-    if (freq == 0) {                                                                        // For inactive/halted frequency
-        sine_active = false;                                                                // Declaring active sine flag as false
-        if (timer0Handle != NULL) {                                                         // If timer handler is not empty
-            Timer_stop(timer0Handle);                                                       // Stopping timer handler
-        }
-        uint16_t dac_word = 0x2000;                                                         // Setting DAC to mid-scale value
-        SPI_Transaction transaction;                                                        // Declaring SPI transaction
-        transaction.count = 1;                                                              // Declaring transaction count
-        transaction.txBuf = &dac_word;                                                      // Declaring transaction TX pin
-        transaction.rxBuf = NULL;                                                           // Declaring transaction RX pin
-        SPI_transfer(spiHandle, &transaction);                                              // Declaring SPI transfer for handler to transaction
-        Task_sleep(1);                                                                      // Brief delay before disabling amp
-        GPIO_write(GPIO_PD4, 0);                                                            // Disable audio amp
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\nSine wave has stopped generating...\r\n");
+    millihertz = freq * SINE_MILLIHERTZ + (uint32_t)atoi(fraction);                         // Declaring frequency in millihertz
+    if (mode[0] != '\0') {                                                                  // For lookup mode given
+        set_sine_interpolation(strcmp(mode, "linear") == 0);                                // Declaring interpolation
+    }
+    if (millihertz == 0) {                                                                  // For inactive/halted frequency
+        sine_millihertz = 0;
+        dac_stream_stop();                                                                  // Stopping output
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nSine wave has stopped generating...\r\n");
     } else {                                                                                // For invalid frequency too large
-        if (freq > sample_rate/2) {                                                         // If frequency exceeds Nyquist limit
+        if (millihertz > sample_rate * (SINE_MILLIHERTZ / 2)) {                             // If frequency exceeds Nyquist limit
             increment_error(ERR_SINE);                                                      // Incrementing sine error
-            snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Frequency %u Hz exceeds Nyquist limit (%u Hz)\r\n", freq, sample_rate/2);
-            UART_write(uart, user_prompt, strlen(user_prompt));                             // Writing from uart
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Frequency %u.%s Hz exceeds Nyquist limit (%u Hz)\r\n", freq, fraction, sample_rate/2);
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing from uart
             return;                                                                         // Return from loop
         }
-        set_sine_frequency(freq);                                                           // Declaring frequency to sine set function
-        if (!sine_active) {                                                                 // If sine is inactive
-            if (timer0Handle == NULL) {                                                     // If timer handler is NULL
-                Timer_Params params;                                                        // Declaring timer parameters
-                Timer_Params_init(&params);                                                 // Initializing timer paramters
-                params.period = 125;                                              // Declaring 8000 period
-                params.periodUnits = Timer_PERIOD_US;                                       // Declaring period
-                params.timerMode = Timer_CONTINUOUS_CALLBACK;                               // Declaring timer mode as forever callback
-                params.timerCallback = sine_timer_callback;                                 // Declaring timer callback to callback function
-                timer0Handle = Timer_open(CONFIG_TIMER_0, &params);                         // Declaring timer handler as opener to parameters
-                if (timer0Handle == NULL) {                                                 // If timer is NULL
-                    increment_error(ERR_SINE);                                              // Incrementing sine error
-                    snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Failed to initialize timer\r\n");
-                    UART_write(uart, user_prompt, strlen(user_prompt));                     // Writing from UART
-                    return;                                                                 // Return from loop
-                }
-            }
-            GPIO_write(GPIO_PD4, 1);                                                        // Enable audio amp first
-            Task_sleep(1);                                                                  // Brief delay for amp to stabilize
-            uint16_t dac_word = 0x2000;                                                     // Starting with mid-scale DAC value
-            SPI_Transaction transaction;                                                    // Declaring SPI transaction
-            transaction.count = 1;                                                          // Declaring transaction count
-            transaction.txBuf = &dac_word;                                                  // Declaring transaction TX buffer to DAC
-            transaction.rxBuf = NULL;                                                       // Declaring transaction RX buffer as NULL
-            SPI_transfer(spiHandle, &transaction);                                          // Declaring SPI transfer to transaction
-            Task_sleep(1);                                                                  // Another brief delay
-            sine_active = true;                                                             // Declaring sine as active
-            Timer_start(timer0Handle);                                                      // Starting timer handler for sine wave
-        }
-        snprintf(user_prompt, USER_PROMPT_SIZE, "\r\n\033[35mGenerating %u Hz sine wave! :) \033[0m\r\n", freq);
-    }
-    UART_write(uart, user_prompt, strlen(user_prompt));                                     // Writing from UART
+        set_sine_frequency(millihertz);                                                     // Declaring frequency to sine set function
+        sine_millihertz = millihertz;
+        if (!dac_stream_start(session, sine_sample)) return;                                // Starting output (error already printed)
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[35mGenerating %u.%s Hz %s wave (%s)! :) \033[0m\r\n",
+                 freq, fraction, wave_names[wave_selected], sine_interpolate ? "linear" : "nearest");
+    }
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from UART
 }
-
-/* Parsing command(s) */
-    // Valid commands
-void valid_cmd(UART_Handle uart, char *command) {                                           // Declaring function to validate/execute commands
-        // -about
-    if (strcmp(command, "-about") == 0) {                                                   // Check for -about command
-        about_cmd(uart);                                                                    // Executing -about
-    }
-        // -help
-    else if (strncmp(command, "-help", 5) == 0) {                                           // Check for -help command
-        char *subcmd = NULL;                                                                // Declaring subcommand pointer variable
-        if (strcmp(command, "-help") != 0) {                                                // Checking if help command consists of subcmd
-            subcmd = command + 6;                                                           // Declaring subcommand limit
-        }
-        help_cmd(uart, subcmd);                                                             // Declaring -help function w/ subcommand
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing user prompt from -help into UART
-    }
-        // -clear
-    else if (strcmp(command, "-clear") == 0) {                                              // Check for -clear command
-        char clearScreen[10];                                                               // Buffer declared for ANSI esc sequence for clearing
-        snprintf(clearScreen, sizeof(clearScreen), "\033[2J\033[H");                        // Formatting screen clear then storing in buffer
-        UART_write(uart, clearScreen, strlen(clearScreen));                                 // Send -clear command to UART
-        const char *promptMsg = "        \033[35m.....Terminal Cleared.....\033[0m\r\n";    // User prompt for successful terminal clearing
-        UART_write(uart, promptMsg, strlen(promptMsg));                                     // Displaying cleared message to terminal
-    }
-        // -print
-    else if (strncmp(command, "-print", 6) == 0) {                                          // Declaring print command to terminal
-        char *substring = NULL;                                                             // Declaring substring to print command
-        if (strcmp(command, "-print") != 0) {                                               // Extracting everything after print command
-            substring = command + 7;                                                        // Declaring substring limit to -print command
-        }
-        print_cmd(uart, substring);                                                         // Declaring -print to UART substring set
-        UART_write(uart, user_prompt, strlen(user_prompt));                                 // Writing UART into user prompt variable
-    }
-        // -memr
-    else if (strncmp(command, "-memr", 5) == 0) {                                           // Handling -memr command
-            char *address_str = command + 5;                                                // Extracting address string w/ moving pointer
-            while (*address_str == ' ') address_str++;                                      // Skipping any additional spaces
-            if (*address_str == '\0') {                                                     // Checking for address
-                const char *error_msg = "\r\n\033[33mWarning\033[0m: Missing address for -memr command.\r\n";
-                UART_write(uart, error_msg, strlen(error_msg));                             // Writing error prompt to UART
-            } else {
-                memr_cmd(uart, address_str);                                                // Address string found and process
-                UART_write(uart, user_prompt, strlen(user_prompt));                         // Writing user_prompt to UART
-            }
+    // Frequency with up to 3 decimals, in millihertz (advances the cursor)
+static bool parse_millihertz(char **cursor, uint32_t *millihertz) {
+    char *end;                                                                              // Declaring parse end
+    uint32_t scale = 100, fraction = 0;                                                     // Declaring decimal place and millihertz part
+    unsigned long whole = strtoul(*cursor, &end, 10);                                       // Scanning whole hertz
+    if (end == *cursor || !isdigit((unsigned char)**cursor) || whole > UINT32_MAX / SINE_MILLIHERTZ) return false;
+    if (*end == '.') {                                                                      // For decimals
+        for (end++; isdigit((unsigned char)*end); end++) {
+            fraction += (*end - '0') * scale;                                               // Keeping the first 3 decimals
+            scale /= 10;
         }
-        // -error
-    else if (strcmp(command, "-error") == 0) {                                              // Handling -error command
-        error_cmd(uart);                                                                    // Processing to UART
     }
-        // -gpio
-    else if (strncmp(command, "-gpio", 5) == 0) {                                           // Handling -gpio command
-        gpio_cmd(uart, command + 5);                                                        // Processing to UART
+    *millihertz = (uint32_t)whole * SINE_MILLIHERTZ + fraction;                             // Declaring frequency in millihertz
+    *cursor = end;
+    return true;                                                                            // Returning success
+}
+    // -tone (mixer voices)
+void tone_cmd(ShellSession *session, char *args) {
+    static const char dtmf_keys[] = "123A456B789C*0#D";                                     // Declaring DTMF keypad (row by row)
+    static const uint16_t dtmf_rows[4] = { 697, 770, 852, 941 };                            // Declaring DTMF row tones (Hz)
+    static const uint16_t dtmf_columns[4] = { 1209, 1336, 1477, 1633 };                     // Declaring DTMF column tones (Hz)
+    uint32_t millihertz[TONE_VOICES], gain[TONE_VOICES];                                    // Declaring voice frequencies and gains
+    uint32_t given = 0;                                                                     // Declaring gain given explicitly
+    int count = 0, unset = 0, v;                                                            // Declaring voice count, default gain count and loop variable
+    bool valid = true;                                                                      // Declaring parse status
+    char *cursor = args + strspn(args, " ");                                                // Declaring parse position
+    if (*cursor == '\0') {                                                                  // Nothing detected after -tone
+        int length = snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nUsage: -tone F1[:PCT] F2[:PCT] ... | -tone dtmf KEY | -tone off\r\n"
+                              "Voices: %d of %d%s\r\n", tone_count, TONE_VOICES, (sine_active && dac_source == tone_sample) ? " (playing)" : "");
+        for (v = 0; v < tone_count && length < USER_PROMPT_SIZE; v++) {                     // Listing voices
+            length += snprintf(session->prompt + length, USER_PROMPT_SIZE - length, "  %d: %lu.%03lu Hz, gain %d%%\r\n", v + 1,
+                               tone_voices[v].millihertz / SINE_MILLIHERTZ, tone_voices[v].millihertz % SINE_MILLIHERTZ,
+                               (tone_voices[v].gain * 100 + INT16_MAX / 2) / INT16_MAX);
+        }
+        uint32_t cycles = (uint32_t)tone_count * TONE_VOICE_CYCLES;                         // Declaring estimated mixer cost per sample
+        uint32_t load = (uint32_t)((uint64_t)cycles * sample_rate * 1000 / CPU_FREQUENCY);  // Declaring estimated DAC task share (0.1%)
+        if (length < USER_PROMPT_SIZE) {
+            length += snprintf(session->prompt + length, USER_PROMPT_SIZE - length, "Estimate: %d cycles per voice, %lu cycles/sample, %lu.%lu%% CPU at %u Hz (%s, not measured)\r\n",
+                               TONE_VOICE_CYCLES, cycles, load / 10, load % 10, sample_rate, TONE_DSP ? "SMLAD/SSAT" : "portable C");
+        }
+#if PERF_ENABLE
+        UInt key = Hwi_disable();                                                           // Disabling interrupts
+        uint32_t fills = perf_sites[PERF_SITE_MIX].count;                                   // Declaring halves timed since the voices changed
+        uint64_t ticks = perf_sites[PERF_SITE_MIX].total;                                   // Declaring their ticks (ISR preemption included)
+        Hwi_restore(key);                                                                   // Restoring interrupts
+        if (fills > 0 && length < USER_PROMPT_SIZE) {                                       // For mixer halves timed
+            uint32_t tenths = (uint32_t)(ticks * 10 / ((uint64_t)fills * DAC_HALF_SIZE));   // Declaring ticks per sample (0.1)
+            load = (uint32_t)((uint64_t)tenths * sample_rate * 100 / ((uint64_t)PERF_TICKS_PER_US * 1000000)); // Declaring measured share (0.1%)
+            snprintf(session->prompt + length, USER_PROMPT_SIZE - length, "Measured: %lu.%lu %s/sample over %lu fills, %lu.%lu%% CPU\r\n",
+                     tenths / 10, tenths % 10, PERF_DWT ? "cycles" : "ns", fills, load / 10, load % 10);
+        }
+#endif
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
+        return;                                                                             // Return from loop
     }
-        // -timer
-    else if (strncmp(command, "-timer", 6) == 0) {                                          // Handling -timer command
-        timer_cmd(uart, command + 6);                                                       // Processing to UART
+    if (strcmp(cursor, "off") == 0 || strcmp(cursor, "0") == 0) {                           // For stop
+        set_tone_voices(NULL, NULL, 0);                                                     // Silencing voices
+        if (dac_source == tone_sample) dac_stream_stop();                                   // Stopping output the mixer owns
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nTones have stopped generating...\r\n");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from UART
+        return;                                                                             // Return from loop
     }
-        // -callback
-    else if (strncmp(command, "-callback", 9) == 0) {                                       // Handling -timer command
-        char *args = command + 9;                                                           // Declaring args pointer for processing
-        callback_cmd(uart, args);                                                           // Processing to UART
+    if (strncmp(cursor, "dtmf ", 5) == 0) {                                                 // For DTMF key
+        cursor += 5 + strspn(cursor + 5, " ");
+        const char *key = (*cursor != '\0') ? strchr(dtmf_keys, toupper((unsigned char)*cursor)) : NULL;
+        valid = key != NULL && cursor[1 + strspn(cursor + 1, " ")] == '\0';
+        if (valid) {                                                                        // Row and column pair at half gain each
+            int position = (int)(key - dtmf_keys);                                          // Declaring keypad position
+            millihertz[0] = dtmf_rows[position / 4] * SINE_MILLIHERTZ;
+            millihertz[1] = dtmf_columns[position % 4] * SINE_MILLIHERTZ;
+            gain[0] = gain[1] = UINT32_MAX;                                                 // Default gains
+            count = 2;
+        }
+    } else {                                                                                // For voice list
+        while (valid && *cursor != '\0') {                                                  // For each voice
+            if (count == TONE_VOICES || !parse_millihertz(&cursor, &millihertz[count])) valid = false;
+            else if (*cursor == ':') {                                                      // For voice gain
+                char *end;                                                                  // Declaring parse end
+                gain[count] = (uint32_t)strtoul(cursor + 1, &end, 10);
+                valid = end != cursor + 1 && gain[count] <= 100;
+                cursor = end;
+            } else gain[count] = UINT32_MAX;                                                // Default gain
+            if (valid && *cursor != ' ' && *cursor != '\0') valid = false;                  // For trailing characters
+            cursor += strspn(cursor, " ");
+            count++;
+        }
     }
-        // -reset
-    else if (strncmp(command, "-reset", 6) == 0) {                                          // Handling -reset command
-        reset_cmd(uart, command + 6);                                                       // Processing to UART
+    for (v = 0; v < count; v++) {                                                           // Totalling explicit gains
+        if (gain[v] == UINT32_MAX) unset++;
+        else given += gain[v];
     }
-        // -ticker
-    else if (strncmp(command, "-ticker", 7) == 0) {                                         // Handling -ticker command
-        ticker_cmd(uart, command + 7);                                                      // Processing to UART
+    for (v = 0; valid && v < count; v++) {                                                  // Default gains share what is left of full scale
+        if (gain[v] == UINT32_MAX) gain[v] = (given < 100) ? (100 - given) / unset : 0;
+        if (millihertz[v] == 0 || millihertz[v] > sample_rate * (SINE_MILLIHERTZ / 2)) valid = false;
     }
-        // -reg
-    else if (strncmp(command, "-reg", 4) == 0) {                                            // Handling -ticker command
-        reg_cmd(uart, command + 4);                                                         // Processing to UART
+    if (!valid || count == 0 || !set_tone_voices(millihertz, gain, count)) {                // For bad voice list
+        increment_error(ERR_SINE);                                                          // Incrementing sine error
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Expected 1-%d voices F[:PCT] (0 < F <= %u Hz, PCT 0-100) or dtmf 0-9*#A-D\r\n",
+                 TONE_VOICES, sample_rate / 2);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
+        return;                                                                             // Return from loop
     }
-        // -script
-    else if (strncmp(command, "-script", 7) == 0) {                                         // Handling -script command
-        script_cmd(uart, command + 7);                                                      // Processing to UART
+    if (!dac_stream_start(session, tone_sample)) return;                                    // Starting output (error already printed)
+    snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[35mMixing %d tone%s! :) \033[0m\r\n", count, count == 1 ? "" : "s");
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from UART
+}
+    // -pcm (jitter-buffered playback of UART7 PCM frames)
+void pcm_cmd(ShellSession *session, char *args) {
+    PcmBuffer *pcm = &pcm_buffer;                                                           // Declaring jitter buffer
+    char *cursor = args + strspn(args, " ");                                                // Declaring parse position
+    char *end;                                                                              // Declaring parse end
+    uint32_t depth = pcm->depth;                                                            // Declaring target depth
+    bool start = strncmp(cursor, "start", 5) == 0 && (cursor[5] == ' ' || cursor[5] == '\0');
+    bool set = strncmp(cursor, "depth", 5) == 0 && cursor[5] == ' ';                        // Declaring depth change
+    if (*cursor == '\0') {                                                                  // Nothing detected after -pcm
+        uint32_t level = pcm->write - pcm->read;                                            // Declaring fill
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nUsage: -pcm start [DEPTH] | -pcm stop | -pcm depth DEPTH\r\n"
+                 "PCM playback: %s, depth %lu samples (%lu ms at %u Hz), level %lu, high %lu of %d\r\n"
+                 "Frames: %lu (lost %lu, late %lu, ignored %lu), samples: %lu\r\n"
+                 "Underruns: %lu, overruns: %lu, adaptive drops: %lu, repeats: %lu\r\n",
+                 !(pcm_mode && sine_active) ? "off" : pcm->priming ? "priming" : "playing",
+                 pcm->depth, pcm->depth * 1000 / sample_rate, sample_rate, level, pcm->high, PCM_RING_SIZE,
+                 pcm->frames, pcm->lost, pcm->late, pcm->ignored, pcm->samples,
+                 pcm->underruns, pcm->overruns, pcm->dropped, pcm->repeated);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
+        return;                                                                             // Return from loop
     }
-        // -rem
-    else if (strncmp(command, "-rem", 4) == 0) {                                            // Handling -rem command
-        rem_cmd(uart, command + 4);                                                         // Processing to UART
+    if (strcmp(cursor, "stop") == 0) {                                                      // For stop
+        if (pcm_mode) dac_stream_stop();                                                    // Stopping output the jitter buffer owns
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nPCM playback has stopped (%lu samples, %lu underruns)...\r\n",
+                 pcm->samples, pcm->underruns);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from UART
+        return;                                                                             // Return from loop
     }
-        // -if
-    else if (strncmp(command, "-if", 3) == 0) {                                             // Handling -if command
-        if_cmd(uart, command + 3);                                                          // Processing to UART
+    if (start || set) {                                                                     // For depth given
+        cursor += 5 + strspn(cursor + 5, " ");
+        if (*cursor != '\0') depth = (uint32_t)strtoul(cursor, &end, 10);
+        else end = cursor;
     }
-        // -uart
-    else if (strncmp(command, "-uart", 5) == 0) {                                           // Handling -uart command
-        uart_cmd(uart, command + 5);                                                        // Processing to UART
+    if ((!start && !set) || (set && end == cursor) || *end != '\0' ||                       // For unknown option or bad depth
+        depth < PCM_DEPTH_MIN || depth > PCM_RING_SIZE / 2) {
+        increment_error(ERR_SINE);                                                          // Incrementing sine error
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Usage -pcm start [DEPTH] | stop | depth DEPTH (%d to %d samples)\r\n",
+                 PCM_DEPTH_MIN, PCM_RING_SIZE / 2);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from uart
+        return;                                                                             // Return from loop
     }
-        // -sine
-    else if (strncmp(command, "-sine", 5) == 0) {                                           // Handling -sine command
-        sine_cmd(uart, command + 5);                                                        // Processing to UART
+    pcm->depth = depth;                                                                     // Declaring target depth (a running buffer adapts to it)
+    if (start) {                                                                            // For playback start
+        pcm_mode = false;                                                                   // Holding the sine timer off the buffer
+        pcm_reset();                                                                        // Emptying buffer
+        if (!dac_stream_start(session, NULL)) return;                                       // Starting output (error already printed)
+    }
+    snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nPCM %s: depth %lu samples (%lu ms at %u Hz)\r\n",
+             start ? "playback waiting for UART7 frames" : "target", depth, depth * 1000 / sample_rate, sample_rate);
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from UART
+}
+    // -perf site name (fixed sites, then "-command" per handler)
+#if PERF_ENABLE
+static const char *perf_names[PERF_SITE_COMMANDS] = { "dispatch", "sine", "ticker", "sw1", "sw2", "mix" };
+static void perf_site_name(int site, char *name, size_t size) {
+    const Command *entry = command_by_id(site - PERF_SITE_COMMANDS);                        // Declaring handler's command
+    if (site < PERF_SITE_COMMANDS) snprintf(name, size, "%s", perf_names[site]);
+    else snprintf(name, size, "-%s", entry ? entry->name : "?");
+}
+    // -perf site copy (consistent against ISRs updating it)
+static void perf_site_get(int site, PerfSite *copy) {
+    UInt key = Hwi_disable();                                                               // Disabling interrupts
+    *copy = perf_sites[site];                                                               // Copying site
+    Hwi_restore(key);                                                                       // Restoring interrupts
+}
+    // -perf site line (count, min/mean/max ticks, max in us, non-empty log2 buckets)
+static void perf_site_print(ShellSession *session, int site, const PerfSite *entry) {
+    char name[MAX_COMMAND_NAME_LENGTH + 2];                                                 // Declaring site name
+    int b, length;                                                                          // Declaring bucket and line length
+    uint32_t max_tenths = (uint32_t)((uint64_t)entry->max * 10 / PERF_TICKS_PER_US);        // Declaring longest run in 0.1 us
+    perf_site_name(site, name, sizeof(name));
+    length = snprintf(session->prompt, USER_PROMPT_SIZE, "%-10s %8lu %8lu %8lu %8lu %6lu.%lu ",
+                      name, entry->count, entry->min, (uint32_t)(entry->total / entry->count), entry->max,
+                      max_tenths / 10, max_tenths % 10);
+    for (b = 0; b < PERF_BUCKETS && length < USER_PROMPT_SIZE - 24; b++) {                  // Appending non-empty buckets
+        if (entry->histogram[b] == 0) continue;
+        length += snprintf(session->prompt + length, USER_PROMPT_SIZE - length, " %s2^%d:%lu",
+                           (b == PERF_BUCKETS - 1) ? ">=" : "<", (b == PERF_BUCKETS - 1) ? b - 1 : b, entry->histogram[b]);
+    }
+    snprintf(session->prompt + length, USER_PROMPT_SIZE - length, "\r\n");
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from UART
+}
+#endif
+    // -perf (handler, dispatch and ISR timing)
+void perf_cmd(ShellSession *session, char *args) {
+#if PERF_ENABLE
+    char *cursor = args + strspn(args, " ");                                                // Declaring parse position
+    char name[MAX_COMMAND_NAME_LENGTH + 2];                                                 // Declaring site name
+    bool reset = strcmp(cursor, "reset") == 0;                                              // Declaring print then clear
+    PerfSite entry;                                                                         // Declaring site copy
+    int site, b, shown = 0;                                                                 // Declaring site walk, bucket and printed count
+    if (*cursor != '\0' && !reset) {                                                        // For one site's histogram
+        for (site = 0; site < PERF_SITES; site++) {                                         // Finding site by name
+            perf_site_name(site, name, sizeof(name));
+            if (site - PERF_SITE_COMMANDS < (int)COMMAND_COUNT && strcmp(name, cursor) == 0) break;
+        }
+        if (site == PERF_SITES) {                                                           // For unknown site
+            increment_error(ERR_UNKNOWN_CMD);                                               // Incrementing unknown command error
+            snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Usage -perf [reset | dispatch | sine | ticker | sw1 | sw2 | mix | -COMMAND]\r\n");
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing from uart
+            return;                                                                         // Return from loop
+        }
+        perf_site_get(site, &entry);
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n%s: %lu runs, %s\r\n", name, entry.count,
+                 PERF_DWT ? "cycles" : "nanoseconds");
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing from UART
+        for (b = 0; b < PERF_BUCKETS && entry.count > 0; b++) {                             // For each bucket
+            int width = (int)((uint64_t)entry.histogram[b] * 40 / entry.count);             // Declaring bar width
+            if (entry.histogram[b] == 0) continue;
+            snprintf(session->prompt, USER_PROMPT_SIZE, "  %10lu - %-10lu %8lu %.*s\r\n",
+                     (b == 0) ? 0 : 1UL << (b - 1), (b == PERF_BUCKETS - 1) ? 0xFFFFFFFFUL : (1UL << b) - 1,
+                     entry.histogram[b], width > 0 ? width : 1, "########################################");
+            uart_output(session->uart, session->prompt, strlen(session->prompt));           // Writing from UART
+        }
+        return;                                                                             // Return from loop
+    }
+    snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nTimebase: %s (%lu per run removed)\r\n"
+             "%-10s %8s %8s %8s %8s %8s  histogram\r\n",
+             PERF_DWT ? "DWT cycles at 120 MHz" : "clock_gettime() nanoseconds", perf_overhead,
+             "site", "count", "min", "mean", "max", "max us");
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from UART
+    for (site = 0; site < PERF_SITES; site++) {                                             // For each site with runs
+        perf_site_get(site, &entry);
+        if (entry.count == 0) continue;
+        perf_site_print(session, site, &entry);
+        shown++;
+    }
+    if (reset) {                                                                            // For clear after printing
+        UInt key = Hwi_disable();                                                           // Disabling interrupts
+        memset(perf_sites, 0, sizeof(perf_sites));                                          // Clearing every site
+        Hwi_restore(key);                                                                   // Restoring interrupts
+    }
+    snprintf(session->prompt, USER_PROMPT_SIZE, "%s\r\n", shown == 0 ? "No runs timed yet." :
+             reset ? "Timing has been reset..." : "");
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from UART
+#else
+    snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nTiming is compiled out (build with PERF_ENABLE=1).\r\n");
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from UART
+#endif
+}
+    // -trace (binary event ring)
+void trace_cmd(ShellSession *session, char *args) {
+    TraceRing *trace = &trace_ring;                                                         // Declaring trace
+    char *cursor = args + strspn(args, " ");                                                // Declaring parse position
+    uint32_t head = trace->head;                                                            // Declaring events recorded
+    if (*cursor == '\0') {                                                                  // Nothing detected after -trace
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nUsage: -trace on | off | clear | dump\r\n"
+                 "Trace: %s, %lu events recorded, %lu held of %d, %lu tasks\r\n",
+                 trace->enabled ? "on" : "off", head, (head < TRACE_EVENTS) ? head : TRACE_EVENTS,
+                 TRACE_EVENTS, trace->task_count);
+    } else if (strcmp(cursor, "on") == 0 || strcmp(cursor, "off") == 0) {                   // For recording switch
+        trace->enabled = (cursor[1] == 'n');                                                // Declaring recording flag
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nTrace recording is %s...\r\n", cursor);
+    } else if (strcmp(cursor, "clear") == 0) {                                              // For empty ring
+        trace_clear();
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nTrace has been cleared...\r\n");
+    } else if (strcmp(cursor, "dump") == 0) {                                               // For binary dump
+        uart_output(session->uart, "\r\n", 2);
+        uint32_t events = trace_dump(session->uart);                                        // Streaming ring
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\nTrace dump: %lu events (decode with host/trace_json)\r\n", events);
+    } else {                                                                                // For unknown option
+        increment_error(ERR_UNKNOWN_CMD);                                                   // Incrementing unknown command error
+        snprintf(session->prompt, USER_PROMPT_SIZE, "\r\n\033[31mError\033[0m: Usage -trace on | off | clear | dump\r\n");
+    }
+    uart_output(session->uart, session->prompt, strlen(session->prompt));                   // Writing from UART
+}
+
+/* Parsing command(s) */
+    // Valid commands
+void valid_cmd(ShellSession *session, char *command) {                                      // Declaring function to validate/execute commands
+    PERF_BEGIN(start);                                                                      // Timing lookup and dispatch
+    size_t length = 0;                                                                      // Declaring command name length
+    while (command[length] != '\0' && command[length] != ' ') length++;                     // Tokenising the command name once
+    const Command *entry = (command[0] == '-') ? find_command(command + 1, length - 1) : NULL;
+    char *args = command + length;                                                          // Declaring arguments (keeps leading separator)
+    if (entry != NULL && entry->schema == CMD_ARGS_NONE && *args != '\0') {                 // For arguments on a bare command
+        entry = NULL;                                                                       // Treating as unknown command
     }
         // N/A
-    else {
+    if (entry == NULL) {
         increment_error(ERR_UNKNOWN_CMD);                                                   // Increment error prompt
         char unknown_str[128];                                                              // Declaring buffer for unknown user input
         snprintf(unknown_str, sizeof(unknown_str), "\r\n\033[31mError\033[0m: Unknown command %s.\r\n", command);
-        UART_write(uart, unknown_str, strlen(unknown_str));                                 // Sending unknown response to UART
+        uart_output(session->uart, unknown_str, strlen(unknown_str));                       // Sending unknown response to UART
+    } else {
+        dispatch_command(session, entry, args);                                             // Dispatching to command handler
     }
+    PERF_END(PERF_SITE_DISPATCH, start);                                                    // Closing on both paths (misses probe the most)
+}
+    // Command dispatch (text and framed commands)
+void dispatch_command(ShellSession *session, const Command *entry, char *args) {
+        // Missing arguments
+    if (entry->schema == CMD_ARGS_REQUIRED && args[strspn(args, " ")] == '\0') {            // For required arguments absent
+        char warning_str[96];                                                               // Declaring buffer for warning
+        snprintf(warning_str, sizeof(warning_str), "\r\n\033[33mWarning\033[0m: Missing arguments for -%s command.\r\n", entry->name);
+        uart_output(session->uart, warning_str, strlen(warning_str));                       // Writing warning prompt to UART
+        return;                                                                             // Return from function
+    }
+    PERF_BEGIN(start);                                                                      // Timing handler
+    trace_event(TRACE_DISPATCH_BEGIN, (uint16_t)command_id(entry), (uint32_t)(session - shell_sessions));
+    entry->handler(session, args);                                                          // Dispatching to command handler
+    trace_event(TRACE_DISPATCH_END, (uint16_t)command_id(entry), (uint32_t)(session - shell_sessions));
+    PERF_END(PERF_SITE_COMMANDS + command_id(entry), start);
 }
@@ -14,6 +14,7 @@
 #include <ti/drivers/Timer.h>                                                               // For Timer_Handle
 #include <ti/sysbios/knl/Task.h>                                                            // For Task types and UArg
 #include <ti/sysbios/knl/Queue.h>                                                           // For Queue types
+#include <ti/sysbios/knl/Semaphore.h>                                                       // For Semaphore_Handle
 #include <ti/drivers/SPI.h>                                                                 // For SPI_Handle
 
 /* Declaring macro variables */
@@ -21,9 +22,63 @@
 #define ESC '\x1B'                                                                          // Defining ESC key to shortcut variable
 #define BUFFER_SIZE 320                                                                     // Defining size to input buffer
 #define MAX_CMD_LENGTH 318                                                                  // Defining max command length
-#define QUEUE_SIZE 32                                                                       // Defining timer queue size
+#define QUEUE_SIZE 32                                                                       // Defining payload queue depth per callback (records share the arena)
 #define MAX_OUTPUT_CHUNK 64                                                                 // Defining max chuck for callback overflow
 #define USER_PROMPT_SIZE 1000                                                               // Defining terminal print length
+#define HELP_LIST_SIZE 1536                                                                 // Defining -help command list length
+#define UART_WRITER_COUNT 2                                                                 // Defining UART output writers (UART0, UART7)
+#define UART_WRITER_STACK_SIZE 1024                                                         // Defining UART writer task stack size
+#define UART_WRITER_PRIORITY 4                                                              // Defining UART writer task priority (above shell tasks)
+#define UART_OUT_RING_SIZE 4096                                                             // Defining output ring bytes per UART (power of 2)
+#define UART_OUT_HEADER 8                                                                   // Defining record header bytes (length/ready word, enqueue tick)
+#define UART_OUT_RECORD_MAX 1024                                                            // Defining longest record (longer writes are split)
+#define UART_OUT_READY 0x80000000u                                                          // Defining published record flag
+#define UART_OUT_BLOCK_TICKS 100                                                            // Defining task wait for ring space before dropping
+#define UART_RX_COUNT 2                                                                     // Defining UART receivers (UART0, UART7)
+#define UART_RX_RING_SIZE 512                                                               // Defining receive ring bytes per UART (power of 2)
+#define UART_RX_TIMEOUT 1000                                                                // Defining line wait before the consumer wakes anyway (ticks)
+#define UART_RX_TIMEOUT_LINE 0                                                              // Defining uart_rx_line() wait ended without a line
+#define UART_RX_LONG_LINE -1                                                                // Defining uart_rx_line() line dropped as too long
+#define UART_RX_OVERRUN -2                                                                  // Defining uart_rx_line() line dropped by a ring overrun
+#define UART_FRAME_END 0xC0                                                                 // Defining SLIP frame delimiter (never in text commands)
+#define UART_FRAME_ESC 0xDB                                                                 // Defining SLIP escape
+#define UART_FRAME_ESC_END 0xDC                                                             // Defining escaped frame delimiter
+#define UART_FRAME_ESC_ESC 0xDD                                                             // Defining escaped escape
+#define UART_FRAME_ESC_NUL 0xDE                                                             // Defining escaped NUL (NUL marks receive overruns)
+#define UART_FRAME_CMD 0x01                                                                 // Defining command batch frame
+#define UART_FRAME_ACK 0x02                                                                 // Defining acknowledgement frame (payload: commands run)
+#define UART_FRAME_NACK 0x03                                                                // Defining negative acknowledgement frame (payload: reason)
+#define UART_FRAME_PCM 0x04                                                                 // Defining PCM sample frame (unacknowledged, 16-bit little-endian samples)
+#define UART_FRAME_SYNC 0x05                                                                // Defining sync frame (first after a restart, clears the peer's duplicate filter)
+#define UART_NACK_CRC 1                                                                     // Defining NACK for a CRC mismatch (sender retransmits)
+#define UART_NACK_FORMAT 2                                                                  // Defining NACK for a malformed batch (sender gives up)
+#define UART_NACK_DAMAGED 3                                                                 // Defining NACK for a frame lost to overrun or length (sender retransmits)
+#define UART_FRAME_OVERHEAD 4                                                               // Defining type, sequence and CRC-16 bytes
+#define UART_FRAME_MAX 256                                                                  // Defining longest decoded frame (fits a receive line)
+#define UART_FRAME_ENCODED_MAX (2 * UART_FRAME_MAX + 2)                                     // Defining longest SLIP-encoded frame
+#define UART_FRAME_ACK_TIMEOUT 100                                                          // Defining acknowledgement wait before retransmit (ticks)
+#define UART_FRAME_RETRIES 3                                                                // Defining retransmits before a frame is given up
+#define TRACE_EVENTS 512                                                                    // Defining trace ring events (power of 2, oldest overwritten)
+#define TRACE_TASKS 12                                                                      // Defining tasks the trace tells apart (context 0 is interrupts)
+#define TRACE_NAME_LENGTH 12                                                                // Defining task name bytes in a dump
+#define TRACE_CHUNK_SIZE 256                                                                // Defining dump bytes per queued UART record
+#define TRACE_TICK_US 1000                                                                  // Defining Clock tick period (us) stamped with each event
+#define TRACE_MAGIC "TRC1"                                                                  // Defining -trace dump header
+#define TRACE_DISPATCH_BEGIN 1                                                              // Defining handler entry (arg0: command ID, arg1: session)
+#define TRACE_DISPATCH_END 2                                                                // Defining handler exit (arg0: command ID, arg1: session)
+#define TRACE_QUEUE_PUT 3                                                                   // Defining queue put (arg0: TRACE_OBJECT, arg1: depth after)
+#define TRACE_QUEUE_GET 4                                                                   // Defining queue get (arg0: TRACE_OBJECT, arg1: depth after)
+#define TRACE_SEM_POST 5                                                                    // Defining semaphore post (arg0: TRACE_OBJECT)
+#define TRACE_SEM_PEND 6                                                                    // Defining semaphore pend start (arg0: TRACE_OBJECT)
+#define TRACE_SEM_TAKE 7                                                                    // Defining semaphore pend return (arg0: TRACE_OBJECT, arg1: 1 taken, 0 timed out)
+#define TRACE_OBJ_TICKER 0                                                                  // Defining ticker semaphore / due-ticker ring
+#define TRACE_OBJ_SCRIPT 1                                                                  // Defining script semaphore
+#define TRACE_OBJ_DAC 2                                                                     // Defining DAC refill semaphore
+#define TRACE_OBJ_WRITER 3                                                                  // Defining UART writer semaphore / output ring (instance: writer)
+#define TRACE_OBJ_RX 4                                                                      // Defining UART receive semaphore (instance: receiver)
+#define TRACE_OBJ_WINDOW 5                                                                  // Defining UART7 frame send window
+#define TRACE_OBJ_CALLBACK 6                                                                // Defining callback payload queue (instance: callback)
+#define TRACE_OBJECT(object, instance) ((uint16_t)((object) | ((instance) << 8)))           // Defining trace object argument
 #define USER "Christian J. Maldonado (\033[31mChris\033[0m)"                                // Defining user name
 #define VERSION_SUB "v12.1"                                                                 // Defining version
 #define ASSIGNMENT "Assignment X"                                                           // Defining assignment
@@ -54,35 +109,373 @@
 #define TIMER_CALLBACK 0                                                                    // Defining Timer Callback
 #define SW1_CALLBACK 1                                                                      // Defining SW1 Callback
 #define SW2_CALLBACK 2                                                                      // Defining SW2 Callback
+#define CALLBACK_ARENA_SIZE 2048                                                            // Defining callback payload arena (RAM budget, bytes)
+#define ARENA_ALIGN 4                                                                       // Defining record alignment (CompiledCommand holds int32_t)
+#define ARENA_NONE 0xFFFF                                                                   // Defining empty arena link
+#define ARENA_FREE 0xFF                                                                     // Defining free block owner
 #define MAX_TICKERS 16                                                                      // Defining max tickers
 #define TICKER_TIMER TICKER_TIMER_0                                                         // Defining ticker timer from system configuration
+#define TICKER_TICK_US 1000                                                                 // Defining timing-wheel tick (1 ms)
+#define TICKER_TICKS_PER_UNIT 10                                                            // Defining -ticker delay/period unit (10 ms) in wheel ticks
+#define TICKER_WHEEL0_BITS 8                                                                // Defining level-0 wheel bits (256 x 1 ms slots)
+#define TICKER_WHEELN_BITS 6                                                                // Defining level-1/2 wheel bits (64 slots each)
+#define TICKER_WHEEL_SLOTS ((1 << TICKER_WHEEL0_BITS) + 2 * (1 << TICKER_WHEELN_BITS))
+#define TICKER_NONE 0xFFFF                                                                  // Defining empty wheel link
+#define TICKER_READY_SIZE 64                                                                // Defining due-ticker ring size (power of 2)
+#define TICKER_TASK_STACK_SIZE 2048                                                         // Defining ticker task stack size length
+#define TICKER_TASK_PRIORITY 3                                                              // Defining ticker task priority (above script and UART7 tasks)
 #define NUM_REGISTERS 32                                                                    // Defining register count
 #define MAX_REG_NAME_LENGTH 10                                                              // Defining max register length
+#define REG_ALIAS_SLOTS 16                                                                  // Defining register alias hash slots (power of 2)
 #define SCRIPT_SIZE 64                                                                      // Defining script size length
 #define MAX_SCRIPT_LINE_LENGTH 318                                                          // Defining max script input length
-#define SCRIPT_QUEUE_SIZE 32                                                                // Defining script queue size length
+#define SCRIPT_CALL_DEPTH 8                                                                 // Defining nested -script <line> x call frames
+#define SCRIPT_SLICE_LINES 16                                                               // Defining script lines run between yields
 #define SCRIPT_TASK_STACK_SIZE 2048                                                         // Defining script task stack size length
-#define SINE_TABLE_SIZE 256                                                                 // Defining sine table size
+#define SINE_MILLIHERTZ 1000                                                                // Defining -sine frequency steps per Hz
+#define SINE_RATE_DEFAULT 8000                                                              // Defining default sample rate (Hz)
+#define SINE_RATE_MIN 1000                                                                  // Defining lowest -sine rate (Hz)
+#define SINE_RATE_MAX 128000                                                                // Defining highest -sine rate (Hz, 16-bit frames at 4 MHz SPI)
+#define WAVE_SINE 0                                                                         // Defining -sine wave sine
+#define WAVE_TRIANGLE 1                                                                     // Defining -sine wave triangle
+#define WAVE_SAW 2                                                                          // Defining -sine wave saw
+#define WAVE_SQUARE 3                                                                       // Defining -sine wave square
+#define WAVE_ARB 4                                                                          // Defining -sine wave arb (uploaded with -sine load)
+#define WAVE_COUNT 5                                                                        // Defining waveform count
+#define WAVE_GAIN_FULL 32768                                                                // Defining 100% amplitude (Q15)
+#define WAVE_OFFSET_MID 0x2000                                                              // Defining DAC mid-scale code
+#define WAVE_DAC_MAX 0x3FFF                                                                 // Defining DAC full-scale code (14 bits)
+#define TONE_VOICES 8                                                                       // Defining mixer voices (even, mixed in pairs)
+#define TONE_SAT_BITS 14                                                                    // Defining mix saturation width (DAC8311 data bits)
+#define TONE_VOICE_CYCLES 24                                                                // Defining estimated mixer cost per voice per sample (M4F cycles; -tone also shows the timed fills)
+#define CPU_FREQUENCY 120000000                                                             // Defining MSP432E401Y system clock (Hz)
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#define TONE_DSP 1                                                                          // Defining Cortex-M4 DSP intrinsics mixer (__SMLAD, __SSAT)
+#else
+#define TONE_DSP 0                                                                          // Defining portable C mixer (host builds)
+#endif
+#ifndef PERF_ENABLE
+#define PERF_ENABLE 1                                                                       // Defining -perf timing (build with -DPERF_ENABLE=0 to compile it away)
+#endif
+#if defined(__TI_ARM__) || defined(__ARM_ARCH_7EM__)
+#define PERF_DWT 1                                                                          // Defining DWT cycle counter timebase (CPU cycles)
+#define PERF_TICKS_PER_US (CPU_FREQUENCY / 1000000)                                         // Defining cycles per microsecond
+#else
+#define PERF_DWT 0                                                                          // Defining clock_gettime() timebase (host builds, nanoseconds)
+#define PERF_TICKS_PER_US 1000                                                              // Defining nanoseconds per microsecond
+#endif
+#define PERF_BUCKETS 24                                                                     // Defining log2 histogram buckets (last one holds anything longer)
+#define PERF_SITE_DISPATCH 0                                                                // Defining valid_cmd site (lookup and handler)
+#define PERF_SITE_SINE 1                                                                    // Defining sine timer ISR site
+#define PERF_SITE_TICKER 2                                                                  // Defining ticker timer ISR site
+#define PERF_SITE_SW1 3                                                                     // Defining SW1 callback site
+#define PERF_SITE_SW2 4                                                                     // Defining SW2 callback site
+#define PERF_SITE_MIX 5                                                                     // Defining DAC task fill site (halves mixed by tone_sample)
+#define PERF_SITE_COMMANDS 6                                                                // Defining first handler site (one per command table entry)
+#define PERF_SITES (PERF_SITE_COMMANDS + COMMAND_SLOTS)                                     // Defining timed sites
+#define PCM_RING_SIZE 4096                                                                  // Defining PCM jitter buffer samples (power of 2)
+#define PCM_DEPTH_DEFAULT 400                                                               // Defining default target fill (samples)
+#define PCM_DEPTH_MIN 32                                                                    // Defining smallest target fill (samples)
+#define PCM_ADAPT_WINDOW 1024                                                               // Defining samples between adaptive fill checks
+#define DAC_HALF_SIZE 128                                                                   // Defining samples per buffer half
+#define DAC_TASK_STACK_SIZE 1024                                                            // Defining DAC task stack size length
+#define DAC_TASK_PRIORITY 5                                                                 // Defining DAC task priority (above UART writers, refills are short)
 #define TWO_PI 6.28318530718                                                                // Defining PI*2 as variable
 #define DAC_MAX_VALUE 16383                                                                 // Defining 14-bit DAC (2^14 - 1)
+#define COMMAND_SLOTS 32                                                                    // Defining command hash slots (power of 2)
+#define MAX_COMMAND_NAME_LENGTH 8                                                           // Defining longest command name (callback)
+#define CMD_ARGS_NONE 0                                                                     // Defining command without arguments
+#define CMD_ARGS_OPTIONAL 1                                                                 // Defining command with optional arguments
+#define CMD_ARGS_REQUIRED 2                                                                 // Defining command with required arguments
+#define CMD_OP_TEXT 0                                                                       // Defining compiled command re-dispatched from text
+#define CMD_OP_GPIO_READ 1                                                                  // Defining compiled -gpio <n> r
+#define CMD_OP_GPIO_WRITE 2                                                                 // Defining compiled -gpio <n> w <0|1>
+#define CMD_OP_GPIO_TOGGLE 3                                                                // Defining compiled -gpio <n> t
+#define CMD_OP_REG 4                                                                        // Defining compiled -reg operation
+#define CMD_OP_IF 5                                                                         // Defining compiled -if (interned condition, resolved destinations)
+#define REG_OP_MOV 0                                                                        // Defining register MOV
+#define REG_OP_XCG 1                                                                        // Defining register XCG
+#define REG_OP_INC 2                                                                        // Defining register INC
+#define REG_OP_DEC 3                                                                        // Defining register DEC
+#define REG_OP_ADD 4                                                                        // Defining register ADD
+#define REG_OP_SUB 5                                                                        // Defining register SUB
+#define REG_OP_NEG 6                                                                        // Defining register NEG
+#define REG_OP_NOT 7                                                                        // Defining register NOT
+#define REG_OP_AND 8                                                                        // Defining register AND
+#define REG_OP_IOR 9                                                                        // Defining register IOR
+#define REG_OP_XOR 10                                                                       // Defining register XOR
+#define REG_OP_MUL 11                                                                       // Defining register MUL
+#define REG_OP_DIV 12                                                                       // Defining register DIV
+#define REG_OP_REM 13                                                                       // Defining register REM
+#define REG_OP_MAX 14                                                                       // Defining register MAX
+#define REG_OP_MIN 15                                                                       // Defining register MIN
+#define REG_OP_COUNT 16                                                                     // Defining register operation count
+#define PROG_OP_END 16                                                                      // Defining micro-program end of run (empty line)
+#define PROG_OP_REM 17                                                                      // Defining micro-program -rem
+#define PROG_OP_GOTO 18                                                                     // Defining micro-program jump to script line (-script <line> x)
+#define PROG_OP_SKIP 19                                                                     // Defining micro-program jump past -if false action
+#define PROG_OP_IF 20                                                                       // Defining micro-program branch unless the -if condition holds
+#define PROG_OP_TEXT 21                                                                     // Defining micro-program line left to the line interpreter
+#define PROG_SIZE 256                                                                       // Defining micro-program instruction capacity
+#define PROG_SLICE_STEPS 256                                                                // Defining micro-program instructions per time slice
+#define IF_COND_LENGTH 48                                                                   // Defining max -if condition length
+#define IF_EXPR_NODES 16                                                                    // Defining max -if condition nodes (operands and operators)
+#define IF_EXPR_IMMS 8                                                                      // Defining max -if condition immediates
+#define IF_EXPR_SLOTS 16                                                                    // Defining interned -if condition slots (power of 2, released when unused)
+#define IF_LIMIT_NODES 1                                                                    // Defining -if compile stopped by IF_EXPR_NODES
+#define IF_LIMIT_IMMS 2                                                                     // Defining -if compile stopped by IF_EXPR_IMMS
+#define IF_DEST_NONE 0xFF                                                                   // Defining empty or invalid -if destination
+#define IF_DEST_TEXT 0xFE                                                                   // Defining command -if destination (span in the text)
+#define IF_NODE_REG 0                                                                       // Defining -if register operand
+#define IF_NODE_IMM 1                                                                       // Defining -if immediate operand
+#define IF_NODE_MUL 2                                                                       // Defining -if *
+#define IF_NODE_DIV 3                                                                       // Defining -if /
+#define IF_NODE_REM 4                                                                       // Defining -if %
+#define IF_NODE_ADD 5                                                                       // Defining -if +
+#define IF_NODE_SUB 6                                                                       // Defining -if -
+#define IF_NODE_LT 7                                                                        // Defining -if <
+#define IF_NODE_LE 8                                                                        // Defining -if <=
+#define IF_NODE_GT 9                                                                        // Defining -if >
+#define IF_NODE_GE 10                                                                       // Defining -if >=
+#define IF_NODE_EQ 11                                                                       // Defining -if = (or ==)
+#define IF_NODE_NE 12                                                                       // Defining -if !=
+#define IF_NODE_AND 13                                                                      // Defining -if &&
+#define IF_NODE_OR 14                                                                       // Defining -if ||
+#define IF_NODE_COUNT 15                                                                    // Defining -if node kind count
+#define DEBUG_LEVEL_MAX 2                                                                   // Defining highest -debug trace level
+#define REG_BANKS 4                                                                         // Defining register banks (selected per session)
+#define SHELL_SESSION_COUNT (SESSION_CALLBACK + MAX_CALLBACKS)                              // Defining shell sessions (UART0, UART7, script, ticker, callbacks)
+#define SESSION_UART0 0                                                                     // Defining UART0 console session
+#define SESSION_UART7 1                                                                     // Defining UART7 input session
+#define SESSION_SCRIPT 2                                                                    // Defining script task session
+#define SESSION_TICKER 3                                                                    // Defining ticker task session
+#define SESSION_CALLBACK 4                                                                  // Defining first callback session (plus callback index)
 
 /* Declaring structures */
+    // Shell history (interactive sessions)
+typedef struct {
+    char entries[HISTORY_SIZE][BUFFER_SIZE];                                                // Declaring command history
+    int count;                                                                              // Declaring stored command count
+    int index;                                                                              // Declaring history cycle index
+} ShellHistory;                                                                             // Declaring struct name as ShellHistory
+    // Shell session (per-channel command context)
+typedef struct {
+    const char *name;                                                                       // Declaring session name
+    UART_Handle uart;                                                                       // Declaring output channel
+    ShellHistory *history;                                                                  // Declaring input history (NULL when not interactive)
+    uint8_t verbosity;                                                                      // Declaring -debug trace level (0 = off)
+    uint8_t bank;                                                                           // Declaring selected register bank
+    char prompt[USER_PROMPT_SIZE];                                                          // Declaring command output buffer
+} ShellSession;                                                                             // Declaring struct name as ShellSession
+    // Command
+typedef void (*CommandHandler)(ShellSession *session, char *args);                          // Declaring command handler type
+typedef struct {
+    const char *name;                                                                       // Declaring command name (without '-')
+    uint8_t length;                                                                         // Declaring command name length
+    uint8_t schema;                                                                         // Declaring argument schema (CMD_ARGS_*)
+    CommandHandler handler;                                                                 // Declaring command handler
+    const char *summary;                                                                    // Declaring -help list text
+    const char *usage;                                                                      // Declaring -help <command> text
+} Command;                                                                                  // Declaring struct name as Command
+    // Register alias
+typedef struct {
+    char name[MAX_REG_NAME_LENGTH];                                                         // Declaring alias name (empty when slot is free)
+    int8_t index;                                                                           // Declaring aliased register index
+} RegAlias;                                                                                 // Declaring struct name as RegAlias
+    // UART output writer (multi-producer ring drained by one task)
+typedef struct {
+    const char *name;                                                                       // Declaring UART name for -output
+    UART_Handle uart;                                                                       // Declaring UART handle
+    Semaphore_Handle sem;                                                                   // Declaring writer wake semaphore
+    volatile uint32_t reserve;                                                              // Declaring reserved byte count (producers, compare-and-swap)
+    volatile uint32_t read;                                                                 // Declaring drained byte count (writer task)
+    uint32_t ring[UART_OUT_RING_SIZE / 4];                                                  // Declaring record ring (word aligned headers)
+    volatile uint32_t records;                                                              // Declaring records written
+    volatile uint32_t bytes;                                                                // Declaring bytes written
+    volatile uint32_t dropped_records;                                                      // Declaring records dropped on a full ring
+    volatile uint32_t dropped_bytes;                                                        // Declaring bytes dropped on a full ring
+    volatile uint32_t waits;                                                                // Declaring task producer waits for space
+    volatile uint32_t high_water;                                                           // Declaring most ring bytes in use
+    volatile uint32_t latency_max;                                                          // Declaring longest enqueue to written time (ticks)
+    volatile uint32_t latency_total;                                                        // Declaring summed latency (ticks)
+} UartWriter;                                                                               // Declaring struct name as UartWriter
+    // UART receiver (callback-mode reads into a ring, lines assembled by the consumer)
+typedef struct {
+    const char *name;                                                                       // Declaring UART name for -uart
+    UART_Handle uart;                                                                       // Declaring UART handle
+    Semaphore_Handle sem;                                                                   // Declaring consumer wake semaphore
+    bool wake_on_byte;                                                                      // Declaring byte wakes (line editors) instead of line wakes
+    int error;                                                                              // Declaring error_counts slot for overruns
+    volatile uint32_t head;                                                                 // Declaring received byte count (callback)
+    volatile uint32_t tail;                                                                 // Declaring consumed byte count (consumer task)
+    volatile bool overrun;                                                                  // Declaring bytes lost since the last stored byte
+    volatile bool stopped;                                                                  // Declaring read completed without bytes (cancelled)
+    uint8_t byte;                                                                           // Declaring callback-mode read buffer
+    uint8_t ring[UART_RX_RING_SIZE];                                                        // Declaring receive ring
+    char line[BUFFER_SIZE];                                                                 // Declaring line being assembled
+    uint16_t length;                                                                        // Declaring assembled line length
+    int8_t status;                                                                          // Declaring assembled line drop status (0 when intact)
+    bool in_frame;                                                                          // Declaring bytes belong to a SLIP frame
+    bool escape;                                                                            // Declaring SLIP escape pending
+    bool frame;                                                                             // Declaring last result was a frame (binary line contents)
+    volatile uint32_t bytes;                                                                // Declaring bytes received
+    volatile uint32_t lines;                                                                // Declaring lines delivered
+    volatile uint32_t frames;                                                               // Declaring frames delivered
+    volatile uint32_t overruns;                                                             // Declaring bytes lost to a full ring
+    volatile uint32_t dropped_lines;                                                        // Declaring lines and frames dropped (too long or overrun)
+    volatile uint32_t high_water;                                                           // Declaring most ring bytes in use
+} UartRx;                                                                                   // Declaring struct name as UartRx
+    // UART7 framed link (stop-and-wait command batches)
+typedef struct {
+    Semaphore_Handle window;                                                                // Declaring send window (one frame awaiting acknowledgement)
+    volatile bool pending;                                                                  // Declaring frame awaiting acknowledgement
+    volatile bool synced;                                                                   // Declaring sync acknowledged since this board started
+    uint8_t pending_type;                                                                   // Declaring type of the pending frame (UART_FRAME_SYNC or _CMD)
+    uint8_t tx_sequence;                                                                    // Declaring next sent sequence number
+    uint8_t pending_sequence;                                                               // Declaring sequence awaiting acknowledgement
+    uint8_t retries;                                                                        // Declaring retransmits of the pending frame
+    uint32_t sent_at;                                                                       // Declaring last transmit time (ticks)
+    uint16_t pending_length;                                                                // Declaring encoded pending frame length
+    uint8_t pending_frame[UART_FRAME_ENCODED_MAX];                                          // Declaring encoded pending frame (kept for retransmit)
+    bool rx_valid;                                                                          // Declaring a command frame has been run
+    uint8_t rx_sequence;                                                                    // Declaring last run sequence number (duplicates are re-acknowledged)
+    uint8_t rx_count;                                                                       // Declaring commands run by that frame
+    volatile uint32_t frames_sent;                                                          // Declaring command frames sent
+    volatile uint32_t frames_received;                                                      // Declaring intact frames received
+    volatile uint32_t commands;                                                             // Declaring framed commands run
+    volatile uint32_t acks;                                                                 // Declaring acknowledgements received
+    volatile uint32_t nacks;                                                                // Declaring negative acknowledgements received
+    volatile uint32_t crc_errors;                                                           // Declaring frames failing CRC
+    volatile uint32_t retransmits;                                                          // Declaring frames sent again
+    volatile uint32_t duplicates;                                                           // Declaring retransmitted frames already run
+    volatile uint32_t failures;                                                             // Declaring frames given up
+} UartLink;                                                                                 // Declaring struct name as UartLink
+    // Trace event (16 bytes in a dump, little-endian)
+typedef struct {
+    volatile uint32_t stamp;                                                                // Declaring ring index + 1 once written (0 while being written)
+    uint32_t time;                                                                          // Declaring timebase ticks (DWT cycles on target, ns on host)
+    uint32_t tick;                                                                          // Declaring Clock ticks (unwraps the timebase across long gaps)
+    uint8_t id;                                                                             // Declaring event (TRACE_*)
+    uint8_t context;                                                                        // Declaring writer (0 interrupt, 1+ task slot)
+    uint16_t arg0;                                                                          // Declaring first argument
+    uint32_t arg1;                                                                          // Declaring second argument
+} TraceEvent;                                                                               // Declaring struct name as TraceEvent
+    // Trace ring (multi-producer, lock-free; overwritten oldest first)
+typedef struct {
+    TraceEvent events[TRACE_EVENTS];                                                        // Declaring event ring
+    volatile uint32_t head;                                                                 // Declaring events reserved since clear
+    volatile bool enabled;                                                                  // Declaring recording flag
+    volatile uint32_t task_count;                                                           // Declaring task slots claimed
+    Task_Handle tasks[TRACE_TASKS];                                                         // Declaring task in each slot
+    const char *names[TRACE_TASKS];                                                         // Declaring task names (NULL until named)
+} TraceRing;                                                                                // Declaring struct name as TraceRing
+    // Compiled command
+typedef struct {
+    uint8_t opcode;                                                                         // Declaring operation (CMD_OP_*)
+    uint8_t number;                                                                         // Declaring GPIO number, register operation (REG_OP_*) or -if slot
+    uint8_t pin;                                                                            // Declaring GPIO driver index
+    uint8_t value;                                                                          // Declaring GPIO write value
+    uint8_t dest;                                                                           // Declaring destination register index
+    uint8_t src[2];                                                                         // Declaring source register indices (-if: true/false line or IF_DEST_*)
+    uint8_t immediate;                                                                      // Declaring immediate flags (bit per source)
+    uint8_t arg_count;                                                                      // Declaring -reg argument count (operation included)
+    int32_t imm[2];                                                                         // Declaring immediate values (-if: destination offset << 16 | length)
+} CompiledCommand;                                                                          // Declaring struct name as CompiledCommand
+    // Compiled -if condition (reverse Polish)
+typedef struct {
+    char text[IF_COND_LENGTH];                                                              // Declaring condition text (interned with the nodes, empty when slot is free)
+    uint8_t count;                                                                          // Declaring node count
+    uint8_t imm_count;                                                                      // Declaring immediate count
+    uint16_t refs;                                                                          // Declaring compiled commands using the slot
+    uint8_t limit;                                                                          // Declaring limit that stopped the compile (IF_LIMIT_*, 0 when none)
+    uint8_t code[IF_EXPR_NODES];                                                            // Declaring node kinds (IF_NODE_*)
+    uint8_t arg[IF_EXPR_NODES];                                                             // Declaring register index or immediate index
+    int32_t imm[IF_EXPR_IMMS];                                                              // Declaring immediate values
+} IfExpr;                                                                                   // Declaring struct name as IfExpr
+    // Script micro-program instruction
+typedef struct {
+    uint8_t op;                                                                             // Declaring operation (REG_OP_* or PROG_OP_*)
+    uint8_t first;                                                                          // Declaring first instruction of a script line (counted as executed)
+    int16_t target;                                                                         // Declaring branch target (instruction index)
+    CompiledCommand operands;                                                               // Declaring register operands or compiled -if
+} ProgInstruction;                                                                          // Declaring struct name as ProgInstruction
+    // Callback payload record (arena block header, free blocks use the header only)
+typedef struct {
+    uint16_t size;                                                                          // Declaring block bytes (header included, ARENA_ALIGN multiple)
+    uint16_t next;                                                                          // Declaring next record in the queue, or next free block
+    uint8_t owner;                                                                          // Declaring callback index (ARENA_FREE when free)
+    uint8_t reserved;                                                                       // Declaring padding
+    CompiledCommand compiled;                                                               // Declaring compiled payload
+    char text[];                                                                            // Declaring payload text (NUL terminated)
+} PayloadRecord;                                                                            // Declaring struct name as PayloadRecord
+    // Callback payload arena (tiled by blocks, free list kept in address order)
+typedef struct {
+    uint32_t heap[CALLBACK_ARENA_SIZE / sizeof(uint32_t)];                                  // Declaring arena storage (word aligned)
+    bool ready;                                                                             // Declaring arena tiled with its first free block
+    uint16_t free_head;                                                                     // Declaring lowest free block
+    uint16_t used;                                                                          // Declaring bytes held by records
+    uint16_t high;                                                                          // Declaring used high-water mark
+    uint16_t records;                                                                       // Declaring records held
+    uint32_t compactions;                                                                   // Declaring compactions run
+    uint32_t failures;                                                                      // Declaring payloads refused for space
+} PayloadArena;                                                                             // Declaring struct name as PayloadArena
     // Callback
 typedef struct {
     int index;                                                                              // Declaring struct index
     int count;                                                                              // Declaring struct count
-    int queue_front;                                                                        // Declaring front queue struct
-    int queue_rear;                                                                         // Declaring queue rear struct
+    uint16_t queue_front;                                                                   // Declaring first payload record (arena offset)
+    uint16_t queue_rear;                                                                    // Declaring last payload record (arena offset)
     int queue_size;                                                                         // Declaring struct queue size
-    int output_position;                                                                    // Declaring output position struct
+    int output_position;                                                                    // Declaring output position in the callback session prompt
     int output_length;                                                                      // Declaring output length struct
-    char payload[QUEUE_SIZE][MAX_CMD_LENGTH];                                               // Declaring struct command array
-    char output_buffer[USER_PROMPT_SIZE];                                                   // Declaring output buffer to terminal sized array
     bool is_executing;                                                                      // Declaring active execution bool
     bool is_button_callback;                                                                // Declaring active button execution bool
     bool is_large_interval;                                                                 // Declaring large timer value bool
-    UART_Handle uart;                                                                       // Processing UART to struct
+    ShellSession *owner;                                                                    // Declaring session that set the callback
 } Callback;                                                                                 // Declaring struct name as Callback
+    // Waveform shape
+typedef struct {
+    const int16_t *table;                                                                   // Declaring Q15 table (WAVE_TABLE_SIZE+1 entries)
+    int32_t gain;                                                                           // Declaring amplitude (Q15)
+    int32_t offset;                                                                         // Declaring mid-point (DAC code)
+} WaveShape;                                                                                // Declaring struct name as WaveShape
+    // Tone mixer voice
+typedef struct {
+    uint32_t phase;                                                                         // Declaring voice phase (2^32 = one cycle)
+    uint32_t increment;                                                                     // Declaring voice phase step per sample
+    uint32_t millihertz;                                                                    // Declaring voice frequency
+    int16_t gain;                                                                           // Declaring voice gain (Q15)
+} ToneVoice;                                                                                // Declaring struct name as ToneVoice
+    // PCM jitter buffer (UART7 task produces, sine timer consumes)
+typedef struct {
+    volatile uint16_t ring[PCM_RING_SIZE];                                                  // Declaring samples as DAC codes
+    volatile uint32_t write;                                                                // Declaring samples written (producer)
+    volatile uint32_t read;                                                                 // Declaring samples played or skipped (consumer)
+    uint32_t depth;                                                                         // Declaring target fill before playing
+    volatile bool priming;                                                                  // Declaring filling to depth
+    uint32_t window;                                                                        // Declaring samples into the adaptive window
+    uint32_t window_low;                                                                    // Declaring lowest fill in the window
+    uint8_t sequence;                                                                       // Declaring last frame sequence number
+    bool sequence_valid;                                                                    // Declaring sequence seen
+    volatile uint32_t frames;                                                               // Declaring frames received
+    volatile uint32_t samples;                                                              // Declaring samples buffered
+    volatile uint32_t lost;                                                                 // Declaring frames missing from the sequence
+    volatile uint32_t late;                                                                 // Declaring duplicate or reordered frames dropped
+    volatile uint32_t ignored;                                                              // Declaring frames received while stopped
+    volatile uint32_t overruns;                                                             // Declaring samples dropped on a full buffer
+    volatile uint32_t underruns;                                                            // Declaring times the buffer ran dry
+    volatile uint32_t dropped;                                                              // Declaring samples skipped by adaptive fill
+    volatile uint32_t repeated;                                                             // Declaring samples held by adaptive fill
+    volatile uint32_t high;                                                                 // Declaring fill high-water mark
+} PcmBuffer;                                                                                // Declaring struct name as PcmBuffer
+    // Timed site (-perf)
+typedef struct {
+    uint32_t count;                                                                         // Declaring runs measured
+    uint32_t min;                                                                           // Declaring shortest run (ticks)
+    uint32_t max;                                                                           // Declaring longest run (ticks)
+    uint64_t total;                                                                         // Declaring sum of runs (ticks)
+    uint32_t histogram[PERF_BUCKETS];                                                       // Declaring runs by log2 ticks (bucket b holds 2^(b-1) to 2^b - 1)
+} PerfSite;                                                                                 // Declaring struct name as PerfSite
     // Ticker
 typedef struct {
     bool active;                                                                            // Declaring bool variable for status
@@ -90,42 +483,54 @@ typedef struct {
     uint32_t period;                                                                        // Declaring period variable
     int32_t count;                                                                          // Declaring count variable
     char payload[MAX_CMD_LENGTH];                                                           // Declaring payload array
-    uint32_t next_execution;                                                                // Declaring next execution variable
-    UART_Handle uart;                                                                       // Declaring UART to struct
+    CompiledCommand compiled;                                                               // Declaring compiled payload
+    uint32_t next_execution;                                                                // Declaring next execution wheel tick
+    uint16_t bucket;                                                                        // Declaring wheel slot (TICKER_NONE when unlinked)
+    uint16_t next;                                                                          // Declaring next ticker in slot
+    uint16_t prev;                                                                          // Declaring previous ticker in slot
+    ShellSession *owner;                                                                    // Declaring session that set the ticker
 } Ticker;                                                                                   // Declaring struct name as Ticker
-    // Script
-typedef struct {
-    int line_number;                                                                        // Declaring variable for script line number
-    char command[MAX_CMD_LENGTH];                                                           // Declaring command array by command length
-    UART_Handle uart;                                                                       // Declaring UART to struct
-} ScriptCommand;                                                                            // Declaring struct name as ScriptCommand
-typedef struct {
-    Queue_Elem elem;                                                                        // Declaring element queue variable
-    ScriptCommand cmd;                                                                      // Declaring script command variable
-} ScriptQueueElement;                                                                       // Declaring struct name as ScriptQueueElement
 
 /* Declaring function operations */
     // Input processing
-void processUserInput(UART_Handle uart);                                                    // Declaring function for input processing
+void processUserInput(ShellSession *session);                                               // Declaring function for input processing
+    // Shell sessions
+void bind_session(ShellSession *session, const ShellSession *owner);                        // Declaring function to run a background session for its owner
+void add_to_history(ShellHistory *history, const char *command);                            // Declaring function for adding to session history
     // Command(s)
-void valid_cmd(UART_Handle uart, char *command);                                            // Declaring function to validate/execute commands
-void about_cmd(UART_Handle uart);                                                           // Declaring function for -about
-void help_cmd(UART_Handle uart, char *subcmd);                                              // Declaring function for -help
-void print_cmd(UART_Handle uart, char *substring);                                          // Declaring function for -print
-void memr_cmd(UART_Handle uart, char *address_str);                                         // Declaring function for -memr
-void error_cmd(UART_Handle uart);                                                           // Declaring function for -error
+void init_commands(void);                                                                   // Declaring function for command registry initialization
+void init_perf(void);                                                                       // Declaring function to start the -perf timebase
+uint32_t timebase_now(void);                                                                // Declaring function for the -perf and -trace timebase
+const Command *find_command(const char *name, size_t length);                               // Declaring function for command lookup
+int command_id(const Command *entry);                                                       // Declaring function for a command's table index (perf and trace)
+const Command *command_by_id(int id);                                                       // Declaring function for command lookup by table index
+void dispatch_command(ShellSession *session, const Command *entry, char *args);             // Declaring function to run a command after the argument check
+void valid_cmd(ShellSession *session, char *command);                                       // Declaring function to validate/execute commands
+bool compile_command(const char *text, CompiledCommand *compiled);                          // Declaring function to compile a stored command
+void release_command(CompiledCommand *compiled);                                            // Declaring function to release a compiled command
+void execute_command(ShellSession *session, const CompiledCommand *compiled, char *text);   // Declaring function to execute a compiled command
+void about_cmd(ShellSession *session);                                                      // Declaring function for -about
+void help_cmd(ShellSession *session, char *subcmd);                                         // Declaring function for -help
+void print_cmd(ShellSession *session, char *substring);                                     // Declaring function for -print
+void memr_cmd(ShellSession *session, char *address_str);                                    // Declaring function for -memr
+void error_cmd(ShellSession *session);                                                      // Declaring function for -error
 void increment_error(int error_type);                                                       // Declaring function for incrementing -error
-void gpio_cmd(UART_Handle uart, char *args);                                                // Declaring function for -gpio
-void timer_cmd(UART_Handle uart, char *args);                                               // Declaring function for -timer
-void callback_cmd(UART_Handle uart, char *args);                                            // Declaring function for -callback
-void reset_cmd(UART_Handle uart, char *args);                                               // Declaring function for -reset
-void ticker_cmd(UART_Handle uart, char *args);                                              // Declaring function for -ticker
-void reg_cmd(UART_Handle uart, char *args);                                                 // Declaring function for -reg
-void script_cmd(UART_Handle uart, char *args);                                              // Declaring function for -script
-void rem_cmd(UART_Handle uart, char *args);                                                 // Declaring function for -rem
-void if_cmd(UART_Handle uart, char *args);                                                  // Declaring function for -if
-void uart_cmd(UART_Handle uart, char *args);                                                // Declaring function for -uart
-void sine_cmd(UART_Handle uart, char *args);                                                // Declaring function for -sine
+void gpio_cmd(ShellSession *session, char *args);                                           // Declaring function for -gpio
+void timer_cmd(ShellSession *session, char *args);                                          // Declaring function for -timer
+void callback_cmd(ShellSession *session, char *args);                                       // Declaring function for -callback
+void reset_cmd(ShellSession *session, char *args);                                          // Declaring function for -reset
+void ticker_cmd(ShellSession *session, char *args);                                         // Declaring function for -ticker
+void reg_cmd(ShellSession *session, char *args);                                            // Declaring function for -reg
+void script_cmd(ShellSession *session, char *args);                                         // Declaring function for -script
+void rem_cmd(ShellSession *session, char *args);                                            // Declaring function for -rem
+void if_cmd(ShellSession *session, char *args);                                             // Declaring function for -if
+void debug_cmd(ShellSession *session, char *args);                                          // Declaring function for -debug
+void uart_cmd(ShellSession *session, char *args);                                           // Declaring function for -uart
+void sine_cmd(ShellSession *session, char *args);                                           // Declaring function for -sine
+void tone_cmd(ShellSession *session, char *args);                                           // Declaring function for -tone
+void pcm_cmd(ShellSession *session, char *args);                                            // Declaring function for -pcm
+void perf_cmd(ShellSession *session, char *args);                                           // Declaring function for -perf
+void trace_cmd(ShellSession *session, char *args);                                          // Declaring function for -trace
     // Callback operations
 void timer_callback(Timer_Handle handle, int_fast16_t status);                              // Declaring function for timer callback
 void sw1_callback(uint_least8_t index);                                                     // Declaring function for SW1 callback
@@ -133,39 +538,85 @@ void sw2_callback(uint_least8_t index);
     // Ticker operations
 void init_ticker_timer();                                                                   // Declaring function for ticker timer
 void ticker_timer_callback(Timer_Handle handle, int_fast16_t status);                       // Declaring function for ticker callback
+void schedule_ticker(int index, uint32_t delay);                                            // Declaring function to (re)link a ticker into the wheel
+void ticker_task(UArg arg0, UArg arg1);                                                     // Declaring function for ticker task handler
 void execute_ticker(int index);                                                             // Declaring function for ticker executions
     // Register operations
 void init_registers();                                                                      // Declaring function for register initialization to UART
-void set_reg_value(const char *reg_name, int32_t value);                                    // Declaring function for setting register
-int32_t get_reg_value(const char *reg_name);                                                // Declaring function for getting register
-int32_t parse_operand(const char *operand);                                                 // Declaring function for register parse operator
+void set_reg_value(ShellSession *session, const char *reg_name, int32_t value);             // Declaring function for setting register
+int reg_index(const char *name);                                                            // Declaring function to resolve a register index
+bool set_reg_alias(const char *name, int index);                                            // Declaring function to alias a register
+int32_t get_reg_value(const ShellSession *session, const char *reg_name);                   // Declaring function for getting register
+int32_t parse_operand(const ShellSession *session, const char *operand);                    // Declaring function for register parse operator
     // Script operations
 void init_script_system(void);                                                              // Declaring function to initialize the script system
 void script_task(UArg arg0, UArg arg1);                                                     // Declaring function to handle script tasks
-bool queue_script_command(const char *command);                                             // Declaring function for queue script command processing
-void execute_script(UART_Handle uart, int start_line);                                      // Declaring function to execute script
-    // Conditional operations                                                               // Declaring function for conditional evaluation
-bool evaluate_condition(UART_Handle uart, const char *operand1, const char *operand2, const char *condition);
-void execute_conditional_dest(UART_Handle uart, const char *dest, bool is_true);            // Declaring function for conditional execution
+void execute_script(ShellSession *session, int start_line);                                 // Declaring function to execute script
+void stop_script(void);                                                                     // Declaring function to stop script execution
+bool compile_program(int start_line);                                                       // Declaring function to compile a script micro-program
+void run_program(int pc, uint32_t generation);                                              // Declaring function to run a script micro-program
+    // Conditional operations
+const char *compile_if(const char *text, const char *args, IfExpr *expr, CompiledCommand *compiled);
+int32_t evaluate_if(const ShellSession *session, const IfExpr *expr);                       // Declaring function for conditional evaluation
+void execute_if(ShellSession *session, const CompiledCommand *compiled, const IfExpr *expr, char *text);
+    // UART output operations
+bool init_uart_writer(UART_Handle uart, const char *name);                                  // Declaring function to start a UART writer task
+void uart_writer_task(UArg arg0, UArg arg1);                                                // Declaring function for UART writer task handler
+void uart_output(UART_Handle uart, const void *data, size_t length);                        // Declaring function to queue UART output
+void output_cmd(ShellSession *session, char *args);                                         // Declaring function for -output
+    // UART receive operations
+UartRx *init_uart_rx(UART_Handle uart, const char *name, bool wake_on_byte, int error);     // Declaring function to start a UART receiver
+void uart_rx_callback(UART_Handle uart, void *buffer, size_t count);                        // Declaring function for callback-mode read completion
+int uart_rx_getc(UartRx *rx, uint32_t timeout);                                             // Declaring function to take one received byte (-1 on timeout)
+int uart_rx_line(UartRx *rx, uint32_t timeout);                                             // Declaring function to assemble a received line
+    // UART7 frame operations
+uint16_t crc16_ccitt(const uint8_t *data, size_t length);                                   // Declaring function for CRC-16/CCITT-FALSE
+uint16_t crc16_ccitt_update(uint16_t crc, const uint8_t *data, size_t length);              // Declaring function to continue a CRC-16/CCITT-FALSE
+    // Trace operations
+void trace_event(uint8_t id, uint16_t arg0, uint32_t arg1);                                 // Declaring function to record a trace event (tasks and ISRs)
+void trace_task_name(const char *name);                                                     // Declaring function to name the calling task in dumps
+void trace_clear(void);                                                                     // Declaring function to empty the trace ring
+uint32_t trace_dump(UART_Handle uart);                                                      // Declaring function to stream the ring in binary (returns events)
+int uart_frame_send(const uint8_t *payload, size_t length);                                 // Declaring function to send a command batch (returns sequence, -1 on failure)
+void uart_frame_receive(ShellSession *session, const uint8_t *frame, size_t length);        // Declaring function to handle a received frame
+void uart_frame_poll(ShellSession *session);                                                // Declaring function to retransmit an unacknowledged frame
     // UART7 operations
 void uart7Task(UArg arg0, UArg arg1);                                                       // Declaring function for UART7 task handler
-void processUart7Input(UART_Handle uart, char *command);                                    // Declaring function for UART7 input processor
+void processUart7Input(ShellSession *session, char *command);                               // Declaring function for UART7 input processor
     // Sine-DAC operations
-void sine_cmd(UART_Handle uart, char *args);                                                // Declaring function for sine/DAC processor
+void sine_cmd(ShellSession *session, char *args);                                           // Declaring function for sine/DAC processor
+void set_sine_frequency(uint32_t millihertz);                                               // Declaring function to set the DDS phase step
+void set_sine_interpolation(bool interpolate);                                              // Declaring function to select table interpolation
+void set_sine_wave(int wave, uint32_t amplitude, int32_t offset);                           // Declaring function to select the waveform shape
+uint16_t sine_sample(void);                                                                 // Declaring function for the next DAC sample
+bool set_tone_voices(const uint32_t *millihertz, const uint32_t *gain, int count);          // Declaring function to set the mixer voices
+uint16_t tone_sample(void);                                                                 // Declaring function for the next mixed DAC sample
+void pcm_receive(uint8_t sequence, const uint8_t *payload, size_t length);                  // Declaring function to buffer received PCM samples
+void init_dac_stream(void);                                                                 // Declaring function to start the DAC refill task
+void dac_task(UArg arg0, UArg arg1);                                                        // Declaring function for DAC task handler
+void dac_transfer_callback(SPI_Handle handle, SPI_Transaction *transaction);                // Declaring function for DAC transfer completion
+void dac_write(uint16_t word);                                                              // Declaring function to write the DAC from a task
 
 /* External declarations */
 extern Callback callbacks[MAX_CALLBACKS];                                                   // Declaring callback's external array
+extern PayloadArena payload_arena;                                                          // Declaring callback payload arena
 extern Timer_Handle timer1Handle;                                                           // Declaring callback 0 timer external variable
 extern Ticker tickers[MAX_TICKERS];                                                         // Declaring ticker's external array
 extern Timer_Handle ticker_timer_handle;                                                    // Declaring ticker timer external variable
 extern char reg_names[NUM_REGISTERS][MAX_REG_NAME_LENGTH];                                  // Declaring external char for 2D register parameter
-extern int32_t registers[NUM_REGISTERS];                                                    // Declaring external variable for register array
+extern int32_t registers[REG_BANKS][NUM_REGISTERS];                                         // Declaring external variable for register banks
 extern char script_space[SCRIPT_SIZE][MAX_SCRIPT_LINE_LENGTH];                              // Declaring external char for 2D script space parameter
+extern CompiledCommand script_compiled[SCRIPT_SIZE];                                        // Declaring external array for compiled script lines
 extern int Queue_count(Queue_Handle queue);                                                 // Declaring external variable for handling queue count
 extern UART_Handle uart7;                                                                   // Declaring external variable for UART7 handle
+extern UartWriter uart_writers[UART_WRITER_COUNT];                                          // Declaring external array for UART writers
+extern UartRx uart_receivers[UART_RX_COUNT];                                                // Declaring external array for UART receivers
+extern UartLink uart_link;                                                                  // Declaring external variable for the UART7 framed link
+extern TraceRing trace_ring;                                                                // Declaring external variable for the event trace
 extern Timer_Handle timer0Handle;                                                           // Declaring external variable for timer0Handle
 extern SPI_Handle spiHandle;                                                                // Declaring external variable for SPI handler
-extern char user_prompt[USER_PROMPT_SIZE];                                                  // Declaring global char for command prompts
+extern PcmBuffer pcm_buffer;                                                                // Declaring external variable for the PCM jitter buffer
+extern ShellSession shell_sessions[SHELL_SESSION_COUNT];                                    // Declaring external array for shell sessions
 
 /* Ending header file */
 #endif /* TONY_H_ */
@@ -22,6 +22,7 @@
 #include <ti/sysbios/knl/Task.h>                                                            // Task API header file controls
 #include <ti/sysbios/knl/Semaphore.h>                                                       // Semaphore API header file controls
 #include <ti/sysbios/knl/Queue.h>                                                           // Queue API header file controls
+#include <ti/sysbios/knl/Clock.h>                                                           // Clock API header file controls
 #include <ti/drivers/SPI.h>                                                                 // SPI API header file controls
 
 /* Device-GPIO maps */
@@ -32,40 +33,730 @@
 /* Driver configuration */
 #include "ti_drivers_config.h"                                                              // Hardware mapping peripherals
 #include "tony.h"                                                                           // Header variable definitions
-#include "sine.h"                                                                           // Sine table header excel values
 
 /* Global variables */
-char command_history[HISTORY_SIZE][BUFFER_SIZE];                                            // Declaring command history variable
-int history_count = 0;                                                                      // Declaring count history variable
-int current_history_index = -1;                                                             // Declaring command history cycle variable
+static ShellHistory console_history = { .index = -1 };                                      // Declaring UART0 command history
 UART_Handle uart7;                                                                          // Declaring global UART7 handle
 Task_Handle uart7TaskHandle;                                                                // Declaring global UART7 task handle
 static uint8_t uart7TaskStack[4096];                                                        // Declaring stack for UART7 task
-static UART_Handle main_uart;                                                               // Declaring global UART handle
+UartWriter uart_writers[UART_WRITER_COUNT] = {0};                                           // Declaring UART output writers
+UartRx uart_receivers[UART_RX_COUNT] = {0};                                                 // Declaring UART receivers
+UartLink uart_link = {0};                                                                   // Declaring UART7 framed link
+TraceRing trace_ring = { .enabled = true };                                                 // Declaring event trace (recording from start-up)
+static uint8_t uartWriterStacks[UART_WRITER_COUNT][UART_WRITER_STACK_SIZE];                 // Declaring UART writer task stacks
 
 /* History function(s) */
     // Add to history buffer
-void add_to_history(const char* command) {
+void add_to_history(ShellHistory *history, const char *command) {
     int i;                                                                                  // Declare i for loops
-    if (history_count < HISTORY_SIZE) {                                                     // Checking for full history
-        strcpy(command_history[history_count++], command);                                  // Add to history if not full
+    if (history->count < HISTORY_SIZE) {                                                    // Checking for full history
+        strcpy(history->entries[history->count++], command);                                // Add to history if not full
     } else {
         for (i = 0; i < HISTORY_SIZE - 1; i++) {                                            // If history is full
-            strcpy(command_history[i], command_history[i + 1]);                             // shift commands one position, discard oldest
+            strcpy(history->entries[i], history->entries[i + 1]);                           // shift commands one position, discard oldest
         }
-        strcpy(command_history[HISTORY_SIZE - 1], command);                                 // Adding new command to end of history
+        strcpy(history->entries[HISTORY_SIZE - 1], command);                                // Adding new command to end of history
     }
-    current_history_index = history_count;                                                  // Updating history index
+    history->index = history->count;                                                        // Updating history index
 }
     // Clear the input line
 void clear_input_line(UART_Handle uart, char* input, size_t* index) {
     while (*index > 0) {                                                                    // While characters are present in terminal
-        UART_write(uart, "\b \b", 3);                                                       // Backspace, space, backspace (erase last character)
+        uart_output(uart, "\b \b", 3);                                                      // Backspace, space, backspace (erase last character)
         (*index)--;                                                                         // Decrementing index
     }
     memset(input, 0, BUFFER_SIZE);                                                          // Clearing input buffer (fill with 0s)
 }
 
+/* UART output function(s) */
+    // Ring counter compare-and-swap (LDREX/STREX on target: fails across any interrupt)
+static bool uart_out_cas(volatile uint32_t *target, uint32_t expected, uint32_t desired) {
+#if defined(__TI_ARM__)
+    if (__ldrex((void *)target) != expected) {                                              // For counter moved by another producer
+        return false;                                                                       // Returning failed swap
+    }
+    return __strex(desired, (void *)target) == 0;                                           // Returning store result (0 when exclusive)
+#else
+    return __atomic_compare_exchange_n(target, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+#endif
+}
+    // Store ordering before publishing a record
+static void uart_out_barrier(void) {
+#if defined(__TI_ARM__)
+    __asm(" dmb");                                                                          // Data memory barrier
+#else
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);                                                // Compiler and memory barrier
+#endif
+}
+    // Lock-free counter add (producers may interrupt each other)
+static void uart_out_add(volatile uint32_t *counter, uint32_t value) {
+    uint32_t current;                                                                       // Declaring observed count
+    do {
+        current = *counter;                                                                 // Reading counter
+    } while (!uart_out_cas(counter, current, current + value));                             // Retrying until the add lands
+}
+    // Writer lookup (NULL before init_uart_writer, writes then go straight to the driver)
+static UartWriter *uart_writer_find(UART_Handle uart) {
+    int i;                                                                                  // Declaring loop variable
+    for (i = 0; i < UART_WRITER_COUNT; i++) {                                               // For each writer
+        if (uart_writers[i].uart == uart && uart != NULL) {                                 // For writer of this UART
+            return &uart_writers[i];                                                        // Returning writer
+        }
+    }
+    return NULL;                                                                            // Returning no writer
+}
+    // Record queue (reserve, copy, publish)
+static void uart_out_record(UartWriter *writer, const uint8_t *data, uint32_t length) {
+    uint8_t *ring = (uint8_t *)writer->ring;                                                // Declaring ring bytes
+    uint32_t size = UART_OUT_HEADER + ((length + 7) & ~7u);                                 // Declaring record size (8-byte aligned headers never wrap)
+    uint32_t start, used, waited = 0;                                                       // Declaring reservation variables
+    while (1) {                                                                             // Until space is reserved or the record is dropped
+        start = writer->reserve;                                                            // Reading reservation counter
+        used = start + size - writer->read;                                                 // Declaring ring bytes in use with this record
+        if (used > UART_OUT_RING_SIZE) {                                                    // For full ring
+            if (BIOS_getThreadType() != BIOS_ThreadType_Task || waited >= UART_OUT_BLOCK_TICKS) {
+                uart_out_add(&writer->dropped_records, 1);                                  // Interrupts never wait: dropping the newest record
+                uart_out_add(&writer->dropped_bytes, length);
+                return;                                                                     // Return from function
+            }
+            if (waited++ == 0) {                                                            // For first wait of this record
+                uart_out_add(&writer->waits, 1);                                            // Counting producer wait
+            }
+            Task_sleep(1);                                                                  // Letting the writer drain
+            continue;
+        }
+        if (uart_out_cas(&writer->reserve, start, start + size)) {                          // For reservation won
+            break;
+        }
+    }
+    while (used > writer->high_water && !uart_out_cas(&writer->high_water, writer->high_water, used));
+    uint32_t offset = start & (UART_OUT_RING_SIZE - 1);                                     // Declaring record offset
+    uint32_t payload = (offset + UART_OUT_HEADER) & (UART_OUT_RING_SIZE - 1);               // Declaring payload offset
+    uint32_t first = UART_OUT_RING_SIZE - payload;                                          // Declaring bytes before the ring end
+    volatile uint32_t *header = (volatile uint32_t *)(ring + offset);                       // Declaring record header
+    if (first > length) {                                                                   // For payload without wrap
+        first = length;
+    }
+    header[1] = Clock_getTicks();                                                           // Stamping enqueue time
+    memcpy(ring + payload, data, first);                                                    // Copying payload
+    memcpy(ring, data + first, length - first);                                             // Copying wrapped payload
+    uart_out_barrier();                                                                     // Ordering payload before publish
+    header[0] = length | UART_OUT_READY;                                                    // Publishing record
+    trace_event(TRACE_QUEUE_PUT, TRACE_OBJECT(TRACE_OBJ_WRITER, writer - uart_writers), used);
+    trace_event(TRACE_SEM_POST, TRACE_OBJECT(TRACE_OBJ_WRITER, writer - uart_writers), 0);
+    Semaphore_post(writer->sem);                                                            // Waking writer
+}
+    // Queue UART output (copies data, callers never wait for the transmitter)
+void uart_output(UART_Handle uart, const void *data, size_t length) {
+    UartWriter *writer = uart_writer_find(uart);                                            // Declaring writer of this UART
+    const uint8_t *bytes = (const uint8_t *)data;                                           // Declaring byte cursor
+    if (writer == NULL) {                                                                   // For UART without a writer
+        UART_write(uart, data, length);                                                     // Writing directly (blocking)
+        return;                                                                             // Return from function
+    }
+    while (length > 0) {                                                                    // Splitting long writes into records
+        size_t chunk = (length > UART_OUT_RECORD_MAX) ? UART_OUT_RECORD_MAX : length;       // Declaring record length
+        uart_out_record(writer, bytes, (uint32_t)chunk);
+        bytes += chunk;
+        length -= chunk;
+    }
+}
+    // UART writer task handler (sole consumer of its ring)
+void uart_writer_task(UArg arg0, UArg arg1) {
+    UartWriter *writer = (UartWriter *)arg0;                                                // Declaring writer from task argument
+    uint8_t *ring = (uint8_t *)writer->ring;                                                // Declaring ring bytes
+    uint16_t object = TRACE_OBJECT(TRACE_OBJ_WRITER, writer - uart_writers);                // Declaring trace object
+    trace_task_name(writer == &uart_writers[0] ? "UART0 out" : "UART7 out");                // Naming task in trace dumps
+    while (1) {                                                                             // Infinite loop
+        trace_event(TRACE_SEM_PEND, object, 0);
+        Semaphore_pend(writer->sem, BIOS_WAIT_FOREVER);                                     // Waiting for published records
+        trace_event(TRACE_SEM_TAKE, object, 1);
+        while (writer->read != writer->reserve) {                                           // For reserved records
+            uint32_t offset = writer->read & (UART_OUT_RING_SIZE - 1);                      // Declaring record offset
+            volatile uint32_t *header = (volatile uint32_t *)(ring + offset);               // Declaring record header
+            uint32_t word = header[0];                                                      // Declaring length and ready flag
+            if (!(word & UART_OUT_READY)) {                                                 // For record still being copied (its producer posts)
+                break;
+            }
+            uint32_t length = word & ~UART_OUT_READY;                                       // Declaring payload length
+            uint32_t size = UART_OUT_HEADER + ((length + 7) & ~7u);                         // Declaring record size
+            uint32_t payload = (offset + UART_OUT_HEADER) & (UART_OUT_RING_SIZE - 1);       // Declaring payload offset
+            uint32_t first = UART_OUT_RING_SIZE - payload;                                  // Declaring bytes before the ring end
+            if (first > length) {                                                           // For payload without wrap
+                first = length;
+            }
+            UART_write(writer->uart, ring + payload, first);                                // Writing payload
+            if (length > first) {                                                           // For wrapped payload
+                UART_write(writer->uart, ring, length - first);                             // Writing remainder
+            }
+            uint32_t latency = Clock_getTicks() - header[1];                                // Declaring enqueue to written time
+            writer->records++;                                                              // Counting record
+            writer->bytes += length;                                                        // Counting bytes
+            writer->latency_total += latency;                                               // Summing latency
+            if (latency > writer->latency_max) {                                            // For new longest latency
+                writer->latency_max = latency;
+            }
+            first = UART_OUT_RING_SIZE - offset;                                            // Declaring record bytes before the ring end
+            if (first > size) {                                                             // For record without wrap
+                first = size;
+            }
+            memset(ring + offset, 0, first);                                                // Clearing record (unpublished space reads as not ready)
+            memset(ring, 0, size - first);                                                  // Clearing wrapped record
+            uart_out_barrier();                                                             // Ordering clear before release
+            writer->read += size;                                                           // Releasing record space
+            trace_event(TRACE_QUEUE_GET, object, writer->reserve - writer->read);
+        }
+    }
+}
+    // UART writer start
+bool init_uart_writer(UART_Handle uart, const char *name) {
+    int i;                                                                                  // Declaring loop variable
+    for (i = 0; i < UART_WRITER_COUNT && uart_writers[i].sem != NULL; i++);                 // Finding unused writer
+    if (i == UART_WRITER_COUNT || uart == NULL) {                                           // For no free writer
+        return false;                                                                       // Returning failed start
+    }
+    UartWriter *writer = &uart_writers[i];                                                  // Declaring writer
+    Semaphore_Params semParams;                                                             // Creating writer semaphore
+    Semaphore_Params_init(&semParams);                                                      // Declaring semaphore parameter initialization
+    semParams.mode = Semaphore_Mode_BINARY;                                                 // One wake drains every published record
+    writer->sem = Semaphore_create(0, &semParams, NULL);                                    // Declaring writer semaphore
+    Task_Params taskParams;                                                                 // Creating writer task
+    Task_Params_init(&taskParams);                                                          // Declaring task parameter
+    taskParams.stackSize = UART_WRITER_STACK_SIZE;                                          // Declaring task stack size
+    taskParams.priority = UART_WRITER_PRIORITY;                                             // Declaring task priority
+    taskParams.stack = &uartWriterStacks[i];                                                // Declaring task stack
+    taskParams.arg0 = (UArg)writer;                                                         // Passing writer
+    writer->name = name;                                                                    // Declaring writer name
+    if (writer->sem == NULL || Task_create(uart_writer_task, &taskParams, NULL) == NULL) {  // For failed semaphore or task
+        return false;                                                                       // Returning failed start (writes stay direct)
+    }
+    writer->uart = uart;                                                                    // Routing uart_output through the ring
+    return true;                                                                            // Returning started writer
+}
+
+/* Trace function(s) */
+    // Task slot of the caller (0 for interrupts; a task claims the next slot the first time it records)
+static uint8_t trace_context(void) {
+    TraceRing *trace = &trace_ring;                                                         // Declaring trace
+    uint32_t i, count;                                                                      // Declaring slot walk
+    if (BIOS_getThreadType() != BIOS_ThreadType_Task) {                                     // For interrupt context
+        return 0;                                                                           // Returning interrupt context
+    }
+    Task_Handle self = Task_self();                                                         // Declaring calling task
+    count = trace->task_count;
+    for (i = 0; i < count && i < TRACE_TASKS; i++) {                                        // For each claimed slot
+        if (trace->tasks[i] == self) return (uint8_t)(i + 1);                               // Returning task's slot
+    }
+    do {                                                                                    // Claiming a slot (only this task claims for itself)
+        count = trace->task_count;
+        if (count >= TRACE_TASKS) return TRACE_TASKS + 1;                                   // Returning shared overflow context
+    } while (!uart_out_cas(&trace->task_count, count, count + 1));
+    trace->tasks[count] = self;                                                             // Declaring slot owner
+    return (uint8_t)(count + 1);                                                            // Returning new slot
+}
+    // Record one event (reserve, fill, stamp; safe from any task or interrupt)
+void trace_event(uint8_t id, uint16_t arg0, uint32_t arg1) {
+    TraceRing *trace = &trace_ring;                                                         // Declaring trace
+    uint32_t index;                                                                         // Declaring reserved index
+    if (!trace->enabled) {                                                                  // For recording paused
+        return;                                                                             // Return from function
+    }
+    do {
+        index = trace->head;                                                                // Reading reservation counter
+    } while (!uart_out_cas(&trace->head, index, index + 1));                                // Retrying until the slot is ours
+    TraceEvent *event = &trace->events[index & (TRACE_EVENTS - 1)];                         // Declaring event slot
+    event->stamp = 0;                                                                       // Marking slot as being written
+    uart_out_barrier();                                                                     // Ordering mark before the fields
+    event->time = timebase_now();                                                           // Stamping timebase
+    event->tick = Clock_getTicks();                                                         // Stamping Clock tick
+    event->id = id;
+    event->context = trace_context();                                                       // Declaring writer
+    event->arg0 = arg0;
+    event->arg1 = arg1;
+    uart_out_barrier();                                                                     // Ordering fields before publish
+    event->stamp = index + 1;                                                               // Publishing event
+}
+    // Name the calling task in dumps
+void trace_task_name(const char *name) {
+    uint8_t context = trace_context();                                                      // Declaring caller's slot
+    if (context >= 1 && context <= TRACE_TASKS) {                                           // For a task with its own slot
+        trace_ring.names[context - 1] = name;                                               // Declaring name
+    }
+}
+    // Empty the ring (task slots and names are kept)
+void trace_clear(void) {
+    TraceRing *trace = &trace_ring;                                                         // Declaring trace
+    bool enabled = trace->enabled;                                                          // Saving recording flag
+    uint32_t i;                                                                             // Declaring loop variable
+    trace->enabled = false;                                                                 // Pausing producers
+    for (i = 0; i < TRACE_EVENTS; i++) {                                                    // For each slot
+        trace->events[i].stamp = 0;                                                         // Marking slot empty
+    }
+    trace->head = 0;                                                                        // Restarting reservations
+    uart_out_barrier();                                                                     // Ordering clear before resuming
+    trace->enabled = enabled;                                                               // Restoring recording flag
+}
+    // Append dump bytes (flushes full chunks to the UART, CRC covers everything after the magic)
+static void trace_put(UART_Handle uart, uint8_t *chunk, size_t *used, uint16_t *crc, const void *data, size_t length) {
+    const uint8_t *bytes = (const uint8_t *)data;                                           // Declaring byte cursor
+    if (crc != NULL) {                                                                      // For checked bytes
+        *crc = crc16_ccitt_update(*crc, bytes, length);
+    }
+    while (length > 0) {                                                                    // Copying into the chunk
+        size_t room = TRACE_CHUNK_SIZE - *used;                                             // Declaring chunk space
+        size_t take = (length < room) ? length : room;                                      // Declaring bytes copied
+        memcpy(chunk + *used, bytes, take);
+        *used += take;
+        bytes += take;
+        length -= take;
+        if (*used == TRACE_CHUNK_SIZE) {                                                    // For full chunk
+            uart_output(uart, chunk, *used);                                                // Queuing chunk
+            *used = 0;
+        }
+    }
+}
+    // Little-endian field
+static void trace_put_le(UART_Handle uart, uint8_t *chunk, size_t *used, uint16_t *crc, uint32_t value, size_t bytes) {
+    uint8_t field[4];                                                                       // Declaring field bytes
+    size_t i;                                                                               // Declaring loop variable
+    for (i = 0; i < bytes; i++) {                                                           // Low byte first
+        field[i] = (uint8_t)(value >> (8 * i));
+    }
+    trace_put(uart, chunk, used, crc, field, bytes);
+}
+    // Stream the ring in binary (header, task and command names, events oldest first, CRC-16)
+uint32_t trace_dump(UART_Handle uart) {
+    TraceRing *trace = &trace_ring;                                                         // Declaring trace
+    uint8_t chunk[TRACE_CHUNK_SIZE + 2];                                                    // Declaring output chunk (and the CRC)
+    char name[TRACE_NAME_LENGTH];                                                           // Declaring padded name
+    size_t used = 0;                                                                        // Declaring chunk fill
+    uint16_t crc = 0xFFFF;                                                                  // Declaring dump CRC
+    bool enabled = trace->enabled;                                                          // Saving recording flag
+    uint32_t head, first, i, events = 0, tasks, commands = 0;                               // Declaring dump extent
+    trace->enabled = false;                                                                 // Pausing producers (a writer caught mid-event is skipped)
+    uart_out_barrier();
+    head = trace->head;                                                                     // Declaring events reserved
+    first = (head > TRACE_EVENTS) ? head - TRACE_EVENTS : 0;                                // Declaring oldest event still held
+    for (i = first; i < head; i++) {                                                        // Counting complete events
+        if (trace->events[i & (TRACE_EVENTS - 1)].stamp == i + 1) events++;
+    }
+    tasks = (trace->task_count < TRACE_TASKS) ? trace->task_count : TRACE_TASKS;            // Declaring named slots
+    while (command_by_id((int)commands) != NULL) commands++;                                // Counting commands
+    trace_put(uart, chunk, &used, NULL, TRACE_MAGIC, 4);                                    // Writing magic
+    trace_put_le(uart, chunk, &used, &crc, PERF_TICKS_PER_US * 1000000UL, 4);               // Writing timebase ticks per second
+    trace_put_le(uart, chunk, &used, &crc, TRACE_TICK_US, 2);                               // Writing Clock tick period
+    trace_put_le(uart, chunk, &used, &crc, tasks, 1);
+    trace_put_le(uart, chunk, &used, &crc, commands, 1);
+    trace_put_le(uart, chunk, &used, &crc, events, 2);
+    trace_put_le(uart, chunk, &used, &crc, head, 4);                                        // Writing events recorded (older ones overwritten)
+    for (i = 0; i < tasks; i++) {                                                           // For each task slot
+        memset(name, 0, sizeof(name));
+        if (trace->names[i] != NULL) strncpy(name, trace->names[i], sizeof(name) - 1);
+        trace_put(uart, chunk, &used, &crc, name, TRACE_NAME_LENGTH);
+    }
+    for (i = 0; i < commands; i++) {                                                        // For each command (ID order)
+        memset(name, 0, sizeof(name));
+        strncpy(name, command_by_id((int)i)->name, MAX_COMMAND_NAME_LENGTH);
+        trace_put(uart, chunk, &used, &crc, name, MAX_COMMAND_NAME_LENGTH);
+    }
+    for (i = first; i < head; i++) {                                                        // For each complete event, oldest first
+        TraceEvent *event = &trace->events[i & (TRACE_EVENTS - 1)];                         // Declaring event
+        if (event->stamp != i + 1) continue;
+        trace_put_le(uart, chunk, &used, &crc, event->time, 4);
+        trace_put_le(uart, chunk, &used, &crc, event->tick, 4);
+        trace_put_le(uart, chunk, &used, &crc, event->id, 1);
+        trace_put_le(uart, chunk, &used, &crc, event->context, 1);
+        trace_put_le(uart, chunk, &used, &crc, event->arg0, 2);
+        trace_put_le(uart, chunk, &used, &crc, event->arg1, 4);
+    }
+    chunk[used++] = (uint8_t)(crc >> 8);                                                    // Appending CRC (big-endian, as frames do)
+    chunk[used++] = (uint8_t)crc;
+    uart_output(uart, chunk, used);                                                         // Queuing last chunk
+    trace->enabled = enabled;                                                               // Restoring recording flag
+    return events;                                                                          // Returning events written
+}
+
+/* UART receive function(s) */
+    // Receiver lookup
+static UartRx *uart_rx_find(UART_Handle uart) {
+    int i;                                                                                  // Declaring loop variable
+    for (i = 0; i < UART_RX_COUNT; i++) {                                                   // For each receiver
+        if (uart_receivers[i].uart == uart && uart != NULL) {                               // For receiver of this UART
+            return &uart_receivers[i];                                                      // Returning receiver
+        }
+    }
+    return NULL;                                                                            // Returning no receiver
+}
+    // Callback-mode read completion (interrupt context: store, wake, re-arm)
+void uart_rx_callback(UART_Handle uart, void *buffer, size_t count) {
+    UartRx *rx = uart_rx_find(uart);                                                        // Declaring receiver of this UART
+    const uint8_t *bytes = (const uint8_t *)buffer;                                         // Declaring received bytes
+    bool wake = false;                                                                      // Declaring consumer wake flag
+    size_t i;                                                                               // Declaring loop variable
+    if (rx == NULL) {                                                                       // For UART without a receiver
+        return;                                                                             // Return from function
+    }
+    if (count == 0) {                                                                       // For cancelled read
+        rx->stopped = true;                                                                 // Leaving the re-arm to the consumer
+        trace_event(TRACE_SEM_POST, TRACE_OBJECT(TRACE_OBJ_RX, rx - uart_receivers), 0);
+        Semaphore_post(rx->sem);                                                            // Waking consumer
+        return;                                                                             // Return from function
+    }
+    for (i = 0; i < count; i++) {                                                           // For each received byte
+        uint32_t head = rx->head;                                                           // Declaring ring head
+        uint32_t used = head - rx->tail + (rx->overrun ? 2 : 1);                            // Declaring ring bytes in use with this byte (and loss marker)
+        if (used > UART_RX_RING_SIZE) {                                                     // For full ring
+            rx->overruns++;                                                                 // Counting lost byte
+            rx->overrun = true;                                                             // Marking the loss for the consumer
+            increment_error(rx->error);                                                     // Incrementing receive error
+            wake = true;                                                                    // Waking consumer to drain
+            continue;
+        }
+        if (rx->overrun) {                                                                  // For bytes lost before this one
+            rx->ring[head++ & (UART_RX_RING_SIZE - 1)] = '\0';                              // Storing loss marker (never part of a command)
+            rx->overrun = false;
+        }
+        rx->ring[head++ & (UART_RX_RING_SIZE - 1)] = bytes[i];                              // Storing byte
+        uart_out_barrier();                                                                 // Ordering bytes before publish
+        rx->head = head;                                                                    // Publishing byte
+        rx->bytes++;                                                                        // Counting byte
+        if (used > rx->high_water) {                                                        // For new high-water mark
+            rx->high_water = used;
+        }
+        wake |= rx->wake_on_byte || bytes[i] == '\r' || bytes[i] == '\n' ||                 // Waking on line and frame ends (or every byte for line editors)
+                bytes[i] == UART_FRAME_END ||
+                used >= UART_RX_RING_SIZE / 2;                                              // and before a long line can fill the ring
+    }
+    if (wake) {                                                                             // For line end, overrun or byte wake
+        trace_event(TRACE_SEM_POST, TRACE_OBJECT(TRACE_OBJ_RX, rx - uart_receivers), rx->head - rx->tail);
+        Semaphore_post(rx->sem);                                                            // Waking consumer
+    }
+    UART_read(uart, &rx->byte, 1);                                                          // Re-arming read
+}
+    // Receive one byte (returns -1 on timeout)
+int uart_rx_getc(UartRx *rx, uint32_t timeout) {
+    while (rx->tail == rx->head) {                                                          // For empty ring
+        if (rx->stopped) {                                                                  // For cancelled read
+            rx->stopped = false;
+            UART_read(rx->uart, &rx->byte, 1);                                              // Re-arming read once the ring is drained
+            continue;
+        }
+        uint16_t object = TRACE_OBJECT(TRACE_OBJ_RX, rx - uart_receivers);                  // Declaring trace object
+        trace_event(TRACE_SEM_PEND, object, timeout);
+        bool woken = Semaphore_pend(rx->sem, timeout);                                      // Declaring wake before the timeout
+        trace_event(TRACE_SEM_TAKE, object, woken);
+        if (!woken) {                                                                       // For no wake in time
+            return -1;                                                                      // Returning timeout
+        }
+    }
+    uint8_t c = rx->ring[rx->tail & (UART_RX_RING_SIZE - 1)];                               // Declaring next byte
+    uart_out_barrier();                                                                     // Ordering read before release
+    rx->tail++;                                                                             // Releasing ring byte
+    return c;                                                                               // Returning byte
+}
+    // Finish the line or frame in rx->line (returns length, 0 when empty, or its drop status)
+static int uart_rx_take(UartRx *rx, bool frame) {
+    int status = rx->status;                                                                // Declaring line drop status
+    int length = rx->length;                                                                // Declaring line length
+    rx->line[length] = '\0';                                                                // Ensuring NULL of line
+    rx->length = 0;                                                                         // Starting next line
+    rx->status = 0;
+    rx->frame = frame;                                                                      // Declaring result kind
+    if (status != 0) {                                                                      // For damaged line
+        rx->dropped_lines++;                                                                // Counting dropped line
+        return status;                                                                      // Returning drop status
+    }
+    if (length > 0) {                                                                       // For non-empty line (CRLF gives an empty one)
+        if (frame) {
+            rx->frames++;                                                                   // Counting frame
+        } else {
+            rx->lines++;                                                                    // Counting line
+        }
+    }
+    return length;                                                                          // Returning line length
+}
+    // Receive one line or SLIP frame into rx->line (returns length, UART_RX_TIMEOUT_LINE or a drop status)
+int uart_rx_line(UartRx *rx, uint32_t timeout) {
+    int c, result;                                                                          // Declaring received byte and result
+    while ((c = uart_rx_getc(rx, timeout)) >= 0) {                                          // Until the ring stays empty for timeout
+        if (c == UART_FRAME_END) {                                                          // For frame delimiter
+            if (rx->in_frame && (rx->length > 0 || rx->status != 0)) {                      // For end of a frame
+                rx->in_frame = false;
+                rx->escape = false;
+                return uart_rx_take(rx, true);                                              // Returning frame
+            }
+            if (!rx->in_frame && (rx->length > 0 || rx->status != 0)) {                     // For text cut short by a frame
+                rx->status = UART_RX_OVERRUN;
+                uart_rx_take(rx, false);                                                    // Dropping partial line
+            }
+            rx->in_frame = true;                                                            // Opening frame (an empty frame only resynchronises)
+            rx->escape = false;
+        } else if (c == '\0') {                                                             // For loss marker (frames escape NUL)
+            rx->status = UART_RX_OVERRUN;                                                   // Dropping the line being received
+        } else if (rx->in_frame) {                                                          // For frame byte
+            if (c == UART_FRAME_ESC) {                                                      // For escape
+                rx->escape = true;
+                continue;
+            }
+            if (rx->escape) {                                                               // For escaped byte (unknown escapes fail the CRC)
+                c = (c == UART_FRAME_ESC_END) ? UART_FRAME_END :
+                    (c == UART_FRAME_ESC_ESC) ? UART_FRAME_ESC :
+                    (c == UART_FRAME_ESC_NUL) ? 0 : c;
+                rx->escape = false;
+            }
+            if (rx->length < UART_FRAME_MAX) {                                              // For room in the frame
+                rx->line[rx->length++] = (char)c;                                           // Appending byte
+            } else if (rx->status == 0) {                                                   // For first byte past the frame limit
+                rx->status = UART_RX_LONG_LINE;                                             // Dropping the frame being received
+            }
+        } else if (c == '\r' || c == '\n') {                                                // For line end
+            if ((result = uart_rx_take(rx, false)) != 0) {                                  // For line or dropped line
+                return result;                                                              // Returning line length or drop status
+            }
+        } else if (rx->length < BUFFER_SIZE - 2) {                                          // For room in the line
+            rx->line[rx->length++] = (char)c;                                               // Appending byte
+        } else if (rx->status == 0) {                                                       // For first byte past the line limit
+            rx->status = UART_RX_LONG_LINE;                                                 // Dropping the line being received
+        }
+    }
+    return UART_RX_TIMEOUT_LINE;                                                            // Returning timeout (partial line kept)
+}
+    // UART receiver start (UART opened in callback read mode with uart_rx_callback)
+UartRx *init_uart_rx(UART_Handle uart, const char *name, bool wake_on_byte, int error) {
+    int i;                                                                                  // Declaring loop variable
+    for (i = 0; i < UART_RX_COUNT && uart_receivers[i].uart != NULL; i++);                  // Finding unused receiver
+    if (i == UART_RX_COUNT || uart == NULL) {                                               // For no free receiver
+        return NULL;                                                                        // Returning failed start
+    }
+    UartRx *rx = &uart_receivers[i];                                                        // Declaring receiver
+    Semaphore_Params semParams;                                                             // Creating receiver semaphore
+    Semaphore_Params_init(&semParams);                                                      // Declaring semaphore parameter initialization
+    semParams.mode = Semaphore_Mode_BINARY;                                                 // One wake drains every received byte
+    rx->sem = Semaphore_create(0, &semParams, NULL);                                        // Declaring receiver semaphore
+    if (rx->sem == NULL) {                                                                  // For failed semaphore
+        return NULL;                                                                        // Returning failed start
+    }
+    rx->name = name;                                                                        // Declaring receiver name
+    rx->wake_on_byte = wake_on_byte;                                                        // Declaring wake policy
+    rx->error = error;                                                                      // Declaring overrun error slot
+    rx->uart = uart;                                                                        // Routing read completions to the ring
+    UART_read(uart, &rx->byte, 1);                                                          // Arming first read
+    return rx;                                                                              // Returning started receiver
+}
+
+/* UART7 frame function(s) */
+static const uint16_t crc16_nibbles[16] = {                                                 // Declaring CRC-16 (0x1021) nibble table
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+    // CRC-16/CCITT-FALSE (initial 0xFFFF, no reflection)
+uint16_t crc16_ccitt(const uint8_t *data, size_t length) {
+    return crc16_ccitt_update(0xFFFF, data, length);                                        // Returning CRC from the initial register
+}
+    // CRC-16/CCITT-FALSE continued over more data
+uint16_t crc16_ccitt_update(uint16_t crc, const uint8_t *data, size_t length) {
+    while (length-- > 0) {                                                                  // For each byte, high nibble first
+        crc = (uint16_t)(crc << 4) ^ crc16_nibbles[(crc >> 12) ^ (*data >> 4)];
+        crc = (uint16_t)(crc << 4) ^ crc16_nibbles[(crc >> 12) ^ (*data++ & 0x0F)];
+    }
+    return crc;                                                                             // Returning CRC
+}
+    // Frame build (type, sequence, payload, CRC) and SLIP encode
+static size_t uart_frame_encode(uint8_t *out, uint8_t type, uint8_t sequence, const uint8_t *payload, size_t length) {
+    uint8_t frame[UART_FRAME_MAX];                                                          // Declaring decoded frame
+    size_t size = length + UART_FRAME_OVERHEAD;                                             // Declaring decoded frame length
+    size_t i, n = 0;                                                                        // Declaring loop and output variables
+    frame[0] = type;                                                                        // Declaring frame type
+    frame[1] = sequence;                                                                    // Declaring sequence number
+    memcpy(frame + 2, payload, length);                                                     // Copying payload
+    uint16_t crc = crc16_ccitt(frame, length + 2);                                          // Declaring frame CRC
+    frame[size - 2] = (uint8_t)(crc >> 8);                                                  // Appending CRC (big-endian)
+    frame[size - 1] = (uint8_t)crc;
+    out[n++] = UART_FRAME_END;                                                              // Leading delimiter flushes line noise
+    for (i = 0; i < size; i++) {                                                            // For each frame byte
+        uint8_t b = frame[i];                                                               // Declaring frame byte
+        if (b == UART_FRAME_END || b == UART_FRAME_ESC || b == 0) {                         // For bytes the receiver reserves
+            out[n++] = UART_FRAME_ESC;                                                      // Escaping byte
+            b = (b == UART_FRAME_END) ? UART_FRAME_ESC_END :
+                (b == UART_FRAME_ESC) ? UART_FRAME_ESC_ESC : UART_FRAME_ESC_NUL;
+        }
+        out[n++] = b;                                                                       // Appending byte
+    }
+    out[n++] = UART_FRAME_END;                                                              // Closing delimiter
+    return n;                                                                               // Returning encoded length
+}
+    // Acknowledgement reply
+static void uart_frame_reply(uint8_t type, uint8_t sequence, uint8_t detail) {
+    uint8_t out[2 * (UART_FRAME_OVERHEAD + 1) + 2];                                         // Declaring encoded reply
+    uart_output(uart7, out, uart_frame_encode(out, type, sequence, &detail, 1));            // Writing reply to UART7
+}
+    // Release the send window
+static void uart_frame_release(UartLink *link) {
+    link->pending = false;                                                                  // Declaring no frame awaiting acknowledgement
+    trace_event(TRACE_SEM_POST, TRACE_OBJECT(TRACE_OBJ_WINDOW, 0), 0);
+    Semaphore_post(link->window);                                                           // Opening window to the next sender
+}
+    // Retransmit the pending frame (or give it up)
+static void uart_frame_retry(ShellSession *session, UartLink *link) {
+    if (link->retries >= UART_FRAME_RETRIES) {                                              // For retries used up
+        link->failures++;                                                                   // Counting failed frame
+        increment_error(ERR_UART);                                                          // Incrementing UART7 error
+        snprintf(session->prompt, USER_PROMPT_SIZE,
+                 "\r\n\033[31mError\033[0m: UART7 frame %u not acknowledged.\r\n", link->pending_sequence);
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing failure prompt to the session channel
+        uart_frame_release(link);
+        return;                                                                             // Return from function
+    }
+    link->retries++;                                                                        // Counting retransmit
+    link->retransmits++;
+    link->sent_at = Clock_getTicks();                                                       // Restarting acknowledgement timer
+    uart_output(uart7, link->pending_frame, link->pending_length);                          // Writing frame again
+}
+    // Take the send window
+static bool uart_frame_window(UartLink *link, uint32_t timeout) {
+    trace_event(TRACE_SEM_PEND, TRACE_OBJECT(TRACE_OBJ_WINDOW, 0), timeout);
+    bool open = Semaphore_pend(link->window, timeout);                                      // Declaring window taken
+    trace_event(TRACE_SEM_TAKE, TRACE_OBJECT(TRACE_OBJ_WINDOW, 0), open);
+    return open;                                                                            // Returning window taken
+}
+    // Start the pending frame (window held)
+static void uart_frame_start(UartLink *link, uint8_t type, const uint8_t *payload, size_t length) {
+    link->pending_type = type;                                                              // Declaring frame type (sync or command batch)
+    link->pending_sequence = link->tx_sequence++;                                           // Declaring frame sequence number
+    link->pending_length = (uint16_t)uart_frame_encode(link->pending_frame, type,
+                                                       link->pending_sequence, payload, length);
+    link->retries = 0;
+    link->sent_at = Clock_getTicks();                                                       // Starting acknowledgement timer
+    uart_out_barrier();                                                                     // Ordering frame before publish
+    link->pending = true;                                                                   // Publishing pending frame to the UART7 task
+    uart_output(uart7, link->pending_frame, link->pending_length);                          // Writing frame to UART7
+}
+    // Send a command batch (waits for the window; the UART7 task never waits on itself)
+int uart_frame_send(const uint8_t *payload, size_t length) {
+    UartLink *link = &uart_link;                                                            // Declaring link
+    uint32_t timeout = UART_FRAME_ACK_TIMEOUT * (UART_FRAME_RETRIES + 1);                   // Declaring window wait (one full retry cycle)
+    if (uart7 == NULL || link->window == NULL || length > UART_FRAME_MAX - UART_FRAME_OVERHEAD) {
+        return -1;                                                                          // Returning failed send
+    }
+    if (BIOS_getThreadType() != BIOS_ThreadType_Task || Task_self() == uart7TaskHandle) {   // For callers that cannot wait
+        timeout = 0;
+    }
+    if (!uart_frame_window(link, timeout)) {                                                // For frame still awaiting acknowledgement
+        return -1;                                                                          // Returning failed send
+    }
+    if (!link->synced) {                                                                    // For first batch since this board started
+        uart_frame_start(link, UART_FRAME_SYNC, NULL, 0);                                   // Clearing the peer's duplicate filter first
+        if (!uart_frame_window(link, timeout)) {                                            // For sync still awaiting acknowledgement
+            return -1;                                                                      // Returning failed send (sync keeps the window)
+        }
+        if (!link->synced) {                                                                // For sync given up
+            uart_frame_release(link);                                                       // Reopening window
+            return -1;                                                                      // Returning failed send
+        }
+    }
+    link->frames_sent++;                                                                    // Counting frame
+    uart_frame_start(link, UART_FRAME_CMD, payload, length);
+    return link->pending_sequence;                                                          // Returning sequence number
+}
+    // Received frame (acknowledgements end the pending frame, command batches run and are acknowledged)
+void uart_frame_receive(ShellSession *session, const uint8_t *frame, size_t length) {
+    UartLink *link = &uart_link;                                                            // Declaring link
+    char args[BUFFER_SIZE];                                                                 // Declaring command arguments
+    size_t at, size;                                                                        // Declaring record offset and payload size
+    int count = 0;                                                                          // Declaring record count
+    if (length < UART_FRAME_OVERHEAD ||                                                     // For short frame or CRC mismatch
+        crc16_ccitt(frame, length - 2) != (uint16_t)((frame[length - 2] << 8) | frame[length - 1])) {
+        link->crc_errors++;                                                                 // Counting CRC error
+        increment_error(ERR_UART);                                                          // Incrementing UART7 error
+        uart_frame_reply(UART_FRAME_NACK, (length > 1) ? frame[1] : 0, UART_NACK_CRC);      // Asking for a retransmit
+        return;                                                                             // Return from function
+    }
+    link->frames_received++;                                                                // Counting intact frame
+    const uint8_t *payload = frame + 2;                                                     // Declaring payload
+    size = length - UART_FRAME_OVERHEAD;                                                    // Declaring payload size
+        // Acknowledgements
+    if (frame[0] == UART_FRAME_ACK || frame[0] == UART_FRAME_NACK) {
+        bool ack = (frame[0] == UART_FRAME_ACK);                                            // Declaring acknowledgement kind
+        uint8_t detail = (size > 0) ? payload[0] : 0;                                       // Declaring commands run or NACK reason
+        if (ack) {
+            link->acks++;                                                                   // Counting acknowledgement
+        } else {
+            link->nacks++;                                                                  // Counting negative acknowledgement
+        }
+        if (!link->pending || ((ack || detail == UART_NACK_FORMAT) && frame[1] != link->pending_sequence)) {
+            return;                                                                         // Ignoring stale reply (CRC NACKs may carry a damaged sequence)
+        }
+        if (ack) {
+            if (link->pending_type == UART_FRAME_SYNC) {                                    // For sync delivered
+                link->synced = true;                                                        // Declaring peer's duplicate filter cleared
+            }
+            uart_frame_release(link);                                                       // Frame delivered
+        } else if (detail == UART_NACK_FORMAT) {                                            // For batch the peer cannot run
+            link->retries = UART_FRAME_RETRIES;                                             // Giving frame up
+            uart_frame_retry(session, link);
+        } else {
+            uart_frame_retry(session, link);                                                // Retransmitting damaged frame
+        }
+        return;                                                                             // Return from function
+    }
+        // PCM samples (never acknowledged: a late retransmit would only add jitter)
+    if (frame[0] == UART_FRAME_PCM) {
+        pcm_receive(frame[1], payload, size);                                               // Buffering samples for the sine timer
+        return;                                                                             // Return from function
+    }
+        // Sync (peer restarted: its sequence numbers start again)
+    if (frame[0] == UART_FRAME_SYNC) {
+        link->rx_valid = false;                                                             // Forgetting the last batch run
+        uart_frame_reply(UART_FRAME_ACK, frame[1], 0);                                      // Acknowledging sync
+        return;                                                                             // Return from function
+    }
+        // Command batches
+    if (frame[0] != UART_FRAME_CMD) {                                                       // For unknown frame type
+        uart_frame_reply(UART_FRAME_NACK, frame[1], UART_NACK_FORMAT);
+        return;                                                                             // Return from function
+    }
+    if (link->rx_valid && frame[1] == link->rx_sequence) {                                  // For retransmit of a batch already run (acknowledgement lost)
+        link->duplicates++;                                                                 // Counting duplicate
+        uart_frame_reply(UART_FRAME_ACK, frame[1], link->rx_count);                         // Acknowledging again without running
+        return;                                                                             // Return from function
+    }
+    for (at = 0; at < size; at += 1 + payload[at], count++) {                               // Checking every record before running any
+        const Command *entry = NULL;                                                        // Declaring record command
+        if (payload[at] >= 2 && at + 1 + payload[at] <= size && payload[at + 1] > 0 &&      // For whole record with a name
+            payload[at + 1] < payload[at]) {
+            entry = find_command((const char *)payload + at + 2, payload[at + 1]);          // Looking up name (unknown on this build: rejected)
+        }
+        if (entry == NULL || (entry->schema == CMD_ARGS_NONE && payload[at] > 1 + payload[at + 1])) { // For bad record or arguments on a bare command
+            increment_error(ERR_UART);                                                      // Incrementing UART7 error
+            uart_frame_reply(UART_FRAME_NACK, frame[1], UART_NACK_FORMAT);
+            return;                                                                         // Return from function
+        }
+    }
+    link->rx_valid = true;                                                                  // Declaring batch run
+    link->rx_sequence = frame[1];
+    link->rx_count = (uint8_t)count;
+    for (at = 0; at < size; at += 1 + payload[at]) {                                        // For each record: length, name length, name, arguments
+        size_t name_length = payload[at + 1];                                               // Declaring command name length
+        size_t arg_length = payload[at] - 1 - name_length;                                  // Declaring argument length
+        args[0] = '\0';
+        if (arg_length > 0) {                                                               // For arguments (handlers expect the separator)
+            args[0] = ' ';
+            memcpy(args + 1, payload + at + 2 + name_length, arg_length);                   // Copying arguments
+            args[arg_length + 1] = '\0';
+        }
+        dispatch_command(session, find_command((const char *)payload + at + 2, name_length), args); // Running pre-encoded command
+    }
+    link->commands += count;                                                                // Counting framed commands
+    uart_frame_reply(UART_FRAME_ACK, frame[1], (uint8_t)count);                             // Acknowledging batch
+}
+    // Acknowledgement timeout
+void uart_frame_poll(ShellSession *session) {
+    UartLink *link = &uart_link;                                                            // Declaring link
+    if (link->pending && Clock_getTicks() - link->sent_at >= UART_FRAME_ACK_TIMEOUT) {      // For acknowledgement overdue
+        uart_frame_retry(session, link);                                                    // Retransmitting frame
+    }
+}
+
 /* UART7 function(s) */
     // UART7 message safety
 bool isMessageTooLong(const char *message) {
@@ -73,36 +764,33 @@ bool isMessageTooLong(const char *message) {
 }
     // UART7 task handler
 void uart7Task(UArg arg0, UArg arg1) {
-    char input[BUFFER_SIZE];                                                                // Declaring input array
-    size_t index = 0;                                                                       // Declaring index variable
-    bool overflow = false;                                                                  // Declaring overflow flag
+    ShellSession *session = &shell_sessions[SESSION_UART7];                                 // Declaring UART7 session
+    UartRx *rx = (UartRx *)arg0;                                                            // Declaring UART7 receiver
+    trace_task_name("UART7");                                                               // Naming task in trace dumps
     while (1) {                                                                             // Infinite processing loop
-        char c;                                                                             // Declaring char scanner
-        UART_read(uart7, &c, 1);                                                            // Reading each char in UART7
-        if (c == '\r' || c == '\n') {                                                       // If break or tab detected
-            if (index > 0 && !overflow) {                                                   // If index full present and overflow inactive
-                input[index] = '\0';                                                        // Process tabs to input
-                processUart7Input(uart7, input);                                            // Declaring input process to UART7
-                index = 0;                                                                  // Declaring index as 0
-                overflow = false;                                                           // Declaring overflow flag as flase
-                Task_sleep(20);                                                             // Adding delay between commands
+        int status = uart_rx_line(rx, uart_link.pending ? UART_FRAME_ACK_TIMEOUT : UART_RX_TIMEOUT);
+        if (status > 0 && rx->frame) {                                                      // For received frame
+            uart_frame_receive(session, (const uint8_t *)rx->line, status);                 // Handling frame
+        } else if (status > 0) {                                                            // For received line (legacy text)
+            processUart7Input(session, rx->line);                                           // Declaring input process to UART7
+        } else if (status < 0 && rx->frame) {                                               // For frame lost to overrun or length
+            if (status == UART_RX_LONG_LINE) {
+                increment_error(ERR_UART);                                                  // Incrementing UART7 error
             }
-            memset(input, 0, BUFFER_SIZE);                                                  // Clearing inputs from buffer size
-        }
-        else if (index < BUFFER_SIZE - 2) {                                                 // For valid index against buffer size
-            input[index++] = c;                                                             // Incrementing each char from input
-        }
-        else {                                                                              // For overflow detected
-            overflow = true;                                                                // Declaring overflow flag as true
+            uart_frame_reply(UART_FRAME_NACK, 0, UART_NACK_DAMAGED);                        // Asking for a retransmit
+        } else if (status == UART_RX_LONG_LINE) {                                           // For overflow detected
             increment_error(ERR_UART);                                                      // Incrementing UART7 error
             const char *OFmsg = "\r\n\033[31mError\033[0m: Input too long, command will be ignored.\r\n";
-            UART_write(main_uart, OFmsg, strlen(OFmsg));                                    // Writing overflow prompt to main UART
+            uart_output(session->uart, OFmsg, strlen(OFmsg));                               // Writing overflow prompt to the session channel
+        } else if (status == UART_RX_OVERRUN) {                                             // For bytes lost to a full ring (counted on receipt)
+            const char *ORmsg = "\r\n\033[31mError\033[0m: UART7 receive overrun, command will be ignored.\r\n";
+            uart_output(session->uart, ORmsg, strlen(ORmsg));                               // Writing overrun prompt to the session channel
         }
-        Task_sleep(10);                                                                     // Giving parse small breaks to avoid collision
+        uart_frame_poll(session);                                                           // Retransmitting an overdue frame
     }
 }
     // UART7 input processer
-void processUart7Input(UART_Handle uart, char *command) {
+void processUart7Input(ShellSession *session, char *command) {
     if (command == NULL || strlen(command) == 0) {                                          // For empty commands
         return;                                                                             // Return from loop
     }
@@ -111,16 +799,16 @@ void processUart7Input(UART_Handle uart, char *command) {
     strncpy(cmd_copy, command, BUFFER_SIZE - 1);                                            // Copying command to buffer format
     cmd_copy[BUFFER_SIZE - 1] = '\0';                                                       // Copying breaks in tabs
     if (strcmp(cmd_copy, "-help") == 0 || strcmp(cmd_copy, "-about") == 0) {                // For commands that generate large output, use a delay
-        valid_cmd(main_uart, cmd_copy);                                                     // Execute command with main UART
+        valid_cmd(session, cmd_copy);                                                       // Execute command in the UART7 session
         Task_sleep(100);                                                                    // Giving system time to process large output
         return;                                                                             // Return from loop
     }
     if (strncmp(cmd_copy, "-print", 6) == 0) {                                              // Special handling for print command
         char *substring = (strlen(cmd_copy) > 7) ? cmd_copy + 7 : NULL;                     // Declaring substring pointer to parse options
-        print_cmd(main_uart, substring);                                                    // Pointing print_cmd variables
-        UART_write(main_uart, user_prompt, strlen(user_prompt));                            // Writing to main uart
+        print_cmd(session, substring);                                                      // Pointing print_cmd variables
+        uart_output(session->uart, session->prompt, strlen(session->prompt));               // Writing to the session channel
     } else {                                                                                // For all other commands
-        valid_cmd(main_uart, cmd_copy);                                                     // Processing normally
+        valid_cmd(session, cmd_copy);                                                       // Processing normally
     }
 }
 
@@ -128,6 +816,7 @@ void processUart7Input(UART_Handle uart, char *command) {
 void *mainThread(void *arg0)                                                                // Entry-point from RTOS
 {
     Task_setPri(Task_self(), 1);                                                            // Set main task to higher priority
+    trace_task_name("UART0");                                                               // Naming task in trace dumps
 
     /* Declaring main variables */
     char        input[BUFFER_SIZE];                                                         // Declaring buffer for user input
@@ -135,6 +824,7 @@ void *mainThread(void *arg0)
     UART_Handle uart;                                                                       // Declaring UART handle variable
     UART_Params uartParams;                                                                 // Declaring variable for UART configuration parameters
     bool        overflow = false;                                                           // Declaring overflow bool
+    bool        overrun = false;                                                            // Declaring receive overrun bool
 
     /* Call driver init functions */
     GPIO_init();                                                                            // Initializing GPIO driver
@@ -144,6 +834,8 @@ void *mainThread(void *arg0)
     init_ticker_timer();                                                                    // Initializing Ticker function
     init_registers();                                                                       // Initializing registers function
     init_script_system();                                                                   // Initializing script function
+    init_commands();                                                                        // Initializing command registry
+    init_perf();                                                                            // Starting -perf timebase
 
     /* Configure the LED pin */
     GPIO_setConfig(GPIO_LED_0, GPIO_CFG_OUT_STD | GPIO_CFG_OUT_LOW);                        // Declaring GPIO LED 1
@@ -164,21 +856,34 @@ void *mainThread(void *arg0)
     uartParams.writeDataMode = UART_DATA_BINARY;                                            // Setting UART0 data writing to binary mode
     uartParams.readDataMode = UART_DATA_BINARY;                                             // Setting UART0 reading data to binary mode
     uartParams.readReturnMode = UART_RETURN_FULL;                                           // Configuring returned data by UART_read() function
+    uartParams.readMode = UART_MODE_CALLBACK;                                               // Receiving into the UART0 ring from the read callback
+    uartParams.readCallback = uart_rx_callback;                                             // Declaring read completion callback
     uartParams.baudRate = 115200;                                                           // Declaring COM speed for UART0 interface
     uart = UART_open(CONFIG_UART_0, &uartParams);                                           // Assigning handle to UART0 COM peripheral
     if (uart == NULL) {                                                                     // Checking if UART0 failed to open
         while (1);                                                                          // Forever loop
     } else {                                                                                // UART0 successfully launched
         const char *successMsg = "\033[32m......UART0 initialized successfully......\033[0m\r\n";
-        UART_write(uart, successMsg, strlen(successMsg));                                   // Printing success message prompt
+        uart_output(uart, successMsg, strlen(successMsg));                                  // Printing success message prompt
+    }
+    ShellSession *session = &shell_sessions[SESSION_UART0];                                 // Declaring console session
+    session->uart = uart;                                                                   // Writing console output to UART0
+    ShellHistory *history = &console_history;                                               // Declaring console history
+    session->history = history;                                                             // Attaching arrow-key history
+    shell_sessions[SESSION_UART7].uart = uart;                                              // Replying to UART7 commands on UART0
+    init_uart_writer(uart, "UART0");                                                        // Queuing UART0 output from here on
+    UartRx *console = init_uart_rx(uart, "UART0", true, ERR_BUFFER_OVERFLOW);               // Receiving UART0 (byte wakes for line editing)
+    if (console == NULL) {                                                                  // Checking if UART0 receiver failed to start
+        while (1);                                                                          // Forever loop
     }
-    main_uart = uart;                                                                       // Storing the main UART handle
 
     /* Create UART7 with data processing off. */
     UART_Params uart7Params;                                                                // Declaring UART7 parameter
     UART_Params_init(&uart7Params);                                                         // Initializing UART7 parameter
     uart7Params.writeDataMode = UART_DATA_BINARY;                                           // Declaring writeDataMode
-    uart7Params.readDataMode = UART_DATA_TEXT;                                              // Declaring readDataMode
+    uart7Params.readDataMode = UART_DATA_BINARY;                                            // Declaring readDataMode (line ends handled by the receiver)
+    uart7Params.readMode = UART_MODE_CALLBACK;                                              // Receiving into the UART7 ring from the read callback
+    uart7Params.readCallback = uart_rx_callback;                                            // Declaring read completion callback
     uart7Params.readReturnMode = UART_RETURN_FULL;                                          // Declaring readReturnMode
     uart7Params.baudRate = 115200;                                                          // Declaring baudRate
     uart7Params.readTimeout = UART_WAIT_FOREVER;                                            // Declaring readTimeout
@@ -187,22 +892,28 @@ void *mainThread(void *arg0)
     if (uart7 == NULL) {                                                                    // Checking if UART7 failed to open
         increment_error(ERR_UART);                                                          // Incrementing UART7 error
         const char *errorMsg = "\r\n\033[31mError\033[0m: Failed to initialize UART7\r\n";  // Printing UART7 failed prompt
-        UART_write(uart, errorMsg, strlen(errorMsg));                                       // Writing error message to UART
+        uart_output(uart, errorMsg, strlen(errorMsg));                                      // Writing error message to UART
     } else {                                                                                // UART7 successfully launched
+        init_uart_writer(uart7, "UART7");                                                   // Queuing UART7 output
+        UartRx *rx7 = init_uart_rx(uart7, "UART7", false, ERR_UART);                        // Receiving UART7 (wakes on full lines)
+        uart_link.window = Semaphore_create(1, NULL, NULL);                                 // Opening framed link send window
         Task_Params taskParams;                                                             // Declaring task parameters
         Task_Params_init(&taskParams);                                                      // Initializing task parameters
         taskParams.stackSize = 4096;                                                        // Adjust stack size as needed
         taskParams.priority = 2;                                                            // Higher priority than main task
         taskParams.stack = &uart7TaskStack;                                                 // Adding stack declaration to global variables
-        taskParams.arg0 = (UArg)uart;                                                       // Passing UART0 handle
-        uart7TaskHandle = Task_create((Task_FuncPtr)uart7Task, &taskParams, NULL);          // Declaring UART7 task handler parameter creation
+        taskParams.arg0 = (UArg)rx7;                                                        // Passing UART7 receiver
+        uart7TaskHandle = NULL;                                                             // Declaring no task until the receiver is up
+        if (rx7 != NULL) {                                                                  // For UART7 receiver started
+            uart7TaskHandle = Task_create((Task_FuncPtr)uart7Task, &taskParams, NULL);      // Declaring UART7 task handler parameter creation
+        }
         if (uart7TaskHandle == NULL) {                                                      // For NULL tasks
             increment_error(ERR_UART);                                                      // Incrementing UART error
             const char *errorMsg = "\r\n\033[31mError\033[0m: Failed to create UART7 task\r\n";
-            UART_write(uart, errorMsg, strlen(errorMsg));                                   // Writing error prompt
+            uart_output(uart, errorMsg, strlen(errorMsg));                                  // Writing error prompt
         } else {                                                                            // For UART7 successful boot
             const char *successMsg = "\033[32m......UART7 initialized successfully......\033[0m\r\n";
-            UART_write(uart, successMsg, strlen(successMsg));                               // Writing success prompt
+            uart_output(uart, successMsg, strlen(successMsg));                              // Writing success prompt
         }
     }
 
@@ -213,40 +924,38 @@ void *mainThread(void *arg0)
     spiParams.bitRate = 4000000;                                                            // 4 MHz
     spiParams.dataSize = 16;                                                                // 16-bit transfers
     spiParams.mode = SPI_MASTER;                                                            // SPI master mode
+    spiParams.transferMode = SPI_MODE_CALLBACK;                                             // Non-blocking (DMA) transfers from the sine timer
+    spiParams.transferCallbackFxn = dac_transfer_callback;                                  // Declaring transfer completion callback
     spiHandle = SPI_open(CONFIG_SPI_0, &spiParams);                                         // Declaring SPI handler as SPI parameter opener
     if (spiHandle == NULL) {                                                                // If SPI is NULL
         const char *errorMsg = "\r\n\033[31mError\033[0m: Failed to initialize SPI for DAC\r\n";
-        UART_write(uart, errorMsg, strlen(errorMsg));                                       // Writing error prompt from uart
+        uart_output(uart, errorMsg, strlen(errorMsg));                                      // Writing error prompt from uart
     }
     GPIO_write(GPIO_PK5, 0);                                                                // Ensure PK5 is 0
-    uint16_t init_dac = 0x2000;                                                             // Initialize DAC with mid-scale value
-    SPI_Transaction transaction;                                                            // Declaring SPI transaction
-    transaction.count = 1;                                                                  // Declaring transaction count
-    transaction.txBuf = &init_dac;                                                          // Declaring transaction TX pin
-    transaction.rxBuf = NULL;                                                               // Declaring transaction RX pin
-    SPI_transfer(spiHandle, &transaction);                                                  // Declaring SPI transfer to transaction from handler
+    dac_write(0x2000);                                                                      // Initialize DAC with mid-scale value
+    init_dac_stream();                                                                      // Starting DAC refill task
     const char *successMsg = "\033[32m...SPI for DAC initialized successfully...\033[0m\r\n";
-    UART_write(uart, successMsg, strlen(successMsg));                                       // Printing success prompt from uart
+    uart_output(uart, successMsg, strlen(successMsg));                                      // Printing success prompt from uart
 
     /* UART(s) succeeded processing phase */
     const char *welcomeMsg = "\033[32m.............MSP432 Accessed!.............\033[0m\r\n"
             "Embedded System by Christian J. Maldonado (\033[31mChris\033[0m)\r\n"
             "Type '-\033[35mabout\033[0m' for compiler & configuration information.\r\n"
             "Type '-\033[35mhelp\033[0m' for available terminal commands.\r\n";
-    UART_write(uart, welcomeMsg, strlen(welcomeMsg));                                       // Sending welcome prompt to UART
+    uart_output(uart, welcomeMsg, strlen(welcomeMsg));                                      // Sending welcome prompt to UART
 
     /* Loop forever echoing */
     while (1) {
         index = 0;                                                                          // Resetting index for each command
         memset(input, 0, BUFFER_SIZE);                                                      // Clearing the input buffer
         overflow = false;                                                                   // Declaring false overflow tick
-        current_history_index = history_count;                                              // Declaring history index with count
+        overrun = false;                                                                    // Declaring false overrun tick
+        history->index = history->count;                                                    // Declaring history index with count
         while (1) {
-            char c;                                                                         // Declaring character for terminal
-            UART_read(uart, &c, 1);                                                         // Reading terminal line to UART
+            char c = (char)uart_rx_getc(console, BIOS_WAIT_FOREVER);                        // Reading terminal line from the UART0 ring
             // Tabs
             if (c == '\r' || c == '\n') {                                                   // Declaring tabs
-                UART_write(uart, "\r\n", 1);                                                // Declaring new line
+                uart_output(uart, "\r\n", 1);                                               // Declaring new line
                 input[index] = '\0';                                                        // Declaring tab to index
                 break;                                                                      // Breaking loop
                 }
@@ -254,43 +963,48 @@ void *mainThread(void *arg0)
             else if (c == '\b' || c == 127) {                                               // Backspace operation
                 if (index > 0) {                                                            // When characters are in terminal
                     index--;                                                                // Decrement characters in terminal
-                    UART_write(uart, "\b \b", 3);                                           // Declaring spaces to UART
+                    uart_output(uart, "\b \b", 3);                                          // Declaring spaces to UART
                 }
             }
             // History
             else if (c == ESC) {                                                            // Check for arrow input
                 char seq[2];                                                                // Array for next two characters
-                UART_read(uart, seq, 2);                                                    // Reading next two characters
+                seq[0] = (char)uart_rx_getc(console, BIOS_WAIT_FOREVER);                    // Reading next two characters
+                seq[1] = (char)uart_rx_getc(console, BIOS_WAIT_FOREVER);
                 if (seq[0] == '[') {                                                        // Checking for ANSI (ESC[)
                     switch(seq[1]) {                                                        // Checking 3rd character to determine which arrow key
                         case 'A':                                                           // Up-arrow key
-                            if (current_history_index > 0) {                                // If not at older index
-                                current_history_index--;                                    // Moving to previous index
+                            if (history->index > 0) {                                       // If not at older index
+                                history->index--;                                           // Moving to previous index
                                 clear_input_line(uart, input, &index);                      // Clear current input line on terminal
-                                strcpy(input, command_history[current_history_index]);      // Copying historical command for input buffer
+                                strcpy(input, history->entries[history->index]);            // Copying historical command for input buffer
                                 index = strlen(input);                                      // Updating index to the end of historical command
-                                UART_write(uart, input, index);                             // Writing historical command to terminal
+                                uart_output(uart, input, index);                            // Writing historical command to terminal
                             }
                             break;                                                          // Breaking case operation
                         case 'B':                                                           // Down-arrow key
-                            if (current_history_index < history_count - 1) {                // If not at newest command
-                                current_history_index++;                                    // Move to newer command in history
+                            if (history->index < history->count - 1) {                      // If not at newest command
+                                history->index++;                                           // Move to newer command in history
                                 clear_input_line(uart, input, &index);                      // Clear current input line
-                                strcpy(input, command_history[current_history_index]);      // Copying historical command for input buffer
+                                strcpy(input, history->entries[history->index]);            // Copying historical command for input buffer
                                 index = strlen(input);                                      // Updating index to the end of historical command
-                                UART_write(uart, input, index);                             // Writing historical command to terminal
-                            } else if (current_history_index == history_count - 1) {        // If at the newest in index
-                                current_history_index++;                                    // Moving downward for empty input
+                                uart_output(uart, input, index);                            // Writing historical command to terminal
+                            } else if (history->index == history->count - 1) {              // If at the newest in index
+                                history->index++;                                           // Moving downward for empty input
                                 clear_input_line(uart, input, &index);                      // Clear current input line
                             }
                             break;                                                          // Breaking case operation
                     }
                 }
             }
+            // Receive overrun
+            else if (c == '\0') {                                                           // Loss marker (bytes dropped on a full ring)
+                overrun = true;                                                             // Dropping the line being typed
+            }
             // Max buffer counter
             else if (index < BUFFER_SIZE - 1) {                                             // When buffer size is under max
                 input[index] = c;                                                           // Input character to input index array
-                UART_write(uart, &c, 1);                                                    // Writing character pointer to UART
+                uart_output(uart, &c, 1);                                                   // Writing character pointer to UART
                 index++;                                                                    // Incrementing index
                 }
             else {                                                                          // Buffer overflow detected
@@ -302,12 +1016,17 @@ void *mainThread(void *arg0)
         if (overflow) {                                                                     // When overflow detected
             increment_error(ERR_BUFFER_OVERFLOW);                                           // Incrementing error count
             const char *overflowMsg = "\r\n\033[31mError\033[0m: Input too long. Command ignored.\r\n";
-            UART_write(uart, overflowMsg, strlen(overflowMsg));                             // Writing overflow message to UART
+            uart_output(uart, overflowMsg, strlen(overflowMsg));                            // Writing overflow message to UART
+            }
+        // Overrun
+        else if (overrun) {                                                                 // When receive overrun detected (counted on receipt)
+            const char *overrunMsg = "\r\n\033[31mError\033[0m: Input lost to a receive overrun. Command ignored.\r\n";
+            uart_output(uart, overrunMsg, strlen(overrunMsg));                              // Writing overrun message to UART
             }
         // History index & valid commands
         else if (index > 0) {
-            add_to_history(input);                                                          // Declaring add_to_history function
-            valid_cmd(uart, input);                                                         // Declaring valid_cmd function
+            add_to_history(history, input);                                                 // Declaring add_to_history function
+            valid_cmd(session, input);                                                      // Declaring valid_cmd function
         }
     }
 }